@@ -70,6 +70,8 @@
         'src/jsrtcontextshim.h',
         'src/jsrtisolateshim.cc',
         'src/jsrtisolateshim.h',
+        'src/jsrtmappedsource.cc',
+        'src/jsrtmappedsource.h',
         'src/jsrtpromise.cc',
         'src/jsrtproxyutils.cc',
         'src/jsrtproxyutils.h',
@@ -1108,6 +1108,78 @@ namespace JsRTApiTest
         JsRTApiTest::RunWithAttributes(JsRTApiTest::ByteCodeWithCallbackTest);
     }
 
+    typedef struct _Utf8SourceCallbackTracker
+    {
+        int loadCount;
+        int unloadCount;
+        const char *script;
+    } Utf8SourceCallbackTracker;
+
+    void ParseScriptWithCallbackUtf8Test(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
+    {
+        // "caf\u00e9" encoded as utf8; the buffer is parsed where it is.
+        static const char script[] = "function test() { return 'caf\xC3\xA9'; }; test();";
+        static const char badScript[] = "function test() { return; ";
+        JsValueRef function = JS_INVALID_REFERENCE;
+        JsValueRef result = JS_INVALID_REFERENCE;
+        JsValueRef args[] = { JS_INVALID_REFERENCE };
+        const wchar_t *stringValue;
+        size_t stringLength;
+        Utf8SourceCallbackTracker tracker = {};
+
+        JsSerializedScriptLoadUtf8SourceCallback load = [](JsSourceContext sourceContext, const char** scriptBuffer)
+        {
+            Utf8SourceCallbackTracker *tracker = (Utf8SourceCallbackTracker*)sourceContext;
+            tracker->loadCount++;
+            *scriptBuffer = tracker->script;
+            return true;
+        };
+        JsSerializedScriptUnloadCallback unload = [](JsSourceContext sourceContext)
+        {
+            ((Utf8SourceCallbackTracker*)sourceContext)->unloadCount++;
+        };
+
+        JsRuntimeHandle rt = JS_INVALID_RUNTIME_HANDLE;
+        JsContextRef current = JS_INVALID_REFERENCE;
+        JsContextRef context = JS_INVALID_REFERENCE;
+        REQUIRE(JsGetCurrentContext(&current) == JsNoError);
+        REQUIRE(JsCreateRuntime(attributes, nullptr, &rt) == JsNoError);
+        REQUIRE(JsCreateContext(rt, &context) == JsNoError);
+        REQUIRE(JsSetCurrentContext(context) == JsNoError);
+
+        CHECK(JsParseScriptWithCallbackUtf8(nullptr, unload, (JsSourceContext)&tracker, "", JsParseScriptAttributeNone, &function) == JsErrorNullArgument);
+        CHECK(JsParseScriptWithCallbackUtf8(load, nullptr, (JsSourceContext)&tracker, "", JsParseScriptAttributeNone, &function) == JsErrorNullArgument);
+        CHECK(tracker.loadCount == 0);
+
+        tracker.script = script;
+        REQUIRE(JsParseScriptWithCallbackUtf8(load, unload, (JsSourceContext)&tracker, "test.js", JsParseScriptAttributeNone, &function) == JsNoError);
+        CHECK(tracker.loadCount == 1);
+        CHECK(tracker.unloadCount == 0);
+
+        REQUIRE(JsGetUndefinedValue(&args[0]) == JsNoError);
+        REQUIRE(JsCallFunction(function, args, _countof(args), &result) == JsNoError);
+        REQUIRE(JsStringToPointer(result, &stringValue, &stringLength) == JsNoError);
+        CHECK(stringLength == 4);
+        CHECK(wcscmp(_u("caf\u00e9"), stringValue) == 0);
+
+        // A script that does not compile still hands its buffer back.
+        Utf8SourceCallbackTracker badTracker = { 0, 0, badScript };
+        CHECK(JsParseScriptWithCallbackUtf8(load, unload, (JsSourceContext)&badTracker, "bad.js", JsParseScriptAttributeNone, &function) == JsErrorScriptCompile);
+        CHECK(badTracker.loadCount == 1);
+
+        REQUIRE(JsSetCurrentContext(current) == JsNoError);
+        REQUIRE(JsDisposeRuntime(rt) == JsNoError);
+
+        CHECK(tracker.loadCount == 1);
+        CHECK(tracker.unloadCount == 1);
+        CHECK(badTracker.unloadCount == 1);
+    }
+
+    TEST_CASE("ApiTest_ParseScriptWithCallbackUtf8Test", "[ApiTest]")
+    {
+        JsRTApiTest::RunWithAttributes(JsRTApiTest::ParseScriptWithCallbackUtf8Test);
+    }
+
     void ContextCleanupTest(JsRuntimeAttributes attributes, JsRuntimeHandle runtime)
     {
         JsRuntimeHandle rt;
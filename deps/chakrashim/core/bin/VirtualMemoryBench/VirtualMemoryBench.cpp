@@ -0,0 +1,215 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Measures VirtualAlloc/VirtualFree/VirtualQuery throughput with many live
+// reservations, the way the recycler's page allocators use them: each thread
+// owns a few segments and keeps committing and decommitting pages inside
+// them while other threads do the same.
+
+#ifdef _WIN32
+#include <windows.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#else
+// The PAL provides its own stdio and stdlib.
+#include <pal.h>
+#endif
+
+static const SIZE_T pageSize = 4096;
+static const SIZE_T segmentPages = 256;
+static const unsigned int segmentsPerThread = 16;
+
+static unsigned int backgroundRegionCount = 4096;
+static unsigned int operationsPerThread = 200000;
+
+// The kernel hands out addresses top down, so regions reserved after the
+// segments sit below them. Lookups that have to get past all of those are
+// the slow case for an address-ordered list.
+static bool backgroundBelowSegments = false;
+static void ** background;
+
+struct ThreadData
+{
+    char * segments[segmentsPerThread];
+    unsigned int seed;
+    unsigned int failures;
+};
+
+static unsigned int NextRandom(unsigned int * seed)
+{
+    *seed = *seed * 1103515245 + 12345;
+    return (*seed >> 16) & 0x7fff;
+}
+
+static DWORD __stdcall WorkerThread(LPVOID param)
+{
+    ThreadData * data = (ThreadData *)param;
+
+    for (unsigned int i = 0; i < operationsPerThread; i++)
+    {
+        char * segment = data->segments[NextRandom(&data->seed) % segmentsPerThread];
+        SIZE_T pageCount = 1 + NextRandom(&data->seed) % 8;
+        SIZE_T page = NextRandom(&data->seed) % (segmentPages - pageCount);
+        char * address = segment + page * pageSize;
+
+        switch (i % 4)
+        {
+        case 0:
+        case 1:
+            if (VirtualAlloc(address, pageCount * pageSize, MEM_COMMIT, PAGE_READWRITE) == NULL)
+            {
+                data->failures++;
+                break;
+            }
+            address[0] = 1;
+            break;
+        case 2:
+            {
+                MEMORY_BASIC_INFORMATION info;
+                if (VirtualQuery(address, &info, sizeof(info)) != sizeof(info))
+                {
+                    data->failures++;
+                }
+            }
+            break;
+        case 3:
+            if (!VirtualFree(address, pageCount * pageSize, MEM_DECOMMIT))
+            {
+                data->failures++;
+            }
+            break;
+        }
+    }
+    return 0;
+}
+
+// Unrelated live reservations, so that region lookups are not trivially
+// cheap. A large process has thousands of these.
+static void ReserveBackgroundRegions()
+{
+    for (unsigned int i = 0; i < backgroundRegionCount; i++)
+    {
+        background[i] = VirtualAlloc(NULL, 16 * pageSize, MEM_RESERVE, PAGE_NOACCESS);
+    }
+}
+
+static void ReleaseBackgroundRegions()
+{
+    for (unsigned int i = 0; i < backgroundRegionCount; i++)
+    {
+        if (background[i] != NULL)
+        {
+            VirtualFree(background[i], 0, MEM_RELEASE);
+        }
+    }
+}
+
+static double RunBenchmark(unsigned int threadCount, unsigned int * failures)
+{
+    ThreadData * data = new ThreadData[threadCount];
+    HANDLE * threads = new HANDLE[threadCount];
+    LARGE_INTEGER frequency, start, end;
+
+    for (unsigned int t = 0; t < threadCount; t++)
+    {
+        data[t].seed = t + 1;
+        data[t].failures = 0;
+        for (unsigned int s = 0; s < segmentsPerThread; s++)
+        {
+            data[t].segments[s] = (char *)VirtualAlloc(NULL, segmentPages * pageSize, MEM_RESERVE, PAGE_NOACCESS);
+            if (data[t].segments[s] == NULL)
+            {
+                fprintf(stderr, "Failed to reserve a segment\n");
+                exit(1);
+            }
+        }
+    }
+
+    if (backgroundBelowSegments)
+    {
+        ReserveBackgroundRegions();
+    }
+
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&start);
+    for (unsigned int t = 0; t < threadCount; t++)
+    {
+        threads[t] = CreateThread(NULL, 0, WorkerThread, &data[t], 0, NULL);
+    }
+    for (unsigned int t = 0; t < threadCount; t++)
+    {
+        WaitForSingleObject(threads[t], INFINITE);
+        CloseHandle(threads[t]);
+    }
+    QueryPerformanceCounter(&end);
+
+    *failures = 0;
+    for (unsigned int t = 0; t < threadCount; t++)
+    {
+        *failures += data[t].failures;
+        for (unsigned int s = 0; s < segmentsPerThread; s++)
+        {
+            VirtualFree(data[t].segments[s], 0, MEM_RELEASE);
+        }
+    }
+
+    if (backgroundBelowSegments)
+    {
+        ReleaseBackgroundRegions();
+    }
+
+    delete[] threads;
+    delete[] data;
+
+    double seconds = (double)(end.QuadPart - start.QuadPart) / (double)frequency.QuadPart;
+    return (double)threadCount * operationsPerThread / seconds;
+}
+
+int main(int argc, char** argv)
+{
+#ifndef _WIN32
+    PAL_InitializeChakraCore(argc, argv);
+#endif
+
+    if (argc > 1)
+    {
+        backgroundRegionCount = (unsigned int)atoi(argv[1]);
+    }
+    if (argc > 2)
+    {
+        operationsPerThread = (unsigned int)atoi(argv[2]);
+    }
+
+    if (argc > 3)
+    {
+        backgroundBelowSegments = strcmp(argv[3], "below") == 0;
+    }
+
+    background = new void *[backgroundRegionCount];
+    if (!backgroundBelowSegments)
+    {
+        ReserveBackgroundRegions();
+    }
+
+    printf("%u background regions %s the segments, %u operations per thread\n",
+        backgroundRegionCount, backgroundBelowSegments ? "below" : "above",
+        operationsPerThread);
+
+    for (unsigned int threadCount = 1; threadCount <= 8; threadCount *= 2)
+    {
+        unsigned int failures;
+        double opsPerSecond = RunBenchmark(threadCount, &failures);
+        printf("%u thread(s): %.0f ops/sec%s\n", threadCount, opsPerSecond,
+            failures != 0 ? " (with failures)" : "");
+    }
+
+    if (!backgroundBelowSegments)
+    {
+        ReleaseBackgroundRegions();
+    }
+    delete[] background;
+    return 0;
+}
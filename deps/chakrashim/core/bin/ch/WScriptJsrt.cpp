@@ -664,6 +664,40 @@ JsValueRef WScriptJsrt::RequestAsyncBreakCallback(JsValueRef callee, bool isCons
     return JS_INVALID_REFERENCE;
 }
 
+// Sets TZ, or removes it when no name is passed, so that tests can check that
+// Date follows time zone changes. Returns false where TZ does not pick the
+// time zone.
+JsValueRef WScriptJsrt::SetTimeZoneCallback(JsValueRef callee, bool isConstructCall, JsValueRef *arguments, unsigned short argumentCount, void *callbackState)
+{
+    JsValueRef result = JS_INVALID_REFERENCE;
+#ifdef _WIN32
+    IfJsrtErrorFail(ChakraRTInterface::JsGetFalseValue(&result), JS_INVALID_REFERENCE);
+#else
+    int status;
+    if (argumentCount < 2)
+    {
+        status = unsetenv("TZ");
+    }
+    else
+    {
+        AutoString timeZone;
+        size_t timeZoneLength;
+        IfJsrtErrorFail(ChakraRTInterface::JsStringToPointerUtf8Copy(arguments[1], &timeZone, &timeZoneLength), JS_INVALID_REFERENCE);
+        status = setenv("TZ", *timeZone, 1);
+    }
+
+    if (status == 0)
+    {
+        IfJsrtErrorFail(ChakraRTInterface::JsGetTrueValue(&result), JS_INVALID_REFERENCE);
+    }
+    else
+    {
+        IfJsrtErrorFail(ChakraRTInterface::JsGetFalseValue(&result), JS_INVALID_REFERENCE);
+    }
+#endif
+    return result;
+}
+
 JsValueRef WScriptJsrt::EmptyCallback(JsValueRef callee, bool isConstructCall, JsValueRef * arguments, unsigned short argumentCount, void * callbackState)
 {
     return JS_INVALID_REFERENCE;
@@ -704,6 +738,7 @@ bool WScriptJsrt::Initialize()
     IfFalseGo(WScriptJsrt::InstallObjectsOnObject(wscript, "Detach", DetachCallback));
     IfFalseGo(WScriptJsrt::InstallObjectsOnObject(wscript, "DumpFunctionPosition", DumpFunctionPositionCallback));
     IfFalseGo(WScriptJsrt::InstallObjectsOnObject(wscript, "RequestAsyncBreak", RequestAsyncBreakCallback));
+    IfFalseGo(WScriptJsrt::InstallObjectsOnObject(wscript, "SetTimeZone", SetTimeZoneCallback));
 
     // ToDo Remove
     IfFalseGo(WScriptJsrt::InstallObjectsOnObject(wscript, "Edit", EmptyCallback));
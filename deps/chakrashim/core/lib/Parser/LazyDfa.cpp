@@ -0,0 +1,804 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#include "ParserPch.h"
+
+namespace UnifiedRegex
+{
+    // ----------------------------------------------------------------------
+    // LazyDfa::Builder
+    // ----------------------------------------------------------------------
+
+    // Translates the pattern's AST into an NFA with one node per character consumed, and into another one for the pattern
+    // read backwards, then partitions the characters into the classes the NFAs' character sets cannot tell apart.
+    class LazyDfa::Builder : private Chars<char16>
+    {
+        friend class LazyDfa;
+
+    private:
+        static const uint MaxRanges = 4096;
+
+        struct CharSetInfo
+        {
+            // Node or literal character the set was built for, so that loop bodies built more than once share their sets
+            const void* source;
+            // Either a set, or numChars characters
+            CharSet<Char>* set;
+            const Char* chars;
+            uint numChars;
+            bool isNegation;
+
+            inline bool Get(const Char c) const
+            {
+                bool isMember = false;
+                if (set != 0)
+                    isMember = set->Get(c);
+                else
+                {
+                    for (uint i = 0; i < numChars; i++)
+                    {
+                        if (chars[i] == c)
+                        {
+                            isMember = true;
+                            break;
+                        }
+                    }
+                }
+                return isMember != isNegation;
+            }
+        };
+
+        Js::ScriptContext* scriptContext;
+        ArenaAllocator* ctAllocator;
+        const Char* litbuf;
+        RegexFlags flags;
+        bool isEligible;
+        // Building the NFA that consumes the input backwards
+        bool isReverse;
+
+        NfaNode* nodes;
+        uint numNodes;
+        uint forwardStart;
+        uint reverseStart;
+
+        CharSetInfo* charSets;
+        uint numCharSets;
+
+        uint numClasses;
+        uint8 asciiClasses[MaxUCharAscii + 1];
+        uint numNonAsciiRanges;
+        Char* nonAsciiRangeStarts;
+        uint8* nonAsciiRangeClasses;
+        uint classSetWords;
+        uint32* classSets;
+
+        Builder(Js::ScriptContext* scriptContext, ArenaAllocator* ctAllocator, const Char* litbuf, RegexFlags flags)
+            : scriptContext(scriptContext)
+            , ctAllocator(ctAllocator)
+            , litbuf(litbuf)
+            , flags(flags)
+            , isEligible(true)
+            , isReverse(false)
+            , nodes(AnewArray(ctAllocator, NfaNode, MaxNodes))
+            , numNodes(0)
+            , forwardStart(0)
+            , reverseStart(0)
+            , charSets(AnewArray(ctAllocator, CharSetInfo, MaxCharSets))
+            , numCharSets(0)
+            , numClasses(0)
+            , numNonAsciiRanges(0)
+            , nonAsciiRangeStarts(0)
+            , nonAsciiRangeClasses(0)
+            , classSetWords(0)
+            , classSets(0)
+        {
+        }
+
+        uint NewNode(const NodeKind kind, const uint next, const uint arg)
+        {
+            if (numNodes >= MaxNodes)
+            {
+                isEligible = false;
+                return 0;
+            }
+            nodes[numNodes].kind = kind;
+            nodes[numNodes].next = next;
+            nodes[numNodes].arg = arg;
+            return numNodes++;
+        }
+
+        uint NewCharSet(const void* source, CharSet<Char>* set, const Char* chars, const uint numChars, const bool isNegation)
+        {
+            for (uint i = 0; i < numCharSets; i++)
+            {
+                if (charSets[i].source == source)
+                    return i;
+            }
+            if (numCharSets >= MaxCharSets)
+            {
+                isEligible = false;
+                return 0;
+            }
+            CharSetInfo& info = charSets[numCharSets];
+            info.source = source;
+            info.set = set;
+            info.chars = chars;
+            info.numChars = numChars;
+            info.isNegation = isNegation;
+            return numCharSets++;
+        }
+
+        uint Consume(const void* source, CharSet<Char>* set, const Char* chars, const uint numChars, const bool isNegation, const uint next)
+        {
+            const uint charSet = NewCharSet(source, set, chars, numChars, isNegation);
+            return NewNode(ConsumeNode, next, charSet);
+        }
+
+        // Return the node matching node then continuing with next
+        uint BuildNode(Node* node, const uint next)
+        {
+            PROBE_STACK(scriptContext, Js::Constants::MinStackRegex);
+
+            if (!isEligible)
+                return next;
+
+            switch (node->tag)
+            {
+            case Node::Empty:
+                return next;
+
+            case Node::BOL:
+            case Node::EOL:
+                if ((flags & MultilineRegexFlag) != 0)
+                {
+                    isEligible = false;
+                    return next;
+                }
+                // Read backwards, the end of input is where the scan starts
+                return NewNode((node->tag == Node::BOL) != isReverse ? BOINode : EOINode, next, 0);
+
+            case Node::MatchChar:
+            {
+                MatchCharNode* charNode = (MatchCharNode*)node;
+                return Consume(charNode, 0, charNode->cs, charNode->isEquivClass ? CaseInsensitive::EquivClassSize : 1, false, next);
+            }
+
+            case Node::MatchSet:
+            {
+                MatchSetNode* setNode = (MatchSetNode*)node;
+                return Consume(setNode, &setNode->set, 0, 0, setNode->isNegation, next);
+            }
+
+            case Node::MatchLiteral:
+            {
+                MatchLiteralNode* literalNode = (MatchLiteralNode*)node;
+                const CharCount width = literalNode->isEquivClass ? CaseInsensitive::EquivClassSize : 1;
+                uint result = next;
+                for (CharCount i = 0; i < literalNode->length && isEligible; i++)
+                {
+                    const CharCount index = isReverse ? i : literalNode->length - 1 - i;
+                    const Char* chars = litbuf + literalNode->offset + index * width;
+                    result = Consume(chars, 0, chars, width, false, result);
+                }
+                return result;
+            }
+
+            case Node::Concat:
+            {
+                uint numItems = 0;
+                for (ConcatNode* curr = (ConcatNode*)node; curr != 0; curr = curr->tail)
+                    numItems++;
+                Node** items = AnewArray(ctAllocator, Node*, numItems);
+                uint i = 0;
+                for (ConcatNode* curr = (ConcatNode*)node; curr != 0; curr = curr->tail)
+                    items[i++] = curr->head;
+                uint result = next;
+                for (uint j = 0; j < numItems && isEligible; j++)
+                    result = BuildNode(items[isReverse ? j : numItems - 1 - j], result);
+                return result;
+            }
+
+            case Node::Alt:
+            {
+                uint result = 0;
+                uint prevSplit = 0;
+                bool isFirst = true;
+                for (AltNode* curr = (AltNode*)node; curr != 0 && isEligible; curr = curr->tail)
+                {
+                    uint arm = BuildNode(curr->head, next);
+                    if (curr->tail != 0)
+                        arm = NewNode(SplitNode, arm, 0);
+                    if (isFirst)
+                        result = arm;
+                    else
+                        nodes[prevSplit].arg = arm;
+                    prevSplit = arm;
+                    isFirst = false;
+                }
+                return result;
+            }
+
+            case Node::DefineGroup:
+                return BuildNode(((DefineGroupNode*)node)->body, next);
+
+            case Node::Loop:
+            {
+                LoopNode* loopNode = (LoopNode*)node;
+                const CharCount lower = loopNode->repeats.lower;
+                const CharCountOrFlag upper = loopNode->repeats.upper;
+                if (lower > MaxNodes || (upper != CharCountFlag && upper - lower > MaxNodes))
+                {
+                    isEligible = false;
+                    return next;
+                }
+
+                uint result = next;
+                if (upper == CharCountFlag)
+                {
+                    const uint entry = NewNode(SplitNode, 0, next);
+                    const uint body = BuildNode(loopNode->body, entry);
+                    if (!isEligible)
+                        return next;
+                    nodes[entry].next = body;
+                    result = entry;
+                }
+                else
+                {
+                    for (CharCount i = lower; i < upper && isEligible; i++)
+                        result = NewNode(SplitNode, BuildNode(loopNode->body, result), next);
+                }
+                for (CharCount i = 0; i < lower && isEligible; i++)
+                    result = BuildNode(loopNode->body, result);
+                return result;
+            }
+
+            default:
+                // Backreferences, assertions and word boundaries depend on more than the characters consumed
+                isEligible = false;
+                return next;
+            }
+        }
+
+        // Partition the characters into classes with the same membership in every character set
+        void Partition()
+        {
+            CharSet<Char> boundaries;
+            boundaries.Set(ctAllocator, 0);
+            boundaries.Set(ctAllocator, MaxUCharAscii + 1);
+            for (uint i = 0; i < numCharSets; i++)
+            {
+                const CharSetInfo& info = charSets[i];
+                if (info.set != 0)
+                {
+                    Char lc, hc;
+                    uint searchStart = 0;
+                    while (searchStart <= MaxUChar && info.set->GetNextRange(UTC(searchStart), &lc, &hc))
+                    {
+                        boundaries.Set(ctAllocator, lc);
+                        if (CTU(hc) < MaxUChar)
+                            boundaries.Set(ctAllocator, UTC(CTU(hc) + 1));
+                        searchStart = CTU(hc) + 1;
+                    }
+                }
+                else
+                {
+                    for (uint j = 0; j < info.numChars; j++)
+                    {
+                        boundaries.Set(ctAllocator, info.chars[j]);
+                        if (CTU(info.chars[j]) < MaxUChar)
+                            boundaries.Set(ctAllocator, UTC(CTU(info.chars[j]) + 1));
+                    }
+                }
+            }
+
+            const uint numRanges = boundaries.Count();
+            if (numRanges > MaxRanges)
+            {
+                isEligible = false;
+                return;
+            }
+
+            // Each range between consecutive boundaries lies entirely inside or outside of every set, so take its
+            // membership from its first character
+            Char* rangeStarts = AnewArray(ctAllocator, Char, numRanges);
+            uint8* rangeClasses = AnewArray(ctAllocator, uint8, numRanges);
+            const uint signatureWords = (numCharSets + 31) / 32;
+            uint32* signatures = AnewArrayZ(ctAllocator, uint32, MaxClasses * signatureWords);
+            uint32* signature = AnewArray(ctAllocator, uint32, signatureWords);
+            {
+                uint r = 0;
+                Char lc, hc;
+                uint searchStart = 0;
+                while (searchStart <= MaxUChar && boundaries.GetNextRange(UTC(searchStart), &lc, &hc))
+                {
+                    for (uint c = CTU(lc); c <= CTU(hc); c++)
+                        rangeStarts[r++] = UTC(c);
+                    searchStart = CTU(hc) + 1;
+                }
+                Assert(r == numRanges);
+            }
+
+            for (uint r = 0; r < numRanges; r++)
+            {
+                for (uint k = 0; k < signatureWords; k++)
+                    signature[k] = 0;
+                for (uint i = 0; i < numCharSets; i++)
+                {
+                    if (charSets[i].Get(rangeStarts[r]))
+                        signature[i / 32] |= 1u << (i % 32);
+                }
+
+                uint classIndex = 0;
+                while (classIndex < numClasses &&
+                    memcmp(signatures + classIndex * signatureWords, signature, signatureWords * sizeof(uint32)) != 0)
+                    classIndex++;
+                if (classIndex == numClasses)
+                {
+                    if (numClasses >= MaxClasses)
+                    {
+                        isEligible = false;
+                        return;
+                    }
+                    js_memcpy_s(signatures + classIndex * signatureWords, signatureWords * sizeof(uint32), signature, signatureWords * sizeof(uint32));
+                    numClasses++;
+                }
+                rangeClasses[r] = (uint8)classIndex;
+            }
+
+            uint r = 0;
+            for (uint c = 0; c <= MaxUCharAscii; c++)
+            {
+                while (r + 1 < numRanges && CTU(rangeStarts[r + 1]) <= c)
+                    r++;
+                asciiClasses[c] = rangeClasses[r];
+            }
+
+            // Merge adjacent non-ASCII ranges of the same class
+            nonAsciiRangeStarts = AnewArray(ctAllocator, Char, numRanges);
+            nonAsciiRangeClasses = AnewArray(ctAllocator, uint8, numRanges);
+            for (r = 0; r < numRanges; r++)
+            {
+                if (CTU(rangeStarts[r]) <= MaxUCharAscii)
+                    continue;
+                if (numNonAsciiRanges > 0 && nonAsciiRangeClasses[numNonAsciiRanges - 1] == rangeClasses[r])
+                    continue;
+                nonAsciiRangeStarts[numNonAsciiRanges] = rangeStarts[r];
+                nonAsciiRangeClasses[numNonAsciiRanges] = rangeClasses[r];
+                numNonAsciiRanges++;
+            }
+            Assert(numNonAsciiRanges > 0 && CTU(nonAsciiRangeStarts[0]) == MaxUCharAscii + 1);
+
+            classSetWords = (numClasses + 31) / 32;
+            classSets = AnewArrayZ(ctAllocator, uint32, numCharSets * classSetWords);
+            for (uint classIndex = 0; classIndex < numClasses; classIndex++)
+            {
+                for (uint i = 0; i < numCharSets; i++)
+                {
+                    if ((signatures[classIndex * signatureWords + i / 32] & (1u << (i % 32))) != 0)
+                        classSets[i * classSetWords + classIndex / 32] |= 1u << (classIndex % 32);
+                }
+            }
+        }
+
+        bool Build(Node* root)
+        {
+            const uint accept = NewNode(AcceptNode, 0, 0);
+            forwardStart = BuildNode(root, accept);
+            isReverse = true;
+            reverseStart = BuildNode(root, accept);
+            // A pattern that consumes no characters has nothing to backtrack over
+            if (!isEligible || numCharSets == 0)
+                return false;
+
+            Partition();
+            return isEligible;
+        }
+    };
+
+    // ----------------------------------------------------------------------
+    // LazyDfa
+    // ----------------------------------------------------------------------
+
+    LazyDfa::LazyDfa(Recycler* recycler, uint numNodes, uint numClasses, uint numNonAsciiRanges, uint numCharSets)
+        : recycler(recycler)
+        , numNodes(numNodes)
+        , forwardStart(0)
+        , reverseStart(0)
+        , numClasses(numClasses)
+        , numNonAsciiRanges(numNonAsciiRanges)
+        , classSetWords((numClasses + 31) / 32)
+        , visitedGeneration(0)
+        , numSortedNodes(0)
+        , tableSize(InitialTableSize)
+        , numStates(0)
+        , cacheSize(0)
+        , cacheResets(0)
+        , charsSinceCacheReset(0)
+        , isDisabled(false)
+    {
+        nodes = RecyclerNewArrayLeaf(recycler, NfaNode, numNodes);
+        nonAsciiRangeStarts = RecyclerNewArrayLeaf(recycler, Char, numNonAsciiRanges);
+        nonAsciiRangeClasses = RecyclerNewArrayLeaf(recycler, uint8, numNonAsciiRanges);
+        classSets = RecyclerNewArrayLeaf(recycler, uint32, numCharSets * classSetWords);
+
+        // Each node is pushed at most once for each edge into it
+        visited = RecyclerNewArrayLeafZ(recycler, uint, numNodes);
+        stack = RecyclerNewArrayLeaf(recycler, uint, 2 * numNodes + 1);
+        nodeSet = RecyclerNewArrayLeafZ(recycler, uint32, (numNodes + 31) / 32);
+        // Each node is in at most one group, and each group but the first follows a mark
+        sortedNodes = RecyclerNewArrayLeaf(recycler, uint, 2 * numNodes);
+
+        table = RecyclerNewArrayZ(recycler, State*, tableSize);
+        for (int i = 0; i < _countof(initialStates); i++)
+            initialStates[i] = 0;
+    }
+
+    LazyDfa* LazyDfa::New(Js::ScriptContext* scriptContext, ArenaAllocator* ctAllocator, Node* root, const Char* litbuf, RegexFlags flags)
+    {
+        if ((root->features & (Node::HasMatchGroup | Node::HasAssertion | Node::HasWordBoundary)) != 0)
+            return 0;
+        if ((flags & MultilineRegexFlag) != 0 && (root->features & (Node::HasBOL | Node::HasEOL)) != 0)
+            return 0;
+
+        Builder builder(scriptContext, ctAllocator, litbuf, flags);
+        if (!builder.Build(root))
+            return 0;
+
+        Recycler* recycler = scriptContext->GetRecycler();
+        LazyDfa* dfa = RecyclerNew(recycler, LazyDfa, recycler, builder.numNodes, builder.numClasses, builder.numNonAsciiRanges, builder.numCharSets);
+        js_memcpy_s(dfa->nodes, builder.numNodes * sizeof(NfaNode), builder.nodes, builder.numNodes * sizeof(NfaNode));
+        dfa->forwardStart = builder.forwardStart;
+        dfa->reverseStart = builder.reverseStart;
+        js_memcpy_s(dfa->asciiClasses, sizeof(dfa->asciiClasses), builder.asciiClasses, sizeof(builder.asciiClasses));
+        js_memcpy_s(dfa->nonAsciiRangeStarts, builder.numNonAsciiRanges * sizeof(Char), builder.nonAsciiRangeStarts, builder.numNonAsciiRanges * sizeof(Char));
+        js_memcpy_s(dfa->nonAsciiRangeClasses, builder.numNonAsciiRanges * sizeof(uint8), builder.nonAsciiRangeClasses, builder.numNonAsciiRanges * sizeof(uint8));
+        js_memcpy_s(dfa->classSets, builder.numCharSets * builder.classSetWords * sizeof(uint32), builder.classSets, builder.numCharSets * builder.classSetWords * sizeof(uint32));
+        return dfa;
+    }
+
+    inline uint LazyDfa::ClassOf(const Char c) const
+    {
+        if (CTU(c) <= MaxUCharAscii)
+            return asciiClasses[CTU(c)];
+
+        // Find the last range starting at or before c
+        uint l = 0;
+        uint h = numNonAsciiRanges;
+        while (h - l > 1)
+        {
+            const uint m = l + (h - l) / 2;
+            if (CTU(nonAsciiRangeStarts[m]) <= CTU(c))
+                l = m;
+            else
+                h = m;
+        }
+        return nonAsciiRangeClasses[l];
+    }
+
+    inline bool LazyDfa::IsInClass(const uint charSet, const uint classIndex) const
+    {
+        return (classSets[charSet * classSetWords + classIndex / 32] & (1u << (classIndex % 32))) != 0;
+    }
+
+    // Begin the groups of a new state. A node reached by one group is not added to a later one.
+    void LazyDfa::BeginClosure()
+    {
+        if (++visitedGeneration == 0)
+        {
+            for (uint i = 0; i < numNodes; i++)
+                visited[i] = 0;
+            visitedGeneration = 1;
+        }
+        numSortedNodes = 0;
+    }
+
+    void LazyDfa::AddClosure(const uint node, const bool isInputStart, const bool isInputEnd, bool &isAccepting)
+    {
+        uint top = 0;
+        stack[top++] = node;
+        while (top > 0)
+        {
+            const uint curr = stack[--top];
+            if (visited[curr] == visitedGeneration)
+                continue;
+            visited[curr] = visitedGeneration;
+
+            const NfaNode& n = nodes[curr];
+            switch (n.kind)
+            {
+            case ConsumeNode:
+                nodeSet[curr / 32] |= 1u << (curr % 32);
+                break;
+            case SplitNode:
+                Assert(top + 2 <= 2 * numNodes + 1);
+                stack[top++] = n.arg;
+                stack[top++] = n.next;
+                break;
+            case BOINode:
+                if (isInputStart)
+                    stack[top++] = n.next;
+                break;
+            case EOINode:
+                if (isInputEnd)
+                    stack[top++] = n.next;
+                else
+                    nodeSet[curr / 32] |= 1u << (curr % 32);
+                break;
+            case AcceptNode:
+                isAccepting = true;
+                break;
+            default:
+                Assert(false);
+                __assume(false);
+            }
+        }
+    }
+
+    // Move the nodes added since the last group into a group of their own
+    void LazyDfa::EndGroup()
+    {
+        const uint groupStart = numSortedNodes;
+        if (groupStart > 0)
+            sortedNodes[numSortedNodes++] = GroupMark;
+
+        const uint nodeSetWords = (numNodes + 31) / 32;
+        for (uint i = 0; i < nodeSetWords; i++)
+        {
+            uint32 bits = nodeSet[i];
+            nodeSet[i] = 0;
+            while (bits != 0)
+            {
+                DWORD index;
+                _BitScanForward(&index, bits);
+                sortedNodes[numSortedNodes++] = i * 32 + index;
+                bits &= bits - 1;
+            }
+        }
+
+        // Drop the mark of an empty group
+        if (numSortedNodes == groupStart + 1)
+            numSortedNodes = groupStart;
+    }
+
+    LazyDfa::State* LazyDfa::InternState(const bool isInputStart, const bool isAddingStarts, const bool isAccepting)
+    {
+        const uint count = numSortedNodes;
+        uint hash = (count << 3) | (isInputStart ? 4 : 0) | (isAddingStarts ? 2 : 0) | (isAccepting ? 1 : 0);
+        for (uint i = 0; i < count; i++)
+            hash = hash * 31 + sortedNodes[i];
+
+        uint slot = hash & (tableSize - 1);
+        for (State* state = table[slot]; state != 0; state = table[slot])
+        {
+            if (state->hash == hash &&
+                state->numNodes == count &&
+                state->isInputStart == isInputStart &&
+                state->isAddingStarts == isAddingStarts &&
+                state->isAccepting == isAccepting &&
+                memcmp(state->nodes, sortedNodes, count * sizeof(uint)) == 0)
+                return state;
+            slot = (slot + 1) & (tableSize - 1);
+        }
+
+        const size_t extraSize = numClasses * sizeof(State*) + count * sizeof(uint);
+        if (cacheSize + sizeof(State) + extraSize > MaxCacheSize)
+        {
+            if (!ResetCache())
+                return 0;
+            slot = hash & (tableSize - 1);
+        }
+        else if ((numStates + 1) * 2 > tableSize)
+        {
+            const uint newTableSize = tableSize * 2;
+            State** newTable = RecyclerNewArrayZ(recycler, State*, newTableSize);
+            for (uint i = 0; i < tableSize; i++)
+            {
+                if (table[i] == 0)
+                    continue;
+                uint newSlot = table[i]->hash & (newTableSize - 1);
+                while (newTable[newSlot] != 0)
+                    newSlot = (newSlot + 1) & (newTableSize - 1);
+                newTable[newSlot] = table[i];
+            }
+            table = newTable;
+            tableSize = newTableSize;
+            slot = hash & (tableSize - 1);
+            while (table[slot] != 0)
+                slot = (slot + 1) & (tableSize - 1);
+        }
+
+        State* state = RecyclerNewPlusZ(recycler, extraSize, State);
+        state->hash = hash;
+        state->numNodes = count;
+        state->isInputStart = isInputStart;
+        state->isAddingStarts = isAddingStarts;
+        state->isAccepting = isAccepting;
+        state->transitions = (State**)(state + 1);
+        state->nodes = (uint*)(state->transitions + numClasses);
+        js_memcpy_s(state->nodes, count * sizeof(uint), sortedNodes, count * sizeof(uint));
+
+        table[slot] = state;
+        numStates++;
+        cacheSize += sizeof(State) + extraSize;
+
+        bool isAcceptingAtEnd = isAccepting;
+        if (!isAcceptingAtEnd)
+        {
+            BeginClosure();
+            for (uint i = 0; i < count && !isAcceptingAtEnd; i++)
+            {
+                if (state->nodes[i] != GroupMark && nodes[state->nodes[i]].kind == EOINode)
+                    AddClosure(nodes[state->nodes[i]].next, isInputStart, true, isAcceptingAtEnd);
+            }
+            // Only whether the end is accepted matters
+            const uint nodeSetWords = (numNodes + 31) / 32;
+            for (uint i = 0; i < nodeSetWords; i++)
+                nodeSet[i] = 0;
+        }
+        state->isAcceptingAtEnd = isAcceptingAtEnd;
+
+        return state;
+    }
+
+    bool LazyDfa::ResetCache()
+    {
+        if (charsSinceCacheReset < (size_t)numStates * MinCharsPerState)
+        {
+            // States are being built faster than they are reused, the backtracker will do as well
+            isDisabled = true;
+            return false;
+        }
+
+        cacheResets++;
+        charsSinceCacheReset = 0;
+        tableSize = InitialTableSize;
+        table = RecyclerNewArrayZ(recycler, State*, tableSize);
+        numStates = 0;
+        cacheSize = 0;
+        for (int i = 0; i < _countof(initialStates); i++)
+            initialStates[i] = 0;
+        return true;
+    }
+
+    LazyDfa::State* LazyDfa::InitialState(const StartKind startKind, const bool isInputStart)
+    {
+        const int index = startKind * 2 + (isInputStart ? 1 : 0);
+        if (initialStates[index] == 0)
+        {
+            BeginClosure();
+            bool isAccepting = false;
+            AddClosure(startKind == ReverseStart ? reverseStart : forwardStart, isInputStart, false, isAccepting);
+            EndGroup();
+            initialStates[index] = InternState(isInputStart, startKind == UnanchoredStart && !isAccepting, isAccepting);
+        }
+        return initialStates[index];
+    }
+
+    LazyDfa::State* LazyDfa::Transition(State* state, const uint classIndex)
+    {
+        const uint resets = cacheResets;
+
+        BeginClosure();
+        bool isAccepting = false;
+        uint i = 0;
+        while (i < state->numNodes && !isAccepting)
+        {
+            for (; i < state->numNodes && state->nodes[i] != GroupMark; i++)
+            {
+                const NfaNode& n = nodes[state->nodes[i]];
+                if (n.kind == ConsumeNode && IsInClass(n.arg, classIndex))
+                    AddClosure(n.next, false, false, isAccepting);
+            }
+            i++;
+            EndGroup();
+        }
+
+        // Once a group has matched, the groups after it, and a match beginning at the next offset, could only find
+        // matches that begin further right
+        bool isAddingStarts = state->isAddingStarts && !isAccepting;
+        if (isAddingStarts)
+        {
+            AddClosure(forwardStart, false, false, isAccepting);
+            EndGroup();
+            isAddingStarts = !isAccepting;
+        }
+
+        State* next = InternState(false, isAddingStarts, isAccepting);
+        // Don't link states from a discarded cache to the new one
+        if (next != 0 && cacheResets == resets)
+            state->transitions[classIndex] = next;
+        return next;
+    }
+
+    // Scan forwards from offset. If anchored, stop at the first match beginning at offset. Otherwise keep going while the
+    // leftmost match could be extended, so that matchEnd is the end of a match that begins where the leftmost one does.
+    LazyDfa::ScanResult LazyDfa::ScanForward(const Char* const input, const CharCount inputLength, const CharCount offset, const bool isAnchored, CharCount &matchEnd)
+    {
+        CharCount inputOffset = offset;
+        State* state = InitialState(isAnchored ? AnchoredStart : UnanchoredStart, inputOffset == 0);
+        if (state == 0)
+            return GaveUp;
+
+        bool isMatched = false;
+        while (true)
+        {
+            if (state->isAccepting || (inputOffset == inputLength && state->isAcceptingAtEnd))
+            {
+                isMatched = true;
+                matchEnd = inputOffset;
+                if (isAnchored)
+                    break;
+            }
+            if (inputOffset >= inputLength || (state->numNodes == 0 && !state->isAddingStarts))
+                break;
+
+            const uint classIndex = ClassOf(input[inputOffset]);
+            State* next = state->transitions[classIndex];
+            if (next == 0)
+            {
+                next = Transition(state, classIndex);
+                if (next == 0)
+                    return GaveUp;
+            }
+            state = next;
+            inputOffset++;
+            charsSinceCacheReset++;
+        }
+
+        return isMatched ? Match : NoMatch;
+    }
+
+    // Scan the reversed pattern backwards from matchEnd, and set matchStart to the leftmost offset, no further left than
+    // offset, at which a match ending at matchEnd begins.
+    LazyDfa::ScanResult LazyDfa::ScanReverse(const Char* const input, const CharCount inputLength, const CharCount offset, const CharCount matchEnd, CharCount &matchStart)
+    {
+        CharCount inputOffset = matchEnd;
+        State* state = InitialState(ReverseStart, inputOffset == inputLength);
+        if (state == 0)
+            return GaveUp;
+
+        bool isMatched = false;
+        while (true)
+        {
+            if (state->isAccepting || (inputOffset == 0 && state->isAcceptingAtEnd))
+            {
+                isMatched = true;
+                matchStart = inputOffset;
+            }
+            if (inputOffset <= offset || state->numNodes == 0)
+                break;
+
+            const uint classIndex = ClassOf(input[inputOffset - 1]);
+            State* next = state->transitions[classIndex];
+            if (next == 0)
+            {
+                next = Transition(state, classIndex);
+                if (next == 0)
+                    return GaveUp;
+            }
+            state = next;
+            inputOffset--;
+            charsSinceCacheReset++;
+        }
+
+        // The forward scan found a match ending at matchEnd
+        Assert(isMatched);
+        return isMatched ? Match : GaveUp;
+    }
+
+    LazyDfa::ScanResult LazyDfa::Scan(const Char* const input, const CharCount inputLength, const CharCount offset, const bool isAnchored, CharCount &matchStart)
+    {
+        if (isDisabled)
+            return GaveUp;
+
+        CharCount matchEnd;
+        const ScanResult result = ScanForward(input, inputLength, offset, isAnchored, matchEnd);
+        if (result != Match || isAnchored)
+        {
+            matchStart = offset;
+            return result;
+        }
+        return ScanReverse(input, inputLength, offset, matchEnd, matchStart);
+    }
+}
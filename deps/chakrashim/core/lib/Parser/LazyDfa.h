@@ -0,0 +1,157 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+//
+// Lazily built DFA for patterns of form:
+//    pattern ::= char | set | literal | pattern pattern | pattern '|' pattern | (pattern) | (?:pattern) | pattern{n,m}
+//              | ^ | $ (not in multiline mode)
+// ie without backreferences, lookaheads or word boundaries. Such a pattern matches a regular language, so where the
+// leftmost match begins can be found in linear time: a forward pass finds where a match beginning there ends, and a pass
+// backwards from that end over the reversed pattern finds where it begins. The backtracking matcher need only be run at
+// that offset to find the extent of the match and capture its groups.
+//
+#pragma once
+
+namespace UnifiedRegex
+{
+    struct Node;
+
+    // ----------------------------------------------------------------------
+    // LazyDfa
+    // ----------------------------------------------------------------------
+
+    class LazyDfa : private Chars<char16>
+    {
+    public:
+        enum ScanResult
+        {
+            NoMatch,
+            Match,
+            GaveUp  // The automaton is too large to be worth running, fall back to backtracking
+        };
+
+    private:
+        class Builder;
+
+        // Limits on the automaton built by the compiler
+        static const uint MaxNodes = 2048;
+        static const uint MaxCharSets = 256;
+        static const uint MaxClasses = 128;
+
+        // Limits on the states built while matching. When the states cached for the automaton take more than
+        // MaxCacheSize bytes they are discarded and built again as needed. If fewer than MinCharsPerState characters were
+        // scanned for each state discarded, over all scans since the last time, the automaton is disabled.
+        static const size_t MaxCacheSize = 256 * 1024;
+        static const uint MinCharsPerState = 10;
+        static const uint InitialTableSize = 64;
+
+        // Separates the groups of nodes of a state
+        static const uint GroupMark = (uint)-1;
+
+        enum NodeKind : uint8
+        {
+            ConsumeNode,  // Consume a character in classes 'arg', continue with 'next'
+            SplitNode,    // Continue with both 'next' and 'arg'
+            BOINode,      // Continue with 'next' if at beginning of input
+            EOINode,      // Continue with 'next' if at end of input
+            AcceptNode    // Overall pattern has matched
+        };
+
+        struct NfaNode
+        {
+            NodeKind kind;
+            uint next;
+            uint arg;
+        };
+
+        enum StartKind
+        {
+            AnchoredStart,    // Forward, for a match beginning at the scan's offset
+            UnanchoredStart,  // Forward, for the leftmost match beginning at or after the scan's offset
+            ReverseStart,     // Backward over the reversed pattern, from the end of a match
+            NumStartKinds
+        };
+
+        // Groups of NFA nodes. Only consume and EOI nodes are kept in a group: the others are followed when the state is
+        // built. An unanchored scan keeps the nodes reached from each offset the match may begin at in a group of their
+        // own, earliest offset first, and no node in more than one group. Once a group has matched, the groups after it
+        // are dropped, so that the last match found is one beginning at the leftmost offset any match begins at.
+        struct State
+        {
+            uint hash;
+            uint numNodes;
+            // Built for the beginning of input, when BOI nodes may be followed
+            bool isInputStart;
+            // A group for a match beginning at the next offset is added on each transition
+            bool isAddingStarts;
+            // Overall pattern has matched
+            bool isAccepting;
+            // Overall pattern matches if this is the end of input
+            bool isAcceptingAtEnd;
+            // Indexed by character class, 0 if not yet built
+            State** transitions;
+            // Sorted within each group, groups separated by GroupMark
+            uint* nodes;
+        };
+
+        Recycler* recycler;
+
+        // Automaton
+        NfaNode* nodes;
+        uint numNodes;
+        uint forwardStart;
+        uint reverseStart;
+        // Characters are partitioned into classes which no character set in the pattern can distinguish
+        uint numClasses;
+        uint8 asciiClasses[MaxUCharAscii + 1];
+        // Classes of the non-ASCII characters, in ranges starting at nonAsciiRangeStarts[i]
+        uint numNonAsciiRanges;
+        Char* nonAsciiRangeStarts;
+        uint8* nonAsciiRangeClasses;
+        // For each character set consumed by a node, a bit vector of the classes in the set
+        uint classSetWords;
+        uint32* classSets;
+
+        // Scratch space for building states
+        uint* visited;
+        uint visitedGeneration;
+        uint* stack;
+        uint32* nodeSet;
+        uint* sortedNodes;
+        uint numSortedNodes;
+
+        // Cache of states
+        State** table;
+        uint tableSize;
+        uint numStates;
+        size_t cacheSize;
+        uint cacheResets;
+        size_t charsSinceCacheReset;
+        State* initialStates[NumStartKinds * 2];
+        bool isDisabled;
+
+        LazyDfa(Recycler* recycler, uint numNodes, uint numClasses, uint numNonAsciiRanges, uint numCharSets);
+
+        inline uint ClassOf(const Char c) const;
+        inline bool IsInClass(const uint charSet, const uint classIndex) const;
+
+        void BeginClosure();
+        void AddClosure(const uint node, const bool isInputStart, const bool isInputEnd, bool &isAccepting);
+        void EndGroup();
+        State* InternState(const bool isInputStart, const bool isAddingStarts, const bool isAccepting);
+        bool ResetCache();
+        State* InitialState(const StartKind startKind, const bool isInputStart);
+        State* Transition(State* state, const uint classIndex);
+        ScanResult ScanForward(const Char* const input, const CharCount inputLength, const CharCount offset, const bool isAnchored, CharCount &matchEnd);
+        ScanResult ScanReverse(const Char* const input, const CharCount inputLength, const CharCount offset, const CharCount matchEnd, CharCount &matchStart);
+
+    public:
+        // Return 0 if the pattern is not in the form above, or its automaton would be too large
+        static LazyDfa* New(Js::ScriptContext* scriptContext, ArenaAllocator* ctAllocator, Node* root, const Char* litbuf, RegexFlags flags);
+
+        // Set matchStart to the leftmost offset at or after offset at which a match begins. If anchored, the match must
+        // begin at offset.
+        ScanResult Scan(const Char* const input, const CharCount inputLength, const CharCount offset, const bool isAnchored, CharCount &matchStart);
+    };
+}
@@ -15,6 +15,7 @@
 #include "StandardChars.h"
 #include "OctoquadIdentifier.h"
 #include "RegexCompileTime.h"
+#include "LazyDfa.h"
 #include "RegexParser.h"
 #include "RegexPattern.h"
 
@@ -161,6 +161,100 @@ namespace UnifiedRegex
         return proposed->prevConsumes.upper < curr->prevConsumes.upper;
     }
 
+    bool Node::AccumConsumedCharsBefore(Compiler& compiler, const Node* target, CharSet<Char>& set) const
+    {
+        PROBE_STACK(compiler.scriptContext, Js::Constants::MinStackRegex);
+
+        if (this == target)
+            return true;
+
+        switch (tag)
+        {
+        case Empty:
+        case BOL:
+        case EOL:
+        case WordBoundary:
+        case Assertion:
+            // Consume nothing
+            break;
+        case MatchLiteral:
+            {
+                const MatchLiteralNode* node = (const MatchLiteralNode*)this;
+                const Char* litptr = compiler.program->rep.insts.litbuf + node->offset;
+                const CharCount litLength = node->length * (node->isEquivClass ? CaseInsensitive::EquivClassSize : 1);
+                for (CharCount i = 0; i < litLength; i++)
+                    set.Set(compiler.ctAllocator, litptr[i]);
+                break;
+            }
+        case MatchChar:
+        case MatchSet:
+            // FIRST is exactly the set of characters consumed
+            set.UnionInPlace(compiler.ctAllocator, *firstSet);
+            break;
+        case Concat:
+            for (const ConcatNode* curr = (const ConcatNode*)this; curr != 0; curr = curr->tail)
+            {
+                if (curr->head->AccumConsumedCharsBefore(compiler, target, set))
+                    return true;
+            }
+            break;
+        case Alt:
+            for (const AltNode* curr = (const AltNode*)this; curr != 0; curr = curr->tail)
+            {
+                // Synchronizing nodes are never within an alternative
+                bool reached = curr->head->AccumConsumedCharsBefore(compiler, target, set);
+                Assert(!reached);
+            }
+            break;
+        case DefineGroup:
+            return ((const DefineGroupNode*)this)->body->AccumConsumedCharsBefore(compiler, target, set);
+        case Loop:
+            // If target is in the body, only the first iteration comes before its first occurrence
+            return ((const LoopNode*)this)->body->AccumConsumedCharsBefore(compiler, target, set);
+        case MatchGroup:
+            // May consume anything
+            set.UnionInPlace(compiler.ctAllocator, *compiler.standardChars->GetFullSet());
+            break;
+        default:
+            Assert(false);
+            break;
+        }
+        return false;
+    }
+
+    bool Node::CheckDeterministicBefore(Compiler& compiler, const Node* target, bool& isDeterministic) const
+    {
+        PROBE_STACK(compiler.scriptContext, Js::Constants::MinStackRegex);
+
+        if (this == target)
+            return true;
+
+        switch (tag)
+        {
+        case Concat:
+            for (const ConcatNode* curr = (const ConcatNode*)this; curr != 0; curr = curr->tail)
+            {
+                if (curr->head->CheckDeterministicBefore(compiler, target, isDeterministic))
+                    return true;
+            }
+            return false;
+        case DefineGroup:
+            return ((const DefineGroupNode*)this)->body->CheckDeterministicBefore(compiler, target, isDeterministic);
+        case Loop:
+            if (((const LoopNode*)this)->body->CheckDeterministicBefore(compiler, target, isDeterministic))
+            {
+                // Earlier iterations run all of the body before target
+                isDeterministic = isDeterministic && this->isDeterministic;
+                return true;
+            }
+            break;
+        default:
+            break;
+        }
+        isDeterministic = isDeterministic && this->isDeterministic;
+        return false;
+    }
+
     bool Node::IsSingleChar(Compiler& compiler, Char& outChar) const
     {
         if (tag != Node::MatchChar)
@@ -4391,6 +4485,20 @@ namespace UnifiedRegex
         program->numLoops = nextLoopId;
     }
 
+    void Compiler::CaptureSyncPrefixSet(Node* root, Node* syncronizingNode)
+    {
+        // A match must start within the run of characters just before the synchronizing node which the pattern may
+        // consume ahead of it. That's only worth checking if some characters can't be consumed.
+        CharSet<Char> prefixSet;
+        root->AccumConsumedCharsBefore(*this, syncronizingNode, prefixSet);
+        if (prefixSet.Count() < NumChars)
+        {
+            RuntimeCharSet<Char>* runtimeSet = RecyclerNewLeaf(scriptContext->GetRecycler(), RuntimeCharSet<Char>);
+            runtimeSet->CloneFrom(rtAllocator, prefixSet);
+            program->rep.insts.syncPrefixSet = runtimeSet;
+        }
+    }
+
     void Compiler::FreeBody()
     {
         if (instBuf != 0)
@@ -4557,6 +4665,8 @@ namespace UnifiedRegex
 #endif
 
                     CharCount skipped = 0;
+                    bool isSyncingToLiteral = false;
+                    bool isDfaAfterSync = false;
 
                     // If the root Node has a hard fail BOI, we should not emit any synchronize Nodes
                     // since we can easily just search from the beginning.
@@ -4579,12 +4689,26 @@ namespace UnifiedRegex
                             {
                                 // Scan and consume the head, continue with rest assuming head has been consumed
                                 skipped = headSyncronizingNode->EmitScan(compiler, true);
+                                isSyncingToLiteral = headSyncronizingNode->tag != Node::MatchSet;
                             }
                             else if (bestSyncronizingNode != 0)
                             {
                                 // Scan for the synchronizing node, then backup ready for entire pattern
                                 skipped = bestSyncronizingNode->EmitScan(compiler, false);
                                 Assert(skipped == 0);
+                                isSyncingToLiteral = true;
+
+                                // With no limit on how far to back up, see if we can at least limit the characters
+                                // backed up over. If what comes before the node may also backtrack, a failing match can
+                                // take time exponential in the length backed up over, so decide where the pattern
+                                // matches from there with the DFA.
+                                if (bestSyncronizingNode->prevConsumes.IsUnbounded())
+                                {
+                                    compiler.CaptureSyncPrefixSet(root, bestSyncronizingNode);
+                                    bool isPrefixDeterministic = true;
+                                    root->CheckDeterministicBefore(compiler, bestSyncronizingNode, isPrefixDeterministic);
+                                    isDfaAfterSync = !isPrefixDeterministic;
+                                }
 
                                 // We're synchronizing to a non-head node; if we have to back up, then try to synchronize to a character
                                 // in the first set before running the remaining instructions
@@ -4604,6 +4728,17 @@ namespace UnifiedRegex
 
                     compiler.Emit<SuccInst>();
                     compiler.CaptureInsts();
+
+                    // Patterns which may backtrack can take time exponential in the input length to fail. If the pattern
+                    // is regular, decide where it matches in linear time first. A pattern synchronized to a literal only
+                    // runs from where the literal is found, which is usually faster than scanning all the input, so it
+                    // only uses the DFA once the literal is found and only if it may back up any distance to it.
+                    if (REGEX_CONFIG_FLAG(RegexDfa) && (root->features & Node::HasLoop) != 0 && !root->isDeterministic &&
+                        (!isSyncingToLiteral || isDfaAfterSync))
+                    {
+                        program->rep.insts.dfa = LazyDfa::New(scriptContext, ctAllocator, root, program->rep.insts.litbuf, program->flags);
+                        program->rep.insts.isDfaAfterSync = isDfaAfterSync;
+                    }
                 }
             }
             else
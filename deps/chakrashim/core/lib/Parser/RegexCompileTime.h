@@ -242,6 +242,14 @@ namespace UnifiedRegex
 
         static bool IsBetterSyncronizingNode(Compiler& compiler, Node* curr, Node* proposed);
 
+        // Accumulate into set the characters pattern may consume before reaching target, or all the characters it may
+        // consume if target is not within it. Return true if target was reached.
+        bool AccumConsumedCharsBefore(Compiler& compiler, const Node* target, CharSet<Char>& set) const;
+
+        // Clear isDeterministic if pattern may backtrack before reaching target, or anywhere if target is not within
+        // it. Return true if target was reached.
+        bool CheckDeterministicBefore(Compiler& compiler, const Node* target, bool& isDeterministic) const;
+
         //
         // Recognizers
         //
@@ -678,6 +686,7 @@ namespace UnifiedRegex
         void CaptureLiterals(Node* root, const Char *litbuf);
         static void EmitAndCaptureSuccInst(Recycler* recycler, Program* program);
         void CaptureInsts();
+        void CaptureSyncPrefixSet(Node* root, Node* syncronizingNode);
         void FreeBody();
 
         Compiler
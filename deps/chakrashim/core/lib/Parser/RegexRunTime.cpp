@@ -4,6 +4,12 @@
 //-------------------------------------------------------------------------------------------------------
 #include "ParserPch.h"
 
+#if defined(_M_IX86) || defined(_M_X64)
+#ifdef _WIN32
+#include <emmintrin.h>
+#endif
+#endif
+
 namespace UnifiedRegex
 {
     // ----------------------------------------------------------------------
@@ -181,6 +187,68 @@ namespace UnifiedRegex
         return true;
     }
 
+    inline CharCount Matcher::BackupToSyncPrefix(const Char* const input, const CharCount matchStart, const CharCount syncOffset) const
+    {
+        // Any match must consume the characters between its start and the synchronizing node, so it can't start before
+        // the last character that can't be consumed there
+        const RuntimeCharSet<Char>* prefixSet = program->rep.insts.syncPrefixSet;
+        if (prefixSet == 0)
+            return matchStart;
+
+        CharCount start = syncOffset;
+        while (start > matchStart && prefixSet->Get(input[start - 1]))
+        {
+#if ENABLE_REGEX_CONFIG_OPTIONS
+            CompStats();
+#endif
+            start--;
+        }
+        return start;
+    }
+
+    inline bool Matcher::FindDfaMatchStartAfterSync(const Char* const input, const CharCount inputLength, CharCount &matchStart)
+    {
+        // The instructions then run from where a match begins, so they don't fail back to the synchronizing
+        // instruction and the DFA runs at most once per match
+        if (!program->rep.insts.isDfaAfterSync)
+            return true;
+        return FindDfaMatchStart(input, inputLength, matchStart, false);
+    }
+
+    inline void Matcher::ScanToChar2(const Char* const input, const CharCount inputLength, CharCount &inputOffset, const Char c0, const Char c1)
+    {
+#if ENABLE_REGEX_CONFIG_OPTIONS
+        const CharCount startOffset = inputOffset;
+#endif
+#if defined(_M_IX86) || defined(_M_X64)
+        const __m128i matchC0 = _mm_set1_epi16((short)c0);
+        const __m128i matchC1 = _mm_set1_epi16((short)c1);
+        while (inputOffset + 8 <= inputLength)
+        {
+            __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + inputOffset));
+            int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi16(chars, matchC0), _mm_cmpeq_epi16(chars, matchC1)));
+            if (mask != 0)
+            {
+                DWORD index;
+                _BitScanForward(&index, mask);
+                inputOffset += index / sizeof(Char);
+                break;
+            }
+            inputOffset += 8;
+        }
+#endif
+        while (inputOffset < inputLength && input[inputOffset] != c0 && input[inputOffset] != c1)
+        {
+            inputOffset++;
+        }
+#if ENABLE_REGEX_CONFIG_OPTIONS
+        for (CharCount i = startOffset; i < inputOffset; i++)
+        {
+            CompStats();
+        }
+#endif
+    }
+
     inline bool Matcher::PopAssertion(CharCount &inputOffset, const uint8 *&instPointer, ContStack &contStack, AssertionStack &assertionStack, bool succeeded)
     {
         AssertionInfo* info = assertionStack.Top();
@@ -1656,13 +1724,7 @@ namespace UnifiedRegex
 #if ENABLE_REGEX_CONFIG_OPTIONS
         matcher.CompStats();
 #endif
-        while (inputOffset < inputLength && input[inputOffset] != matchC)
-        {
-#if ENABLE_REGEX_CONFIG_OPTIONS
-            matcher.CompStats();
-#endif
-            inputOffset++;
-        }
+        matcher.ScanToChar2(input, inputLength, inputOffset, matchC, matchC);
 
         matchStart = inputOffset;
         instPointer += sizeof(*this);
@@ -1690,13 +1752,7 @@ namespace UnifiedRegex
 #if ENABLE_REGEX_CONFIG_OPTIONS
         matcher.CompStats();
 #endif
-        while (inputOffset < inputLength && input[inputOffset] != matchC0 && input[inputOffset] != matchC1)
-        {
-#if ENABLE_REGEX_CONFIG_OPTIONS
-            matcher.CompStats();
-#endif
-            inputOffset++;
-        }
+        matcher.ScanToChar2(input, inputLength, inputOffset, matchC0, matchC1);
 
         matchStart = inputOffset;
         instPointer += sizeof(*this);
@@ -1793,13 +1849,7 @@ namespace UnifiedRegex
 #if ENABLE_REGEX_CONFIG_OPTIONS
         matcher.CompStats();
 #endif
-        while (inputOffset < inputLength && input[inputOffset] != matchC)
-        {
-#if ENABLE_REGEX_CONFIG_OPTIONS
-            matcher.CompStats();
-#endif
-            inputOffset++;
-        }
+        matcher.ScanToChar2(input, inputLength, inputOffset, matchC, matchC);
 
         if (inputOffset >= inputLength)
             return matcher.HardFail(HARDFAIL_PARAMETERS(ImmediateFail));
@@ -1830,13 +1880,7 @@ namespace UnifiedRegex
 #if ENABLE_REGEX_CONFIG_OPTIONS
         matcher.CompStats();
 #endif
-        while (inputOffset < inputLength && (input[inputOffset] != matchC0 && input[inputOffset] != matchC1))
-        {
-#if ENABLE_REGEX_CONFIG_OPTIONS
-            matcher.CompStats();
-#endif
-            inputOffset++;
-        }
+        matcher.ScanToChar2(input, inputLength, inputOffset, matchC0, matchC1);
 
         if (inputOffset >= inputLength)
             return matcher.HardFail(HARDFAIL_PARAMETERS(ImmediateFail));
@@ -1951,13 +1995,7 @@ namespace UnifiedRegex
             inputOffset = matchStart + backup.lower;
 
         const Char matchC = c;
-        while (inputOffset < inputLength && input[inputOffset] != matchC)
-        {
-#if ENABLE_REGEX_CONFIG_OPTIONS
-            matcher.CompStats();
-#endif
-            inputOffset++;
-        }
+        matcher.ScanToChar2(input, inputLength, inputOffset, matchC, matchC);
 
         if (inputOffset >= inputLength)
             return matcher.HardFail(HARDFAIL_PARAMETERS(ImmediateFail));
@@ -1970,7 +2008,13 @@ namespace UnifiedRegex
             CharCount maxBackup = inputOffset - matchStart;
             matchStart = inputOffset - min(maxBackup, (CharCount)backup.upper);
         }
-        // else: leave start where it is
+        else
+        {
+            // Backup no further than the characters which could come before the synchronizing node
+            matchStart = matcher.BackupToSyncPrefix(input, matchStart, inputOffset);
+            if (!matcher.FindDfaMatchStartAfterSync(input, inputLength, matchStart))
+                return matcher.HardFail(HARDFAIL_PARAMETERS(ImmediateFail));
+        }
 
         // Move input to new match start
         inputOffset = matchStart;
@@ -2033,7 +2077,13 @@ namespace UnifiedRegex
             CharCount maxBackup = inputOffset - matchStart;
             matchStart = inputOffset - min(maxBackup, (CharCount)backup.upper);
         }
-        // else: leave start where it is
+        else
+        {
+            // Backup no further than the characters which could come before the synchronizing node
+            matchStart = matcher.BackupToSyncPrefix(input, matchStart, inputOffset);
+            if (!matcher.FindDfaMatchStartAfterSync(input, inputLength, matchStart))
+                return matcher.HardFail(HARDFAIL_PARAMETERS(ImmediateFail));
+        }
 
         // Move input to new match start
         inputOffset = matchStart;
@@ -2087,7 +2137,13 @@ namespace UnifiedRegex
             CharCount maxBackup = inputOffset - matchStart;
             matchStart = inputOffset - min(maxBackup, (CharCount)backup.upper);
         }
-        // else: leave start where it is
+        else
+        {
+            // Backup no further than the characters which could come before the literal
+            matchStart = matcher.BackupToSyncPrefix(input, matchStart, inputOffset);
+            if (!matcher.FindDfaMatchStartAfterSync(input, inputLength, matchStart))
+                return matcher.HardFail(HARDFAIL_PARAMETERS(ImmediateFail));
+        }
 
         // Move input to new match start
         inputOffset = matchStart;
@@ -2213,7 +2269,13 @@ namespace UnifiedRegex
             CharCount maxBackup = bestMatchOffset - matchStart;
             matchStart = bestMatchOffset - min(maxBackup, (CharCount)backup.upper);
         }
-        // else: leave start where it is
+        else
+        {
+            // Backup no further than the characters which could come before the literal
+            matchStart = matcher.BackupToSyncPrefix(input, matchStart, bestMatchOffset);
+            if (!matcher.FindDfaMatchStartAfterSync(input, inputLength, matchStart))
+                return matcher.HardFail(HARDFAIL_PARAMETERS(ImmediateFail));
+        }
 
         // Move input to new match start
         inputOffset = matchStart;
@@ -4455,6 +4517,15 @@ namespace UnifiedRegex
     }
 #endif
 
+    inline bool Matcher::FindDfaMatchStart(const Char* const input, const CharCount inputLength, CharCount &offset, const bool isAnchored)
+    {
+        CharCount matchStart;
+        const LazyDfa::ScanResult result = program->rep.insts.dfa->Scan(input, inputLength, offset, isAnchored, matchStart);
+        if (result == LazyDfa::Match)
+            offset = matchStart;
+        return result != LazyDfa::NoMatch;
+    }
+
     inline bool Matcher::MatchHere(const Char* const input, const CharCount inputLength, CharCount &matchStart, CharCount &nextSyncInputOffset, ContStack &contStack, AssertionStack &assertionStack, uint &qcTicks, bool firstIteration)
     {
         // Reset the continuation and assertion stacks ready for fresh run
@@ -4800,6 +4871,13 @@ namespace UnifiedRegex
                 previousQcTime = 0;
                 uint qcTicks = 0;
 
+                if (prog->rep.insts.dfa != 0 && !prog->rep.insts.isDfaAfterSync && !FindDfaMatchStart(input, inputLength, offset, !loopMatchHere))
+                {
+                    groupInfos[0].Reset();
+                    res = false;
+                    break;
+                }
+
                 // This is the next offset in the input from where we will try to sync. For sync instructions that back up, this
                 // is used to avoid trying to sync when we have not yet reached the offset in the input we last synced to before
                 // backing up.
@@ -4944,6 +5022,9 @@ namespace UnifiedRegex
         rep.insts.litbuf = 0;
         rep.insts.litbufLen = 0;
         rep.insts.scannersForSyncToLiterals = 0;
+        rep.insts.syncPrefixSet = 0;
+        rep.insts.dfa = 0;
+        rep.insts.isDfaAfterSync = false;
     }
 
     Program *Program::New(Recycler *recycler, RegexFlags flags)
@@ -4986,6 +5067,9 @@ namespace UnifiedRegex
         if(tag != InstructionsTag || !rep.insts.insts)
             return;
 
+        if(rep.insts.syncPrefixSet)
+            rep.insts.syncPrefixSet->FreeBody(rtAllocator);
+
         Inst *inst = reinterpret_cast<Inst *>(rep.insts.insts);
         const auto instEnd = reinterpret_cast<Inst *>(reinterpret_cast<uint8 *>(inst) + rep.insts.instsLen);
         Assert(inst < instEnd);
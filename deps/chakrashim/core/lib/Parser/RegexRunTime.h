@@ -17,6 +17,7 @@ namespace UnifiedRegex
     class ContStack;
     class AssertionStack;
     class OctoquadMatcher;
+    class LazyDfa;
 
     enum class ChompMode : uint8
     {
@@ -92,6 +93,18 @@ namespace UnifiedRegex
             // ever be only one of those instructions per program. Since scanners are large (> 1 KB), for that instruction they
             // are allocated on the recycler with pointers stored here to reference them.
             ScannerInfo **scannersForSyncToLiterals;
+
+            // Characters which may be consumed before the node synchronized to by the program's SyncTo...AndBackup
+            // instruction, when it may back up any distance. Allocated on the recycler with contents in the run-time
+            // allocator, owned by program, may be 0.
+            RuntimeCharSet<Char> *syncPrefixSet;
+
+            // Decides where the pattern matches before the instructions are run to capture its groups, for patterns
+            // prone to backtracking. Allocated on the recycler, may be 0.
+            LazyDfa *dfa;
+            // Run dfa from where the program's SyncTo...AndBackup instruction backs up to rather than before the
+            // instructions, so that input without the synchronizing node is rejected by the cheaper scan for it.
+            bool isDfaAfterSync;
         };
 
         struct SingleChar
@@ -1784,6 +1797,20 @@ namespace UnifiedRegex
         // As above, but control whether to try backtracking or later matches
         inline bool HardFail(const Char* const input, const CharCount inputLength, CharCount &matchStart, CharCount &inputOffset, const uint8 *&instPointer, ContStack &contStack, AssertionStack &assertionStack, uint &qcTicks, HardFailMode mode);
 
+        // Return the earliest start, not before matchStart, from which a match could reach the node synchronized to at
+        // syncOffset when there is no limit on how far to back up
+        inline CharCount BackupToSyncPrefix(const Char* const input, const CharCount matchStart, const CharCount syncOffset) const;
+
+        // Advance inputOffset to the first c0 or c1 at or after it, or to inputLength if there is none
+        inline void ScanToChar2(const Char* const input, const CharCount inputLength, CharCount &inputOffset, const Char c0, const Char c1);
+
+        // Advance offset to the leftmost start of a match found by the program's DFA, or return false if the DFA found
+        // there is no match. Leave offset as is if the DFA gave up.
+        inline bool FindDfaMatchStart(const Char* const input, const CharCount inputLength, CharCount &offset, const bool isAnchored);
+
+        // As above, from the start a SyncTo...AndBackup instruction backed up to, if the program runs its DFA there
+        inline bool FindDfaMatchStartAfterSync(const Char* const input, const CharCount inputLength, CharCount &matchStart);
+
         inline void Run(const Char* const input, const CharCount inputLength, CharCount &matchStart, CharCount &nextSyncInputOffset, ContStack &contStack, AssertionStack &assertionStack, uint &qcTicks, bool firstIteration);
         inline bool MatchHere(const Char* const input, const CharCount inputLength, CharCount &matchStart, CharCount &nextSyncInputOffset, ContStack &contStack, AssertionStack &assertionStack, uint &qcTicks, bool firstIteration);
 
@@ -453,6 +453,7 @@ namespace Js
         interpretedCount(0),
         loopInterpreterLimit(CONFIG_FLAG(LoopInterpretCount)),
         savedPolymorphicCacheState(0),
+        redeferralCallEpoch(scriptContext->GetThreadContext()->GetRedeferralEpoch()),
         debuggerScopeIndex(0),
         flags(Flags_HasNoExplicitReturnValue),
         m_hasFinally(false),
@@ -520,6 +521,8 @@ namespace Js
         , m_isFromNativeCodeModule(false)
         , hasHotLoop(false)
         , m_isPartialDeserializedFunction(false)
+        , m_isUndeferredFunction(false)
+        , m_hasBeenInlined(false)
 #if DBG
         , m_isSerialized(false)
 #endif
@@ -1947,6 +1950,7 @@ namespace Js
         {
             // Restore if the function has nameIdentifier reference, as that name on the left side will not be parsed again while deferparse.
             funcBody->SetIsNameIdentifierRef(this->GetIsNameIdentifierRef());
+            funcBody->SetIsUndeferredFunction();
 
             this->UpdateFunctionBodyImpl(funcBody);
             this->m_hasBeenParsed = true;
@@ -4433,6 +4437,116 @@ namespace Js
 #endif
     }
 
+    bool FunctionBody::CanBeRedeferred()
+    {
+        // Redeferral regenerates the byte code in place from source, the same way the function was first undeferred,
+        // so it is limited to leaf functions that got their byte code that way. Anything that may still be using the
+        // current byte code - an interpreter frame, a suspended generator, jitted code or a bailout out of an inlined
+        // copy of the function - rules it out.
+        if (!m_isUndeferredFunction ||
+            m_hasBeenInlined ||
+            this->m_depth != 0 ||
+            this->IsDeferredParseFunction() ||
+            this->GetByteCode() == nullptr ||
+            this->GetNestedCount() != 0 ||
+            this->GetIsGlobalFunc() ||
+            this->IsCoroutine() ||
+            this->GetIsAsmjsMode() ||
+            this->IsInDebugMode() ||
+            this->GetUtf8SourceInfo()->GetIsLibraryCode() ||
+            this->GetInlineCachesOnFunctionObject() ||
+            this->HasGeneratedFromByteCodeCache())
+        {
+            return false;
+        }
+
+        bool hasNativeCode = false;
+        this->MapEntryPoints([&](int index, FunctionEntryPointInfo* entryPoint)
+        {
+            if (entryPoint != nullptr && !entryPoint->IsNotScheduled())
+            {
+                hasNativeCode = true;
+            }
+        });
+        this->MapLoopHeaders([&](uint loopNumber, LoopHeader* header)
+        {
+            header->MapEntryPoints([&](int index, LoopEntryPointInfo* entryPoint)
+            {
+                if (!entryPoint->IsNotScheduled())
+                {
+                    hasNativeCode = true;
+                }
+            });
+        });
+
+        return !hasNativeCode;
+    }
+
+    bool FunctionBody::DoRedeferFunction(uint inactiveThreshold)
+    {
+        if (!this->CanBeRedeferred())
+        {
+            return false;
+        }
+
+        if (PHASE_FORCE(Js::RedeferralPhase, this))
+        {
+            return true;
+        }
+
+        // Every call goes through the interpreter as long as the function has no native code, and the interpreter
+        // stamps the function with the current epoch, which advances once per full collection.
+        return this->GetInactiveCollectionCount() >= inactiveThreshold;
+    }
+
+    uint32 FunctionBody::GetInactiveCollectionCount() const
+    {
+        return this->m_scriptContext->GetThreadContext()->GetRedeferralEpoch() - this->redeferralCallEpoch;
+    }
+
+    void FunctionBody::RedeferFunction()
+    {
+        Assert(this->CanBeRedeferred());
+
+#if ENABLE_DEBUG_CONFIG_OPTIONS
+        char16 debugStringBuffer[MAX_FUNCTION_BODY_DEBUG_STRING_SIZE];
+#endif
+        PHASE_PRINT_TRACE(Js::RedeferralPhase, this, _u("Redeferring function %s (%s) after %u inactive collections\n"),
+            this->GetDisplayName(), this->GetDebugNumberSet(debugStringBuffer), this->GetInactiveCollectionCount());
+
+        // CleanupToReparse drops the saved parent scope info along with everything generated from the parse, but
+        // the function needs it to be parsed again on its own.
+        ScopeInfo * scopeInfo = this->GetScopeInfo();
+        this->CleanupToReparse();
+        this->SetScopeInfo(scopeInfo);
+
+        this->AddDeferParseAttribute();
+        this->SetDeferredParsingEntryPoint();
+
+        // Function objects that have been called cache the old entry point on their types. Send them back through
+        // the deferred parsing thunk as well; a cross-site thunk picks the entry point up from the entry point info.
+        FunctionEntryPointInfo * defaultEntryPointInfo = this->GetDefaultFunctionEntryPointInfo();
+        JavascriptMethod deferredParsingThunk = m_scriptContext->DeferredParsingThunk;
+        auto redeferType = [&](ScriptFunctionType* functionType)
+        {
+            if (!CrossSite::IsThunk(functionType->GetEntryPoint()))
+            {
+                functionType->SetEntryPoint(deferredParsingThunk);
+            }
+            functionType->SetEntryPointInfo(defaultEntryPointInfo);
+        };
+
+        if (this->deferredPrototypeType)
+        {
+            redeferType(this->deferredPrototypeType);
+        }
+        this->MapFunctionObjectTypes([&](DynamicType* type)
+        {
+            Assert(type->GetTypeId() == TypeIds_Function);
+            redeferType((ScriptFunctionType*)type);
+        });
+    }
+
     void FunctionBody::SetEntryToDeferParseForDebugger()
     {
         ProxyEntryPointInfo* defaultEntryPointInfo = this->GetDefaultEntryPointInfo();
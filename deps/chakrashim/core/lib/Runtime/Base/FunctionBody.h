@@ -2028,6 +2028,8 @@ namespace Js
 
         bool m_isFromNativeCodeModule : 1;
         bool m_isPartialDeserializedFunction : 1;
+        bool m_isUndeferredFunction : 1; // Byte code was generated by undeferring a ParseableFunctionInfo and can be regenerated the same way
+        bool m_hasBeenInlined : 1;       // Inlined into jitted code; a bailout out of it resumes in this function's byte code
         bool m_isAsmJsScheduledForFullJIT : 1;
         bool m_hasLocalClosureRegister : 1;
         bool m_hasParamClosureRegister : 1;
@@ -2080,6 +2082,7 @@ namespace Js
         uint32 loopInterpreterLimit;
         uint32 debuggerScopeIndex;
         uint32 savedPolymorphicCacheState;
+        uint32 redeferralCallEpoch; // Redeferral epoch of the last interpreted call
 
         // >>>>>>WARNING! WARNING!<<<<<<<<<<
         //
@@ -2216,6 +2219,8 @@ namespace Js
         uint32 GetInterpretedCount() const { return interpretedCount; }
         uint32 SetInterpretedCount(uint32 val) { return interpretedCount = val; }
         uint32 IncreaseInterpretedCount() { return interpretedCount++; }
+        void SetRedeferralCallEpoch(uint32 epoch) { redeferralCallEpoch = epoch; }
+        uint32 GetInactiveCollectionCount() const;
 
         uint32 GetLoopInterpreterLimit() const { return loopInterpreterLimit; }
         uint32 SetLoopInterpreterLimit(uint32 val) { return loopInterpreterLimit = val; }
@@ -2525,6 +2530,9 @@ namespace Js
         bool GetCanReleaseLoopHeaders() const { return (this->m_depth == 0); }
         void SetPendingLoopHeaderRelease(bool pendingLoopHeaderRelease) { this->m_pendingLoopHeaderRelease = pendingLoopHeaderRelease; }
 
+        void SetIsUndeferredFunction() { m_isUndeferredFunction = true; }
+        void SetHasBeenInlined() { m_hasBeenInlined = true; }
+
         bool GetIsFromNativeCodeModule() const { return m_isFromNativeCodeModule; }
         void SetIsFromNativeCodeModule(bool isFromNativeCodeModule) { m_isFromNativeCodeModule = isFromNativeCodeModule; }
 
@@ -3103,6 +3111,9 @@ namespace Js
         void SetEntryToDeferParseForDebugger();
         void ResetEntryPoint();
         void CleanupToReparse();
+        bool CanBeRedeferred();
+        bool DoRedeferFunction(uint inactiveThreshold);
+        void RedeferFunction();
         void AddDeferParseAttribute();
         void RemoveDeferParseAttribute();
 #if DBG
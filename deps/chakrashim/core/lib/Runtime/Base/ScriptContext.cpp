@@ -74,6 +74,7 @@ namespace Js
         disposeScriptByFaultInjectionEventHandler(nullptr),
 #endif
         integerStringMap(this->GeneralAllocator()),
+        nextTreeReadInPlaceIndex(0),
         guestArena(nullptr),
         raiseMessageToDebuggerFunctionType(nullptr),
         transitionToDebugModeIfFirstSourceFn(nullptr),
@@ -1526,6 +1527,25 @@ if (!sourceList)
         }
     }
 
+    void ScriptContext::RedeferFunctionBodies(uint inactiveThreshold)
+    {
+        Assert(!this->IsClosed());
+
+        // Redeferral swaps entry points underneath the debugger and the profiler thunks; leave those alone.
+        if (this->IsScriptContextInSourceRundownOrDebugMode() || this->IsProfiling())
+        {
+            return;
+        }
+
+        this->MapFunction([inactiveThreshold](Js::FunctionBody* functionBody)
+        {
+            if (!PHASE_OFF(Js::RedeferralPhase, functionBody) && functionBody->DoRedeferFunction(inactiveThreshold))
+            {
+                functionBody->RedeferFunction();
+            }
+        });
+    }
+
     JavascriptString* ScriptContext::GetIntegerString(Var aValue)
     {
         return this->GetIntegerString(TaggedInt::ToInt32(aValue));
@@ -4291,20 +4311,29 @@ void ScriptContext::RegisterPrototypeChainEnsuredToHaveOnlyWritableDataPropertie
         registeredPrototypeChainEnsuredToHaveOnlyWritableDataPropertiesScriptContext = nullptr;
     }
 
-    JavascriptString * ScriptContext::GetLastNumberToStringRadix10(double value)
+    // Numbers are converted to strings through a small direct mapped cache, so that
+    // repeatedly formatting the same handful of values doesn't redo the conversion.
+    static uint GetNumberToStringRadix10CacheIndex(double value)
+    {
+        uint64 bits = NumberUtilities::ToSpecial(value);
+        return (uint)((bits * 0x9E3779B97F4A7C15ull) >> 59) & (Cache::NumberToStringRadix10CacheSize - 1);
+    }
+
+    JavascriptString * ScriptContext::GetCachedNumberToStringRadix10(double value)
     {
-        if (value == lastNumberToStringRadix10)
+        uint index = GetNumberToStringRadix10CacheIndex(value);
+        if (value == numberToStringRadix10Values[index])
         {
-            return cache->lastNumberToStringRadix10String;
+            return cache->numberToStringRadix10Strings[index];
         }
         return nullptr;
     }
 
-    void
-        ScriptContext::SetLastNumberToStringRadix10(double value, JavascriptString * str)
+    void ScriptContext::SetCachedNumberToStringRadix10(double value, JavascriptString * str)
     {
-            lastNumberToStringRadix10 = value;
-            cache->lastNumberToStringRadix10String = str;
+        uint index = GetNumberToStringRadix10CacheIndex(value);
+        numberToStringRadix10Values[index] = value;
+        cache->numberToStringRadix10Strings[index] = str;
     }
 
     bool ScriptContext::GetLastUtcTimeFromStr(JavascriptString * str, double& dbl)
@@ -4329,6 +4358,26 @@ void ScriptContext::RegisterPrototypeChainEnsuredToHaveOnlyWritableDataPropertie
             cache->lastUtcTimeFromStrString = str;
     }
 
+    // Counts a read of an unflattened concat string tree that doesn't flatten it. Returns false once the
+    // same tree has been read in place often enough that flattening it is cheaper than walking it again.
+    bool ScriptContext::CountTreeReadInPlace(JavascriptString * str)
+    {
+        Assert(str != nullptr);
+        for (uint i = 0; i < Cache::TreesReadInPlaceCacheSize; i++)
+        {
+            if (cache->treesReadInPlace[i] == str)
+            {
+                return ++treeReadInPlaceCounts[i] <= MaxTreeReadInPlaceCount;
+            }
+        }
+
+        const uint index = nextTreeReadInPlaceIndex;
+        nextTreeReadInPlaceIndex = (index + 1) % Cache::TreesReadInPlaceCacheSize;
+        cache->treesReadInPlace[index] = str;
+        treeReadInPlaceCounts[index] = 1;
+        return true;
+    }
+
 #if ENABLE_NATIVE_CODEGEN
     BOOL ScriptContext::IsNativeAddress(void * codeAddr)
     {
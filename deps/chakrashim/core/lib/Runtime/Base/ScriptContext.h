@@ -365,9 +365,12 @@ namespace Js
         virtual void Dispose(bool isShutdown) override {}
         virtual void Mark(Recycler *recycler) override { AssertMsg(false, "Mark called on object that isn't TrackableObject"); }
 
-        JavascriptString * lastNumberToStringRadix10String;
+        static const uint NumberToStringRadix10CacheSize = 32;
+        JavascriptString * numberToStringRadix10Strings[NumberToStringRadix10CacheSize];
         EnumeratedObjectCache enumObjCache;
         JavascriptString * lastUtcTimeFromStrString;
+        static const uint TreesReadInPlaceCacheSize = 2;
+        JavascriptString * treesReadInPlace[TreesReadInPlaceCacheSize];
         EvalCacheDictionary* evalCacheDictionary;
         EvalCacheDictionary* indirectEvalCacheDictionary;
         NewFunctionCache* newFunctionCache;
@@ -786,8 +789,11 @@ private:
 
         JsUtil::BaseDictionary<uint, JavascriptString *, ArenaAllocator> integerStringMap;
 
-        double lastNumberToStringRadix10;
+        double numberToStringRadix10Values[Cache::NumberToStringRadix10CacheSize];
         double lastUtcTimeFromStr;
+        static const uint MaxTreeReadInPlaceCount = 8;
+        uint treeReadInPlaceCounts[Cache::TreesReadInPlaceCacheSize];
+        uint nextTreeReadInPlaceIndex;
 
 #if ENABLE_PROFILE_INFO
         bool referencesSharedDynamicSourceContextInfo;
@@ -1206,6 +1212,7 @@ private:
         void *GetFirstInterpreterFrameReturnAddress() { return firstInterpreterFrameReturnAddress;}
 
         void CleanupWeakReferenceDictionaries();
+        void RedeferFunctionBodies(uint inactiveThreshold);
 
         void Initialize();
         bool Close(bool inDestructor);
@@ -1477,10 +1484,11 @@ private:
         void ClearPrototypeChainEnsuredToHaveOnlyWritableDataPropertiesCaches();
 
     public:
-        JavascriptString * GetLastNumberToStringRadix10(double value);
-        void SetLastNumberToStringRadix10(double value, JavascriptString * str);
+        JavascriptString * GetCachedNumberToStringRadix10(double value);
+        void SetCachedNumberToStringRadix10(double value, JavascriptString * str);
         bool GetLastUtcTimeFromStr(JavascriptString * str, double& dbl);
         void SetLastUtcTimeFromStr(JavascriptString * str, double value);
+        bool CountTreeReadInPlace(JavascriptString * str);
         bool IsNoContextSourceContextInfo(SourceContextInfo *sourceContextInfo) const
         {
             return sourceContextInfo == cache->noContextSourceContextInfo;
@@ -121,6 +121,7 @@ ThreadContext::ThreadContext(AllocationPolicyManager * allocationPolicyManager,
         ),
     recycler(nullptr),
     hasCollectionCallBack(false),
+    redeferralEpoch(0),
     callDispose(true),
 #if ENABLE_NATIVE_CODEGEN
     jobProcessor(nullptr),
@@ -2348,6 +2349,8 @@ ThreadContext::PreCollectionCallBack(CollectionFlags flags)
 
     if (!partial)
     {
+        this->TryRedeferral();
+
         // Integrate allocated pages from background JIT threads
 #if ENABLE_NATIVE_CODEGEN
         if (codeGenNumberThreadAllocator)
@@ -2614,6 +2617,29 @@ ThreadContext::ClearScriptContextCaches()
     }
 }
 
+void
+ThreadContext::TryRedeferral()
+{
+    // Redeferred functions are reparsed on their own, which relies on deferred nested parsing
+    if (!CONFIG_FLAG(Redeferral) || !CONFIG_FLAG(DeferNested))
+    {
+        return;
+    }
+
+    // Functions called from here on are stamped with the new epoch, so the difference to a function's stamp is the
+    // number of full collections it went uncalled for.
+    this->redeferralEpoch++;
+
+    const uint inactiveThreshold = CONFIG_FLAG(RedeferralInactiveThreshold);
+    for (Js::ScriptContext *scriptContext = scriptContextList; scriptContext != nullptr; scriptContext = scriptContext->next)
+    {
+        if (!scriptContext->IsClosed())
+        {
+            scriptContext->RedeferFunctionBodies(inactiveThreshold);
+        }
+    }
+}
+
 #ifdef PERSISTENT_INLINE_CACHES
 void
 ThreadContext::ClearInlineCachesWithDeadWeakRefs()
@@ -730,6 +730,7 @@ private:
     DListBase<CollectCallBack> collectCallBackList;
     CriticalSection csCollectionCallBack;
     bool hasCollectionCallBack;
+    uint32 redeferralEpoch;
     bool isOptimizedForManyInstances;
     bool bgJit;
 
@@ -1327,6 +1328,8 @@ public:
     void ClearIsInstInlineCaches();
     void ClearEquivalentTypeCaches();
     void ClearScriptContextCaches();
+    void TryRedeferral();
+    uint32 GetRedeferralEpoch() const { return redeferralEpoch; }
 
     void RegisterTypeWithProtoPropertyCache(const Js::PropertyId propertyId, Js::Type *const type);
     void InvalidateProtoTypePropertyCaches(const Js::PropertyId propertyId);
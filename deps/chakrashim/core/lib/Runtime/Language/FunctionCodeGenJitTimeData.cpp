@@ -811,6 +811,11 @@ namespace Js
         profiledIterations(GetFunctionBody() && GetFunctionBody()->GetByteCode() ? GetFunctionBody()->GetProfiledIterations() : 0),
         next(0)
     {
+        if (entryPoint == nullptr && GetFunctionBody() != nullptr)
+        {
+            // Inlinee: bailing out of the inlined code resumes in its byte code, which must not be redeferred.
+            GetFunctionBody()->SetHasBeenInlined();
+        }
     }
 
     FunctionInfo *FunctionCodeGenJitTimeData::GetFunctionInfo() const
@@ -1792,6 +1792,7 @@ namespace Js
 #endif
 
         executeFunction->IncreaseInterpretedCount();
+        executeFunction->SetRedeferralCallEpoch(threadContext->GetRedeferralEpoch());
 #ifdef BGJIT_STATS
         functionScriptContext->interpretedCount++;
         functionScriptContext->maxFuncInterpret = max(functionScriptContext->maxFuncInterpret, executeFunction->GetInterpretedCount());
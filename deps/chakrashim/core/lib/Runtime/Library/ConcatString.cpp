@@ -371,4 +371,124 @@ namespace Js
         return true;
     }
 #endif
+
+    /////////////////////// StringChunkIterator //////////////////////////
+
+    StringChunkIterator::StringChunkIterator(JavascriptString *str, charcount_t start, uint maxVisitCount) :
+        depth(0), root(str), skipCount(start), visitCount(0), maxVisitCount(maxVisitCount)
+    {
+        Assert(str);
+        Assert(start <= str->GetLength());
+    }
+
+    bool StringChunkIterator::Next(_Outptr_result_buffer_(*length) const char16 **chars, _Out_ charcount_t *length)
+    {
+        *chars = nullptr;
+        *length = 0;
+
+        for (;;)
+        {
+            JavascriptString *str = root;
+            if (str)
+            {
+                root = nullptr;
+            }
+            else
+            {
+                str = NextItem();
+                if (!str)
+                {
+                    return false;
+                }
+            }
+
+            if (++visitCount > maxVisitCount)
+            {
+                return false;
+            }
+
+            // Skip whole subtrees that end before the start
+            const charcount_t strLength = str->GetLength();
+            if (skipCount >= strLength)
+            {
+                skipCount -= strLength;
+                continue;
+            }
+
+            if (!str->IsFinalized() && depth < MaxDepth && TryPushItems(str))
+            {
+                continue;
+            }
+
+            *chars = str->GetString() + skipCount;
+            *length = strLength - skipCount;
+            skipCount = 0;
+            return true;
+        }
+    }
+
+    bool StringChunkIterator::TryPushItems(JavascriptString *str)
+    {
+        Assert(!str->IsFinalized());
+        Assert(depth < MaxDepth);
+
+        Frame &frame = frames[depth];
+        frame.node = str;
+        frame.index = 0;
+        frame.builder = nullptr;
+        frame.chunk = nullptr;
+
+        frame.count = str->GetRandomAccessItemsFromConcatString(frame.items);
+        if (frame.count == -1)
+        {
+            if (!VirtualTableInfo<ConcatStringBuilder>::HasVirtualTable(str))
+            {
+                return false;
+            }
+
+            const ConcatStringBuilder *builder = static_cast<const ConcatStringBuilder *>(str);
+            const ConcatStringBuilder *head = builder->GetHead();
+            frame.items = head->m_slots;
+            frame.count = head->m_count;
+            frame.builder = builder;
+            frame.chunk = head;
+        }
+
+        ++depth;
+        return true;
+    }
+
+    JavascriptString *StringChunkIterator::NextItem()
+    {
+        while (depth > 0)
+        {
+            Frame &frame = frames[depth - 1];
+            while (frame.index < frame.count)
+            {
+                JavascriptString *const item = frame.items[frame.index++];
+                if (item)
+                {
+                    return item;
+                }
+            }
+
+            if (frame.chunk && frame.chunk != frame.builder)
+            {
+                // Move on to the chunk that follows this one, the one that links back to it
+                const ConcatStringBuilder *next = frame.builder;
+                while (next->m_prevChunk != frame.chunk)
+                {
+                    next = next->m_prevChunk;
+                }
+                frame.items = next->m_slots;
+                frame.count = next->m_count;
+                frame.index = 0;
+                frame.chunk = next;
+                continue;
+            }
+
+            --depth;
+        }
+        return nullptr;
+    }
 } // namespace Js.
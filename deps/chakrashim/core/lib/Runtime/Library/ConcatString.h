@@ -109,6 +109,7 @@ namespace Js
     class ConcatStringBuilder sealed : public ConcatStringBase
     {
         friend JavascriptString;
+        friend class StringChunkIterator;
         ConcatStringBuilder(ScriptContext* scriptContext, int initialSlotCount);
         ConcatStringBuilder(const ConcatStringBuilder& other);
         void AllocateSlots(int requestedSlotCount);
@@ -124,6 +125,23 @@ namespace Js
         const char16 * GetSz() override sealed;
         void Append(JavascriptString* str);
 
+        // Calls fn with each item from last to first, following the chunks without flattening.
+        template <typename Fn>
+        void ForEachItemReverse(Fn fn) const
+        {
+            Assert(!this->IsFinalized());
+            for (const ConcatStringBuilder *current = this; current; current = current->m_prevChunk)
+            {
+                for (int i = current->m_count - 1; i >= 0; --i)
+                {
+                    if (current->m_slots[i])
+                    {
+                        fn(current->m_slots[i]);
+                    }
+                }
+            }
+        }
+
     private:
         // MAX number of slots in one chunk. Until we fit into this, we realloc, otherwise create new chunk.
         static const int c_maxChunkSlotCount = 1024;
@@ -229,6 +247,50 @@ namespace Js
         bool IsFilled() const;
 #endif
     };
+
+    // Walks the characters of a string from left to right, one contiguous chunk at a time, without flattening
+    // concat string trees. Only the leaves are read, so a tree is never copied. Strings that are flattened or
+    // aren't concat strings are leaves, as are the subtrees below MaxDepth, which get flattened on their own.
+    // Usage pattern:
+    //   StringChunkIterator iterator(str, startIndex);
+    //   const char16 *chars;
+    //   charcount_t length;
+    //   while (iterator.Next(&chars, &length)) { ... }
+    class StringChunkIterator
+    {
+    public:
+        StringChunkIterator(JavascriptString *str, charcount_t start = 0, uint maxVisitCount = UINT_MAX);
+
+        // Gets the next non-empty chunk. Returns false at the end of the string, or once more than
+        // maxVisitCount strings have been visited, which IsOverVisitCount tells apart.
+        bool Next(_Outptr_result_buffer_(*length) const char16 **chars, _Out_ charcount_t *length);
+        bool IsOverVisitCount() const { return visitCount > maxVisitCount; }
+
+    private:
+        static const int MaxDepth = 16;
+
+        struct Frame
+        {
+            JavascriptString *node;     // keeps the items reachable
+            JavascriptString * const * items;
+            int count;
+            int index;
+
+            // Set when the items are a chunk of a ConcatStringBuilder, whose chunks are linked from last to first
+            const ConcatStringBuilder *builder;
+            const ConcatStringBuilder *chunk;
+        };
+
+        bool TryPushItems(JavascriptString *str);
+        JavascriptString *NextItem();
+
+        Frame frames[MaxDepth];
+        int depth;
+        JavascriptString *root;
+        charcount_t skipCount;
+        uint visitCount;
+        uint maxVisitCount;
+    };
 }
 
 
@@ -57,7 +57,9 @@ namespace JSON
         return Parse(input, reviver, scriptContext);
     }
 
-    Js::Var Parse(Js::JavascriptString* input, Js::RecyclableObject* reviver, Js::ScriptContext* scriptContext)
+    // Runs parseFn, then the reviver over its result
+    template <typename Fn>
+    static Js::Var ParseHelper(Js::RecyclableObject* reviver, Js::ScriptContext* scriptContext, Fn parseFn)
     {
         // alignment required because of the union in JSONParser::m_token
         __declspec (align(8)) JSONParser parser(scriptContext, reviver);
@@ -65,7 +67,7 @@ namespace JSON
 
         TryFinally([&]()
         {
-            result = parser.Parse(input);
+            result = parseFn(parser);
 
 #ifdef ENABLE_DEBUG_CONFIG_OPTIONS
             if (CONFIG_FLAG(ForceGCAfterJSONParse))
@@ -94,6 +96,18 @@ namespace JSON
         return result;
     }
 
+    Js::Var Parse(Js::JavascriptString* input, Js::RecyclableObject* reviver, Js::ScriptContext* scriptContext)
+    {
+        return ParseHelper(reviver, scriptContext, [&](JSONParser& parser) { return parser.Parse(input); });
+    }
+
+    Js::Var ParseUtf8(const utf8char_t* input, uint length, Js::RecyclableObject* reviver, Js::ScriptContext* scriptContext)
+    {
+        PROBE_STACK(scriptContext, Js::Constants::MinStackDefault);
+
+        return ParseHelper(reviver, scriptContext, [&](JSONParser& parser) { return parser.ParseUtf8(input, length); });
+    }
+
     inline bool IsValidReplacerType(Js::TypeId typeId)
     {
         switch(typeId)
@@ -152,6 +166,18 @@ namespace JSON
         return Anew(tempAlloc, BVSparse<ArenaAllocator>, tempAlloc);
     }
 
+    // Runs the session on value as the "" property of a fresh holder object
+    static Js::Var StringifyWrapped(StringifySession& stringifySession, Js::Var value, Js::ScriptContext* scriptContext)
+    {
+        Js::DynamicObject* wrapper = scriptContext->GetLibrary()->CreateObject();
+        JS_ETW(EventWriteJSCRIPT_RECYCLER_ALLOCATE_OBJECT(wrapper));
+        Js::PropertyRecord const * propertyRecord;
+        scriptContext->GetOrAddPropertyRecord(_u(""), 0, &propertyRecord);
+        Js::PropertyId propertyId = propertyRecord->GetPropertyId();
+        Js::JavascriptOperators::InitProperty(wrapper, propertyId, value);
+        return stringifySession.Str(scriptContext->GetLibrary()->GetEmptyString(), propertyId, wrapper);
+    }
+
     Js::Var Stringify(Js::RecyclableObject* function, Js::CallInfo callInfo, ...)
     {
         PROBE_STACK(function->GetScriptContext(), Js::Constants::MinStackDefault);
@@ -319,14 +345,7 @@ namespace JSON
         BEGIN_TEMP_ALLOCATOR(tempAlloc, scriptContext, _u("JSON"))
         {
             stringifySession.CompleteInit(space, tempAlloc);
-
-            Js::DynamicObject* wrapper = scriptContext->GetLibrary()->CreateObject();
-            JS_ETW(EventWriteJSCRIPT_RECYCLER_ALLOCATE_OBJECT(wrapper));
-            Js::PropertyRecord const * propertyRecord;
-            scriptContext->GetOrAddPropertyRecord(_u(""), 0, &propertyRecord);
-            Js::PropertyId propertyId = propertyRecord->GetPropertyId();
-            Js::JavascriptOperators::InitProperty(wrapper, propertyId, value);
-            result = stringifySession.Str(scriptContext->GetLibrary()->GetEmptyString(), propertyId, wrapper);
+            result = StringifyWrapped(stringifySession, value, scriptContext);
         }
         END_TEMP_ALLOCATOR(tempAlloc, scriptContext);
 
@@ -334,6 +353,199 @@ namespace JSON
         return result;
     }
 
+    // Encodes a stringify result as UTF-8 one leaf at a time, so the string tree the
+    // session built is never flattened into a single UTF-16 buffer. Lone surrogates
+    // become U+FFFD, as they do when the host encodes a flat string.
+    class Utf8Writer
+    {
+    public:
+        Utf8Writer(ArenaAllocator* alloc, charcount_t lengthHint)
+            : alloc(alloc),
+              pending(alloc),
+              scratch(nullptr),
+              scratchLength(0),
+              pendingSurrogate(0)
+        {
+            capacity = lengthHint > InitialCapacity ? lengthHint : InitialCapacity;
+            buffer = AnewArray(alloc, utf8char_t, capacity);
+            count = 0;
+        }
+
+        void Write(Js::JavascriptString* str)
+        {
+            pending.Push(str);
+            while (!pending.Empty())
+            {
+                Js::JavascriptString* current = pending.Pop();
+                Js::JavascriptString * const * items;
+                int itemCount;
+
+                if (current->IsFinalized())
+                {
+                    Append(current->GetString(), current->GetLength());
+                }
+                else if ((itemCount = current->GetRandomAccessItemsFromConcatString(items)) >= 0)
+                {
+                    for (int i = itemCount - 1; i >= 0; --i)
+                    {
+                        if (items[i])
+                        {
+                            pending.Push(items[i]);
+                        }
+                    }
+                }
+                else if (VirtualTableInfo<Js::ConcatStringBuilder>::HasVirtualTable(current))
+                {
+                    static_cast<Js::ConcatStringBuilder*>(current)->ForEachItemReverse([&](Js::JavascriptString* item)
+                    {
+                        pending.Push(item);
+                    });
+                }
+                else if (VirtualTableInfo<Js::JSONString>::HasVirtualTable(current))
+                {
+                    // Escape into scratch space rather than finalizing the leaf into the recycler
+                    charcount_t length = current->GetLength();
+                    static_cast<Js::JSONString*>(current)->CopyEscaped(GetScratch(length));
+                    Append(scratch, length);
+                }
+                else
+                {
+                    Append(current->GetString(), current->GetLength());
+                }
+            }
+        }
+
+        Js::ArrayBuffer* CreateArrayBuffer(Js::ScriptContext* scriptContext)
+        {
+            if (pendingSurrogate != 0)
+            {
+                Reserve(3);
+                count = utf8::EncodeFull(ReplacementChar, buffer + count) - buffer;
+                pendingSurrogate = 0;
+            }
+            if (count > UINT32_MAX)
+            {
+                Js::Throw::OutOfMemory();
+            }
+
+            Js::ArrayBuffer* arrayBuffer = scriptContext->GetLibrary()->CreateArrayBuffer(static_cast<uint32>(count));
+            if (count != 0)
+            {
+                js_memcpy_s(arrayBuffer->GetBuffer(), arrayBuffer->GetByteLength(), buffer, count);
+            }
+            return arrayBuffer;
+        }
+
+    private:
+        static const size_t InitialCapacity = 256;
+        static const char16 ReplacementChar = 0xFFFD;
+
+        void Append(const char16* str, charcount_t length)
+        {
+            // Each UTF-16 unit needs at most 3 bytes, plus a pending surrogate left unpaired
+            Reserve(static_cast<size_t>(length) * 3 + 3);
+
+            utf8char_t* out = buffer + count;
+            for (charcount_t i = 0; i < length; i++)
+            {
+                char16 ch = str[i];
+                if (pendingSurrogate != 0)
+                {
+                    char16 high = pendingSurrogate;
+                    pendingSurrogate = 0;
+                    if (Js::NumberUtilities::IsSurrogateLowerPart(ch))
+                    {
+                        out = utf8::EncodeSurrogatePair(high, ch, out);
+                        continue;
+                    }
+                    out = utf8::EncodeFull(ReplacementChar, out);
+                }
+
+                if (ch < 0x80)
+                {
+                    *out++ = static_cast<utf8char_t>(ch);
+                }
+                else if (Js::NumberUtilities::IsSurrogateUpperPart(ch))
+                {
+                    // The low half may start the next leaf
+                    pendingSurrogate = ch;
+                }
+                else if (Js::NumberUtilities::IsSurrogateLowerPart(ch))
+                {
+                    out = utf8::EncodeFull(ReplacementChar, out);
+                }
+                else
+                {
+                    out = utf8::EncodeFull(ch, out);
+                }
+            }
+            count = out - buffer;
+        }
+
+        void Reserve(size_t needed)
+        {
+            if (capacity - count >= needed)
+            {
+                return;
+            }
+
+            size_t newCapacity = max(capacity * 2, count + needed);
+            utf8char_t* newBuffer = AnewArray(alloc, utf8char_t, newCapacity);
+            js_memcpy_s(newBuffer, newCapacity, buffer, count);
+            AdeleteArray(alloc, capacity, buffer);
+            buffer = newBuffer;
+            capacity = newCapacity;
+        }
+
+        char16* GetScratch(charcount_t length)
+        {
+            if (scratchLength < length)
+            {
+                if (scratch != nullptr)
+                {
+                    AdeleteArray(alloc, scratchLength, scratch);
+                }
+                scratch = AnewArray(alloc, char16, length);
+                scratchLength = length;
+            }
+            return scratch;
+        }
+
+        ArenaAllocator* alloc;
+        JsUtil::Stack<Js::JavascriptString*> pending;
+        utf8char_t* buffer;
+        size_t capacity;
+        size_t count;
+        char16* scratch;
+        charcount_t scratchLength;
+        char16 pendingSurrogate;
+    };
+
+    Js::Var StringifyToUtf8(Js::Var value, Js::ScriptContext* scriptContext)
+    {
+        PROBE_STACK(scriptContext, Js::Constants::MinStackDefault);
+
+        Js::Var result = nullptr;
+        StringifySession stringifySession(scriptContext);
+
+        BEGIN_TEMP_ALLOCATOR(tempAlloc, scriptContext, _u("JSON"))
+        {
+            stringifySession.CompleteInit(scriptContext->GetLibrary()->GetNull(), tempAlloc);
+            result = StringifyWrapped(stringifySession, value, scriptContext);
+
+            if (Js::JavascriptString::Is(result))
+            {
+                Js::JavascriptString* str = Js::JavascriptString::FromVar(result);
+                Utf8Writer writer(tempAlloc, str->GetLength());
+                writer.Write(str);
+                result = writer.CreateArrayBuffer(scriptContext);
+            }
+        }
+        END_TEMP_ALLOCATOR(tempAlloc, scriptContext);
+
+        return result;
+    }
+
     // -------- StringifySession implementation ------------//
 
     void StringifySession::CompleteInit(Js::Var space, ArenaAllocator* tempAlloc)
@@ -19,6 +19,12 @@ namespace JSON
     Js::Var Stringify(Js::RecyclableObject* function, Js::CallInfo callInfo, ...);
     Js::Var Parse(Js::RecyclableObject* function, Js::CallInfo callInfo, ...);
 
+    // JSON.parse of utf8 text, which doesn't need to be null terminated. reviver is optional.
+    Js::Var ParseUtf8(const utf8char_t* input, uint length, Js::RecyclableObject* reviver, Js::ScriptContext* scriptContext);
+
+    // JSON.stringify(value) encoded as UTF-8 into a new ArrayBuffer, or undefined
+    Js::Var StringifyToUtf8(Js::Var value, Js::ScriptContext* scriptContext);
+
     class StringifySession
     {
     public:
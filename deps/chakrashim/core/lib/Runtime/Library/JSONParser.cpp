@@ -14,6 +14,7 @@ namespace JSON
     void JSONParser::Finalizer()
     {
         m_scanner.Finalizer();
+        m_utf8Scanner.Finalizer();
         if(arenaAllocatorObject)
         {
             this->scriptContext->ReleaseTemporaryGuestAllocator(arenaAllocatorObject);
@@ -21,6 +22,22 @@ namespace JSON
     }
 
     Js::Var JSONParser::Parse(LPCWSTR str, int length)
+    {
+        return ParseText(m_scanner, str, length);
+    }
+
+    Js::Var JSONParser::Parse(Js::JavascriptString* input)
+    {
+        return Parse(input->GetSz(), input->GetLength());
+    }
+
+    Js::Var JSONParser::ParseUtf8(const utf8char_t* str, uint length)
+    {
+        return ParseText(m_utf8Scanner, str, length);
+    }
+
+    template <typename CharType>
+    Js::Var JSONParser::ParseText(JSONScanner<CharType>& scanner, const CharType* str, uint length)
     {
         if (length > MIN_CACHE_LENGTH)
         {
@@ -30,21 +47,16 @@ namespace JSON
                 this->arenaAllocator = arenaAllocatorObject->GetAllocator();
             }
         }
-        m_scanner.Init(str, length, &m_token, scriptContext, str, this->arenaAllocator);
-        Scan();
-        Js::Var ret = ParseObject();
+        scanner.Init(str, length, &m_token, scriptContext, str, this->arenaAllocator);
+        scanner.Scan();
+        Js::Var ret = ParseObject(scanner);
         if (m_token.tk != tkEOF)
         {
-            m_scanner.ThrowSyntaxError(JSERR_JsonSyntax);
+            scanner.ThrowSyntaxError(JSERR_JsonSyntax);
         }
         return ret;
     }
 
-    Js::Var JSONParser::Parse(Js::JavascriptString* input)
-    {
-        return Parse(input->GetSz(), input->GetLength());
-    }
-
     Js::Var JSONParser::Walk(Js::JavascriptString* name, Js::PropertyId id, Js::Var holder, uint32 index)
     {
         AssertMsg(reviver, "JSON post parse walk with null reviver");
@@ -189,7 +201,8 @@ namespace JSON
         return value;
     }
 
-    Js::Var JSONParser::ParseObject()
+    template <typename Scanner>
+    Js::Var JSONParser::ParseObject(Scanner& scanner)
     {
         PROBE_STACK(scriptContext, Js::Constants::MinStackDefault);
 
@@ -200,44 +213,44 @@ namespace JSON
 
         case tkFltCon:
             retVal = Js::JavascriptNumber::ToVarIntCheck(m_token.GetDouble(), scriptContext);
-            Scan();
+            scanner.Scan();
             return retVal;
 
         case tkStrCon:
             {
                 // will auto-null-terminate the string (as length=len+1)
-                uint len = m_scanner.GetCurrentStringLen();
-                retVal = Js::JavascriptString::NewCopyBuffer(m_scanner.GetCurrentString(), len, scriptContext);
-                Scan();
+                uint len = scanner.GetCurrentStringLen();
+                retVal = Js::JavascriptString::NewCopyBuffer(scanner.GetCurrentString(), len, scriptContext);
+                scanner.Scan();
                 return retVal;
             }
 
         case tkTRUE:
             retVal = scriptContext->GetLibrary()->GetTrue();
-            Scan();
+            scanner.Scan();
             return retVal;
 
         case tkFALSE:
             retVal = scriptContext->GetLibrary()->GetFalse();
-            Scan();
+            scanner.Scan();
             return retVal;
 
         case tkNULL:
             retVal = scriptContext->GetLibrary()->GetNull();
-            Scan();
+            scanner.Scan();
             return retVal;
 
         case tkSub:  // unary minus
 
-            if (Scan() == tkFltCon)
+            if (scanner.Scan() == tkFltCon)
             {
                 retVal = Js::JavascriptNumber::ToVarIntCheck(-m_token.GetDouble(), scriptContext);
-                Scan();
+                scanner.Scan();
                 return retVal;
             }
             else
             {
-                m_scanner.ThrowSyntaxError(JSERR_JsonBadNumber);
+                scanner.ThrowSyntaxError(JSERR_JsonBadNumber);
             }
 
         case tkLBrack:
@@ -246,7 +259,7 @@ namespace JSON
                 Js::JavascriptArray* arrayObj = scriptContext->GetLibrary()->CreateArray(0);
 
                 //skip '['
-                Scan();
+                scanner.Scan();
 
                 //iterate over the array members, get JSON objects and add them in the pArrayMemberList
                 uint k = 0;
@@ -256,20 +269,20 @@ namespace JSON
                     {
                         break;
                     }
-                    Js::Var value = ParseObject();
+                    Js::Var value = ParseObject(scanner);
                     arrayObj->SetItem(k++, value, Js::PropertyOperation_None);
 
                     // if next token is not a comma consider the end of the array member list.
                     if (tkComma != m_token.tk)
                         break;
-                    Scan();
+                    scanner.Scan();
                     if(tkRBrack == m_token.tk)
                     {
-                        m_scanner.ThrowSyntaxError(JSERR_JsonIllegalChar);
+                        scanner.ThrowSyntaxError(JSERR_JsonIllegalChar);
                     }
                 }
                 //check and consume the ending ']'
-                CheckCurrentToken(tkRBrack, JSERR_JsonNoRbrack);
+                CheckCurrentToken(scanner, tkRBrack, JSERR_JsonNoRbrack);
                 return arrayObj;
 
             }
@@ -297,12 +310,12 @@ namespace JSON
 #endif
 
                 //next token after '{'
-                Scan();
+                scanner.Scan();
 
                 //if empty object "{}" return;
                 if(tkRCurly == m_token.tk)
                 {
-                    Scan();
+                    scanner.Scan();
                     return object;
                 }
                 JsonTypeCache* previousCache = nullptr;
@@ -316,12 +329,12 @@ namespace JSON
                     //pick "name"
                     if(tkStrCon != m_token.tk)
                     {
-                        m_scanner.ThrowSyntaxError(JSERR_JsonIllegalChar);
+                        scanner.ThrowSyntaxError(JSERR_JsonIllegalChar);
                     }
 
                     // currentStrLength = length w/o null-termination
-                    WCHAR* currentStr = m_scanner.GetCurrentString();
-                    uint currentStrLength = m_scanner.GetCurrentStringLen();
+                    WCHAR* currentStr = scanner.GetCurrentString();
+                    uint currentStrLength = scanner.GetCurrentStringLen();
 
                     DynamicType* typeWithoutProperty = object->GetDynamicType();
                     if(IsCaching())
@@ -335,11 +348,11 @@ namespace JSON
                             currentCache->propertyRecord->Equals(JsUtil::CharacterBuffer<WCHAR>(currentStr, currentStrLength)))
                         {
                             //check and consume ":"
-                            if(Scan() != tkColon )
+                            if(scanner.Scan() != tkColon )
                             {
-                                m_scanner.ThrowSyntaxError(JSERR_JsonNoColon);
+                                scanner.ThrowSyntaxError(JSERR_JsonNoColon);
                             }
-                            Scan();
+                            scanner.Scan();
 
                             // Cache all values from currentCache as there is a chance that ParseObject might change the cache
                             DynamicType* typeWithProperty = currentCache->typeWithProperty;
@@ -352,13 +365,13 @@ namespace JSON
                             object->EnsureSlots(typeWithoutProperty->GetTypeHandler()->GetSlotCapacity(),
                                 typeWithProperty->GetTypeHandler()->GetSlotCapacity(), scriptContext, typeWithProperty->GetTypeHandler());
                             object->ReplaceType(typeWithProperty);
-                            Js::Var value = ParseObject();
+                            Js::Var value = ParseObject(scanner);
                             object->SetSlot(SetSlotArguments(propertyId, propertyIndex, value));
 
                             // if the next token is not a comma consider the list of members done.
                             if (tkComma != m_token.tk)
                                 break;
-                            Scan();
+                            scanner.Scan();
                             continue;
                         }
                     }
@@ -368,12 +381,12 @@ namespace JSON
                     scriptContext->GetOrAddPropertyRecord(currentStr, currentStrLength, &propertyRecord);
 
                     //check and consume ":"
-                    if(Scan() != tkColon )
+                    if(scanner.Scan() != tkColon )
                     {
-                        m_scanner.ThrowSyntaxError(JSERR_JsonNoColon);
+                        scanner.ThrowSyntaxError(JSERR_JsonNoColon);
                     }
-                    Scan();
-                    Js::Var value = ParseObject();
+                    scanner.Scan();
+                    Js::Var value = ParseObject(scanner);
                     PropertyValueInfo info;
                     object->SetProperty(propertyRecord->GetPropertyId(), value, PropertyOperation_None, &info);
 
@@ -405,16 +418,16 @@ namespace JSON
                     // if the next token is not a comma consider the list of members done.
                     if (tkComma != m_token.tk)
                         break;
-                    Scan();
+                    scanner.Scan();
                 }
 
                 // check  and consume the ending '}"
-                CheckCurrentToken(tkRCurly, JSERR_JsonNoRcurly);
+                CheckCurrentToken(scanner, tkRCurly, JSERR_JsonNoRcurly);
                 return object;
             }
 
         default:
-            m_scanner.ThrowSyntaxError(JSERR_JsonSyntax);
+            scanner.ThrowSyntaxError(JSERR_JsonSyntax);
         }
     }
 } // namespace JSON
@@ -56,22 +56,24 @@ namespace JSON
 
         Js::Var Parse(LPCWSTR str, int length);
         Js::Var Parse(Js::JavascriptString* input);
+        // Parses utf8 text, e.g. the content of a Buffer, without making a string of it first
+        Js::Var ParseUtf8(const utf8char_t* str, uint length);
         Js::Var Walk(Js::JavascriptString* name, Js::PropertyId id, Js::Var holder, uint32 index = Js::JavascriptArray::InvalidIndex);
         void Finalizer();
 
     private:
-        tokens Scan()
-        {
-            return m_scanner.Scan();
-        }
+        template <typename CharType>
+        Js::Var ParseText(JSONScanner<CharType>& scanner, const CharType* str, uint length);
 
-        Js::Var ParseObject();
+        template <typename Scanner>
+        Js::Var ParseObject(Scanner& scanner);
 
-        void CheckCurrentToken(int tk, int wErr)
+        template <typename Scanner>
+        void CheckCurrentToken(Scanner& scanner, int tk, int wErr)
         {
             if (m_token.tk != tk)
-                m_scanner.ThrowSyntaxError(wErr);
-            Scan();
+                scanner.ThrowSyntaxError(wErr);
+            scanner.Scan();
         }
 
         bool IsCaching()
@@ -80,7 +82,8 @@ namespace JSON
         }
 
         Token m_token;
-        JSONScanner m_scanner;
+        JSONScanner<char16> m_scanner;
+        JSONScanner<utf8char_t> m_utf8Scanner;
         Js::ScriptContext* scriptContext;
         Js::RecyclableObject* reviver;
         Js::TempGuestArenaAllocatorObject* arenaAllocatorObject;
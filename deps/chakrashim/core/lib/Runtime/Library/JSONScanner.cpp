@@ -5,18 +5,26 @@
 #include "RuntimeLibraryPch.h"
 #include "JSONScanner.h"
 
+#if defined(_M_IX86) || defined(_M_X64)
+#ifdef _WIN32
+#include <emmintrin.h>
+#endif
+#endif
+
 using namespace Js;
 
 namespace JSON
 {
     // -------- Scanner implementation ------------//
-    JSONScanner::JSONScanner()
+    template <typename CharType>
+    JSONScanner<CharType>::JSONScanner()
         : inputText(0), inputLen(0), pToken(0), stringBuffer(0), allocator(0), allocatorObject(0),
         currentRangeCharacterPairList(0), stringBufferLength(0), currentIndex(0)
     {
     }
 
-    void JSONScanner::Finalizer()
+    template <typename CharType>
+    void JSONScanner<CharType>::Finalizer()
     {
         // All dynamic memory allocated by this object is on the arena - either the one this object owns or by the
         // one shared with JSON parser - here we will deallocate ours. The others will be deallocated when JSONParser
@@ -28,7 +36,8 @@ namespace JSON
         }
     }
 
-    void JSONScanner::Init(const char16* input, uint len, Token* pOutToken, Js::ScriptContext* sc, const char16* current, ArenaAllocator* allocator)
+    template <typename CharType>
+    void JSONScanner<CharType>::Init(const CharType* input, uint len, Token* pOutToken, Js::ScriptContext* sc, const CharType* current, ArenaAllocator* allocator)
     {
         // Note that allocator could be nullptr from JSONParser, if we could not reuse an allocator, keep our own
         inputText = input;
@@ -39,7 +48,8 @@ namespace JSON
         this->allocator = allocator;
     }
 
-    tokens JSONScanner::Scan()
+    template <typename CharType>
+    tokens JSONScanner<CharType>::Scan()
     {
         pTokenString = currentChar;
 
@@ -74,30 +84,8 @@ namespace JSON
             case '8':
             case '9':
                 //decimal digit starts a number
-                {
-                    currentChar--;
-
-                    // we use StrToDbl() here for compat with the rest of the engine. StrToDbl() accept a larger syntax.
-                    // Verify first the JSON grammar.
-                    const char16* saveCurrentChar = currentChar;
-                    if(!IsJSONNumber())
-                    {
-                       ThrowSyntaxError(JSERR_JsonBadNumber);
-                    }
-                    currentChar = saveCurrentChar;
-                    double val;
-                    const char16* end;
-                    val = Js::NumberUtilities::StrToDbl(currentChar, &end, scriptContext);
-                    if(currentChar == end)
-                    {
-                       ThrowSyntaxError(JSERR_JsonBadNumber);
-                    }
-                    AssertMsg(!Js::JavascriptNumber::IsNan(val), "Bad result from string to double conversion");
-                    pToken->tk = tkFltCon;
-                    pToken->SetDouble(val, false);
-                    currentChar = end;
-                    return tkFltCon;
-                }
+                currentChar--;
+                return ScanNumber();
 
             case ',':
                 return (pToken->tk = tkComma);
@@ -156,7 +144,65 @@ namespace JSON
         return (pToken->tk = tkEOF);
     }
 
-    bool JSONScanner::IsJSONNumber()
+    template <typename CharType>
+    tokens JSONScanner<CharType>::ScanNumber()
+    {
+        // we use StrToDbl() here for compat with the rest of the engine. StrToDbl() accept a larger syntax.
+        // Verify first the JSON grammar.
+        const CharType* saveCurrentChar = currentChar;
+        if(!IsJSONNumber())
+        {
+           ThrowSyntaxError(JSERR_JsonBadNumber);
+        }
+        currentChar = saveCurrentChar;
+
+        // StrToDbl() only stops at a character that can't be part of a number, so a number running
+        // up to the end of the input is copied out and null terminated first: utf8 input is not.
+        const CharType* inputEnd = inputText + inputLen;
+        const CharType* numberEnd = currentChar;
+        while (numberEnd < inputEnd &&
+            (('0' <= *numberEnd && *numberEnd <= '9') || *numberEnd == '.' || *numberEnd == 'e' || *numberEnd == 'E' || *numberEnd == '+' || *numberEnd == '-'))
+        {
+            numberEnd++;
+        }
+
+        double val;
+        const CharType* end;
+        if (numberEnd == inputEnd)
+        {
+            CharType localBuffer[32];
+            CharType* number = localBuffer;
+            uint numberLength = (uint)(numberEnd - currentChar);
+            if (numberLength >= _countof(localBuffer))
+            {
+                EnsureAllocator();
+                number = AnewArray(this->allocator, CharType, UInt32Math::Add(numberLength, 1));
+            }
+            js_memcpy_s(number, numberLength * sizeof(CharType), currentChar, numberLength * sizeof(CharType));
+            number[numberLength] = 0;
+
+            const CharType* numberLim;
+            val = Js::NumberUtilities::StrToDbl(number, &numberLim, scriptContext);
+            end = currentChar + (numberLim - number);
+        }
+        else
+        {
+            val = Js::NumberUtilities::StrToDbl(currentChar, &end, scriptContext);
+        }
+
+        if(currentChar == end)
+        {
+           ThrowSyntaxError(JSERR_JsonBadNumber);
+        }
+        AssertMsg(!Js::JavascriptNumber::IsNan(val), "Bad result from string to double conversion");
+        pToken->tk = tkFltCon;
+        pToken->SetDouble(val, false);
+        currentChar = end;
+        return tkFltCon;
+    }
+
+    template <typename CharType>
+    bool JSONScanner<CharType>::IsJSONNumber()
     {
         bool firstDigitIsAZero = false;
         if (PeekNextChar() == '0')
@@ -193,7 +239,7 @@ namespace JSON
                     // at least one digit after '.'
                     if(currentChar < inputText + inputLen)
                     {
-                        char16 nch = ReadNextChar();
+                        CharType nch = ReadNextChar();
                         if('0' <= nch && nch <= '9')
                         {
                             return true;
@@ -220,7 +266,89 @@ namespace JSON
         return true;
     }
 
-    tokens JSONScanner::ScanString()
+    template <typename CharType>
+    char16 JSONScanner<CharType>::ScanEscapeSequence()
+    {
+        //JSON escape sequence in a string \", \/, \\, \b, \f, \n, \r, \t, unicode seq
+        // unlikely V5.8 regular chars are not escaped, i.e '\g'' in a string is illegal not 'g'
+        if (currentChar >= inputText + inputLen )
+        {
+           ThrowSyntaxError(JSERR_JsonNoStrEnd);
+        }
+
+        CharType ch = ReadNextChar();
+        switch (ch)
+        {
+        case 0:
+            currentChar--;
+           ThrowSyntaxError(JSERR_JsonNoStrEnd);
+
+        case '"':
+        case '/':
+        case '\\':
+            return ch;
+
+        case 'b':
+            return 0x08;
+
+        case 'f':
+            return 0x0C;
+
+        case 'n':
+            return 0x0A;
+
+        case 'r':
+            return 0x0D;
+
+        case 't':
+            return 0x09;
+
+        case 'u':
+            {
+                int chcode;
+                int tempHex;
+                // 4 hex digits
+                if (currentChar + 3 >= inputText + inputLen)
+                {
+                    //no room left for 4 hex chars
+                   ThrowSyntaxError(JSERR_JsonNoStrEnd);
+
+                }
+                if (!Js::NumberUtilities::FHexDigit((WCHAR)ReadNextChar(), &tempHex))
+                {
+                   ThrowSyntaxError(JSERR_JsonBadHexDigit);
+                }
+                chcode = tempHex * 0x1000;
+
+                if (!Js::NumberUtilities::FHexDigit((WCHAR)ReadNextChar(), &tempHex))
+                {
+                   ThrowSyntaxError(JSERR_JsonBadHexDigit);
+                }
+                chcode += tempHex * 0x0100;
+
+                if (!Js::NumberUtilities::FHexDigit((WCHAR)ReadNextChar(), &tempHex))
+                {
+                   ThrowSyntaxError(JSERR_JsonBadHexDigit);
+                }
+                chcode += tempHex * 0x0010;
+
+                if (!Js::NumberUtilities::FHexDigit((WCHAR)ReadNextChar(), &tempHex))
+                {
+                   ThrowSyntaxError(JSERR_JsonBadHexDigit);
+                }
+                chcode += tempHex;
+                AssertMsg(chcode == (chcode & 0xFFFF), "Bad unicode code");
+                return (char16)chcode;
+            }
+
+        default:
+            // Any other '\o' is an error in JSON
+           ThrowSyntaxError(JSERR_JsonIllegalChar);
+        }
+    }
+
+    template <>
+    tokens JSONScanner<char16>::ScanString()
     {
         char16 ch;
 
@@ -234,7 +362,6 @@ namespace JSON
         while (currentChar < inputText + inputLen)
         {
             ch = ReadNextChar();
-            int tempHex;
 
             if (ch == '"')
             {
@@ -254,88 +381,7 @@ namespace JSON
             }
             else if ('\\' == ch)
             {
-                //JSON escape sequence in a string \", \/, \\, \b, \f, \n, \r, \t, unicode seq
-                // unlikely V5.8 regular chars are not escaped, i.e '\g'' in a string is illegal not 'g'
-                if (currentChar >= inputText + inputLen )
-                {
-                   ThrowSyntaxError(JSERR_JsonNoStrEnd);
-                }
-
-                ch = ReadNextChar();
-                switch (ch)
-                {
-                case 0:
-                    currentChar--;
-                   ThrowSyntaxError(JSERR_JsonNoStrEnd);
-
-                case '"':
-                case '/':
-                case '\\':
-                    //keep ch
-                    break;
-
-                case 'b':
-                    ch = 0x08;
-                    break;
-
-                case 'f':
-                    ch = 0x0C;
-                    break;
-
-                case 'n':
-                    ch = 0x0A;
-                    break;
-
-                case 'r':
-                    ch = 0x0D;
-                    break;
-
-                case 't':
-                    ch = 0x09;
-                    break;
-
-                case 'u':
-                    {
-                        int chcode;
-                        // 4 hex digits
-                        if (currentChar + 3 >= inputText + inputLen)
-                        {
-                            //no room left for 4 hex chars
-                           ThrowSyntaxError(JSERR_JsonNoStrEnd);
-
-                        }
-                        if (!Js::NumberUtilities::FHexDigit((WCHAR)ReadNextChar(), &tempHex))
-                        {
-                           ThrowSyntaxError(JSERR_JsonBadHexDigit);
-                        }
-                        chcode = tempHex * 0x1000;
-
-                        if (!Js::NumberUtilities::FHexDigit((WCHAR)ReadNextChar(), &tempHex))
-                        {
-                           ThrowSyntaxError(JSERR_JsonBadHexDigit);
-                        }
-                        chcode += tempHex * 0x0100;
-
-                        if (!Js::NumberUtilities::FHexDigit((WCHAR)ReadNextChar(), &tempHex))
-                        {
-                           ThrowSyntaxError(JSERR_JsonBadHexDigit);
-                        }
-                        chcode += tempHex * 0x0010;
-
-                        if (!Js::NumberUtilities::FHexDigit((WCHAR)ReadNextChar(), &tempHex))
-                        {
-                           ThrowSyntaxError(JSERR_JsonBadHexDigit);
-                        }
-                        chcode += tempHex;
-                        AssertMsg(chcode == (chcode & 0xFFFF), "Bad unicode code");
-                        ch = (char16)chcode;
-                    }
-                    break;
-
-                default:
-                    // Any other '\o' is an error in JSON
-                   ThrowSyntaxError(JSERR_JsonIllegalChar);
-                }
+                ch = ScanEscapeSequence();
 
                 // flush
                 this->GetCurrentRangeCharacterPairList()->Add(RangeCharacterPair((uint)(bulkStart - inputText), bulkLength, ch));
@@ -404,7 +450,157 @@ namespace JSON
         return (pToken->tk = tkStrCon);
     }
 
-    void JSONScanner::BuildUnescapedString(bool shouldSkipLastCharacter)
+    // Skips ascii characters that stand for themselves in a string, stopping at a quote, a backslash,
+    // a control character or the first byte of a multi-byte sequence.
+    static const utf8char_t* SkipPlainAscii(const utf8char_t* current, const utf8char_t* end)
+    {
+#if defined(_M_IX86) || defined(_M_X64)
+        const __m128i quote = _mm_set1_epi8('"');
+        const __m128i backslash = _mm_set1_epi8('\\');
+        const __m128i space = _mm_set1_epi8(' ');
+        while (end - current >= 16)
+        {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(current));
+            // The compare is signed, so bytes of multi-byte sequences are below ' ' along with control characters
+            __m128i special = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+                _mm_cmplt_epi8(chunk, space));
+            int mask = _mm_movemask_epi8(special);
+            if (mask != 0)
+            {
+                DWORD index;
+                _BitScanForward(&index, mask);
+                return current + index;
+            }
+            current += 16;
+        }
+#endif
+        while (current < end && *current >= ' ' && *current < 0x80 && *current != '"' && *current != '\\')
+        {
+            current++;
+        }
+        return current;
+    }
+
+    // Decodes the multi-byte sequence at current into one or two words of buffer and returns how many.
+    // Noncharacters are kept as they are. Each maximal subpart of an ill-formed sequence becomes a single
+    // U+FFFD, following the WHATWG Encoding Standard, which is also how TextDecoder and buf.toString() do it.
+    static uint DecodeUtf8Sequence(const utf8char_t*& current, const utf8char_t* end, char16* buffer)
+    {
+        const utf8char_t lead = *current++;
+        uint needed;
+        codepoint_t codePoint;
+        utf8char_t lower = 0x80;
+        utf8char_t upper = 0xBF;
+
+        if (lead >= 0xC2 && lead <= 0xDF)
+        {
+            needed = 1;
+            codePoint = lead & 0x1F;
+        }
+        else if (lead >= 0xE0 && lead <= 0xEF)
+        {
+            needed = 2;
+            codePoint = lead & 0x0F;
+            if (lead == 0xE0) lower = 0xA0;         // overlong
+            if (lead == 0xED) upper = 0x9F;         // surrogates
+        }
+        else if (lead >= 0xF0 && lead <= 0xF4)
+        {
+            needed = 3;
+            codePoint = lead & 0x07;
+            if (lead == 0xF0) lower = 0x90;         // overlong
+            if (lead == 0xF4) upper = 0x8F;         // above U+10FFFF
+        }
+        else
+        {
+            buffer[0] = 0xFFFD;
+            return 1;
+        }
+
+        for (uint i = 0; i < needed; i++)
+        {
+            // The byte that ends the subpart is not consumed, it starts whatever comes next
+            if (current >= end || *current < lower || *current > upper)
+            {
+                buffer[0] = 0xFFFD;
+                return 1;
+            }
+            codePoint = (codePoint << 6) | (*current++ & 0x3F);
+            lower = 0x80;
+            upper = 0xBF;
+        }
+
+        if (codePoint >= 0x10000)
+        {
+            Js::NumberUtilities::CodePointAsSurrogatePair(codePoint, &buffer[0], &buffer[1]);
+            return 2;
+        }
+        buffer[0] = (char16)codePoint;
+        return 1;
+    }
+
+    // Utf8 text can't be mapped directly to the char16 string, so the string is always decoded into stringBuffer.
+    template <>
+    tokens JSONScanner<utf8char_t>::ScanString()
+    {
+        const utf8char_t* inputEnd = inputText + inputLen;
+        this->currentIndex = 0;
+        GetStringBufferForAppend(0);
+
+        while (true)
+        {
+            const utf8char_t* bulkStart = currentChar;
+            currentChar = SkipPlainAscii(currentChar, inputEnd);
+            uint bulkLength = (uint)(currentChar - bulkStart);
+            if (bulkLength > 0)
+            {
+                char16* buffer = GetStringBufferForAppend(bulkLength);
+                for (uint i = 0; i < bulkLength; i++)
+                {
+                    buffer[i] = bulkStart[i];
+                }
+                currentIndex += bulkLength;
+            }
+
+            if (currentChar >= inputEnd)
+            {
+                // no ending '"' found
+               ThrowSyntaxError(JSERR_JsonNoStrEnd);
+            }
+
+            utf8char_t ch = ReadNextChar();
+            if (ch == '"')
+            {
+                //end of the string
+                break;
+            }
+            else if (ch == '\\')
+            {
+                char16 unescaped = ScanEscapeSequence();
+                *GetStringBufferForAppend(1) = unescaped;
+                currentIndex++;
+            }
+            else if (ch <= 0x1F)
+            {
+                //JSON doesn't accept \u0000 - \u001f range
+               ThrowSyntaxError(JSERR_JsonIllegalChar);
+            }
+            else
+            {
+                // Multi-byte sequence; one outside the BMP decodes to a surrogate pair
+                currentChar--;
+                char16* buffer = GetStringBufferForAppend(2);
+                currentIndex += DecodeUtf8Sequence(currentChar, inputEnd, buffer);
+            }
+        }
+
+        this->currentString = this->stringBuffer;
+        return (pToken->tk = tkStrCon);
+    }
+
+    template <>
+    void JSONScanner<char16>::BuildUnescapedString(bool shouldSkipLastCharacter)
     {
         AssertMsg(this->allocator != nullptr, "We must have built the allocator");
         AssertMsg(this->currentRangeCharacterPairList != nullptr, "We must have built the currentRangeCharacterPairList");
@@ -455,19 +651,56 @@ namespace JSON
         OUTPUT_TRACE_DEBUGONLY(Js::JSONPhase, _u("BuildUnescapedString(): unescaped string as '%.*s'\n"), GetCurrentStringLen(), this->stringBuffer);
     }
 
-    JSONScanner::RangeCharacterPairList* JSONScanner::GetCurrentRangeCharacterPairList(void)
+    template <typename CharType>
+    typename JSONScanner<CharType>::RangeCharacterPairList* JSONScanner<CharType>::GetCurrentRangeCharacterPairList(void)
     {
         if (this->currentRangeCharacterPairList == nullptr)
         {
-            if (this->allocator == nullptr)
+            EnsureAllocator();
+            this->currentRangeCharacterPairList = Anew(this->allocator, RangeCharacterPairList, this->allocator, 4);
+        }
+
+        return this->currentRangeCharacterPairList;
+    }
+
+    template <typename CharType>
+    void JSONScanner<CharType>::EnsureAllocator()
+    {
+        if (this->allocator == nullptr)
+        {
+            this->allocatorObject = this->scriptContext->GetTemporaryGuestAllocator(_u("JSONScanner"));
+            this->allocator = this->allocatorObject->GetAllocator();
+        }
+    }
+
+    // Returns room for count more characters at currentIndex, growing stringBuffer and keeping its content
+    template <typename CharType>
+    char16* JSONScanner<CharType>::GetStringBufferForAppend(uint count)
+    {
+        uint requiredSize = UInt32Math::Add(this->currentIndex, count);
+        if (this->stringBuffer == nullptr || requiredSize > (uint)this->stringBufferLength)
+        {
+            if (requiredSize > INT_MAX)
             {
-                this->allocatorObject = this->scriptContext->GetTemporaryGuestAllocator(_u("JSONScanner"));
-                this->allocator = this->allocatorObject->GetAllocator();
+                Js::Throw::OutOfMemory();
             }
 
-            this->currentRangeCharacterPairList = Anew(this->allocator, RangeCharacterPairList, this->allocator, 4);
+            EnsureAllocator();
+            uint newLength = min(max(requiredSize, max((uint)this->stringBufferLength * 2, 64u)), (uint)INT_MAX);
+            char16* newBuffer = AnewArray(this->allocator, char16, newLength);
+            if (this->stringBuffer)
+            {
+                js_wmemcpy_s(newBuffer, newLength, this->stringBuffer, this->currentIndex);
+                AdeleteArray(this->allocator, this->stringBufferLength, this->stringBuffer);
+            }
+
+            this->stringBuffer = newBuffer;
+            this->stringBufferLength = (int)newLength;
         }
 
-        return this->currentRangeCharacterPairList;
+        return this->stringBuffer + this->currentIndex;
     }
+
+    template class JSONScanner<char16>;
+    template class JSONScanner<utf8char_t>;
 } // namespace JSON
@@ -11,13 +11,16 @@ namespace JSON
     // Small scanner for exclusive JSON purpose. The general
     // JScript scanner is not appropriate here because of the JSON restricted lexical grammar
     // token enums and structures are shared although the token semantics is slightly different.
+    // CharType is char16 for JavaScript strings or utf8char_t for utf8 text, which doesn't have to be
+    // null terminated. Either way the strings that are scanned come out as char16.
+    template <typename CharType>
     class JSONScanner
     {
     public:
         JSONScanner();
         tokens Scan();
-        void Init(const char16* input, uint len, Token* pOutToken,
-            ::Js::ScriptContext* sc, const char16* current, ArenaAllocator* allocator);
+        void Init(const CharType* input, uint len, Token* pOutToken,
+            ::Js::ScriptContext* sc, const CharType* current, ArenaAllocator* allocator);
 
         void Finalizer();
         char16* GetCurrentString() { return currentString; } 
@@ -52,24 +55,28 @@ namespace JSON
         void BuildUnescapedString(bool shouldSkipLastCharacter);
 
         RangeCharacterPairList* GetCurrentRangeCharacterPairList(void);
+        void EnsureAllocator();
+        char16* GetStringBufferForAppend(uint count);
 
-        inline char16 ReadNextChar(void)
+        inline CharType ReadNextChar(void)
         {
             return *currentChar++;
         }
 
-        inline char16 PeekNextChar(void)
+        inline CharType PeekNextChar(void)
         {
             return *currentChar;
         }
 
         tokens ScanString();
+        tokens ScanNumber();
+        char16 ScanEscapeSequence();
         bool IsJSONNumber();
 
-        const char16* inputText;
+        const CharType* inputText;
         uint    inputLen;
-        const char16* currentChar;
-        const char16* pTokenString;
+        const CharType* currentChar;
+        const CharType* pTokenString;
 
         Token*   pToken;
         ::Js::ScriptContext* scriptContext;
@@ -81,4 +88,8 @@ namespace JSON
 
         friend class JSONParser;
     };
+
+    template <> tokens JSONScanner<char16>::ScanString();
+    template <> tokens JSONScanner<utf8char_t>::ScanString();
+    template <> void JSONScanner<char16>::BuildUnescapedString(bool shouldSkipLastCharacter);
 } // namespace JSON
@@ -90,6 +90,23 @@ namespace Js
         return buffer;
     }
 
+    void JSONString::CopyEscaped(_Out_writes_(m_charLength) char16 *const buffer)
+    {
+        Assert(!this->IsFinalized());
+        WritableStringBuffer stringBuffer(buffer, this->GetLength());
+        JavascriptString* str = JSONString::Escape<EscapingOperation_Escape>(this->m_originalString, m_start, &stringBuffer);
+        Assert(str == nullptr);
+    }
+
+    void JSONString::CopyVirtual(
+        _Out_writes_(m_charLength) char16 *const buffer,
+        StringCopyInfoStack &nestedStringTreeCopyInfos,
+        const byte recursionDepth)
+    {
+        // Escape straight into the destination instead of finalizing into a buffer of our own first
+        CopyEscaped(buffer);
+    }
+
     void WritableStringBuffer::Append(const char16 * str, charcount_t countNeeded)
     {
         JavascriptString::CopyHelper(m_pszCurrentPtr, str, countNeeded);
@@ -40,9 +40,12 @@ namespace Js
     public:
         static JSONString* New(JavascriptString* originalString, charcount_t start, charcount_t extraChars);
         virtual const char16* GetSz() override;
+        // Writes the escaped string, quotes included, without finalizing this string.
+        void CopyEscaped(_Out_writes_(m_charLength) char16 *const buffer);
     protected:
         DEFINE_VTABLE_CTOR(JSONString, JavascriptString);
         DECLARE_CONCRETE_STRING_CLASS;
+        virtual void CopyVirtual(_Out_writes_(m_charLength) char16 *const buffer, StringCopyInfoStack &nestedStringTreeCopyInfos, const byte recursionDepth) override;
     private:
         JavascriptString* m_originalString;
         charcount_t m_start; /* start of the escaping operation */
@@ -6,6 +6,8 @@
 #include "RuntimeLibraryPch.h"
 #include "Types/PathTypeHandler.h"
 #include "Types/SpreadArgument.h"
+#include "DataStructures/MergeSort.h"
+#include "DataStructures/RadixSort.h"
 
 namespace Js
 {
@@ -6127,41 +6129,39 @@ Case0:
         }
     }
 
+    class CompareVarsComparer
+    {
+    public:
+        CompareVarsComparer(CompareVarsInfo* compareInfo) : compareInfo(compareInfo) {}
+
+        int Compare(const Var& a, const Var& b)
+        {
+            return compareVars(compareInfo, &a, &b);
+        }
+
+    private:
+        CompareVarsInfo* compareInfo;
+    };
+
     static void hybridSort(__inout_ecount(length) Var *elements, uint32 length, CompareVarsInfo* compareInfo)
     {
-        // The cost of memory moves starts to be more expensive than additional comparer calls (given a simple comparer)
-        // for arrays of more than 512 elements.
-        if (length > 512)
+        if (length < 2)
         {
-            qsort_s(elements, length, sizeof(Var), compareVars, compareInfo);
             return;
         }
 
-        for (int i = 1; i < (int)length; i++)
-        {
-            if (compareVars(compareInfo, elements + i, elements + i - 1) < 0) {
-                // binary search for the left-most element greater than value:
-                int first = 0;
-                int last = i - 1;
-                while (first <= last)
-                {
-                    int middle = (first + last) / 2;
-                    if (compareVars(compareInfo, elements + i, elements + middle) < 0)
-                    {
-                        last = middle - 1;
-                    }
-                    else
-                    {
-                        first = middle + 1;
-                    }
-                }
+        // The compare function can throw at any point of a merge, so sort a copy to keep the elements
+        // intact. Merge sort takes few calls to the compare function for runs that are already in order
+        // and keeps equal elements in their original order.
+        Recycler* recycler = compareInfo->scriptContext->GetRecycler();
+        Var* copy = RecyclerNewArray(recycler, Var, length);
+        Var* scratch = RecyclerNewArray(recycler, Var, length);
+        js_memcpy_s(copy, sizeof(Var) * length, elements, sizeof(Var) * length);
 
-                // insert value right before first:
-                Var value = elements[i];
-                memmove(elements + first + 1, elements + first, (i - first) * sizeof(Var));
-                elements[first] = value;
-            }
-        }
+        CompareVarsComparer comparer(compareInfo);
+        JsUtil::MergeSort<Var, CompareVarsComparer>::Sort(copy, length, scratch, comparer);
+
+        js_memcpy_s(elements, sizeof(Var) * length, copy, sizeof(Var) * length);
     }
 
     void JavascriptArray::Sort(RecyclableObject* compFn)
@@ -6350,20 +6350,112 @@ Case0:
         return countUndefined;
     }
 
-    int __cdecl JavascriptArray::CompareElements(void* context, const void* elem1, const void* elem2)
+    void JavascriptArray::SortElements(Element* elements, uint32 left, uint32 right)
     {
-        const Element* element1 = static_cast<const Element*>(elem1);
-        const Element* element2 = static_cast<const Element*>(elem2);
-
-        Assert(element1 != NULL);
-        Assert(element2 != NULL);
+        class StringValueComparer
+        {
+        public:
+            int Compare(const Element& element1, const Element& element2)
+            {
+                return JavascriptString::strcmp(element1.StringValue, element2.StringValue);
+            }
+        };
 
-        return JavascriptString::strcmp(element1->StringValue, element2->StringValue);
+        uint32 count = right - left + 1;
+        Element* scratch = RecyclerNewArrayZ(this->GetRecycler(), Element, count);
+        StringValueComparer comparer;
+        JsUtil::MergeSort<Element, StringValueComparer>::Sort(elements + left, count, scratch, comparer);
     }
 
-    void JavascriptArray::SortElements(Element* elements, uint32 left, uint32 right)
+    // Radix sort keys that order int32s the way their decimal strings compare: negative numbers first,
+    // then by the digits padded with zeros to ten places, then by the number of digits.
+    static const uint64 Int32StringOrderPowersOfTen[] =
+    {
+        1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000, 10000000000
+    };
+
+    class Int32StringOrderKey
+    {
+    public:
+        static uint64 GetKey(uint64 key)
+        {
+            return key;
+        }
+
+        static uint64 FromInt32(int32 value)
+        {
+            uint64 magnitude = value < 0 ? (uint64)0 - (int64)value : (uint64)value;
+            uint digits = 1;
+            while (digits < 10 && magnitude >= Int32StringOrderPowersOfTen[digits])
+            {
+                digits++;
+            }
+
+            uint64 padded = magnitude * Int32StringOrderPowersOfTen[10 - digits];
+            return ((uint64)(value >= 0) << 38) | (padded << 4) | digits;
+        }
+
+        static int32 ToInt32(uint64 key)
+        {
+            uint digits = (uint)(key & 0xF);
+            uint64 magnitude = ((key >> 4) & 0x3FFFFFFFF) / Int32StringOrderPowersOfTen[10 - digits];
+            return (key >> 38) ? (int32)magnitude : (int32)(0 - (uint32)magnitude);
+        }
+    };
+
+    bool JavascriptArray::TrySortNativeIntArrayInPlace(JavascriptNativeIntArray* pArr)
     {
-        qsort_s(elements, right - left + 1, sizeof(Element), CompareElements, this);
+        SparseArraySegment<int32>* seg = (SparseArraySegment<int32>*)pArr->head;
+        if (seg->next != nullptr)
+        {
+            return false;
+        }
+
+        if (seg->length == 0)
+        {
+            return true;
+        }
+
+        ScriptContext* scriptContext = pArr->GetScriptContext();
+        uint32 segLength = seg->length;
+        uint32 count = 0;
+
+        BEGIN_TEMP_ALLOCATOR(tempAlloc, scriptContext, _u("Runtime"))
+        {
+            uint64* keys = AnewArray(tempAlloc, uint64, segLength);
+            for (uint32 i = 0; i < segLength; i++)
+            {
+                if (!SparseArraySegment<int32>::IsMissingItem(&seg->elements[i]))
+                {
+                    keys[count++] = Int32StringOrderKey::FromInt32(seg->elements[i]);
+                }
+            }
+
+            uint64* scratch = AnewArray(tempAlloc, uint64, count);
+            JsUtil::RadixSort<uint64, uint64, Int32StringOrderKey>::Sort(keys, count, scratch);
+
+            for (uint32 i = 0; i < count; i++)
+            {
+                seg->elements[i] = Int32StringOrderKey::ToInt32(keys[i]);
+            }
+        }
+        END_TEMP_ALLOCATOR(tempAlloc, scriptContext);
+
+        // Holes go to the end, past the new length of the segment, as they do for var arrays
+        for (uint32 i = count; i < segLength; i++)
+        {
+            seg->elements[i] = SparseArraySegment<int32>::GetMissingItem();
+        }
+        seg->length = count;
+
+        pArr->ClearSegmentMap();
+        pArr->SetHasNoMissingValues();
+        pArr->InvalidateLastUsedSegment();
+
+#ifdef VALIDATE_ARRAY
+        pArr->ValidateArray();
+#endif
+        return true;
     }
 
     Var JavascriptArray::EntrySort(RecyclableObject* function, CallInfo callInfo, ...)
@@ -6417,6 +6509,12 @@ Case0:
                 arr->FillFromPrototypes(0, arr->length); // We need find all missing value from [[proto]] object
             }
 
+            // Int arrays sorted by their strings don't need to leave their native representation at all
+            if (!compFn && JavascriptNativeIntArray::Is(arr) && TrySortNativeIntArrayInPlace(JavascriptNativeIntArray::FromVar(arr)))
+            {
+                return args[0];
+            }
+
             // Maintain nativity of the array only for the following cases (To favor inplace conversions - keeps the conversion cost less):
             // -    int cases for X86 and
             // -    FloatArray for AMD64
@@ -547,6 +547,10 @@ namespace Js
 
         uint32 sort(__inout_ecount(*length) Var *orig, uint32 *length, ScriptContext *scriptContext);
 
+        // Sorts the elements by their strings, as sort without a compare function does, if the array
+        // has a single segment. Returns false otherwise.
+        static bool TrySortNativeIntArrayInPlace(JavascriptNativeIntArray* pArr);
+
         BOOL GetPropertyBuiltIns(PropertyId propertyId, Var* value);
         bool GetSetterBuiltIns(PropertyId propertyId, PropertyValueInfo* info, DescriptorFlags* descriptorFlags);
     private:
@@ -555,7 +559,6 @@ namespace Js
             JavascriptString* StringValue;
         };
 
-        static int __cdecl CompareElements(void* context, const void* elem1, const void* elem2);
         void SortElements(Element* elements, uint32 left, uint32 right);
 
         template <typename Fn>
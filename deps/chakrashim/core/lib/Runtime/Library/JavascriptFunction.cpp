@@ -1512,6 +1512,12 @@ LABEL1:
 
         Assert(functionInfo);
 
+        if (!functionInfo->IsDeferredParseFunction() && functionInfo->GetFunctionBody()->IsDeferredParseFunction())
+        {
+            // The function body was redeferred after going unused; regenerate its byte code in place.
+            functionInfo = functionInfo->GetFunctionBody();
+        }
+
         if (functionInfo->IsDeferredParseFunction())
         {
             funcBody = functionInfo->Parse(functionRef);
@@ -31,9 +31,9 @@ namespace Js
         return static_cast<JavascriptMap *>(RecyclableObject::FromVar(aValue));
     }
 
-    JavascriptMap::MapDataList::Iterator JavascriptMap::GetIterator()
+    JavascriptMap::MapDataMap::Iterator JavascriptMap::GetIterator()
     {
-        return list.GetIterator();
+        return map->GetIterator();
     }
 
     Var JavascriptMap::NewInstance(RecyclableObject* function, CallInfo callInfo, ...)
@@ -340,27 +340,20 @@ namespace Js
 
     void JavascriptMap::Clear()
     {
-        list.Clear();
         map->Clear();
     }
 
     bool JavascriptMap::Delete(Var key)
     {
-        if (map->ContainsKey(key))
-        {
-            MapDataNode* node = map->Item(key);
-            list.Remove(node);
-            return map->Remove(key);
-        }
-        return false;
+        return map->Remove(key);
     }
 
     bool JavascriptMap::Get(Var key, Var* value)
     {
-        if (map->ContainsKey(key))
+        MapDataKeyValuePair* pair = map->Find(key);
+        if (pair != nullptr)
         {
-            MapDataNode* node = map->Item(key);
-            *value = node->data.Value();
+            *value = pair->Value();
             return true;
         }
         return false;
@@ -368,21 +361,17 @@ namespace Js
 
     bool JavascriptMap::Has(Var key)
     {
-        return map->ContainsKey(key);
+        return map->Find(key) != nullptr;
     }
 
     void JavascriptMap::Set(Var key, Var value)
     {
-        if (map->ContainsKey(key))
-        {
-            MapDataNode* node = map->Item(key);
-            node->data = MapDataKeyValuePair(key, value);
-        }
-        else
+        MapDataKeyValuePair pair(key, value);
+        bool added;
+        MapDataKeyValuePair* existing = map->Insert(pair, &added);
+        if (!added)
         {
-            MapDataKeyValuePair pair(key, value);
-            MapDataNode* node = list.Append(pair, GetScriptContext()->GetRecycler());
-            map->Add(key, node);
+            *existing = pair;
         }
     }
 
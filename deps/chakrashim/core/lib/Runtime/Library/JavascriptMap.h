@@ -10,15 +10,12 @@ namespace Js
     {
     public:
         typedef JsUtil::KeyValuePair<Var, Var> MapDataKeyValuePair;
-        typedef MapOrSetDataNode<MapDataKeyValuePair> MapDataNode;
-        typedef MapOrSetDataList<MapDataKeyValuePair> MapDataList;
-        typedef JsUtil::BaseDictionary<Var, MapDataNode*, Recycler, PowerOf2SizePolicy, SameValueZeroComparer> MapDataMap;
+        typedef MapOrSetDataTable<MapDataKeyValuePair> MapDataMap;
 
     private:
-        MapDataList list;
         MapDataMap* map;
 
-        DEFINE_VTABLE_CTOR_MEMBER_INIT(JavascriptMap, DynamicObject, list);
+        DEFINE_VTABLE_CTOR(JavascriptMap, DynamicObject);
         DEFINE_MARSHAL_OBJECT_TO_SCRIPT_CONTEXT(JavascriptMap);
 
     public:
@@ -36,7 +33,7 @@ namespace Js
         void Set(Var key, Var value);
         int Size();
 
-        MapDataList::Iterator GetIterator();
+        MapDataMap::Iterator GetIterator();
 
         virtual BOOL GetDiagTypeString(StringBuilder<ArenaAllocator>* stringBuilder, ScriptContext* requestContext) override;
 
@@ -913,7 +913,7 @@ namespace Js
             return string;
         }
 
-        string = scriptContext->GetLastNumberToStringRadix10(value);
+        string = scriptContext->GetCachedNumberToStringRadix10(value);
         if (string == nullptr)
         {
             char16 szBuffer[bufSize];
@@ -923,7 +923,7 @@ namespace Js
                 Js::JavascriptError::ThrowOutOfMemoryError(scriptContext);
             }
             string = JavascriptString::NewCopySz(szBuffer, scriptContext);
-            scriptContext->SetLastNumberToStringRadix10(value, string);
+            scriptContext->SetCachedNumberToStringRadix10(value, string);
         }
         return string;
     }
@@ -9,15 +9,12 @@ namespace Js
     class JavascriptSet : public DynamicObject
     {
     public:
-        typedef MapOrSetDataNode<Var> SetDataNode;
-        typedef MapOrSetDataList<Var> SetDataList;
-        typedef JsUtil::BaseDictionary<Var, SetDataNode*, Recycler, PowerOf2SizePolicy, SameValueZeroComparer> SetDataSet;
+        typedef MapOrSetDataTable<Var> SetDataSet;
 
     private:
-        SetDataList list;
         SetDataSet* set;
 
-        DEFINE_VTABLE_CTOR_MEMBER_INIT(JavascriptSet, DynamicObject, list);
+        DEFINE_VTABLE_CTOR(JavascriptSet, DynamicObject);
         DEFINE_MARSHAL_OBJECT_TO_SCRIPT_CONTEXT(JavascriptSet);
 
     public:
@@ -34,7 +31,7 @@ namespace Js
         bool Has(Var value);
         int Size();
 
-        SetDataList::Iterator GetIterator();
+        SetDataSet::Iterator GetIterator();
 
         virtual BOOL GetDiagTypeString(StringBuilder<ArenaAllocator>* stringBuilder, ScriptContext* requestContext) override;
 
@@ -337,6 +337,20 @@ namespace Js
     {
         AssertMsg( IsValidIndexValue(index), "Must specify valid character");
 
+        if (CanReadTreeInPlace(this))
+        {
+            // Read the character from its leaf, unless finding the leaf takes a long walk. Then the caller is
+            // likely reading the characters of a big tree one by one, and is better off with it flattened.
+            StringChunkIterator iterator(this, index, MaxGetItemVisitCount);
+            const char16 *chars;
+            charcount_t length;
+            if (iterator.Next(&chars, &length))
+            {
+                return chars[0];
+            }
+            Assert(iterator.IsOverVisitCount());
+        }
+
         const char16 *str = this->GetString();
         return str[index];
     }
@@ -1074,28 +1088,20 @@ case_2:
         if (position < pThis->GetLengthAsSignedInt())
         {
             const char16* searchStr = searchString->GetString();
+            if (searchLen <= MaxTreeSearchLength && CanReadTreeInPlace(pThis))
+            {
+                return IndexOfInTree(pThis, position, searchStr, searchLen);
+            }
+
             const char16* inputStr = pThis->GetString();
-            if (searchLen == 1)
+            JmpTable jmpTable;
+            if (searchLen >= MinBoyerMooreSearchLength && BuildLastCharForwardBoyerMooreTable(jmpTable, searchStr, searchLen))
             {
-                int i = position;
-                for(; i < len && inputStr[i] != *searchStr ; i++);
-                if (i < len)
-                {
-                    result = i;
-                }
+                result = IndexOfUsingJmpTable(jmpTable, inputStr, len, searchStr, searchLen, position);
             }
             else
             {
-                JmpTable jmpTable;
-                bool fAsciiJumpTable = BuildLastCharForwardBoyerMooreTable(jmpTable, searchStr, searchLen);
-                if (!fAsciiJumpTable)
-                {
-                    result = JavascriptString::strstr(pThis, searchString, false, position);
-                }
-                else
-                {
-                    result = IndexOfUsingJmpTable(jmpTable, inputStr, len, searchStr, searchLen, position);
-                }
+                result = IndexOfUsingFirstAndLastChar(inputStr, len, searchStr, searchLen, position);
             }
         }
         return result;
@@ -2513,7 +2519,6 @@ case_2:
 
         GetThisAndSearchStringArguments(args, scriptContext, _u("String.prototype.startsWith"), &pThis, &pSearch, false);
 
-        const char16* thisStr = pThis->GetString();
         int thisStrLen = pThis->GetLength();
 
         const char16* searchStr = pSearch->GetString();
@@ -2536,7 +2541,7 @@ case_2:
         if (startPosition <= thisStrLen - searchStrLen)
         {
             Assert(searchStrLen <= thisStrLen - startPosition);
-            if (wmemcmp(thisStr + startPosition, searchStr, searchStrLen) == 0)
+            if (RangeEquals(pThis, startPosition, searchStr, searchStrLen))
             {
                 return scriptContext->GetLibrary()->GetTrue();
             }
@@ -2566,7 +2571,6 @@ case_2:
 
         GetThisAndSearchStringArguments(args, scriptContext, _u("String.prototype.endsWith"), &pThis, &pSearch, false);
 
-        const char16* thisStr = pThis->GetString();
         int thisStrLen = pThis->GetLength();
 
         const char16* searchStr = pSearch->GetString();
@@ -2589,7 +2593,7 @@ case_2:
         {
             Assert(startPosition <= thisStrLen);
             Assert(searchStrLen <= thisStrLen - startPosition);
-            if (wmemcmp(thisStr + startPosition, searchStr, searchStrLen) == 0)
+            if (RangeEquals(pThis, startPosition, searchStr, searchStrLen))
             {
                 return scriptContext->GetLibrary()->GetTrue();
             }
@@ -3012,6 +3016,50 @@ case_2:
             return false;
         }
 
+        const bool readLeftInPlace = CanReadTreeInPlace(leftString);
+        const bool readRightInPlace = CanReadTreeInPlace(rightString);
+        if (readLeftInPlace || readRightInPlace)
+        {
+            // Compare the trees chunk by chunk, so that a mismatch doesn't cost flattening either of them.
+            // A tree that has been compared too often already is flattened for the next comparisons.
+            if (!readLeftInPlace)
+            {
+                leftString->GetString();
+            }
+            if (!readRightInPlace)
+            {
+                rightString->GetString();
+            }
+
+            StringChunkIterator leftIterator(leftString);
+            StringChunkIterator rightIterator(rightString);
+            const char16 *leftChars = nullptr, *rightChars = nullptr;
+            charcount_t leftLength = 0, rightLength = 0;
+            for (;;)
+            {
+                if (leftLength == 0 && !leftIterator.Next(&leftChars, &leftLength))
+                {
+                    break;
+                }
+                if (rightLength == 0 && !rightIterator.Next(&rightChars, &rightLength))
+                {
+                    break;
+                }
+
+                const charcount_t length = min(leftLength, rightLength);
+                if (leftChars != rightChars && wmemcmp(leftChars, rightChars, length) != 0)
+                {
+                    return false;
+                }
+                leftChars += length;
+                leftLength -= length;
+                rightChars += length;
+                rightLength -= length;
+            }
+            Assert(leftLength == 0 && rightLength == 0);
+            return true;
+        }
+
         if (wmemcmp(leftString->GetString(), rightString->GetString(), leftString->GetLength()) == 0)
         {
             return true;
@@ -3019,6 +3067,45 @@ case_2:
         return false;
     }
 
+    bool JavascriptString::IsUnflattenedTree(JavascriptString *str)
+    {
+        return !str->IsFinalized() && str->IsTree();
+    }
+
+    // Whether str is a tree to read without flattening it. A tree that keeps being read that way is flattened
+    // instead, as the walks would soon cost more than the copy.
+    bool JavascriptString::CanReadTreeInPlace(JavascriptString *str)
+    {
+        return IsUnflattenedTree(str) && str->GetScriptContext()->CountTreeReadInPlace(str);
+    }
+
+    // Whether the characters of str starting at start are the given ones, without flattening a tree read in place
+    bool JavascriptString::RangeEquals(JavascriptString *str, charcount_t start, const char16 *chars, charcount_t length)
+    {
+        Assert(start <= str->GetLength() && length <= str->GetLength() - start);
+
+        if (!CanReadTreeInPlace(str))
+        {
+            return wmemcmp(str->GetString() + start, chars, length) == 0;
+        }
+
+        StringChunkIterator iterator(str, start);
+        const char16 *chunk;
+        charcount_t chunkLength;
+        while (length > 0 && iterator.Next(&chunk, &chunkLength))
+        {
+            const charcount_t compareLength = min(chunkLength, length);
+            if (wmemcmp(chunk, chars, compareLength) != 0)
+            {
+                return false;
+            }
+            chars += compareLength;
+            length -= compareLength;
+        }
+        Assert(length == 0);
+        return true;
+    }
+
     //
     // LessThan implements algorithm of ES5 11.8.5 step 4
     // returns false for same string pattern
@@ -3391,6 +3478,125 @@ case_2:
         return result;
     }
 
+    // IndexOf on a concat string tree that isn't flattened. Each chunk is searched in place, and matches that
+    // span chunks are found in a window holding the end of the previous chunks and the start of the next one.
+    int JavascriptString::IndexOfInTree(JavascriptString *str, int position, const char16 *searchStr, int searchLen)
+    {
+        Assert(IsUnflattenedTree(str));
+        Assert(searchLen > 0 && searchLen <= MaxTreeSearchLength);
+
+        JmpTable jmpTable;
+        const bool fAsciiJumpTable = searchLen >= MinBoyerMooreSearchLength && BuildLastCharForwardBoyerMooreTable(jmpTable, searchStr, searchLen);
+
+        auto search = [&](const char16 *inputStr, int len) -> int
+        {
+            if (len < searchLen)
+            {
+                return -1;
+            }
+            if (fAsciiJumpTable)
+            {
+                return IndexOfUsingJmpTable(jmpTable, inputStr, len, searchStr, searchLen, 0);
+            }
+            return IndexOfUsingFirstAndLastChar(inputStr, len, searchStr, searchLen, 0);
+        };
+
+        const int overlap = searchLen - 1;
+        char16 window[2 * (MaxTreeSearchLength - 1)];
+        int windowLength = 0;
+        int chunkStart = position;
+
+        StringChunkIterator iterator(str, position);
+        const char16 *chunk;
+        charcount_t length;
+        while (iterator.Next(&chunk, &length))
+        {
+            const int chunkLength = (int)length;
+
+            if (windowLength > 0)
+            {
+                // Matches that start before this chunk come first
+                const int count = min(chunkLength, overlap);
+                js_wmemcpy_s(window + windowLength, _countof(window) - windowLength, chunk, count);
+                const int index = search(window, windowLength + count);
+                if (index != -1)
+                {
+                    return chunkStart - windowLength + index;
+                }
+            }
+
+            const int index = search(chunk, chunkLength);
+            if (index != -1)
+            {
+                return chunkStart + index;
+            }
+
+            // Keep the last overlap characters seen
+            if (chunkLength >= overlap)
+            {
+                js_wmemcpy_s(window, _countof(window), chunk + chunkLength - overlap, overlap);
+                windowLength = overlap;
+            }
+            else
+            {
+                const int keep = min(windowLength, overlap - chunkLength);
+                memmove(window, window + windowLength - keep, keep * sizeof(char16));
+                js_wmemcpy_s(window + keep, _countof(window) - keep, chunk, chunkLength);
+                windowLength = keep + chunkLength;
+            }
+            chunkStart += chunkLength;
+        }
+
+        return -1;
+    }
+
+    // Looks for the first and the last characters of searchStr at the right distance from each other, eight
+    // positions at a time, and only compares the characters in between where both match. For short search
+    // strings this beats Boyer-Moore, which can't skip far.
+    int JavascriptString::IndexOfUsingFirstAndLastChar(const char16* inputStr, int len, const char16* searchStr, int searchLen, int position)
+    {
+        Assert(searchLen > 0);
+        Assert(position >= 0 && position <= len);
+
+        const int lastOffset = searchLen - 1;
+        const char16 first = searchStr[0];
+        const char16 last = searchStr[lastOffset];
+        const int end = len - lastOffset;   // the candidate positions are below end
+        int i = position;
+
+#if defined(_M_IX86) || defined(_M_X64)
+        const __m128i firstChars = _mm_set1_epi16((short)first);
+        const __m128i lastChars = _mm_set1_epi16((short)last);
+        for (; end - i >= 8; i += 8)
+        {
+            const __m128i firstMatches = _mm_cmpeq_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(inputStr + i)), firstChars);
+            const __m128i lastMatches = _mm_cmpeq_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(inputStr + i + lastOffset)), lastChars);
+            uint mask = (uint)_mm_movemask_epi8(_mm_and_si128(firstMatches, lastMatches));
+            while (mask != 0)
+            {
+                DWORD index;
+                _BitScanForward(&index, mask);
+                const int candidate = i + (int)(index / sizeof(char16));
+                if (searchLen <= 2 || wmemcmp(inputStr + candidate + 1, searchStr + 1, searchLen - 2) == 0)
+                {
+                    return candidate;
+                }
+                mask &= ~(3u << index);
+            }
+        }
+#endif
+
+        for (; i < end; i++)
+        {
+            if (inputStr[i] == first && inputStr[i + lastOffset] == last &&
+                (searchLen <= 2 || wmemcmp(inputStr + i + 1, searchStr + 1, searchLen - 2) == 0))
+            {
+                return i;
+            }
+        }
+        return -1;
+    }
+
     int JavascriptString::LastIndexOfUsingJmpTable(JmpTable jmpTable, const char16* inputStr, int len, const char16* searchStr, int searchLen, int position)
     {
         const char16 searchFirst = searchStr[0];
@@ -3488,8 +3694,6 @@ case_2:
 
     uint JavascriptString::strstr(JavascriptString *string, JavascriptString *substring, bool useBoyerMoore, uint start)
     {
-        uint i;
-
         const char16 *stringOrig = string->GetString();
         uint stringLenOrig = string->GetLength();
         const char16 *stringSz = stringOrig + start;
@@ -3497,7 +3701,7 @@ case_2:
         uint stringLen = stringLenOrig - start;
         uint substringLen = substring->GetLength();
 
-        if (useBoyerMoore && substringLen > 2)
+        if (useBoyerMoore && substringLen >= MinBoyerMooreSearchLength)
         {
             JmpTable jmpTable;
             bool fAsciiJumpTable = BuildLastCharForwardBoyerMooreTable(jmpTable, substringSz, substringLen);
@@ -3522,16 +3726,10 @@ case_2:
             {
                 return 0;
             }
-            for (i = 0; i <= stringLen - substringLen; i++)
+            int result = IndexOfUsingFirstAndLastChar(stringSz, (int)stringLen, substringSz, (int)substringLen, 0);
+            if (result != -1)
             {
-                // Quick check for first character.
-                if (stringSz[i] == substringSz[0])
-                {
-                    if (substringLen == 1 || memcmp(stringSz+i+1, substringSz+1, (substringLen-1)*sizeof(char16)) == 0)
-                    {
-                        return i + start;
-                    }
-                }
+                return (uint)result + start;
             }
         }
 
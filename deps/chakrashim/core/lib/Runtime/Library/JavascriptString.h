@@ -62,6 +62,13 @@ namespace Js
     protected:
         static const byte MaxCopyRecursionDepth = 3;
 
+        // Limits on reading unflattened concat string trees in place
+        static const uint MaxGetItemVisitCount = 32;
+        static const int MaxTreeSearchLength = 64;
+
+        // Shorter search strings are found faster by comparing their first and last characters in bulk
+        static const int MinBoyerMooreSearchLength = 16;
+
     public:
 
         BOOL HasItemAt(charcount_t idxChar);
@@ -158,7 +165,12 @@ namespace Js
         char16* GetSzCopy();   // get a copy of the inner string without compacting the chunks
 
         static Var ToCaseCore(JavascriptString* pThis, ToCase toCase);
+        static bool IsUnflattenedTree(JavascriptString *str);
+        static bool CanReadTreeInPlace(JavascriptString *str);
+        static bool RangeEquals(JavascriptString *str, charcount_t start, const char16 *chars, charcount_t length);
+        static int IndexOfInTree(JavascriptString *str, int position, const char16 *searchStr, int searchLen);
         static int IndexOfUsingJmpTable(JmpTable jmpTable, const char16* inputStr, int len, const char16* searchStr, int searchLen, int position);
+        static int IndexOfUsingFirstAndLastChar(const char16* inputStr, int len, const char16* searchStr, int searchLen, int position);
         static int LastIndexOfUsingJmpTable(JmpTable jmpTable, const char16* inputStr, int len, const char16* searchStr, int searchLen, int position);
         static bool BuildLastCharForwardBoyerMooreTable(JmpTable jmpTable, const char16* searchStr, int searchLen);
         static bool BuildFirstCharBackwardBoyerMooreTable(JmpTable jmpTable, const char16* searchStr, int searchLen);
@@ -0,0 +1,336 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+// This is the deterministic hash table behind ES6 Map and Set. Entries are
+// appended to a dense array in insertion order, each with its hash, and an
+// open addressed array of buckets holds the indices of the entries. Deleting
+// an entry leaves a tombstone in the entry array, which the buckets still
+// point to so that probing goes on past it. Tombstones are dropped when the
+// table is rebuilt, which happens when the entry array fills up or gets
+// sparse.
+//
+// Iterators are positions in the entry array and are always valid no matter
+// what modifications are made to the table during iteration. Rebuilding or
+// clearing the table moves it to a new store and leaves the old one behind
+// with a link to the new one. The old entries are dropped, and the old
+// buckets are reused to hold the positions that were removed from them, so
+// an iterator on an old store can work out its position in the new one:
+// its old position less the removed positions before it. Stores are
+// recycler allocated, so the table doesn't need to track its iterators.
+
+namespace Js
+{
+    template <typename TData>
+    class MapOrSetDataTable
+    {
+    private:
+        struct Entry
+        {
+            TData data;
+            hash_t hash;
+        };
+
+        class Store
+        {
+        public:
+            Entry* entries;
+            uint32* buckets;
+            uint32 capacity;        // of entries; there are twice as many buckets
+            uint32 bucketShift;
+            uint32 usedCount;       // entries appended, deleted ones included
+            uint32 liveCount;
+            Store* next;            // set when the table has moved on to another store
+            uint32 removedCount;    // number of removed positions in buckets once next is set
+        };
+
+        static const uint32 MinCapacity = 4;
+        static const uint32 MaxCapacity = 1u << 30;
+        static const uint32 EmptyBucket = UINT32_MAX;
+        static const uint32 Cleared = UINT32_MAX;
+        static const uint32 NotFound = UINT32_MAX;
+
+        Store* store;
+        Recycler* recycler;
+
+    public:
+        class Iterator
+        {
+            Store* store;
+            uint32 index;
+        public:
+            Iterator() : store(nullptr), index(0) { }
+            Iterator(Store* store) : store(store), index(0) { }
+
+            bool Next()
+            {
+                if (store == nullptr)
+                {
+                    return false;
+                }
+
+                // Catch up with any rebuilds or clears made since the last step
+                while (store->next != nullptr)
+                {
+                    if (store->removedCount == Cleared)
+                    {
+                        index = 0;
+                    }
+                    else
+                    {
+                        index -= CountRemovedBefore(store, index);
+                    }
+                    store = store->next;
+                }
+
+                while (index < store->usedCount)
+                {
+                    Entry& entry = store->entries[index++];
+                    if (!IsDeleted(entry.data))
+                    {
+                        return true;
+                    }
+                }
+
+                store = nullptr;
+                return false;
+            }
+
+            TData& Current()
+            {
+                Assert(store != nullptr && index > 0);
+                return store->entries[index - 1].data;
+            }
+        };
+
+        MapOrSetDataTable(Recycler* recycler) : recycler(recycler)
+        {
+            store = NewStore(MinCapacity);
+        }
+
+        uint32 Count() const
+        {
+            return store->liveCount;
+        }
+
+        // The returned data is only valid until the next change to the table
+        TData* Find(Var key)
+        {
+            uint32 index = FindEntry(store, key, GetHashCode(key));
+            return index == NotFound ? nullptr : &store->entries[index].data;
+        }
+
+        // Appends data unless its key is already in the table. Returns the data of the
+        // key's entry either way, which is valid until the next change to the table.
+        TData* Insert(const TData& data, bool* added)
+        {
+            Var key = GetKey(data);
+            hash_t hash = GetHashCode(key);
+            uint32 index = FindEntry(store, key, hash);
+            if (index != NotFound)
+            {
+                *added = false;
+                return &store->entries[index].data;
+            }
+
+            if (store->usedCount == store->capacity)
+            {
+                uint32 newCapacity = store->capacity;
+                if (store->liveCount >= store->capacity / 2)
+                {
+                    if (newCapacity == MaxCapacity)
+                    {
+                        Js::Throw::OutOfMemory();
+                    }
+                    newCapacity *= 2;
+                }
+                Rebuild(newCapacity);
+            }
+
+            *added = true;
+            return &Append(store, data, hash)->data;
+        }
+
+        bool Remove(Var key)
+        {
+            uint32 index = FindEntry(store, key, GetHashCode(key));
+            if (index == NotFound)
+            {
+                return false;
+            }
+
+            // Leave a tombstone, and drop the references so the key and value can be collected
+            SetDeleted(store->entries[index].data);
+            store->liveCount--;
+
+            if (store->capacity > MinCapacity && store->liveCount < store->capacity / 4)
+            {
+                Rebuild(store->capacity / 2);
+            }
+            return true;
+        }
+
+        void Clear()
+        {
+            Store* oldStore = store;
+            store = NewStore(MinCapacity);
+
+            oldStore->next = store;
+            oldStore->removedCount = Cleared;
+            oldStore->entries = nullptr;
+            oldStore->buckets = nullptr;
+        }
+
+        Iterator GetIterator()
+        {
+            return Iterator(store);
+        }
+
+    private:
+        static Var GetKey(Var data)
+        {
+            return data;
+        }
+
+        static Var GetKey(const JsUtil::KeyValuePair<Var, Var>& data)
+        {
+            return data.Key();
+        }
+
+        static bool IsDeleted(const TData& data)
+        {
+            return GetKey(data) == nullptr;
+        }
+
+        static void SetDeleted(Var& data)
+        {
+            data = nullptr;
+        }
+
+        static void SetDeleted(JsUtil::KeyValuePair<Var, Var>& data)
+        {
+            data = JsUtil::KeyValuePair<Var, Var>(nullptr, nullptr);
+        }
+
+        static hash_t GetHashCode(Var key)
+        {
+            return SameValueZeroComparer<Var>::GetHashCode(key);
+        }
+
+        static uint32 GetBucket(Store* store, hash_t hash)
+        {
+            // Spread the bits of the hash, as the hashes of recycler pointers have low bits in common
+            return (uint32)(hash * 0x9E3779B1u) >> store->bucketShift;
+        }
+
+        static uint32 FindEntry(Store* store, Var key, hash_t hash)
+        {
+            const uint32 mask = store->capacity * 2 - 1;
+            for (uint32 bucket = GetBucket(store, hash); ; bucket = (bucket + 1) & mask)
+            {
+                uint32 index = store->buckets[bucket];
+                if (index == EmptyBucket)
+                {
+                    return NotFound;
+                }
+
+                Entry& entry = store->entries[index];
+                if (entry.hash == hash && !IsDeleted(entry.data) && SameValueZeroComparer<Var>::Equals(GetKey(entry.data), key))
+                {
+                    return index;
+                }
+            }
+        }
+
+        static Entry* Append(Store* store, const TData& data, hash_t hash)
+        {
+            Assert(store->usedCount < store->capacity);
+
+            // There are always empty buckets, as at most half of them are in use
+            const uint32 mask = store->capacity * 2 - 1;
+            uint32 bucket = GetBucket(store, hash);
+            while (store->buckets[bucket] != EmptyBucket)
+            {
+                bucket = (bucket + 1) & mask;
+            }
+
+            uint32 index = store->usedCount++;
+            store->buckets[bucket] = index;
+            store->liveCount++;
+
+            Entry* entry = &store->entries[index];
+            entry->data = data;
+            entry->hash = hash;
+            return entry;
+        }
+
+        // Number of the ascending removed positions of an old store that are before index
+        static uint32 CountRemovedBefore(Store* store, uint32 index)
+        {
+            uint32 lo = 0;
+            uint32 hi = store->removedCount;
+            while (lo < hi)
+            {
+                uint32 mid = lo + (hi - lo) / 2;
+                if (store->buckets[mid] < index)
+                {
+                    lo = mid + 1;
+                }
+                else
+                {
+                    hi = mid;
+                }
+            }
+            return lo;
+        }
+
+        Store* NewStore(uint32 capacity)
+        {
+            Assert(capacity >= MinCapacity && capacity <= MaxCapacity && ::Math::IsPow2((int32)capacity));
+
+            Store* newStore = RecyclerNewStructZ(recycler, Store);
+            newStore->entries = RecyclerNewArrayZ(recycler, Entry, capacity);
+            newStore->buckets = RecyclerNewArrayLeaf(recycler, uint32, capacity * 2);
+            memset(newStore->buckets, 0xFF, sizeof(uint32) * capacity * 2);
+            newStore->capacity = capacity;
+
+            uint32 bucketShift = 32;
+            for (uint32 bucketCount = capacity * 2; bucketCount > 1; bucketCount >>= 1)
+            {
+                bucketShift--;
+            }
+            newStore->bucketShift = bucketShift;
+            return newStore;
+        }
+
+        void Rebuild(uint32 newCapacity)
+        {
+            Store* oldStore = store;
+            Store* newStore = NewStore(newCapacity);
+
+            // The old buckets aren't needed for lookups anymore, so they take the removed positions,
+            // of which there are fewer than the buckets.
+            uint32 removedCount = 0;
+            for (uint32 i = 0; i < oldStore->usedCount; i++)
+            {
+                Entry& entry = oldStore->entries[i];
+                if (IsDeleted(entry.data))
+                {
+                    oldStore->buckets[removedCount++] = i;
+                }
+                else
+                {
+                    Append(newStore, entry.data, entry.hash);
+                }
+            }
+            Assert(newStore->liveCount == oldStore->liveCount);
+
+            store = newStore;
+            oldStore->next = newStore;
+            oldStore->removedCount = removedCount;
+            oldStore->entries = nullptr;
+        }
+    };
+}
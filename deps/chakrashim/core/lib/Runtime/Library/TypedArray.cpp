@@ -7,6 +7,8 @@
 // can share the same array buffer.
 //----------------------------------------------------------------------------
 #include "RuntimeLibraryPch.h"
+#include "DataStructures/MergeSort.h"
+#include "DataStructures/RadixSort.h"
 
 #define INSTANTIATE_BUILT_IN_ENTRYPOINTS(typeName) \
     template Var typeName::NewInstance(RecyclableObject* function, CallInfo callInfo, ...); \
@@ -2422,18 +2424,11 @@ namespace Js
                 JavascriptNumber::ToVarWithCheck((double)x, scriptContext),
                 JavascriptNumber::ToVarWithCheck((double)y, scriptContext));
 
-            Assert(TypedArrayBase::Is(contextArray[0]));
-            if (TypedArrayBase::IsDetachedTypedArray(contextArray[0]))
-            {
-                JavascriptError::ThrowTypeError(scriptContext, JSERR_DetachedTypedArray, _u("[TypedArray].prototype.sort"));
-            }
-
             if (TaggedInt::Is(retVal))
             {
-                return TaggedInt::ToInt32(retVal);
+                dblResult = TaggedInt::ToInt32(retVal);
             }
-
-            if (JavascriptNumber::Is_NoTaggedIntCheck(retVal))
+            else if (JavascriptNumber::Is_NoTaggedIntCheck(retVal))
             {
                 dblResult = JavascriptNumber::GetValue(retVal);
             }
@@ -2442,6 +2437,13 @@ namespace Js
                 dblResult = JavascriptConversion::ToNumber_Full(retVal, scriptContext);
             }
 
+            // Checked after the conversion, which can run script (valueOf) as well
+            Assert(TypedArrayBase::Is(contextArray[0]));
+            if (TypedArrayBase::IsDetachedTypedArray(contextArray[0]))
+            {
+                JavascriptError::ThrowTypeError(scriptContext, JSERR_DetachedTypedArray, _u("[TypedArray].prototype.sort"));
+            }
+
             if (dblResult < 0)
             {
                 return -1;
@@ -2468,6 +2470,140 @@ namespace Js
         }
     }
 
+    // Maps elements to unsigned keys that order them the way sort does without a comparison function,
+    // with -0 before +0 and NaN last, so they can be radix sorted.
+    template<typename T> struct TypedArraySortKey
+    {
+        typedef T Type;
+        static Type GetKey(T value) { return value; }
+    };
+
+    template<> struct TypedArraySortKey<int8>
+    {
+        typedef uint8 Type;
+        static Type GetKey(int8 value) { return (uint8)value ^ 0x80; }
+    };
+
+    template<> struct TypedArraySortKey<int16>
+    {
+        typedef uint16 Type;
+        static Type GetKey(int16 value) { return (uint16)value ^ 0x8000; }
+    };
+
+    template<> struct TypedArraySortKey<int32>
+    {
+        typedef uint32 Type;
+        static Type GetKey(int32 value) { return (uint32)value ^ 0x80000000; }
+    };
+
+    template<> struct TypedArraySortKey<int64>
+    {
+        typedef uint64 Type;
+        static Type GetKey(int64 value) { return (uint64)value ^ 0x8000000000000000; }
+    };
+
+    template<> struct TypedArraySortKey<bool>
+    {
+        typedef uint8 Type;
+        static Type GetKey(bool value) { return value ? 1 : 0; }
+    };
+
+    template<> struct TypedArraySortKey<char16>
+    {
+        typedef uint16 Type;
+        static Type GetKey(char16 value) { return (uint16)value; }
+    };
+
+    template<> struct TypedArraySortKey<float>
+    {
+        typedef uint32 Type;
+        static Type GetKey(float value)
+        {
+            if (NumberUtilities::IsNan(value))
+            {
+                return UINT32_MAX;
+            }
+
+            // Flip all the bits of negative numbers so larger magnitudes come first, and set the sign of the others
+            uint32 bits = NumberUtilities::ToSpecial(value);
+            return (bits & 0x80000000) ? ~bits : bits | 0x80000000;
+        }
+    };
+
+    template<> struct TypedArraySortKey<double>
+    {
+        typedef uint64 Type;
+        static Type GetKey(double value)
+        {
+            if (NumberUtilities::IsNan(value))
+            {
+                return UINT64_MAX;
+            }
+
+            uint64 bits = NumberUtilities::ToSpecial(value);
+            return (bits & 0x8000000000000000) ? ~bits : bits | 0x8000000000000000;
+        }
+    };
+
+    template<typename T> class TypedArrayElementComparer
+    {
+    public:
+        TypedArrayElementComparer(void** context) : context(context) {}
+
+        int Compare(const T& x, const T& y)
+        {
+            return TypedArrayCompareElementsHelper<T>(context, &x, &y);
+        }
+
+    private:
+        void** context;
+    };
+
+    template<typename T> void TypedArraySortElements(TypedArrayBase* typedArrayBase, RecyclableObject* compareFn, ArenaAllocator* allocator)
+    {
+        T* elements = reinterpret_cast<T*>(typedArrayBase->GetByteBuffer());
+        uint32 length = typedArrayBase->GetLength();
+        T* scratch = AnewArray(allocator, T, length);
+
+        if (compareFn == nullptr)
+        {
+            typedef TypedArraySortKey<T> SortKey;
+            JsUtil::RadixSort<T, typename SortKey::Type, SortKey>::Sort(elements, length, scratch);
+            return;
+        }
+
+        // The comparison function can detach the buffer, so sort a copy and only write it back once
+        // every call has returned.
+        T* copy = AnewArray(allocator, T, length);
+        js_memcpy_s(copy, length * sizeof(T), elements, length * sizeof(T));
+
+        void* context[] = { typedArrayBase, compareFn };
+        TypedArrayElementComparer<T> comparer(context);
+        JsUtil::MergeSort<T, TypedArrayElementComparer<T>>::Sort(copy, length, scratch, comparer);
+
+        // Script can't run between this check and the copy; the buffer is fetched again in case the
+        // elements pointer went stale while script ran.
+        if (typedArrayBase->IsDetachedBuffer())
+        {
+            JavascriptError::ThrowTypeError(typedArrayBase->GetScriptContext(), JSERR_DetachedTypedArray, _u("[TypedArray].prototype.sort"));
+        }
+        elements = reinterpret_cast<T*>(typedArrayBase->GetByteBuffer());
+        js_memcpy_s(elements, length * sizeof(T), copy, length * sizeof(T));
+    }
+
+    template void TypedArraySortElements<int8>(TypedArrayBase* typedArrayBase, RecyclableObject* compareFn, ArenaAllocator* allocator);
+    template void TypedArraySortElements<uint8>(TypedArrayBase* typedArrayBase, RecyclableObject* compareFn, ArenaAllocator* allocator);
+    template void TypedArraySortElements<int16>(TypedArrayBase* typedArrayBase, RecyclableObject* compareFn, ArenaAllocator* allocator);
+    template void TypedArraySortElements<uint16>(TypedArrayBase* typedArrayBase, RecyclableObject* compareFn, ArenaAllocator* allocator);
+    template void TypedArraySortElements<int32>(TypedArrayBase* typedArrayBase, RecyclableObject* compareFn, ArenaAllocator* allocator);
+    template void TypedArraySortElements<uint32>(TypedArrayBase* typedArrayBase, RecyclableObject* compareFn, ArenaAllocator* allocator);
+    template void TypedArraySortElements<float>(TypedArrayBase* typedArrayBase, RecyclableObject* compareFn, ArenaAllocator* allocator);
+    template void TypedArraySortElements<double>(TypedArrayBase* typedArrayBase, RecyclableObject* compareFn, ArenaAllocator* allocator);
+    template void TypedArraySortElements<int64>(TypedArrayBase* typedArrayBase, RecyclableObject* compareFn, ArenaAllocator* allocator);
+    template void TypedArraySortElements<uint64>(TypedArrayBase* typedArrayBase, RecyclableObject* compareFn, ArenaAllocator* allocator);
+    template void TypedArraySortElements<bool>(TypedArrayBase* typedArrayBase, RecyclableObject* compareFn, ArenaAllocator* allocator);
+    template void TypedArraySortElements<char16>(TypedArrayBase* typedArrayBase, RecyclableObject* compareFn, ArenaAllocator* allocator);
+
     Var TypedArrayBase::EntrySort(RecyclableObject* function, CallInfo callInfo, ...)
     {
         PROBE_STACK(function->GetScriptContext(), Js::Constants::MinStackDefault);
@@ -2511,19 +2647,11 @@ namespace Js
             compareFn = RecyclableObject::FromVar(args[1]);
         }
 
-        // Get the elements comparison function for the type of this TypedArray
-        void* elementCompare = reinterpret_cast<void*>(typedArrayBase->GetCompareElementsFunction());
-
-        Assert(elementCompare);
-
-        // Cast compare to the correct function type
-        int(__cdecl*elementCompareFunc)(void*, const void*, const void*) = (int(__cdecl*)(void*, const void*, const void*))elementCompare;
-
-        void * contextToPass[] = { typedArrayBase, compareFn };
-
-        // We can always call qsort_s with the same arguments. If user compareFn is non-null, the callback will use it to do the comparison.
-        qsort_s(typedArrayBase->GetByteBuffer(), length, typedArrayBase->GetBytesPerElement(), elementCompareFunc, contextToPass);
-
+        BEGIN_TEMP_ALLOCATOR(tempAlloc, scriptContext, _u("Runtime"))
+        {
+            typedArrayBase->SortElements(compareFn, tempAlloc);
+        }
+        END_TEMP_ALLOCATOR(tempAlloc, scriptContext);
 
         return typedArrayBase;
     }
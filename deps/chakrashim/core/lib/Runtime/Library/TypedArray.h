@@ -10,7 +10,10 @@ namespace Js
 {
     typedef Var (*PFNCreateTypedArray)(Js::ArrayBuffer* arrayBuffer, uint32 offSet, uint32 mappedLength, Js::JavascriptLibrary* javascriptLibrary);
 
+    class TypedArrayBase;
+
     template<typename T> int __cdecl TypedArrayCompareElementsHelper(void* context, const void* elem1, const void* elem2);
+    template<typename T> void TypedArraySortElements(TypedArrayBase* typedArrayBase, RecyclableObject* compareFn, ArenaAllocator* allocator);
 
     class TypedArrayBase : public ArrayBufferParent
     {
@@ -166,8 +169,8 @@ namespace Js
         static int32 ToLengthChecked(Var lengthVar, uint32 elementSize, ScriptContext* scriptContext);
         static bool ArrayIteratorPrototypeHasUserDefinedNext(ScriptContext *scriptContext);
 
-        typedef int(__cdecl* CompareElementsFunction)(void*, const void*, const void*);
-        virtual CompareElementsFunction GetCompareElementsFunction() = 0;
+        // Sorts the elements in place, with compareFn if it isn't null
+        virtual void SortElements(RecyclableObject* compareFn, ArenaAllocator* allocator) = 0;
 
         virtual Var Subarray(uint32 begin, uint32 end) = 0;
         int32 BYTES_PER_ELEMENT;
@@ -412,9 +415,9 @@ namespace Js
         }
 
     protected:
-        CompareElementsFunction GetCompareElementsFunction()
+        void SortElements(RecyclableObject* compareFn, ArenaAllocator* allocator)
         {
-            return &TypedArrayCompareElementsHelper<TypeName>;
+            TypedArraySortElements<TypeName>(this, compareFn, allocator);
         }
     };
 
@@ -458,9 +461,9 @@ namespace Js
         virtual Var  DirectGetItem(__in uint32 index) override;
 
     protected:
-        CompareElementsFunction GetCompareElementsFunction()
+        void SortElements(RecyclableObject* compareFn, ArenaAllocator* allocator)
         {
-            return &TypedArrayCompareElementsHelper<char16>;
+            TypedArraySortElements<char16>(this, compareFn, allocator);
         }
     };
 
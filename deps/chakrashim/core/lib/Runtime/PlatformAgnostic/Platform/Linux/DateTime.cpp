@@ -8,6 +8,11 @@
 #include <sys/time.h>
 #include "ChakraPlatform.h"
 
+// getenv here is the PAL's, which keeps the environment array it found at
+// startup and misses variables the host adds later, like node setting
+// process.env.TZ. The time zone code reads the live array, as tzset() does.
+extern char **environ;
+
 namespace PlatformAgnostic
 {
 namespace DateTime
@@ -134,9 +139,770 @@ namespace DateTime
         wstr[*length] = (WCHAR)0;
     }
 
+    // Days since 1970-01-01 for a proleptic Gregorian date (month 1 to 12)
+    static inline int64 DaysFromCivil(int64 year, int month, int day)
+    {
+        year -= month <= 2;
+        const int64 era = (year >= 0 ? year : year - 399) / 400;
+        const int64 yoe = year - era * 400;
+        const int64 doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+        const int64 doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + doe - 719468;
+    }
+
+    static inline int64 YearFromDays(int64 days)
+    {
+        days += 719468;
+        const int64 era = (days >= 0 ? days : days - 146096) / 146097;
+        const int64 doe = days - era * 146097;
+        const int64 yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        const int64 doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        const int64 mp = (5 * doy + 2) / 153;
+        return yoe + era * 400 + (mp >= 10);
+    }
+
+    static inline int64 FloorDiv(int64 value, int64 divisor)
+    {
+        return value / divisor - (value % divisor < 0);
+    }
+
+    // Local time zone rules for the process, read from the same TZif file (or
+    // TZ rule string) that tzset() would use. Date conversions binary-search
+    // the transition table instead of calling mktime/localtime_r, which take
+    // the libc time zone lock and re-check the zone file on every call.
+    // The table is reloaded only when the TZ variable changes or Reset is called.
+    class TimeZoneCache
+    {
+    public:
+        struct LocalTimeType
+        {
+            int32 gmtoff; // seconds east of UTC
+            bool isdst;
+            char abbr[__CC_PA_TIMEZONE_ABVR_NAME_LENGTH];
+        };
+
+        TimeZoneCache() : state(NotLoaded), tzIsSet(false), transitions(nullptr), transitionTypes(nullptr),
+            transitionCount(0), types(nullptr), typeCount(0), hasRule(false) { }
+
+        // False if the zone could not be read; callers use libc instead
+        bool GetLocalTimeType(int64 utcSeconds, LocalTimeType *type);
+        bool GetOffsetFromLocal(int64 localSeconds, int32 *gmtoff);
+        void Reset();
+
+        static TimeZoneCache Instance;
+
+    private:
+        // A transition date of a POSIX TZ rule, e.g. M3.2.0/2
+        struct RuleDate
+        {
+            enum Kind { Julian, ZeroBasedJulian, MonthWeekDay } kind;
+            int day;
+            int week;
+            int month;
+            int32 time; // seconds after local midnight
+        };
+
+        // Rule used after the last transition, from the TZif footer or TZ itself
+        struct PosixRule
+        {
+            LocalTimeType standard;
+            LocalTimeType daylight;
+            RuleDate start;
+            RuleDate end;
+            bool hasDaylight;
+        };
+
+        enum State { NotLoaded, Loaded, Unusable };
+
+        static const size_t MaxTZLength = 256;
+        static const size_t MaxZoneFileSize = 1024 * 1024;
+
+        CriticalSection cs;
+        State state;
+        bool tzIsSet;
+        char tz[MaxTZLength];
+
+        int64 *transitions;
+        uint8 *transitionTypes;
+        uint32 transitionCount;
+        LocalTimeType *types;
+        uint32 typeCount;
+        PosixRule rule;
+        bool hasRule;
+
+        bool EnsureLoaded();
+        void Clear();
+        bool Load(const char *tzValue);
+        bool LoadFile(const char *path);
+        bool ParseZoneFile(const uint8 *data, size_t size);
+        const LocalTimeType &Lookup(int64 utcSeconds) const;
+        const LocalTimeType &LookupRule(int64 utcSeconds) const;
+
+        static int64 RuleTransition(int64 year, const RuleDate &date);
+        static bool ParseRule(const char *&str, PosixRule *result);
+        static bool ParseRuleName(const char *&str, char *name);
+        static bool ParseRuleOffset(const char *&str, int32 maxHours, int32 *seconds);
+        static bool ParseRuleDate(const char *&str, RuleDate *date);
+        static bool ParseRuleNumber(const char *&str, int min, int max, int *value);
+    };
+
+    TimeZoneCache TimeZoneCache::Instance;
+
+    static const char *GetEnvironmentValue(const char *name)
+    {
+        const size_t length = strlen(name);
+        for (char **entry = environ; entry != nullptr && *entry != nullptr; entry++)
+        {
+            if (strncmp(*entry, name, length) == 0 && (*entry)[length] == '=')
+            {
+                return *entry + length + 1;
+            }
+        }
+        return nullptr;
+    }
+
+    static inline uint32 ReadBigEndian32(const uint8 *data)
+    {
+        return ((uint32)data[0] << 24) | ((uint32)data[1] << 16) | ((uint32)data[2] << 8) | data[3];
+    }
+
+    static inline uint64 ReadBigEndian64(const uint8 *data)
+    {
+        return ((uint64)ReadBigEndian32(data) << 32) | ReadBigEndian32(data + 4);
+    }
+
+    bool TimeZoneCache::GetLocalTimeType(int64 utcSeconds, LocalTimeType *type)
+    {
+        AutoCriticalSection autoCs(&cs);
+        if (!EnsureLoaded())
+        {
+            return false;
+        }
+
+        *type = Lookup(utcSeconds);
+        return true;
+    }
+
+    bool TimeZoneCache::GetOffsetFromLocal(int64 localSeconds, int32 *gmtoff)
+    {
+        AutoCriticalSection autoCs(&cs);
+        if (!EnsureLoaded())
+        {
+            return false;
+        }
+
+        // The offset in effect a day earlier is the one before any transition
+        // near this local time. Prefer it: an ambiguous local time resolves to
+        // the earlier instant, and a skipped one is read with the offset from
+        // before the transition.
+        const int32 before = Lookup(localSeconds - 86400).gmtoff;
+        const int32 after = Lookup(localSeconds - before).gmtoff;
+        if (after != before && Lookup(localSeconds - after).gmtoff == after)
+        {
+            *gmtoff = after;
+        }
+        else
+        {
+            *gmtoff = before;
+        }
+        return true;
+    }
+
+    void TimeZoneCache::Reset()
+    {
+        AutoCriticalSection autoCs(&cs);
+        Clear();
+    }
+
+    bool TimeZoneCache::EnsureLoaded()
+    {
+        const char *tzValue = GetEnvironmentValue("TZ");
+        if (state != NotLoaded)
+        {
+            const bool unchanged = tzValue == nullptr ?
+                !tzIsSet : (tzIsSet && strcmp(tzValue, tz) == 0);
+            if (unchanged)
+            {
+                return state == Loaded;
+            }
+            Clear();
+        }
+
+        tzIsSet = tzValue != nullptr;
+        if (tzIsSet)
+        {
+            const size_t length = strlen(tzValue);
+            if (length >= MaxTZLength)
+            {
+                // Too long to remember; leave it to libc
+                return false;
+            }
+            memcpy(tz, tzValue, length + 1);
+        }
+
+        state = Load(tzValue) ? Loaded : Unusable;
+        return state == Loaded;
+    }
+
+    void TimeZoneCache::Clear()
+    {
+        if (transitions != nullptr)
+        {
+            HeapDeleteArray(transitionCount, transitions);
+        }
+        if (transitionTypes != nullptr)
+        {
+            HeapDeleteArray(transitionCount, transitionTypes);
+        }
+        if (types != nullptr)
+        {
+            HeapDeleteArray(typeCount, types);
+        }
+        transitions = nullptr;
+        transitionTypes = nullptr;
+        transitionCount = 0;
+        types = nullptr;
+        typeCount = 0;
+        hasRule = false;
+        state = NotLoaded;
+    }
+
+    bool TimeZoneCache::Load(const char *tzValue)
+    {
+        if (tzValue == nullptr)
+        {
+            return LoadFile("/etc/localtime");
+        }
+
+        const char *name = tzValue;
+        if (*name == ':')
+        {
+            name++;
+        }
+        if (*name == '\0')
+        {
+            // Empty TZ means UTC
+            const char *utc = "UTC0";
+            hasRule = ParseRule(utc, &rule);
+            return hasRule;
+        }
+
+        char path[PATH_MAX];
+        if (*name == '/')
+        {
+            if (LoadFile(name))
+            {
+                return true;
+            }
+        }
+        else
+        {
+            const char *tzdir = GetEnvironmentValue("TZDIR");
+            if (tzdir == nullptr || *tzdir == '\0')
+            {
+                tzdir = "/usr/share/zoneinfo";
+            }
+            const int length = snprintf(path, sizeof(path), "%s/%s", tzdir, name);
+            if (length > 0 && length < (int)sizeof(path) && LoadFile(path))
+            {
+                return true;
+            }
+        }
+
+        // Not a zone file, so it should be a POSIX rule like "EST5EDT,M3.2.0,M11.1.0"
+        const char *current = tzValue;
+        hasRule = ParseRule(current, &rule) && *current == '\0';
+        return hasRule;
+    }
+
+    bool TimeZoneCache::LoadFile(const char *path)
+    {
+        FILE *file = fopen(path, "rb");
+        if (file == nullptr)
+        {
+            return false;
+        }
+
+        bool result = false;
+        uint8 *data = HeapNewNoThrowArray(uint8, MaxZoneFileSize);
+        if (data != nullptr)
+        {
+            const size_t size = fread(data, 1, MaxZoneFileSize, file);
+            // A file filling the whole buffer is not a zone file we know how to read
+            if (size < MaxZoneFileSize && !ferror(file))
+            {
+                result = ParseZoneFile(data, size);
+            }
+            HeapDeleteArray(MaxZoneFileSize, data);
+        }
+        fclose(file);
+
+        if (!result)
+        {
+            Clear();
+        }
+        return result;
+    }
+
+    // See RFC 8536 for the TZif format
+    bool TimeZoneCache::ParseZoneFile(const uint8 *data, size_t size)
+    {
+        const size_t headerSize = 44;
+        if (size < headerSize || memcmp(data, "TZif", 4) != 0)
+        {
+            return false;
+        }
+
+        const uint8 version = data[4];
+        size_t timeSize = 4;
+        const uint8 *header = data;
+        const uint8 *end = data + size;
+        uint32 counts[6];
+        for (int pass = 0; ; pass++)
+        {
+            for (int i = 0; i < 6; i++)
+            {
+                counts[i] = ReadBigEndian32(header + 20 + i * 4);
+            }
+            if (pass > 0 || version < '2')
+            {
+                break;
+            }
+
+            // Skip the 32-bit data block; the second header and block use 64-bit times
+            const uint64 blockSize = (uint64)counts[3] * 5 + (uint64)counts[4] * 6 + counts[5] +
+                (uint64)counts[2] * 8 + counts[1] + counts[0];
+            if (blockSize + headerSize * 2 > (uint64)(end - header))
+            {
+                return false;
+            }
+            header += headerSize + blockSize;
+            if (memcmp(header, "TZif", 4) != 0)
+            {
+                return false;
+            }
+            timeSize = 8;
+        }
+
+        const uint32 isutcCount = counts[0];
+        const uint32 isstdCount = counts[1];
+        const uint32 leapCount = counts[2];
+        const uint32 timeCount = counts[3];
+        const uint32 typeCount = counts[4];
+        const uint32 charCount = counts[5];
+
+        // Zones counting leap seconds ("right/...") are left to libc
+        if (leapCount != 0 || typeCount == 0 || typeCount > 256 || charCount == 0)
+        {
+            return false;
+        }
+
+        const uint8 *current = header + headerSize;
+        const uint64 blockSize = (uint64)timeCount * (timeSize + 1) + (uint64)typeCount * 6 + charCount +
+            isstdCount + isutcCount;
+        if (blockSize > (uint64)(end - current))
+        {
+            return false;
+        }
+
+        const uint8 *times = current;
+        const uint8 *indices = times + timeCount * timeSize;
+        const uint8 *typeData = indices + timeCount;
+        const char *chars = (const char *)(typeData + typeCount * 6);
+
+        this->types = HeapNewNoThrowArray(LocalTimeType, typeCount);
+        if (this->types == nullptr)
+        {
+            return false;
+        }
+        this->typeCount = typeCount;
+
+        for (uint32 i = 0; i < typeCount; i++)
+        {
+            const uint8 *entry = typeData + i * 6;
+            LocalTimeType &type = this->types[i];
+            type.gmtoff = (int32)ReadBigEndian32(entry);
+            type.isdst = entry[4] != 0;
+
+            const uint8 abbrIndex = entry[5];
+            if (abbrIndex >= charCount)
+            {
+                return false;
+            }
+            size_t length = strnlen(chars + abbrIndex, charCount - abbrIndex);
+            if (length >= __CC_PA_TIMEZONE_ABVR_NAME_LENGTH)
+            {
+                length = __CC_PA_TIMEZONE_ABVR_NAME_LENGTH - 1;
+            }
+            memcpy(type.abbr, chars + abbrIndex, length);
+            type.abbr[length] = '\0';
+        }
+
+        if (timeCount > 0)
+        {
+            // Whatever was allocated is freed by Clear on failure
+            this->transitionCount = timeCount;
+            this->transitions = HeapNewNoThrowArray(int64, timeCount);
+            this->transitionTypes = HeapNewNoThrowArray(uint8, timeCount);
+            if (this->transitions == nullptr || this->transitionTypes == nullptr)
+            {
+                return false;
+            }
+
+            for (uint32 i = 0; i < timeCount; i++)
+            {
+                this->transitions[i] = timeSize == 8 ?
+                    (int64)ReadBigEndian64(times + i * 8) :
+                    (int64)(int32)ReadBigEndian32(times + i * 4);
+                this->transitionTypes[i] = indices[i];
+                if (indices[i] >= typeCount || (i > 0 && this->transitions[i] <= this->transitions[i - 1]))
+                {
+                    return false;
+                }
+            }
+        }
+
+        // Version 2+ files end with the POSIX rule for times after the last transition
+        if (timeSize == 8)
+        {
+            const char *footer = (const char *)(current + blockSize);
+            const char *footerEnd = (const char *)end;
+            if (footer < footerEnd && *footer == '\n')
+            {
+                const char *ruleEnd = (const char *)memchr(footer + 1, '\n', footerEnd - footer - 1);
+                if (ruleEnd != nullptr && ruleEnd > footer + 1 && (size_t)(ruleEnd - footer) < MaxTZLength)
+                {
+                    char ruleString[MaxTZLength];
+                    memcpy(ruleString, footer + 1, ruleEnd - footer - 1);
+                    ruleString[ruleEnd - footer - 1] = '\0';
+
+                    const char *ruleCurrent = ruleString;
+                    hasRule = ParseRule(ruleCurrent, &rule) && *ruleCurrent == '\0';
+                }
+            }
+        }
+
+        return true;
+    }
+
+    const TimeZoneCache::LocalTimeType &TimeZoneCache::Lookup(int64 utcSeconds) const
+    {
+        if (transitionCount == 0)
+        {
+            return hasRule ? LookupRule(utcSeconds) : types[0];
+        }
+
+        if (utcSeconds < transitions[0])
+        {
+            // Time type 0 applies before the first transition
+            return types[0];
+        }
+
+        if (utcSeconds >= transitions[transitionCount - 1] && hasRule)
+        {
+            return LookupRule(utcSeconds);
+        }
+
+        // Last transition at or before utcSeconds
+        uint32 low = 0;
+        uint32 high = transitionCount;
+        while (high - low > 1)
+        {
+            const uint32 middle = low + (high - low) / 2;
+            if (transitions[middle] <= utcSeconds)
+            {
+                low = middle;
+            }
+            else
+            {
+                high = middle;
+            }
+        }
+        return types[transitionTypes[low]];
+    }
+
+    const TimeZoneCache::LocalTimeType &TimeZoneCache::LookupRule(int64 utcSeconds) const
+    {
+        Assert(hasRule);
+        if (!rule.hasDaylight)
+        {
+            return rule.standard;
+        }
+
+        const int64 year = YearFromDays(FloorDiv(utcSeconds + rule.standard.gmtoff, 86400));
+        // Start is given in standard time and end in daylight time
+        const int64 start = RuleTransition(year, rule.start) - rule.standard.gmtoff;
+        const int64 end = RuleTransition(year, rule.end) - rule.daylight.gmtoff;
+
+        const bool isDaylight = start < end ?
+            (utcSeconds >= start && utcSeconds < end) :
+            !(utcSeconds >= end && utcSeconds < start); // southern hemisphere
+        return isDaylight ? rule.daylight : rule.standard;
+    }
+
+    // Local seconds since the epoch at which a rule date takes effect in the given year
+    int64 TimeZoneCache::RuleTransition(int64 year, const RuleDate &date)
+    {
+        int64 day;
+        switch (date.kind)
+        {
+        case RuleDate::Julian:
+            // 1 to 365, February 29th is never counted
+            day = DaysFromCivil(year, 1, 1) + date.day - 1;
+            if (date.day >= 60 && IsLeap((int)(year % 400 + 400)))
+            {
+                day++;
+            }
+            break;
+
+        case RuleDate::ZeroBasedJulian:
+            day = DaysFromCivil(year, 1, 1) + date.day;
+            break;
+
+        default:
+        {
+            // Day of week (0 is Sunday) in week 1 to 5 of the month, 5 meaning the last one
+            const int64 first = DaysFromCivil(year, date.month, 1);
+            const int firstWeekDay = (int)((first % 7 + 11) % 7); // 1970-01-01 was a Thursday
+            day = first + (date.day - firstWeekDay + 7) % 7 + (date.week - 1) * 7;
+
+            const int64 next = date.month == 12 ?
+                DaysFromCivil(year + 1, 1, 1) : DaysFromCivil(year, date.month + 1, 1);
+            while (day >= next)
+            {
+                day -= 7;
+            }
+            break;
+        }
+        }
+
+        return day * 86400 + date.time;
+    }
+
+    // std offset [dst [offset] [,start[/time],end[/time]]], see tzset(3)
+    bool TimeZoneCache::ParseRule(const char *&str, PosixRule *result)
+    {
+        int32 offset;
+        if (!ParseRuleName(str, result->standard.abbr) || !ParseRuleOffset(str, 24, &offset))
+        {
+            return false;
+        }
+        // POSIX offsets are west of UTC
+        result->standard.gmtoff = -offset;
+        result->standard.isdst = false;
+        result->hasDaylight = false;
+
+        if (*str == '\0')
+        {
+            return true;
+        }
+
+        if (!ParseRuleName(str, result->daylight.abbr))
+        {
+            return false;
+        }
+        result->daylight.isdst = true;
+        result->daylight.gmtoff = result->standard.gmtoff + 3600;
+        if (*str != ',' && *str != '\0')
+        {
+            if (!ParseRuleOffset(str, 24, &offset))
+            {
+                return false;
+            }
+            result->daylight.gmtoff = -offset;
+        }
+
+        // Without transition dates libc falls back to the "posixrules" zone file,
+        // which is not worth emulating here
+        if (*str++ != ',' || !ParseRuleDate(str, &result->start) ||
+            *str++ != ',' || !ParseRuleDate(str, &result->end))
+        {
+            return false;
+        }
+
+        result->hasDaylight = true;
+        return true;
+    }
+
+    bool TimeZoneCache::ParseRuleName(const char *&str, char *name)
+    {
+        const char *begin = str;
+        const char *end;
+        if (*str == '<')
+        {
+            // Quoted form, e.g. <+03> or <-0330>
+            begin = ++str;
+            while (*str != '\0' && *str != '>')
+            {
+                str++;
+            }
+            if (*str != '>')
+            {
+                return false;
+            }
+            end = str++;
+        }
+        else
+        {
+            while ((*str >= 'A' && *str <= 'Z') || (*str >= 'a' && *str <= 'z'))
+            {
+                str++;
+            }
+            end = str;
+        }
+
+        const size_t length = end - begin;
+        if (length < 3 || length >= __CC_PA_TIMEZONE_ABVR_NAME_LENGTH)
+        {
+            return false;
+        }
+        memcpy(name, begin, length);
+        name[length] = '\0';
+        return true;
+    }
+
+    bool TimeZoneCache::ParseRuleOffset(const char *&str, int32 maxHours, int32 *seconds)
+    {
+        int sign = 1;
+        if (*str == '+' || *str == '-')
+        {
+            sign = *str++ == '-' ? -1 : 1;
+        }
+
+        int hours, minutes = 0, secs = 0;
+        if (!ParseRuleNumber(str, 0, maxHours, &hours))
+        {
+            return false;
+        }
+        if (*str == ':')
+        {
+            str++;
+            if (!ParseRuleNumber(str, 0, 59, &minutes))
+            {
+                return false;
+            }
+            if (*str == ':')
+            {
+                str++;
+                if (!ParseRuleNumber(str, 0, 59, &secs))
+                {
+                    return false;
+                }
+            }
+        }
+
+        *seconds = sign * (hours * 3600 + minutes * 60 + secs);
+        return true;
+    }
+
+    bool TimeZoneCache::ParseRuleDate(const char *&str, RuleDate *date)
+    {
+        if (*str == 'J')
+        {
+            str++;
+            date->kind = RuleDate::Julian;
+            if (!ParseRuleNumber(str, 1, 365, &date->day))
+            {
+                return false;
+            }
+        }
+        else if (*str == 'M')
+        {
+            str++;
+            date->kind = RuleDate::MonthWeekDay;
+            if (!ParseRuleNumber(str, 1, 12, &date->month) || *str++ != '.' ||
+                !ParseRuleNumber(str, 1, 5, &date->week) || *str++ != '.' ||
+                !ParseRuleNumber(str, 0, 6, &date->day))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            date->kind = RuleDate::ZeroBasedJulian;
+            if (!ParseRuleNumber(str, 0, 365, &date->day))
+            {
+                return false;
+            }
+        }
+
+        date->time = 2 * 3600;
+        if (*str == '/')
+        {
+            str++;
+            // Version 3 TZif footers allow -167 to 167 hours
+            return ParseRuleOffset(str, 167, &date->time);
+        }
+        return true;
+    }
+
+    bool TimeZoneCache::ParseRuleNumber(const char *&str, int min, int max, int *value)
+    {
+        if (*str < '0' || *str > '9')
+        {
+            return false;
+        }
+
+        int result = 0;
+        while (*str >= '0' && *str <= '9')
+        {
+            result = result * 10 + (*str++ - '0');
+            if (result > max)
+            {
+                return false;
+            }
+        }
+
+        if (result < min)
+        {
+            return false;
+        }
+        *value = result;
+        return true;
+    }
+
+    // Seconds since the epoch for a time value, if it is one the cache can handle
+    static inline bool SecondsFromTv(double tv, int64 *seconds)
+    {
+        // Comfortably outside the range of valid time values
+        const double limit = 1e16;
+        if (!(tv > -limit && tv < limit))
+        {
+            return false;
+        }
+        *seconds = (int64)floor(tv / DateTimeTicks_PerSecond);
+        return true;
+    }
+
+    static inline bool GetCachedLocalTimeType(double utcTime, TimeZoneCache::LocalTimeType *type)
+    {
+        int64 seconds;
+        return SecondsFromTv(utcTime, &seconds) &&
+            TimeZoneCache::Instance.GetLocalTimeType(seconds, type);
+    }
+
+    static inline bool GetCachedOffsetFromLocal(double localTime, int32 *gmtoff)
+    {
+        int64 seconds;
+        return SecondsFromTv(localTime, &seconds) &&
+            TimeZoneCache::Instance.GetOffsetFromLocal(seconds, gmtoff);
+    }
+
     const WCHAR *Utility::GetStandardName(size_t *nameLength, const DateTime::YMD *ymd)
     {
         AssertMsg(ymd != NULL, "xplat needs DateTime::YMD is defined for this call");
+
+        const double localTime = Js::DateUtilities::TvFromDate(ymd->year, ymd->mon, ymd->mday, ymd->time);
+        int32 gmtoff;
+        TimeZoneCache::LocalTimeType type;
+        if (GetCachedOffsetFromLocal(localTime, &gmtoff) &&
+            GetCachedLocalTimeType(localTime - gmtoff * DateTimeTicks_PerSecond, &type))
+        {
+            CopyTimeZoneName(data.standardName, &data.standardNameLength, type.abbr);
+            *nameLength = data.standardNameLength;
+            return data.standardName;
+        }
+
         struct tm time_tm;
         bool leap_added;
         YMD_TO_TM(ymd, &time_tm, &leap_added);
@@ -217,6 +983,15 @@ namespace DateTime
     double DaylightTimeHelper::UtcToLocal(double utcTime, int &bias,
                                           int &offset, bool &isDaylightSavings)
     {
+        TimeZoneCache::LocalTimeType type;
+        if (GetCachedLocalTimeType(utcTime, &type))
+        {
+            isDaylightSavings = type.isdst;
+            offset = type.gmtoff / 60;
+            bias = offset;
+            return utcTime + type.gmtoff * DateTimeTicks_PerSecond;
+        }
+
         YMD ymdUTC, local;
 
         Js::DateUtilities::GetYmdFromTv(utcTime, &ymdUTC);
@@ -228,6 +1003,12 @@ namespace DateTime
 
     double DaylightTimeHelper::LocalToUtc(double localTime)
     {
+        int32 gmtoff;
+        if (GetCachedOffsetFromLocal(localTime, &gmtoff))
+        {
+            return localTime - gmtoff * DateTimeTicks_PerSecond;
+        }
+
         YMD ymdLocal, utc;
 
         Js::DateUtilities::GetYmdFromTv(localTime, &ymdLocal);
@@ -235,5 +1016,10 @@ namespace DateTime
 
         return Js::DateUtilities::TvFromDate(utc.year, utc.mon, utc.mday, utc.time);
     }
+
+    void DaylightTimeHelper::ResetTimeZoneCache()
+    {
+        TimeZoneCache::Instance.Reset();
+    }
 } // namespace DateTime
 } // namespace PlatformAgnostic
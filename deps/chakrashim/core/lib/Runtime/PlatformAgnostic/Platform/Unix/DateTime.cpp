@@ -92,6 +92,11 @@ namespace DateTime
 
         return Js::DateUtilities::TvFromDate(utc.year, utc.mon, utc.mday, utc.time);
     }
+
+    void DaylightTimeHelper::ResetTimeZoneCache()
+    {
+        CFTimeZoneResetSystem();
+    }
 } // namespace DateTime
 } // namespace PlatformAgnostic
 #endif
@@ -259,5 +259,10 @@ namespace DateTime
         }
     }
 
+    void DaylightTimeHelper::ResetTimeZoneCache()
+    {
+        // Nothing cached per process; TimeZoneInfo refreshes itself by tick count
+    }
+
 } // namespace DateTime
 } // namespace PlatformAgnostic
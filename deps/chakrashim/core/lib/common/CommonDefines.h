@@ -142,6 +142,14 @@
 #error "Background page zeroing can't be turned on if freeing pages in the background is disabled"
 #endif
 
+// Recycler page segments carved out of transparent huge pages (-RecyclerHugePages).
+// Relies on the PAL's MEM_RESERVE_HUGEPAGES, which is only implemented for Linux.
+#if defined(__linux__)
+#define ENABLE_HUGE_PAGE_SEGMENTS 1
+#else
+#define ENABLE_HUGE_PAGE_SEGMENTS 0
+#endif
+
 #define BUCKETIZE_MEDIUM_ALLOCATIONS 1              // *** TODO: Won't build if disabled currently
 #define SMALLBLOCK_MEDIUM_ALLOC 1                   // *** TODO: Won't build if disabled currently
 #define LARGEHEAPBLOCK_ENCODING 1                   // Large heap block metadata encoding
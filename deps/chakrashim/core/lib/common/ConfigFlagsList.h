@@ -10,6 +10,7 @@ PHASE(All)
     PHASE(Parse)
         PHASE(RegexCompile)
         PHASE(DeferParse)
+            PHASE(Redeferral)
         PHASE(DeferEventHandlers)
         PHASE(FunctionSourceInfoParse)
         PHASE(StringTemplateParse)
@@ -373,6 +374,8 @@ PHASE(All)
 #define DEFAULT_CONFIG_Prejit               (false)
 #define DEFAULT_CONFIG_DeferNested          (true)
 #define DEFAULT_CONFIG_DeferTopLevelTillFirstCall (true)
+#define DEFAULT_CONFIG_Redeferral           (false)
+#define DEFAULT_CONFIG_RedeferralInactiveThreshold (5)
 #define DEFAULT_CONFIG_DirectCallTelemetryStats (false)
 #define DEFAULT_CONFIG_errorStackTrace      (true)
 #define DEFAULT_CONFIG_FastPathCap          (-1)        // By default, we do not have any fast path cap
@@ -461,6 +464,7 @@ PHASE(All)
 #define DEFAULT_CONFIG_RegexProfile         (false)
 #define DEFAULT_CONFIG_RegexDebug           (false)
 #define DEFAULT_CONFIG_RegexOptimize        (true)
+#define DEFAULT_CONFIG_RegexDfa             (true)
 #define DEFAULT_CONFIG_DynamicRegexMruListSize (16)
 #define DEFAULT_CONFIG_GoptCleanupThreshold  (25)
 #define DEFAULT_CONFIG_AsmGoptCleanupThreshold  (500)
@@ -1291,6 +1295,9 @@ FLAGNR(Boolean, RecyclerProtectPagesOnRescan, "Temporarily switch all pages to r
 FLAGNR(Boolean, RecyclerVerifyMark    , "verify concurrent gc", false)
 #endif
 FLAGR (Number,  LowMemoryCap          , "Memory cap indicating a low-memory process", DEFAULT_CONFIG_LowMemoryCap)
+FLAGR (Boolean, RecyclerHugePages     , "Carve recycler page segments out of 2MB regions backed by transparent huge pages (Linux only). Weakens memory protection: these segments get no guard pages, and freed or decommitted pages stay readable and writable until their whole region is released", false)
+FLAGR (Boolean, Redeferral            , "Release the byte code of functions that stay uncalled across several full collections and reparse them on their next call", DEFAULT_CONFIG_Redeferral)
+FLAGR (Number,  RedeferralInactiveThreshold, "Number of consecutive full collections a function must go uncalled before it is redeferred", DEFAULT_CONFIG_RedeferralInactiveThreshold)
 FLAGNR(Number,  NewPagesCapDuringBGSweeping, "New pages count allowed to be allocated during background sweeping", DEFAULT_CONFIG_NewPagesCapDuringBGSweeping)
 #ifdef RUNTIME_DATA_COLLECTION
 FLAGNR(String,  RuntimeDataOutputFile, "Filename to write the dynamic profile info", nullptr)
@@ -1365,6 +1372,7 @@ FLAGR (Boolean, RegexTracing          , "Trace all Regex invocations to the outp
 FLAGR (Boolean, RegexProfile          , "Collect usage statistics on all Regex invocations.", DEFAULT_CONFIG_RegexProfile)
 FLAGR (Boolean, RegexDebug            , "Trace compilation of UnifiedRegex expressions.", DEFAULT_CONFIG_RegexDebug)
 FLAGR (Boolean, RegexOptimize         , "Optimize regular expressions in the unified Regex system (default: true)", DEFAULT_CONFIG_RegexOptimize)
+FLAGR (Boolean, RegexDfa              , "Find where eligible regular expressions match with a lazily built DFA before backtracking (default: true)", DEFAULT_CONFIG_RegexDfa)
 FLAGR (Number,  DynamicRegexMruListSize, "Size of the MRU list for dynamic regexes", DEFAULT_CONFIG_DynamicRegexMruListSize)
 #endif
 
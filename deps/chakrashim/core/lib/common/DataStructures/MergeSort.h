@@ -0,0 +1,282 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+namespace JsUtil
+{
+    // Stable merge sort for comparisons that are expensive, such as calls to a script function.
+    // Like TimSort it finds the runs that are already in order (reversing descending ones), extends
+    // short runs by binary insertion and merges runs of balanced lengths. Before merging two runs the
+    // parts of them that are already in place are found by galloping, so input that is sorted or close
+    // to sorted takes about length comparisons. There is no galloping mode within a merge.
+    //
+    // comparer.Compare(a, b) returns a negative, zero or positive number. If it throws, the elements
+    // are left as a mix of their original values, so callers that can't lose elements sort a copy.
+    template <class T, class TComparer> class MergeSort
+    {
+    public:
+        // scratch must have room for length elements
+        static void Sort(T* elements, size_t length, T* scratch, TComparer& comparer)
+        {
+            if (length < 2)
+            {
+                return;
+            }
+
+            size_t runBase[MaxRunCount];
+            size_t runLength[MaxRunCount];
+            uint runCount = 0;
+            const size_t minRun = MinRunLength(length);
+
+            for (size_t start = 0; start < length; )
+            {
+                size_t run = CountRunAndMakeAscending(elements + start, length - start, comparer);
+                if (run < minRun)
+                {
+                    size_t forced = min(minRun, length - start);
+                    BinaryInsertionSort(elements + start, forced, run, comparer);
+                    run = forced;
+                }
+
+                Assert(runCount < MaxRunCount);
+                runBase[runCount] = start;
+                runLength[runCount] = run;
+                runCount++;
+                start += run;
+
+                // Keep the pending run lengths decreasing faster than the Fibonacci numbers
+                while (runCount > 1)
+                {
+                    uint i = runCount - 2;
+                    if ((i > 0 && runLength[i - 1] <= runLength[i] + runLength[i + 1]) ||
+                        (i > 1 && runLength[i - 2] <= runLength[i - 1] + runLength[i]))
+                    {
+                        if (runLength[i - 1] < runLength[i + 1])
+                        {
+                            i--;
+                        }
+                    }
+                    else if (runLength[i] > runLength[i + 1])
+                    {
+                        break;
+                    }
+                    MergeAt(elements, scratch, runBase, runLength, runCount, i, comparer);
+                }
+            }
+
+            while (runCount > 1)
+            {
+                uint i = runCount - 2;
+                if (i > 0 && runLength[i - 1] < runLength[i + 1])
+                {
+                    i--;
+                }
+                MergeAt(elements, scratch, runBase, runLength, runCount, i, comparer);
+            }
+        }
+
+    private:
+        // Enough for any length that fits in a size_t, given the run length invariant above
+        static const uint MaxRunCount = 85;
+
+        static size_t MinRunLength(size_t length)
+        {
+            size_t remainder = 0;
+            while (length >= 64)
+            {
+                remainder |= length & 1;
+                length >>= 1;
+            }
+            return length + remainder;
+        }
+
+        static size_t CountRunAndMakeAscending(T* elements, size_t length, TComparer& comparer)
+        {
+            if (length == 1)
+            {
+                return 1;
+            }
+
+            size_t runEnd = 2;
+            if (comparer.Compare(elements[1], elements[0]) < 0)
+            {
+                // Only strictly descending runs are reversed, which keeps the sort stable
+                while (runEnd < length && comparer.Compare(elements[runEnd], elements[runEnd - 1]) < 0)
+                {
+                    runEnd++;
+                }
+
+                for (size_t lo = 0, hi = runEnd - 1; lo < hi; lo++, hi--)
+                {
+                    T temp = elements[lo];
+                    elements[lo] = elements[hi];
+                    elements[hi] = temp;
+                }
+            }
+            else
+            {
+                while (runEnd < length && comparer.Compare(elements[runEnd], elements[runEnd - 1]) >= 0)
+                {
+                    runEnd++;
+                }
+            }
+            return runEnd;
+        }
+
+        // Sorts elements[0, length) given that elements[0, sortedLength) is already sorted
+        static void BinaryInsertionSort(T* elements, size_t length, size_t sortedLength, TComparer& comparer)
+        {
+            for (size_t i = sortedLength; i < length; i++)
+            {
+                T value = elements[i];
+                size_t lo = 0;
+                size_t hi = i;
+                while (lo < hi)
+                {
+                    size_t mid = lo + (hi - lo) / 2;
+                    if (comparer.Compare(value, elements[mid]) < 0)
+                    {
+                        hi = mid;
+                    }
+                    else
+                    {
+                        lo = mid + 1;
+                    }
+                }
+
+                memmove(elements + lo + 1, elements + lo, (i - lo) * sizeof(T));
+                elements[lo] = value;
+            }
+        }
+
+        // Number of elements of the sorted elements[0, length) that are not greater than key,
+        // probing from the start with growing steps before searching between the last two probes
+        static size_t GallopRight(const T& key, const T* elements, size_t length, TComparer& comparer)
+        {
+            size_t lo = 0;
+            size_t hi = length;
+            for (size_t step = 1; lo < length; step *= 2)
+            {
+                size_t probe = lo + step - 1;
+                if (probe >= length)
+                {
+                    break;
+                }
+                if (comparer.Compare(key, elements[probe]) < 0)
+                {
+                    hi = probe;
+                    break;
+                }
+                lo = probe + 1;
+            }
+
+            while (lo < hi)
+            {
+                size_t mid = lo + (hi - lo) / 2;
+                if (comparer.Compare(key, elements[mid]) < 0)
+                {
+                    hi = mid;
+                }
+                else
+                {
+                    lo = mid + 1;
+                }
+            }
+            return lo;
+        }
+
+        // Number of elements of the sorted elements[0, length) that are less than key,
+        // probing from the end with growing steps before searching between the last two probes
+        static size_t GallopLeft(const T& key, const T* elements, size_t length, TComparer& comparer)
+        {
+            size_t lo = 0;
+            size_t hi = length;
+            for (size_t step = 1; hi > 0; step *= 2)
+            {
+                if (step > hi)
+                {
+                    break;
+                }
+                size_t probe = hi - step;
+                if (comparer.Compare(elements[probe], key) < 0)
+                {
+                    lo = probe + 1;
+                    break;
+                }
+                hi = probe;
+            }
+
+            while (lo < hi)
+            {
+                size_t mid = lo + (hi - lo) / 2;
+                if (comparer.Compare(elements[mid], key) < 0)
+                {
+                    lo = mid + 1;
+                }
+                else
+                {
+                    hi = mid;
+                }
+            }
+            return lo;
+        }
+
+        // Merges runs i and i + 1 into run i
+        static void MergeAt(T* elements, T* scratch, size_t* runBase, size_t* runLength, uint& runCount, uint i, TComparer& comparer)
+        {
+            T* left = elements + runBase[i];
+            size_t leftLength = runLength[i];
+            T* right = elements + runBase[i + 1];
+            size_t rightLength = runLength[i + 1];
+
+            runLength[i] = leftLength + rightLength;
+            for (uint j = i + 1; j + 1 < runCount; j++)
+            {
+                runBase[j] = runBase[j + 1];
+                runLength[j] = runLength[j + 1];
+            }
+            runCount--;
+
+            // Elements of the left run that don't exceed the first of the right run are already in place
+            size_t inPlace = GallopRight(right[0], left, leftLength, comparer);
+            left += inPlace;
+            leftLength -= inPlace;
+            if (leftLength == 0)
+            {
+                return;
+            }
+
+            // and so are elements of the right run that aren't less than the last of the left run
+            rightLength = GallopLeft(left[leftLength - 1], right, rightLength, comparer);
+            if (rightLength == 0)
+            {
+                return;
+            }
+
+            js_memcpy_s(scratch, leftLength * sizeof(T), left, leftLength * sizeof(T));
+            const T* from = scratch;
+            const T* fromEnd = scratch + leftLength;
+            const T* rightEnd = right + rightLength;
+            T* to = left;
+            while (from < fromEnd && right < rightEnd)
+            {
+                if (comparer.Compare(*right, *from) < 0)
+                {
+                    *to++ = *right++;
+                }
+                else
+                {
+                    *to++ = *from++;
+                }
+            }
+
+            // Whatever is left of the right run is already in place
+            if (from < fromEnd)
+            {
+                js_memcpy_s(to, (fromEnd - from) * sizeof(T), from, (fromEnd - from) * sizeof(T));
+            }
+        }
+    };
+}
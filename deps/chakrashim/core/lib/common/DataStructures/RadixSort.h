@@ -0,0 +1,96 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+#pragma once
+
+namespace JsUtil
+{
+    // Stable least significant digit radix sort, one byte of the key at a time, for elements ordered
+    // by an unsigned integer key. TKeyFunc::GetKey(element) returns the element's key as a TKey.
+    // The counts for every byte are taken in a single pass up front, and the pass for a byte is
+    // skipped when all keys have the same value in it, so small values in a wide key only pay for
+    // the bytes that differ.
+    template <class T, class TKey, class TKeyFunc> class RadixSort
+    {
+    public:
+        // Short inputs are insertion sorted in place and don't touch scratch
+        static const uint32 InsertionSortThreshold = 32;
+
+        // scratch must have room for length elements
+        static void Sort(T* elements, uint32 length, T* scratch)
+        {
+            if (length <= InsertionSortThreshold)
+            {
+                InsertionSort(elements, length);
+                return;
+            }
+
+            uint32 offsets[sizeof(TKey)][256];
+            memset(offsets, 0, sizeof(offsets));
+            for (uint32 i = 0; i < length; i++)
+            {
+                TKey key = TKeyFunc::GetKey(elements[i]);
+                for (uint digit = 0; digit < sizeof(TKey); digit++)
+                {
+                    offsets[digit][(key >> (digit * 8)) & 0xFF]++;
+                }
+            }
+
+            T* from = elements;
+            T* to = scratch;
+            for (uint digit = 0; digit < sizeof(TKey); digit++)
+            {
+                const uint shift = digit * 8;
+                uint32* digitOffsets = offsets[digit];
+                if (digitOffsets[Digit(from[0], shift)] == length)
+                {
+                    continue;
+                }
+
+                uint32 offset = 0;
+                for (uint value = 0; value < 256; value++)
+                {
+                    uint32 count = digitOffsets[value];
+                    digitOffsets[value] = offset;
+                    offset += count;
+                }
+
+                for (uint32 i = 0; i < length; i++)
+                {
+                    to[digitOffsets[Digit(from[i], shift)]++] = from[i];
+                }
+
+                T* temp = from;
+                from = to;
+                to = temp;
+            }
+
+            if (from != elements)
+            {
+                js_memcpy_s(elements, length * sizeof(T), from, length * sizeof(T));
+            }
+        }
+
+    private:
+        static uint Digit(const T& element, uint shift)
+        {
+            return (uint)((TKeyFunc::GetKey(element) >> shift) & 0xFF);
+        }
+
+        static void InsertionSort(T* elements, uint32 length)
+        {
+            for (uint32 i = 1; i < length; i++)
+            {
+                T value = elements[i];
+                TKey key = TKeyFunc::GetKey(value);
+                uint32 j = i;
+                for (; j > 0 && key < TKeyFunc::GetKey(elements[j - 1]); j--)
+                {
+                    elements[j] = elements[j - 1];
+                }
+                elements[j] = value;
+            }
+        }
+    };
+}
@@ -21,6 +21,9 @@ secondaryAllocator(nullptr)
 #if defined(_M_X64_OR_ARM64) && defined(RECYCLER_WRITE_BARRIER)
 , isWriteBarrierAllowed(false)
 #endif
+#if ENABLE_HUGE_PAGE_SEGMENTS
+, hugePageRegion(nullptr)
+#endif
 {
     this->segmentPageCount = pageCount + secondaryAllocPageCount;
 }
@@ -33,7 +36,7 @@ SegmentBase<T>::~SegmentBase()
     if (this->address)
     {
         char* originalAddress = this->address - (leadingGuardPageCount * AutoSystemInfo::PageSize);
-        allocator->GetVirtualAllocator()->Free(originalAddress, GetPageCount() * AutoSystemInfo::PageSize, MEM_RELEASE);
+        ReleaseAddressSpace(originalAddress);
         allocator->ReportFree(this->segmentPageCount * AutoSystemInfo::PageSize); //Note: We reported the guard pages free when we decommitted them during segment initialization
 #if defined(_M_X64_OR_ARM64) && defined(RECYCLER_WRITE_BARRIER_BYTE)
         RecyclerWriteBarrierManager::OnSegmentFree(this->address, this->segmentPageCount);
@@ -47,6 +50,20 @@ SegmentBase<T>::~SegmentBase()
     }
 }
 
+template<typename T>
+void
+SegmentBase<T>::ReleaseAddressSpace(char * originalAddress)
+{
+#if ENABLE_HUGE_PAGE_SEGMENTS
+    if (this->hugePageRegion != nullptr)
+    {
+        HugePageSegmentPool::Instance.Free(this->hugePageRegion, originalAddress, GetPageCount() + leadingGuardPageCount + trailingGuardPageCount);
+        return;
+    }
+#endif
+    GetAllocator()->GetVirtualAllocator()->Free(originalAddress, GetPageCount() * AutoSystemInfo::PageSize, MEM_RELEASE);
+}
+
 template<typename T>
 bool SegmentBase<T>::IsInPreReservedHeapPageAllocator() const
 {
@@ -95,7 +112,17 @@ SegmentBase<T>::Initialize(DWORD allocFlags, bool excludeGuardPages)
         return false;
     }
 
-    this->address = (char *)GetAllocator()->GetVirtualAllocator()->Alloc(NULL, totalPages * AutoSystemInfo::PageSize, MEM_RESERVE | allocFlags, PAGE_READWRITE, this->IsInCustomHeapAllocator());
+#if ENABLE_HUGE_PAGE_SEGMENTS
+    if (this->allocator->useHugePageSegments && HugePageSegmentPool::CanAlloc(totalPages))
+    {
+        Assert(!addGuardPages);
+        this->address = HugePageSegmentPool::Instance.Alloc(totalPages, MEM_RESERVE | allocFlags, &this->hugePageRegion);
+    }
+    if (this->address == nullptr)
+#endif
+    {
+        this->address = (char *)GetAllocator()->GetVirtualAllocator()->Alloc(NULL, totalPages * AutoSystemInfo::PageSize, MEM_RESERVE | allocFlags, PAGE_READWRITE, this->IsInCustomHeapAllocator());
+    }
 
     if (this->address == nullptr)
     {
@@ -125,7 +152,7 @@ SegmentBase<T>::Initialize(DWORD allocFlags, bool excludeGuardPages)
 
     if (!allocator->CreateSecondaryAllocator(this, committed, &this->secondaryAllocator))
     {
-        GetAllocator()->GetVirtualAllocator()->Free(originalAddress, GetPageCount() * AutoSystemInfo::PageSize, MEM_RELEASE);
+        ReleaseAddressSpace(originalAddress);
         this->allocator->ReportFailure(GetPageCount() * AutoSystemInfo::PageSize);
         this->address = nullptr;
         return false;
@@ -133,7 +160,7 @@ SegmentBase<T>::Initialize(DWORD allocFlags, bool excludeGuardPages)
 #if defined(_M_X64_OR_ARM64) && defined(RECYCLER_WRITE_BARRIER_BYTE)
     else if (!RecyclerWriteBarrierManager::OnSegmentAlloc(this->address, this->segmentPageCount))
     {
-        GetAllocator()->GetVirtualAllocator()->Free(originalAddress, GetPageCount() * AutoSystemInfo::PageSize, MEM_RELEASE);
+        ReleaseAddressSpace(originalAddress);
         this->allocator->ReportFailure(GetPageCount() * AutoSystemInfo::PageSize);
         this->address = nullptr;
         return false;
@@ -581,6 +608,9 @@ PageAllocatorBase<T>::PageAllocatorBase(AllocationPolicyManager * policyManager,
     disableAllocationOutOfMemory(false),
     secondaryAllocPageCount(secondaryAllocPageCount),
     excludeGuardPages(excludeGuardPages),
+#if ENABLE_HUGE_PAGE_SEGMENTS
+    useHugePageSegments(false),
+#endif
     virtualAllocator(nullptr),
     type(type)
     , reservedBytes(0)
@@ -1445,7 +1475,7 @@ PageAllocatorBase<T>::ReleasePages(__in void * address, uint pageCount, __in voi
      *  Now that we've either decommitted or freed the pages in the segment,
      *  move the segment to the right segment list
      */
-    if (this->freePageCount + pageCount > maxFreePageCount)
+    if (this->freePageCount + pageCount > maxFreePageCount + this->GetHugePageFreePageSlack())
     {
         // Release a whole segment if possible to reduce the number of VirtualFree and fragmentation
         if (!ZeroPages() && !emptySegments.Empty())
@@ -1796,6 +1826,25 @@ PageAllocatorBase<T>::DecommitNow(bool all)
 
     size_t pageToDecommit = this->freePageCount - newFreePageCount;
 
+    bool decommitPartialSegments = true;
+    if (!all && this->GetHugePageFreePageSlack() != 0)
+    {
+        // Release the empty segments we can release outright. Decommitting the
+        // rest would split huge pages, so keep it free unless it is over the slack.
+        size_t wholeSegmentPages = min(pageToDecommit - pageToDecommit % maxAllocPageCount, static_cast<size_t>(emptySegments.Count()) * maxAllocPageCount);
+        if (pageToDecommit - wholeSegmentPages <= this->GetHugePageFreePageSlack())
+        {
+            if (wholeSegmentPages == 0)
+            {
+                PAGE_ALLOC_TRACE_AND_STATS_0(_u("No empty segments to decommit"));
+                return;
+            }
+            pageToDecommit = wholeSegmentPages;
+            newFreePageCount = this->freePageCount - pageToDecommit;
+            decommitPartialSegments = false;
+        }
+    }
+
     PAGE_ALLOC_TRACE_AND_STATS(_u("Decommit page count = %d"), pageToDecommit);
     PAGE_ALLOC_TRACE_AND_STATS(_u("Free page count = %d"), this->freePageCount);
     PAGE_ALLOC_TRACE_AND_STATS(_u("New free page count = %d"), newFreePageCount);
@@ -1805,6 +1854,7 @@ PageAllocatorBase<T>::DecommitNow(bool all)
 #endif
 
     // decommit from page that already has other decommitted page already
+    if (decommitPartialSegments)
     {
         typename DListBase<PageSegmentBase<T>>::EditingIterator i(&decommitSegments);
 
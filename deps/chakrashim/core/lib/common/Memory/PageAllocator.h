@@ -178,6 +178,12 @@ protected:
 #if defined(_M_X64_OR_ARM64) && defined(RECYCLER_WRITE_BARRIER)
     bool   isWriteBarrierAllowed;
 #endif
+#if ENABLE_HUGE_PAGE_SEGMENTS
+    HugePageSegmentPool::Region * hugePageRegion;
+#endif
+
+private:
+    void ReleaseAddressSpace(char * originalAddress);
 };
 
 /*
@@ -534,6 +540,18 @@ protected:
         return segment->GetAvailablePageCount() <= maxAllocPageCount;
     }
 
+    // Decommitting individual pages splits the huge pages under them, so in
+    // huge page mode up to a region's worth of pages beyond maxFreePageCount
+    // stays free before pages are decommitted one by one.
+    size_t GetHugePageFreePageSlack() const
+    {
+#if ENABLE_HUGE_PAGE_SEGMENTS
+        return useHugePageSegments ? HugePageSegmentPool::RegionPageCount : 0;
+#else
+        return 0;
+#endif
+    }
+
 #if DBG_DUMP
     virtual void DumpStats() const;
 #endif
@@ -576,6 +594,9 @@ protected:
     bool stopAllocationOnOutOfMemory;
     bool disableAllocationOutOfMemory;
     bool excludeGuardPages;
+#if ENABLE_HUGE_PAGE_SEGMENTS
+    bool useHugePageSegments;
+#endif
     AllocationPolicyManager * policyManager;
     TVirtualAlloc * virtualAllocator;
 
@@ -22,6 +22,16 @@ RecyclerPageAllocator::RecyclerPageAllocator(Recycler* recycler, AllocationPolic
         maxAllocPageCount)
 {
     this->recycler = recycler;
+
+#if ENABLE_HUGE_PAGE_SEGMENTS && !defined(JD_PRIVATE)
+    if (flagTable.RecyclerHugePages)
+    {
+        // Guard pages would be decommitted in the middle of a huge page, and
+        // their random sizes would break up the 2MB regions anyway.
+        this->useHugePageSegments = true;
+        this->excludeGuardPages = true;
+    }
+#endif
 }
 
 bool RecyclerPageAllocator::IsMemProtectMode()
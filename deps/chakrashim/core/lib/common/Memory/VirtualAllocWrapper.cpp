@@ -404,6 +404,234 @@ PreReservedVirtualAllocWrapper::Free(LPVOID lpAddress, size_t dwSize, DWORD dwFr
     }
 }
 
+#if ENABLE_HUGE_PAGE_SEGMENTS
+/*
+* class HugePageSegmentPool
+*/
+HugePageSegmentPool HugePageSegmentPool::Instance;
+
+HugePageSegmentPool::HugePageSegmentPool() :
+    retainedPageCount(0),
+    disabled(false),
+    cs(4000)
+{
+    CompileAssert(RegionPageCount * 4096 == 2 * 1024 * 1024);
+}
+
+HugePageSegmentPool::~HugePageSegmentPool()
+{
+    // Regions are released as soon as they are empty. Anything still here
+    // belongs to a recycler that outlived the pool; leave the address space
+    // to the OS rather than calling into the PAL during static destruction.
+    regions.Clear(&NoThrowNoMemProtectHeapAllocator::Instance);
+    fullRegions.Clear(&NoThrowNoMemProtectHeapAllocator::Instance);
+}
+
+/*
+*   HugePageSegmentPool::Alloc
+*   -   First fit over the regions that still have free pages, so new segments
+*       fill up partially used huge pages before another region is reserved.
+*   -   Commits the pages if MEM_COMMIT is requested, reserves them otherwise.
+*   -   Returns the region the pages came from, which Free takes back.
+*/
+char *
+HugePageSegmentPool::Alloc(size_t pageCount, DWORD allocationType, Region ** outRegion)
+{
+    Assert(AutoSystemInfo::PageSize * RegionPageCount == 2 * 1024 * 1024);
+    Assert(CanAlloc(pageCount));
+    Assert((allocationType & ~(MEM_RESERVE | MEM_COMMIT)) == 0);
+
+    *outRegion = nullptr;
+
+    AutoCriticalSection autocs(&this->cs);
+
+    if (this->disabled)
+    {
+        return nullptr;
+    }
+
+    Region * region = nullptr;
+    BVIndex index = BVInvalidIndex;
+
+    DListBase<Region>::Iterator i(&regions);
+    while (region == nullptr && i.Next())
+    {
+        Region& current = i.Data();
+        if (current.freePageCount < pageCount)
+        {
+            continue;
+        }
+
+        index = current.freePages.GetNextBit(0);
+        while (index != BVInvalidIndex && index + pageCount <= RegionPageCount)
+        {
+            if (current.freePages.TestRange(index, static_cast<uint>(pageCount)))
+            {
+                region = &current;
+                break;
+            }
+            index = current.freePages.GetNextBit(index + 1);
+        }
+    }
+
+    if (region == nullptr)
+    {
+        region = AddRegion();
+        if (region == nullptr)
+        {
+            return nullptr;
+        }
+        index = 0;
+    }
+
+    char * address = region->address + index * AutoSystemInfo::PageSize;
+    if ((allocationType & MEM_COMMIT) != 0 &&
+        VirtualAlloc(address, pageCount * AutoSystemInfo::PageSize, MEM_COMMIT, PAGE_READWRITE) == nullptr)
+    {
+        // Leave an empty region in place; the next request will reuse it.
+        return nullptr;
+    }
+
+    ZeroDirtyPages(region, index, pageCount);
+    region->freePages.ClearRange(index, static_cast<uint>(pageCount));
+    region->freePageCount -= static_cast<uint>(pageCount);
+    if (region->freePageCount == 0)
+    {
+        regions.MoveElementTo(region, &fullRegions);
+    }
+
+    *outRegion = region;
+    return address;
+}
+
+/*
+*   HugePageSegmentPool::Free
+*   -   Returns the segment's pages to their region.
+*   -   Releases the region once it is entirely free, which gives back the
+*       whole huge page. Partially used regions keep their reservation, so a
+*       segment coming and going does not keep reserving and re-aligning 2MB
+*       of address space.
+*/
+void
+HugePageSegmentPool::Free(Region * region, char * address, size_t pageCount)
+{
+    AutoCriticalSection autocs(&this->cs);
+
+    Assert(address >= region->address);
+    Assert(address + pageCount * AutoSystemInfo::PageSize <= region->address + RegionPageCount * AutoSystemInfo::PageSize);
+
+    BVIndex index = (BVIndex)((address - region->address) / AutoSystemInfo::PageSize);
+    Assert(!region->freePages.Test(index));
+
+    if (region->freePageCount == 0)
+    {
+        fullRegions.MoveElementTo(region, &regions);
+    }
+
+    region->freePages.SetRange(index, static_cast<uint>(pageCount));
+    region->freePageCount += static_cast<uint>(pageCount);
+    if (region->freePageCount == RegionPageCount)
+    {
+        this->retainedPageCount -= region->dirtyPages.Count();
+        VirtualFree(region->address, 0, MEM_RELEASE);
+        regions.RemoveElement(&NoThrowNoMemProtectHeapAllocator::Instance, region);
+    }
+    else
+    {
+        RetainFreedPages(region, address, pageCount);
+    }
+}
+
+HugePageSegmentPool::Region *
+HugePageSegmentPool::AddRegion()
+{
+    const size_t regionSize = RegionPageCount * AutoSystemInfo::PageSize;
+    char * regionAddress = (char *)VirtualAlloc(NULL, regionSize, MEM_RESERVE | MEM_RESERVE_HUGEPAGES, PAGE_READWRITE);
+    if (regionAddress == nullptr)
+    {
+        return nullptr;
+    }
+
+    if (((size_t)regionAddress & (regionSize - 1)) != 0)
+    {
+        // The reservation fell back to an ordinary one, whose pages cannot
+        // share a huge page. Leave segments to the page allocator from now on.
+        VirtualFree(regionAddress, 0, MEM_RELEASE);
+        this->disabled = true;
+        return nullptr;
+    }
+
+    Region * region = regions.PrependNode(&NoThrowNoMemProtectHeapAllocator::Instance, regionAddress);
+    if (region == nullptr)
+    {
+        VirtualFree(regionAddress, 0, MEM_RELEASE);
+    }
+    return region;
+}
+
+/*
+*   HugePageSegmentPool::RetainFreedPages
+*   -   Decommitting part of a region splits the huge page under it, so the
+*       committed pages of a freed range are kept as they are while the pool
+*       holds fewer than MaxRetainedPageCount of them.
+*   -   Past that the range is decommitted, which bounds what the pool holds
+*       on to that the page allocators no longer account for.
+*/
+void
+HugePageSegmentPool::RetainFreedPages(Region * region, char * address, size_t pageCount)
+{
+    char * const end = address + pageCount * AutoSystemInfo::PageSize;
+    size_t committedPageCount = 0;
+    MEMORY_BASIC_INFORMATION memInfo;
+
+    for (char * current = address; current < end; current += memInfo.RegionSize)
+    {
+        if (VirtualQuery(current, &memInfo, sizeof(memInfo)) == 0)
+        {
+            committedPageCount = MaxRetainedPageCount + 1;
+            break;
+        }
+        memInfo.RegionSize = min(memInfo.RegionSize, static_cast<size_t>(end - current));
+        if (memInfo.State == MEM_COMMIT)
+        {
+            committedPageCount += memInfo.RegionSize / AutoSystemInfo::PageSize;
+        }
+    }
+
+    if (this->retainedPageCount + committedPageCount > MaxRetainedPageCount)
+    {
+#pragma warning(suppress: 6250)
+        VirtualFree(address, pageCount * AutoSystemInfo::PageSize, MEM_DECOMMIT);
+        return;
+    }
+
+    for (char * current = address; current < end; current += memInfo.RegionSize)
+    {
+        VirtualQuery(current, &memInfo, sizeof(memInfo));
+        memInfo.RegionSize = min(memInfo.RegionSize, static_cast<size_t>(end - current));
+        if (memInfo.State == MEM_COMMIT)
+        {
+            BVIndex index = (BVIndex)((current - region->address) / AutoSystemInfo::PageSize);
+            region->dirtyPages.SetRange(index, (uint)(memInfo.RegionSize / AutoSystemInfo::PageSize));
+        }
+    }
+    this->retainedPageCount += static_cast<uint>(committedPageCount);
+}
+
+void
+HugePageSegmentPool::ZeroDirtyPages(Region * region, BVIndex index, size_t pageCount)
+{
+    for (BVIndex i = index; i < index + pageCount; i++)
+    {
+        if (region->dirtyPages.TestAndClear(i))
+        {
+            memset(region->address + i * AutoSystemInfo::PageSize, 0, AutoSystemInfo::PageSize);
+            this->retainedPageCount--;
+        }
+    }
+}
+#endif
+
 #if defined(ENABLE_JIT_CLAMP)
 /*
 * class AutoEnableDynamicCodeGen
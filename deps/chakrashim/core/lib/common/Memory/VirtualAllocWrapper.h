@@ -72,6 +72,58 @@ private:
 #endif
 };
 
+#if ENABLE_HUGE_PAGE_SEGMENTS
+/*
+* HugePageSegmentPool hands out segment-sized pieces of 2MB regions that are
+* reserved on a huge page boundary and advised for transparent huge pages, so
+* that many small page segments share one TLB entry instead of hundreds.
+* Pages inside a region are tracked with a bitVector; a region is released
+* only once every page in it has been returned.
+* Decommitting part of a region splits its huge page, so pages freed from a
+* region that is still in use are kept committed, up to MaxRetainedPageCount
+* pages across the pool, and zeroed when they are handed out again.
+* For the same reason nothing inside a region is ever made inaccessible:
+* segments carved from it have no guard pages, and decommitted pages stay
+* mapped read/write until the whole region is released.
+*/
+class HugePageSegmentPool
+{
+public:
+    static const uint RegionPageCount = 512;  // 2MB with 4K pages
+    static const uint MaxRetainedPageCount = RegionPageCount;
+
+    struct Region
+    {
+        Region(char * address) : address(address), freePageCount(RegionPageCount) { freePages.SetAll(); }
+
+        char *                      address;
+        uint                        freePageCount;
+        BVStatic<RegionPageCount>   freePages;
+        BVStatic<RegionPageCount>   dirtyPages;     // free pages that were not decommitted
+    };
+
+    HugePageSegmentPool();
+    ~HugePageSegmentPool();
+
+    char *      Alloc(DECLSPEC_GUARD_OVERFLOW size_t pageCount, DWORD allocationType, __out Region ** region);
+    void        Free(__in Region * region, __in char * address, size_t pageCount);
+
+    static bool CanAlloc(size_t pageCount) { return pageCount <= RegionPageCount / 2; }
+    static HugePageSegmentPool Instance;
+
+private:
+    Region *    AddRegion();
+    void        RetainFreedPages(Region * region, char * address, size_t pageCount);
+    void        ZeroDirtyPages(Region * region, BVIndex index, size_t pageCount);
+
+    DListBase<Region>   regions;        // regions with free pages
+    DListBase<Region>   fullRegions;
+    uint                retainedPageCount;
+    bool                disabled;       // the OS cannot align or map huge page regions
+    CriticalSection     cs;
+};
+#endif
+
 #if defined(ENABLE_JIT_CLAMP)
 
 class AutoEnableDynamicCodeGen
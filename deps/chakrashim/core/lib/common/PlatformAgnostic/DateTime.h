@@ -73,6 +73,10 @@ namespace DateTime
     public:
         double UtcToLocal(double utcTime, int &bias, int &offset, bool &isDaylightSavings);
         double LocalToUtc(double time);
+
+        // Drops time zone data cached for the process, so the next conversion
+        // picks up a changed time zone configuration.
+        static void ResetTimeZoneCache();
     };
 
 } // namespace DateTime
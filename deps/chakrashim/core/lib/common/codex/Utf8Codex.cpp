@@ -4,6 +4,10 @@
 //-------------------------------------------------------------------------------------------------------
 #include "Utf8Codex.h"
 
+#if defined(_M_IX86) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
 #ifndef _WIN32
 #undef _Analysis_assume_
 #define _Analysis_assume_(expr)
@@ -40,6 +44,64 @@ namespace utf8
         return (reinterpret_cast<size_t>(pb) & mAlignmentMask) == 0 || (reinterpret_cast<size_t>(pch) & mAlignmentMask) == 0;
     }
 
+    // The ascii runs of a string are converted 16 characters at a time. These stop at the first block of
+    // 16 that isn't all ascii, and return the number of characters done, which is a multiple of 16.
+
+    inline size_t DecodeAsciiBlocks(__out_ecount(count) char16 *buffer, LPCUTF8 ptr, size_t count)
+    {
+        size_t done = 0;
+#if defined(_M_IX86) || defined(_M_X64)
+        const __m128i zero = _mm_setzero_si128();
+        for (; count - done >= 16; done += 16)
+        {
+            const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr + done));
+            if (_mm_movemask_epi8(bytes) != 0)
+            {
+                break;
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(buffer + done), _mm_unpacklo_epi8(bytes, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(buffer + done + 8), _mm_unpackhi_epi8(bytes, zero));
+        }
+#endif
+        return done;
+    }
+
+    inline size_t EncodeAsciiBlocks(__out_ecount(count) LPUTF8 buffer, const char16 *source, size_t count)
+    {
+        size_t done = 0;
+#if defined(_M_IX86) || defined(_M_X64)
+        const __m128i nonAsciiBits = _mm_set1_epi16((short)0xFF80);
+        const __m128i zero = _mm_setzero_si128();
+        for (; count - done >= 16; done += 16)
+        {
+            const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + done));
+            const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i *>(source + done + 8));
+            const __m128i nonAscii = _mm_and_si128(_mm_or_si128(low, high), nonAsciiBits);
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(nonAscii, zero)) != 0xFFFF)
+            {
+                break;
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(buffer + done), _mm_packus_epi16(low, high));
+        }
+#endif
+        return done;
+    }
+
+    inline size_t SkipAsciiBlocks(LPCUTF8 ptr, size_t count)
+    {
+        size_t done = 0;
+#if defined(_M_IX86) || defined(_M_X64)
+        for (; count - done >= 16; done += 16)
+        {
+            if (_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr + done))) != 0)
+            {
+                break;
+            }
+        }
+#endif
+        return done;
+    }
+
     inline size_t EncodedBytes(char16 prefix)
     {
          CodexAssert(0 == (prefix & 0xFF00)); // prefix must really be a byte. We use char16 for as a convenience for the API.
@@ -383,6 +445,12 @@ LFourByte:
         if (!ShouldFastPath(ptr, buffer)) goto LSlowPath;
 
 LFastPath:
+        {
+            const size_t asciiCount = DecodeAsciiBlocks(buffer, ptr, cch);
+            buffer += asciiCount;
+            ptr += asciiCount;
+            cch -= asciiCount;
+        }
         while (cch >= 4)
         {
             uint32 bytes = *(uint32 *)ptr;
@@ -418,6 +486,11 @@ LSlowPath:
         if (!ShouldFastPath(p, dest)) goto LSlowPath;
 
 LFastPath:
+        {
+            const size_t asciiCount = DecodeAsciiBlocks(dest, p, pbEnd - p);
+            dest += asciiCount;
+            p += asciiCount;
+        }
         while (p + 3 < pbEnd)
         {
             unsigned bytes = *(unsigned *)p;
@@ -480,6 +553,12 @@ LSlowPath:
         if (!ShouldFastPath(dest, source)) goto LSlowPath;
 
 LFastPath:
+        {
+            const size_t asciiCount = EncodeAsciiBlocks(dest, source, cch);
+            dest += asciiCount;
+            source += asciiCount;
+            cch -= (charcount_t)asciiCount;
+        }
         while (cch >= 4)
         {
             uint32 first = ((const uint32 *)source)[0];
@@ -556,6 +635,14 @@ LSlowPath:
         // Avoid using a reinterpret_cast to start a misaligned read.
         if (!IsAligned(pchCurrent)) goto LSlowPath;
 LFastPath:
+        if (pchCurrent < pchEnd)
+        {
+            const size_t bytesLeft = pchEnd - pchCurrent;
+            const size_t asciiCount = SkipAsciiBlocks(pchCurrent, bytesLeft < i ? bytesLeft : i);
+            pchCurrent += asciiCount;
+            i -= (charcount_t)asciiCount;
+        }
+
         // Skip 4 bytes at a time.
         while (pchCurrent < pchEndMinus4 && i > 4)
         {
@@ -593,6 +680,13 @@ LSlowPath:
         if (!IsAligned(pchCurrent)) goto LSlowPath;
 
 LFastPath:
+        if (pchCurrent < pchEnd)
+        {
+            const size_t asciiCount = SkipAsciiBlocks(pchCurrent, pchEnd - pchCurrent);
+            pchCurrent += asciiCount;
+            i += (charcount_t)asciiCount;
+        }
+
         // Skip 4 bytes at a time.
         while (pchCurrent < pchEndMinus4)
         {
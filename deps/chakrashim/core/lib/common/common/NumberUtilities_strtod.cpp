@@ -1860,6 +1860,326 @@ LFail:
 }
 
 
+/***************************************************************************
+Shortest digits using Grisu3 (Florian Loitsch, "Printing Floating-Point
+Numbers Quickly and Accurately with Integers", PLDI 2010).
+
+The double and its rounding boundaries are scaled by a cached power of ten
+using 64 bit integer arithmetic, which is off by at most a few units in the
+last place. The digits are generated from the scaled upper boundary, and
+Grisu3 works out whether that error could have changed the result. It
+fails for about one double in two hundred, for which the caller falls back
+to the exact algorithms above.
+***************************************************************************/
+struct DIYFP
+{
+    uint64 m_f;
+    int m_wExp;
+
+    DIYFP() : m_f(0), m_wExp(0) { }
+    DIYFP(uint64 f, int wExp) : m_f(f), m_wExp(wExp) { }
+
+    void Normalize()
+    {
+        Assert(m_f != 0);
+        while (0 == (m_f & 0xFFC0000000000000ull))
+        {
+            m_f <<= 10;
+            m_wExp -= 10;
+        }
+        while (0 == (m_f & 0x8000000000000000ull))
+        {
+            m_f <<= 1;
+            m_wExp--;
+        }
+    }
+
+    // The upper 64 bits of the 128 bit product, rounded.
+    DIYFP Mul(const DIYFP &other) const
+    {
+        uint64 a = m_f >> 32;
+        uint64 b = m_f & 0xFFFFFFFF;
+        uint64 c = other.m_f >> 32;
+        uint64 d = other.m_f & 0xFFFFFFFF;
+        uint64 ac = a * c;
+        uint64 bc = b * c;
+        uint64 ad = a * d;
+        uint64 bd = b * d;
+        uint64 mid = (bd >> 32) + (ad & 0xFFFFFFFF) + (bc & 0xFFFFFFFF) + (1u << 31);
+        return DIYFP(ac + (ad >> 32) + (bc >> 32) + (mid >> 32), m_wExp + other.m_wExp + 64);
+    }
+};
+
+struct CACHEDPOWER
+{
+    uint64 m_f;
+    int16 m_wExp2;
+    int16 m_wExp10;
+};
+
+// Normalized 10^k, rounded to nearest, for k from -348 to 340 in steps of 8.
+static const CACHEDPOWER g_rgCachedPowers[] =
+{
+{ 0xFA8FD5A0081C0288ull, -1220, -348 },
+    { 0xBAAEE17FA23EBF76ull, -1193, -340 },
+    { 0x8B16FB203055AC76ull, -1166, -332 },
+    { 0xCF42894A5DCE35EAull, -1140, -324 },
+    { 0x9A6BB0AA55653B2Dull, -1113, -316 },
+    { 0xE61ACF033D1A45DFull, -1087, -308 },
+    { 0xAB70FE17C79AC6CAull, -1060, -300 },
+    { 0xFF77B1FCBEBCDC4Full, -1034, -292 },
+    { 0xBE5691EF416BD60Cull, -1007, -284 },
+    { 0x8DD01FAD907FFC3Cull,  -980, -276 },
+    { 0xD3515C2831559A83ull,  -954, -268 },
+    { 0x9D71AC8FADA6C9B5ull,  -927, -260 },
+    { 0xEA9C227723EE8BCBull,  -901, -252 },
+    { 0xAECC49914078536Dull,  -874, -244 },
+    { 0x823C12795DB6CE57ull,  -847, -236 },
+    { 0xC21094364DFB5637ull,  -821, -228 },
+    { 0x9096EA6F3848984Full,  -794, -220 },
+    { 0xD77485CB25823AC7ull,  -768, -212 },
+    { 0xA086CFCD97BF97F4ull,  -741, -204 },
+    { 0xEF340A98172AACE5ull,  -715, -196 },
+    { 0xB23867FB2A35B28Eull,  -688, -188 },
+    { 0x84C8D4DFD2C63F3Bull,  -661, -180 },
+    { 0xC5DD44271AD3CDBAull,  -635, -172 },
+    { 0x936B9FCEBB25C996ull,  -608, -164 },
+    { 0xDBAC6C247D62A584ull,  -582, -156 },
+    { 0xA3AB66580D5FDAF6ull,  -555, -148 },
+    { 0xF3E2F893DEC3F126ull,  -529, -140 },
+    { 0xB5B5ADA8AAFF80B8ull,  -502, -132 },
+    { 0x87625F056C7C4A8Bull,  -475, -124 },
+    { 0xC9BCFF6034C13053ull,  -449, -116 },
+    { 0x964E858C91BA2655ull,  -422, -108 },
+    { 0xDFF9772470297EBDull,  -396, -100 },
+    { 0xA6DFBD9FB8E5B88Full,  -369,  -92 },
+    { 0xF8A95FCF88747D94ull,  -343,  -84 },
+    { 0xB94470938FA89BCFull,  -316,  -76 },
+    { 0x8A08F0F8BF0F156Bull,  -289,  -68 },
+    { 0xCDB02555653131B6ull,  -263,  -60 },
+    { 0x993FE2C6D07B7FACull,  -236,  -52 },
+    { 0xE45C10C42A2B3B06ull,  -210,  -44 },
+    { 0xAA242499697392D3ull,  -183,  -36 },
+    { 0xFD87B5F28300CA0Eull,  -157,  -28 },
+    { 0xBCE5086492111AEBull,  -130,  -20 },
+    { 0x8CBCCC096F5088CCull,  -103,  -12 },
+    { 0xD1B71758E219652Cull,   -77,   -4 },
+    { 0x9C40000000000000ull,   -50,    4 },
+    { 0xE8D4A51000000000ull,   -24,   12 },
+    { 0xAD78EBC5AC620000ull,     3,   20 },
+    { 0x813F3978F8940984ull,    30,   28 },
+    { 0xC097CE7BC90715B3ull,    56,   36 },
+    { 0x8F7E32CE7BEA5C70ull,    83,   44 },
+    { 0xD5D238A4ABE98068ull,   109,   52 },
+    { 0x9F4F2726179A2245ull,   136,   60 },
+    { 0xED63A231D4C4FB27ull,   162,   68 },
+    { 0xB0DE65388CC8ADA8ull,   189,   76 },
+    { 0x83C7088E1AAB65DBull,   216,   84 },
+    { 0xC45D1DF942711D9Aull,   242,   92 },
+    { 0x924D692CA61BE758ull,   269,  100 },
+    { 0xDA01EE641A708DEAull,   295,  108 },
+    { 0xA26DA3999AEF774Aull,   322,  116 },
+    { 0xF209787BB47D6B85ull,   348,  124 },
+    { 0xB454E4A179DD1877ull,   375,  132 },
+    { 0x865B86925B9BC5C2ull,   402,  140 },
+    { 0xC83553C5C8965D3Dull,   428,  148 },
+    { 0x952AB45CFA97A0B3ull,   455,  156 },
+    { 0xDE469FBD99A05FE3ull,   481,  164 },
+    { 0xA59BC234DB398C25ull,   508,  172 },
+    { 0xF6C69A72A3989F5Cull,   534,  180 },
+    { 0xB7DCBF5354E9BECEull,   561,  188 },
+    { 0x88FCF317F22241E2ull,   588,  196 },
+    { 0xCC20CE9BD35C78A5ull,   614,  204 },
+    { 0x98165AF37B2153DFull,   641,  212 },
+    { 0xE2A0B5DC971F303Aull,   667,  220 },
+    { 0xA8D9D1535CE3B396ull,   694,  228 },
+    { 0xFB9B7CD9A4A7443Cull,   720,  236 },
+    { 0xBB764C4CA7A44410ull,   747,  244 },
+    { 0x8BAB8EEFB6409C1Aull,   774,  252 },
+    { 0xD01FEF10A657842Cull,   800,  260 },
+    { 0x9B10A4E5E9913129ull,   827,  268 },
+    { 0xE7109BFBA19C0C9Dull,   853,  276 },
+    { 0xAC2820D9623BF429ull,   880,  284 },
+    { 0x80444B5E7AA7CF85ull,   907,  292 },
+    { 0xBF21E44003ACDD2Dull,   933,  300 },
+    { 0x8E679C2F5E44FF8Full,   960,  308 },
+    { 0xD433179D9C8CB841ull,   986,  316 },
+    { 0x9E19DB92B4E31BA9ull,  1013,  324 },
+    { 0xEB96BF6EBADF77D9ull,  1039,  332 },
+    { 0xAF87023B9BF0EE6Bull,  1066,  340 },
+};
+
+static const int kwCachedPowersMinExp10 = -348;
+static const int kwCachedPowersExp10Step = 8;
+
+// The scaled values have binary exponents in this range, so their integral
+// part fits in 32 bits and ten times their fractional part fits in 64 bits.
+static const int kwGrisuMinExp2 = -60;
+static const int kwGrisuMaxExp2 = -32;
+
+static const uint32 g_rgluTens[] =
+{
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
+
+// Moves the last digit toward the double as long as that stays inside the
+// unsafe interval, and checks that the result is the closest shortest digit
+// sequence no matter where in its error bounds the scaled double really is.
+static BOOL FGrisuRoundWeed(byte *prgb, int cb, uint64 luDistHighW, uint64 luUnsafe, uint64 luRest, uint64 luTenKappa, uint64 luUnit)
+{
+    uint64 luSmallDist = luDistHighW - luUnit;
+    uint64 luBigDist = luDistHighW + luUnit;
+
+    Assert(luRest <= luUnsafe);
+    while (luRest < luSmallDist &&
+        luUnsafe - luRest >= luTenKappa &&
+        (luRest + luTenKappa < luSmallDist || luSmallDist - luRest >= luRest + luTenKappa - luSmallDist))
+    {
+        prgb[cb - 1]--;
+        luRest += luTenKappa;
+    }
+
+    if (luRest < luBigDist &&
+        luUnsafe - luRest >= luTenKappa &&
+        (luRest + luTenKappa < luBigDist || luBigDist - luRest > luRest + luTenKappa - luBigDist))
+    {
+        return FALSE;
+    }
+
+    return 2 * luUnit <= luRest && luRest <= luUnsafe - 4 * luUnit;
+}
+
+_Success_(return)
+static BOOL FDblToRgbGrisu(double dbl, _Out_writes_to_(kcbMaxRgb, (*ppbLim - prgb)) byte *prgb, int *pwExp10, byte **ppbLim)
+{
+    // Caller should take care of 0, negative and non-finite values.
+    Assert(Js::NumberUtilities::IsFinite(dbl));
+    Assert(0 < dbl);
+
+    uint64 luBits = Js::NumberUtilities::ToSpecial(dbl);
+    uint64 luMantissa = luBits & 0x000FFFFFFFFFFFFFull;
+    int wExp2 = (int)(luBits >> 52);
+    DIYFP w;
+    if (wExp2 > 0)
+    {
+        w = DIYFP(luMantissa | 0x0010000000000000ull, wExp2 - 1075);
+    }
+    else
+    {
+        w = DIYFP(luMantissa, -1074);
+    }
+
+    // The boundaries are halfway to the adjacent doubles. The lower one is
+    // closer when the mantissa is a power of two, except for the smallest normal.
+    DIYFP high((w.m_f << 1) + 1, w.m_wExp - 1);
+    high.Normalize();
+    DIYFP low;
+    if (0 == luMantissa && wExp2 > 1)
+    {
+        low = DIYFP((w.m_f << 2) - 1, w.m_wExp - 2);
+    }
+    else
+    {
+        low = DIYFP((w.m_f << 1) - 1, w.m_wExp - 1);
+    }
+    low.m_f <<= low.m_wExp - high.m_wExp;
+    low.m_wExp = high.m_wExp;
+    w.Normalize();
+    Assert(w.m_wExp == high.m_wExp);
+
+    // Pick the cached power c = 10^-k that puts the exponent of w * c in range.
+    int wMinExp2 = kwGrisuMinExp2 - (w.m_wExp + 64);
+    int k = (int)ceil((wMinExp2 + 63) * 0.30102999566398114);
+    int iPower = (k - kwCachedPowersMinExp10 - 1) / kwCachedPowersExp10Step + 1;
+    Assert(iPower >= 0 && iPower < (int)_countof(g_rgCachedPowers));
+    const CACHEDPOWER &power = g_rgCachedPowers[iPower];
+    DIYFP c(power.m_f, power.m_wExp2);
+
+    DIYFP scaledW = w.Mul(c);
+    DIYFP scaledLow = low.Mul(c);
+    DIYFP scaledHigh = high.Mul(c);
+    Assert(scaledW.m_wExp >= kwGrisuMinExp2 && scaledW.m_wExp <= kwGrisuMaxExp2);
+
+    // Widen the interval by the possible error of one unit on either side.
+    // Anything that is inside of it might round trip; anything that is inside
+    // of it when narrowed by the error instead surely does.
+    uint64 luUnit = 1;
+    uint64 luTooLow = scaledLow.m_f - luUnit;
+    uint64 luTooHigh = scaledHigh.m_f + luUnit;
+    uint64 luUnsafe = luTooHigh - luTooLow;
+
+    int cbitFraction = -scaledW.m_wExp;
+    uint64 luOne = 1ull << cbitFraction;
+    uint32 luIntegrals = (uint32)(luTooHigh >> cbitFraction);
+    uint64 luFractionals = luTooHigh & (luOne - 1);
+
+    // Find the biggest power of ten that is no more than the integral part.
+    int kappa = ((64 - cbitFraction + 1) * 1233 >> 12) + 1;
+    Assert(kappa <= (int)_countof(g_rgluTens));
+    if (kappa > 0 && luIntegrals < g_rgluTens[kappa - 1])
+    {
+        kappa--;
+    }
+
+    int ib = 0;
+    BOOL fOk;
+    for (;;)
+    {
+        if (kappa > 0)
+        {
+            uint32 luDivisor = g_rgluTens[kappa - 1];
+            prgb[ib++] = (byte)(luIntegrals / luDivisor);
+            luIntegrals %= luDivisor;
+            kappa--;
+
+            uint64 luRest = ((uint64)luIntegrals << cbitFraction) + luFractionals;
+            if (luRest < luUnsafe)
+            {
+                fOk = FGrisuRoundWeed(prgb, ib, luTooHigh - scaledW.m_f, luUnsafe, luRest, (uint64)luDivisor << cbitFraction, luUnit);
+                break;
+            }
+        }
+        else
+        {
+            luFractionals *= 10;
+            luUnit *= 10;
+            luUnsafe *= 10;
+            prgb[ib++] = (byte)(luFractionals >> cbitFraction);
+            luFractionals &= luOne - 1;
+            kappa--;
+
+            if (luFractionals < luUnsafe)
+            {
+                fOk = FGrisuRoundWeed(prgb, ib, (luTooHigh - scaledW.m_f) * luUnit, luUnsafe, luFractionals, luOne, luUnit);
+                break;
+            }
+        }
+
+        if (ib >= kcchMaxSig)
+        {
+            // Not expected, as 17 digits always suffice; leave it to the exact algorithms.
+            return FALSE;
+        }
+    }
+
+    if (!fOk)
+    {
+        return FALSE;
+    }
+
+    // The digits times 10^(kappa + k) is the double; drop any trailing zeros.
+    int wExp10 = ib + kappa - power.m_wExp10;
+    while (ib > 1 && 0 == prgb[ib - 1])
+    {
+        ib--;
+    }
+    Assert(prgb[0] != 0);
+
+    *pwExp10 = wExp10;
+    *ppbLim = &prgb[ib];
+    return TRUE;
+}
+
 static BOOL FormatDigits(_In_reads_(pbLim - pbSrc) byte *pbSrc, byte *pbLim, int wExp10, _Out_writes_(cchDst) OLECHAR *pchDst, int cchDst)
 {
     AssertArrMem(pbSrc, pbLim - pbSrc);
@@ -2431,7 +2751,8 @@ BOOL Js::NumberUtilities::FNonZeroFiniteDblToStr(double dbl, __out_ecount(cchDst
         AssertMsg(FALSE, "Failure in FDblToRgbPrecise");
 #endif //DBG
 
-    if (!FDblToRgbFast(dbl, rgb, &wExp10, &pbLim) &&
+    if (!FDblToRgbGrisu(dbl, rgb, &wExp10, &pbLim) &&
+        !FDblToRgbFast(dbl, rgb, &wExp10, &pbLim) &&
         !FDblToRgbPrecise(dbl, rgb, &wExp10, &pbLim))
     {
         AssertMsg(FALSE, "Failure in FDblToRgbPrecise");
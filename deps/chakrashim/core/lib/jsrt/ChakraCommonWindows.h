@@ -364,4 +364,41 @@
             _Outptr_result_buffer_(*stringLength) const wchar_t **stringValue,
             _Out_ size_t *stringLength);
 
+    /// <summary>
+    ///     A callback called with the characters of a string value, one chunk at a time.
+    /// </summary>
+    /// <param name="chunk">The characters of the chunk, not null terminated.</param>
+    /// <param name="length">The number of characters in the chunk.</param>
+    /// <param name="callbackState">The state passed to <c>JsStringForEachChunk</c>.</param>
+    /// <returns>Whether to go on with the next chunk.</returns>
+    typedef bool (CHAKRA_CALLBACK *JsStringChunkCallback)(_In_reads_(length) const wchar_t *chunk, _In_ size_t length, _In_opt_ void *callbackState);
+
+    /// <summary>
+    ///     Calls a callback with the characters of a string value from left to right, one
+    ///     contiguous chunk at a time.
+    /// </summary>
+    /// <remarks>
+    ///     <para>
+    ///     Unlike <c>JsStringToPointer</c>, this doesn't flatten a string that was built by
+    ///     concatenation into a single buffer, so it is cheaper for strings that are only read once.
+    ///     The chunks are only valid during the callback, which must not call into the runtime.
+    ///     </para>
+    ///     <para>
+    ///     Requires an active script context.
+    ///     </para>
+    /// </remarks>
+    /// <param name="value">The string value to read.</param>
+    /// <param name="start">The index of the first character to read.</param>
+    /// <param name="callback">The callback to call with each chunk.</param>
+    /// <param name="callbackState">User provided state that will be passed back to the callback.</param>
+    /// <returns>
+    ///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+    /// </returns>
+    CHAKRA_API
+        JsStringForEachChunk(
+            _In_ JsValueRef value,
+            _In_ size_t start,
+            _In_ JsStringChunkCallback callback,
+            _In_opt_ void *callbackState);
+
 #endif // _CHAKRACOMMONWINDOWS_H_
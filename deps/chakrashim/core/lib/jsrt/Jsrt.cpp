@@ -13,6 +13,7 @@
 #include "Common/ByteSwap.h"
 #include "Library/DataView.h"
 #include "Library/JavascriptSymbol.h"
+#include "Library/JSON.h"
 #include "Base/ThreadContextTlsEntry.h"
 #include "Codex/Utf8Helper.h"
 
@@ -1106,6 +1107,39 @@ CHAKRA_API JsStringToPointer(_In_ JsValueRef stringValue, _Outptr_result_buffer_
     });
 }
 
+#ifdef _WIN32
+CHAKRA_API JsStringForEachChunk(_In_ JsValueRef value, _In_ size_t start, _In_ JsStringChunkCallback callback, _In_opt_ void *callbackState)
+{
+    VALIDATE_JSREF(value);
+    PARAM_NOT_NULL(callback);
+
+    if (!Js::JavascriptString::Is(value))
+    {
+        return JsErrorInvalidArgument;
+    }
+
+    return GlobalAPIWrapper([&]() -> JsErrorCode {
+        Js::JavascriptString *jsString = Js::JavascriptString::FromVar(value);
+        if (start > jsString->GetLength())
+        {
+            return JsErrorInvalidArgument;
+        }
+
+        Js::StringChunkIterator iterator(jsString, (charcount_t)start);
+        const char16 *chunk;
+        charcount_t length;
+        while (iterator.Next(&chunk, &length))
+        {
+            if (!callback(chunk, length, callbackState))
+            {
+                break;
+            }
+        }
+        return JsNoError;
+    });
+}
+#endif // _WIN32
+
 CHAKRA_API JsStringToPointerUtf8Copy(_In_ JsValueRef stringValue, _Outptr_result_buffer_(*stringLength) char **stringPtr, _Out_ size_t *stringLength)
 {
     const wchar_t* wstr;
@@ -1134,6 +1168,57 @@ CHAKRA_API JsStringToPointerUtf8Copy(_In_ JsValueRef stringValue, _Outptr_result
     return err;
 }
 
+CHAKRA_API JsStringifyUtf8(_In_ JsValueRef value, _Out_ JsValueRef *result)
+{
+    return ContextAPIWrapper<true>([&] (Js::ScriptContext *scriptContext) -> JsErrorCode {
+        VALIDATE_INCOMING_REFERENCE(value, scriptContext);
+        PARAM_NOT_NULL(result);
+        *result = nullptr;
+
+        *result = JSON::StringifyToUtf8((Js::Var)value, scriptContext);
+        return JsNoError;
+    });
+}
+
+CHAKRA_API JsParseJsonUtf8(_In_reads_(length) const char *content, _In_ size_t length, _In_opt_ JsValueRef reviver, _Out_ JsValueRef *result)
+{
+    return ContextAPIWrapper<true>([&] (Js::ScriptContext *scriptContext) -> JsErrorCode {
+        PARAM_NOT_NULL(result);
+        *result = nullptr;
+
+        if (content == nullptr && length != 0)
+        {
+            return JsErrorNullArgument;
+        }
+
+        Js::RecyclableObject* reviverObject = nullptr;
+        if (reviver != JS_INVALID_REFERENCE)
+        {
+            VALIDATE_INCOMING_REFERENCE(reviver, scriptContext);
+            if (Js::JavascriptConversion::IsCallable(reviver))
+            {
+                reviverObject = Js::RecyclableObject::FromVar(reviver);
+            }
+        }
+
+        if (length > UINT_MAX)
+        {
+            return JsErrorOutOfMemory;
+        }
+
+        *result = JSON::ParseUtf8(reinterpret_cast<const utf8char_t*>(content), static_cast<uint>(length), reviverObject, scriptContext);
+        return JsNoError;
+    });
+}
+
+CHAKRA_API JsResetTimeZoneCache()
+{
+    return GlobalAPIWrapper([&]() -> JsErrorCode {
+        PlatformAgnostic::DateTime::DaylightTimeHelper::ResetTimeZoneCache();
+        return JsNoError;
+    });
+}
+
 CHAKRA_API JsConvertValueToString(_In_ JsValueRef value, _Out_ JsValueRef *result)
 {
     return ContextAPIWrapper<true>([&] (Js::ScriptContext *scriptContext) -> JsErrorCode {
@@ -2867,7 +2952,7 @@ CHAKRA_API JsSetPromiseContinuationCallback(_In_ JsPromiseContinuationCallback p
     /*allowInObjectBeforeCollectCallback*/true);
 }
 
-JsErrorCode RunScriptCore(const byte *script, size_t cb, LoadScriptFlag loadScriptFlag, JsSourceContext sourceContext, const wchar_t *sourceUrl, bool parseOnly, JsParseScriptAttributes parseAttributes, bool isSourceModule, JsValueRef *result)
+JsErrorCode RunScriptCore(const byte *script, size_t cb, LoadScriptFlag loadScriptFlag, JsSourceContext sourceContext, const wchar_t *sourceUrl, bool parseOnly, JsParseScriptAttributes parseAttributes, bool isSourceModule, JsValueRef *result, Js::ISourceHolder *sourceHolder = nullptr)
 {
     Js::JavascriptFunction *scriptFunction;
     CompileScriptException se;
@@ -2915,6 +3000,13 @@ JsErrorCode RunScriptCore(const byte *script, size_t cb, LoadScriptFlag loadScri
         {
             loadScriptFlag = (LoadScriptFlag)(loadScriptFlag | LoadScriptFlag_Module);
         }
+        if (sourceHolder != nullptr)
+        {
+            // The host owns the utf8 buffer; LoadScript keeps a source info built over the
+            // holder instead of copying the script into the recycler.
+            Assert((loadScriptFlag & LoadScriptFlag_Utf8Source) == LoadScriptFlag_Utf8Source);
+            utf8SourceInfo = Js::Utf8SourceInfo::NewWithHolder(scriptContext, sourceHolder, static_cast<int32>(cb), &si, isLibraryCode);
+        }
         scriptFunction = scriptContext->LoadScript(script, cb, &si, &se, &utf8SourceInfo, Js::Constants::GlobalCode, loadScriptFlag);
 
 #if ENABLE_TTD
@@ -3059,6 +3151,41 @@ JsErrorCode RunScriptCore(const wchar_t *script, JsSourceContext sourceContext,
     return RunScriptCore(reinterpret_cast<const byte*>(script), wcslen(script) * sizeof(wchar_t), LoadScriptFlag_None, sourceContext, sourceUrl, parseOnly, parseAttributes, isSourceModule, result);
 }
 
+template <typename TLoadCallback, typename TUnloadCallback>
+JsErrorCode RunScriptWithCallbackCore(TLoadCallback scriptLoadCallback, TUnloadCallback scriptUnloadCallback, JsSourceContext sourceContext, const char *sourceUrl, bool parseOnly, JsParseScriptAttributes parseAttributes, JsValueRef *result)
+{
+    // The holder is only referenced from this frame until RunScriptCore wraps it in a
+    // Utf8SourceInfo; the recycler scans the stack, so it stays alive in between.
+    Js::ISourceHolder *sourceHolder = nullptr;
+    LPCUTF8 script = nullptr;
+    size_t cb = 0;
+    JsErrorCode errorCode = ContextAPINoScriptWrapper([&](Js::ScriptContext *scriptContext) -> JsErrorCode {
+        PARAM_NOT_NULL(scriptLoadCallback);
+        PARAM_NOT_NULL(scriptUnloadCallback);
+
+        typedef Js::JsrtSourceHolder<TLoadCallback, TUnloadCallback> TSourceHolder;
+        sourceHolder = RecyclerNewFinalized(scriptContext->GetRecycler(), TSourceHolder, scriptLoadCallback, scriptUnloadCallback, sourceContext);
+
+        script = sourceHolder->GetSource(_u("RunScriptWithCallbackCore"));
+        cb = sourceHolder->GetByteLength(_u("RunScriptWithCallbackCore"));
+        return JsNoError;
+    });
+
+    if (errorCode != JsNoError)
+    {
+        return errorCode;
+    }
+
+    // Once the holder exists, failing below still ends in scriptUnloadCallback.
+    utf8::NarrowToWide url((LPCSTR)sourceUrl);
+    if (!url)
+    {
+        return JsErrorOutOfMemory;
+    }
+
+    return RunScriptCore(reinterpret_cast<const byte*>(script), cb, LoadScriptFlag_Utf8Source, sourceContext, url, parseOnly, parseAttributes, false /*isModule*/, result, sourceHolder);
+}
+
 #ifdef _WIN32
 CHAKRA_API JsParseScript(_In_z_ const wchar_t * script, _In_ JsSourceContext sourceContext, _In_z_ const wchar_t *sourceUrl, _Out_ JsValueRef * result)
 {
@@ -3370,6 +3497,17 @@ CHAKRA_API JsRunScriptUtf8(
     return RunScriptCore(script, sourceContext, sourceUrl, false, JsParseScriptAttributeNone, false, result);
 }
 
+CHAKRA_API JsParseScriptWithCallbackUtf8(
+    _In_ JsSerializedScriptLoadUtf8SourceCallback scriptLoadCallback,
+    _In_ JsSerializedScriptUnloadCallback scriptUnloadCallback,
+    _In_ JsSourceContext sourceContext,
+    _In_z_ const char *sourceUrl,
+    _In_ JsParseScriptAttributes parseAttributes,
+    _Out_ JsValueRef *result)
+{
+    return RunScriptWithCallbackCore(scriptLoadCallback, scriptUnloadCallback, sourceContext, sourceUrl, true, parseAttributes, result);
+}
+
 CHAKRA_API JsSerializeScriptUtf8(
     _In_z_ const char *script,
     _Out_writes_to_opt_(*bufferSize, *bufferSize) ChakraBytePtr buffer,
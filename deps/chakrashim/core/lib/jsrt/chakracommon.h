@@ -1203,6 +1203,42 @@ typedef UINT32 DWORD;
             _In_z_ const char *sourceUrl,
             _Out_opt_ JsValueRef * result);
 
+    /// <summary>
+    ///     Parses a script from a utf8 buffer owned by the host and returns a function
+    ///     representing the script.
+    /// </summary>
+    /// <remarks>
+    ///     <para>
+    ///     Requires an active script context.
+    ///     </para>
+    ///     <para>
+    ///     Unlike <c>JsParseScriptUtf8</c>, the source is not copied. scriptLoadCallback is
+    ///     called once to get the null terminated source and the runtime keeps referring to
+    ///     that buffer until all functions created from it are garbage collected. It will then
+    ///     call scriptUnloadCallback to inform the caller it is safe to release.
+    ///     </para>
+    /// </remarks>
+    /// <param name="scriptLoadCallback">Callback called to get the source code of the script.</param>
+    /// <param name="scriptUnloadCallback">Callback called when the source code is no longer needed.</param>
+    /// <param name="sourceContext">
+    ///     A cookie identifying the script that can be used by debuggable script contexts.
+    ///     This context will passed into scriptLoadCallback and scriptUnloadCallback.
+    /// </param>
+    /// <param name="sourceUrl">The location the script came from, encoded as utf8.</param>
+    /// <param name="parseAttributes">Attribute mask for parsing the script</param>
+    /// <param name="result">A function representing the script code.</param>
+    /// <returns>
+    ///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+    /// </returns>
+    CHAKRA_API
+        JsParseScriptWithCallbackUtf8(
+            _In_ JsSerializedScriptLoadUtf8SourceCallback scriptLoadCallback,
+            _In_ JsSerializedScriptUnloadCallback scriptUnloadCallback,
+            _In_ JsSourceContext sourceContext,
+            _In_z_ const char *sourceUrl,
+            _In_ JsParseScriptAttributes parseAttributes,
+            _Out_ JsValueRef *result);
+
     /// <summary>
     ///     Gets the property ID associated with the name.
     /// </summary>
@@ -1298,6 +1334,72 @@ typedef UINT32 DWORD;
             _Outptr_result_buffer_(*stringLength) char **stringValue,
             _Out_ size_t *stringLength);
 
+    /// <summary>
+    ///     Serializes a value to JSON, encoded as utf8 into a new ArrayBuffer.
+    /// </summary>
+    /// <remarks>
+    ///     <para>
+    ///     Same as calling <c>JSON.stringify(value)</c> and encoding the string, except the
+    ///     result is written into the ArrayBuffer without creating the string itself. If
+    ///     <c>JSON.stringify</c> would return undefined, result is set to undefined.
+    ///     </para>
+    ///     <para>
+    ///     Requires an active script context.
+    ///     </para>
+    /// </remarks>
+    /// <param name="value">The value to serialize.</param>
+    /// <param name="result">The new ArrayBuffer, or undefined.</param>
+    /// <returns>
+    ///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+    /// </returns>
+    CHAKRA_API
+        JsStringifyUtf8(
+            _In_ JsValueRef value,
+            _Out_ JsValueRef *result);
+
+    /// <summary>
+    ///     Parses JSON text encoded as utf8, such as the content of an ArrayBuffer.
+    /// </summary>
+    /// <remarks>
+    ///     <para>
+    ///     Same as calling <c>JSON.parse</c> on the decoded string, except the text is scanned
+    ///     as utf8 without creating that string. The content does not need to be null terminated,
+    ///     and positions in syntax errors are byte offsets.
+    ///     </para>
+    ///     <para>
+    ///     Requires an active script context.
+    ///     </para>
+    /// </remarks>
+    /// <param name="content">The JSON text, encoded as utf8.</param>
+    /// <param name="length">The length of the text in bytes.</param>
+    /// <param name="reviver">Optional function called like the reviver of <c>JSON.parse</c>; ignored if it is not callable.</param>
+    /// <param name="result">The parsed value.</param>
+    /// <returns>
+    ///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+    /// </returns>
+    CHAKRA_API
+        JsParseJsonUtf8(
+            _In_reads_(length) const char *content,
+            _In_ size_t length,
+            _In_opt_ JsValueRef reviver,
+            _Out_ JsValueRef *result);
+
+    /// <summary>
+    ///     Notifies the engine that the time zone configuration has changed.
+    /// </summary>
+    /// <remarks>
+    ///     <para>
+    ///     Time zone data is cached for the whole process and is only reloaded when the TZ
+    ///     environment variable changes. Call this after changing the system time zone in
+    ///     some other way, so later Date operations in every runtime pick up the new zone.
+    ///     </para>
+    /// </remarks>
+    /// <returns>
+    ///     The code <c>JsNoError</c> if the operation succeeded, a failure code otherwise.
+    /// </returns>
+    CHAKRA_API
+        JsResetTimeZoneCache();
+
     /// <summary>
     ///     Gets the symbol associated with the property ID.
     /// </summary>
@@ -3559,6 +3559,7 @@ SetErrorMode(
 #define MEM_TOP_DOWN                    0x100000
 #define MEM_WRITE_WATCH                 0x200000
 #define MEM_RESERVE_EXECUTABLE          0x40000000 // reserve memory using executable memory allocator
+#define MEM_RESERVE_HUGEPAGES           0x10000000 // align the reservation to a huge page and advise the OS to back it with huge pages; reserved pages stay accessible
 
 PALIMPORT
 HANDLE
@@ -27,9 +27,8 @@ extern "C"
 #endif // __cplusplus
 
 typedef struct _CMI {
-    
-    struct _CMI * pNext;        /* Link to the next entry. */
-    struct _CMI * pLast;        /* Link to the previous entry. */
+
+    CRITICAL_SECTION critsec;   /* Guards the per-page state below. */
 
     UINT_PTR   startBoundary;   /* Starting location of the region. */
     SIZE_T   memSize;         /* Size of the entire region.. */
@@ -69,6 +68,8 @@ enum VIRTUAL_CONSTANTS
     VIRTUAL_PAGE_SIZE       = 0x1000,
 #endif  // __sparc__
     VIRTUAL_PAGE_MASK       = VIRTUAL_PAGE_SIZE - 1,
+    VIRTUAL_HUGE_PAGE_SIZE  = 0x200000,
+    VIRTUAL_HUGE_PAGE_MASK  = VIRTUAL_HUGE_PAGE_SIZE - 1,
     BOUNDARY_64K    = 0xffff
 };
 
@@ -32,6 +32,7 @@ Abstract:
 
 #include <sys/types.h>
 #include <sys/mman.h>
+#include <pthread.h>
 #include <errno.h>
 #include <string.h>
 #include <unistd.h>
@@ -56,8 +57,19 @@ typedef struct FREE_BLOCK {
 } FREE_BLOCK;
 #endif  // MMAP_IGNORES_HINT
 
-// The first node in our list of allocated blocks.
-static PCMI pVirtualMemory;
+// Reserved regions, sorted by start address so that a lookup is a binary
+// search rather than a walk over every region.
+//
+// Adding or removing a region requires virtual_critsec and the write side of
+// virtual_region_lock. Looking a region up requires either one of those or
+// the read side of virtual_region_lock. Committing, decommitting, protecting
+// and querying pages of an existing region only take the read side plus the
+// region's own critsec, so they neither wait for unrelated reservations nor
+// for each other when they touch different regions.
+static PCMI *pVirtualMemory;
+static SIZE_T nVirtualMemoryCount;
+static SIZE_T nVirtualMemoryCapacity;
+static pthread_rwlock_t virtual_region_lock = PTHREAD_RWLOCK_INITIALIZER;
 
 #if MMAP_IGNORES_HINT
 // The first node in our list of freed blocks.
@@ -92,6 +104,20 @@ static int gBackingFile PAL_GLOBAL = -1;
 #define MAP_ANON MAP_ANONYMOUS
 #endif
 
+// Linux hands back zero-filled pages for private anonymous memory that was
+// discarded with MADV_DONTNEED, so pages can be committed and decommitted in
+// place with mprotect()/madvise(). Replacing them with mmap(MAP_FIXED)
+// instead splits and merges VMAs with mmap_sem held for writing.
+#if defined(__linux__) && !MMAP_DOESNOT_ALLOW_REMAP && !RESERVE_FROM_BACKING_FILE
+#define VIRTUAL_COMMIT_IN_PLACE 1
+
+// Huge page regions stay readable and writable while they are reserved.
+// Changing the protection of part of a region splits its VMA, and the kernel
+// only backs whole, uniformly mapped 2MB ranges with a huge page.
+#define VIRTUALIsHugePageRegion(pInformation) \
+    (((pInformation)->allocationType & MEM_RESERVE_HUGEPAGES) != 0)
+#endif
+
 /*++
 Function:
     ReserveVirtualMemory()
@@ -130,6 +156,8 @@ VIRTUALInitialize(bool initializeExecutableMemoryAllocator)
     InternalInitializeCriticalSection(&virtual_critsec);
 
     pVirtualMemory = NULL;
+    nVirtualMemoryCount = 0;
+    nVirtualMemoryCapacity = 0;
 
     if (initializeExecutableMemoryAllocator)
     {
@@ -149,7 +177,7 @@ extern "C"
 void VIRTUALCleanup()
 {
     PCMI pEntry;
-    PCMI pTempEntry;
+    SIZE_T i;
 #if MMAP_IGNORES_HINT
     FREE_BLOCK *pFreeBlock;
     FREE_BLOCK *pTempFreeBlock;
@@ -159,9 +187,9 @@ void VIRTUALCleanup()
     InternalEnterCriticalSection(pthrCurrent, &virtual_critsec);
 
     // Clean up the allocated memory.
-    pEntry = pVirtualMemory;
-    while ( pEntry )
+    for ( i = 0; i < nVirtualMemoryCount; i++ )
     {
+        pEntry = pVirtualMemory[ i ];
         WARN( "The memory at %d was not freed through a call to VirtualFree.\n",
               pEntry->startBoundary );
         InternalFree(pEntry->pAllocState);
@@ -169,11 +197,13 @@ void VIRTUALCleanup()
 #if MMAP_DOESNOT_ALLOW_REMAP
         InternalFree(pEntry->pDirtyPages );
 #endif
-        pTempEntry = pEntry;
-        pEntry = pEntry->pNext;
-        InternalFree(pTempEntry );
+        InternalDeleteCriticalSection(&pEntry->critsec);
+        InternalFree(pEntry );
     }
+    InternalFree(pVirtualMemory);
     pVirtualMemory = NULL;
+    nVirtualMemoryCount = 0;
+    nVirtualMemoryCapacity = 0;
     
 #if MMAP_IGNORES_HINT
     // Clean up the free list.
@@ -527,6 +557,36 @@ static BOOL VIRTUALSetDirtyPages( UINT nStatus, SIZE_T nStartingBit,
 #endif // MMAP_DOESNOT_ALLOW_REMAP
 
 
+/****
+ *
+ * VIRTUALFindRegionIndex( )
+ *
+ *          IN UINT_PTR address - The address to look for.
+ *
+ *          Returns the number of regions that start at or below address.
+ *          The caller must hold virtual_critsec or virtual_region_lock.
+ */
+static SIZE_T VIRTUALFindRegionIndex( IN UINT_PTR address )
+{
+    SIZE_T low = 0;
+    SIZE_T high = nVirtualMemoryCount;
+
+    while ( low < high )
+    {
+        SIZE_T mid = low + ( high - low ) / 2;
+
+        if ( pVirtualMemory[ mid ]->startBoundary <= address )
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    return low;
+}
+
 /****
  *
  * VIRTUALFindRegionInformation( )
@@ -534,29 +594,23 @@ static BOOL VIRTUALSetDirtyPages( UINT nStatus, SIZE_T nStartingBit,
  *          IN UINT_PTR address - The address to look for.
  *
  *          Returns the PCMI if found, NULL otherwise.
+ *          The caller must hold virtual_critsec or virtual_region_lock.
  */
 static PCMI VIRTUALFindRegionInformation( IN UINT_PTR address ) 
 {
     PCMI pEntry = NULL;
+    SIZE_T index;
     
     TRACE( "VIRTUALFindRegionInformation( %#x )\n", address );
 
-    pEntry = pVirtualMemory;
-    
-    while( pEntry )
+    index = VIRTUALFindRegionIndex( address );
+    if ( index > 0 )
     {
-        if ( pEntry->startBoundary > address )
+        pEntry = pVirtualMemory[ index - 1 ];
+        if ( pEntry->startBoundary + pEntry->memSize <= address )
         {
-            /* Gone past the possible location in the list. */
             pEntry = NULL;
-            break;
         }
-        if ( pEntry->startBoundary + pEntry->memSize > address ) 
-        {
-            break;
-        }
-        
-        pEntry = pEntry->pNext;
     }
     return pEntry;
 }
@@ -571,11 +625,10 @@ Function :
 BOOL VIRTUALOwnedRegion( IN UINT_PTR address )
 {
     PCMI pEntry = NULL;
-    CPalThread * pthrCurrent = InternalGetCurrentThread();
     
-    InternalEnterCriticalSection(pthrCurrent, &virtual_critsec);
+    pthread_rwlock_rdlock(&virtual_region_lock);
     pEntry = VIRTUALFindRegionInformation( address );
-    InternalLeaveCriticalSection(pthrCurrent, &virtual_critsec);
+    pthread_rwlock_unlock(&virtual_region_lock);
 
     return pEntry != NULL;
 }
@@ -585,13 +638,15 @@ Function :
 
     VIRTUALReleaseMemory
     
-    Removes a PCMI entry from the list.
+    Removes a PCMI entry from the region map.
+    NOTE: The caller must own virtual_critsec.
     
     Returns true on success. FALSE otherwise.
 --*/
 static BOOL VIRTUALReleaseMemory( PCMI pMemoryToBeReleased )
 {
     BOOL bRetVal = TRUE;
+    SIZE_T index;
     
     if ( !pMemoryToBeReleased )
     {
@@ -599,29 +654,22 @@ static BOOL VIRTUALReleaseMemory( PCMI pMemoryToBeReleased )
         return FALSE;
     }
 
-    if ( pMemoryToBeReleased == pVirtualMemory )
-    {
-        /* This is either the first entry, or the only entry. */
-        pVirtualMemory = pMemoryToBeReleased->pNext;
-        if ( pMemoryToBeReleased->pNext )
-        {
-            pMemoryToBeReleased->pNext->pLast = NULL;
-        }
-    }
-    else /* Could be anywhere in the list. */
+    pthread_rwlock_wrlock(&virtual_region_lock);
+
+    index = VIRTUALFindRegionIndex( pMemoryToBeReleased->startBoundary );
+    if ( index == 0 || pVirtualMemory[ index - 1 ] != pMemoryToBeReleased )
     {
-        /* Delete the entry from the linked list. */
-        if ( pMemoryToBeReleased->pLast )
-        {
-            pMemoryToBeReleased->pLast->pNext = pMemoryToBeReleased->pNext;
-        }
-        
-        if ( pMemoryToBeReleased->pNext )
-        {
-            pMemoryToBeReleased->pNext->pLast = pMemoryToBeReleased->pLast;
-        }
+        pthread_rwlock_unlock(&virtual_region_lock);
+        ASSERT( "The region is not in the region map.\n" );
+        return FALSE;
     }
 
+    memmove( pVirtualMemory + index - 1, pVirtualMemory + index,
+             ( nVirtualMemoryCount - index ) * sizeof( PCMI ) );
+    nVirtualMemoryCount--;
+
+    pthread_rwlock_unlock(&virtual_region_lock);
+
 #if MMAP_IGNORES_HINT
     // We've removed the block from our allocated list. Add it to the
     // free list.
@@ -639,6 +687,7 @@ static BOOL VIRTUALReleaseMemory( PCMI pMemoryToBeReleased )
     pMemoryToBeReleased->pDirtyPages = NULL;
 #endif // MMAP_DOESNOT_ALLOW_REMAP
 
+    InternalDeleteCriticalSection( &pMemoryToBeReleased->critsec );
     InternalFree( pMemoryToBeReleased );
     pMemoryToBeReleased = NULL;
 
@@ -727,7 +776,7 @@ static DWORD VIRTUALConvertVirtualFlags( IN BYTE VirtualProtect )
 
 
 /***
- *  Displays the linked list.
+ *  Displays the region map.
  *
  */
 #if defined _DEBUG
@@ -739,13 +788,11 @@ static void VIRTUALDisplayList( void  )
     PCMI p;
     SIZE_T count;
     SIZE_T index;
-    CPalThread * pthrCurrent = InternalGetCurrentThread();
 
-    InternalEnterCriticalSection(pthrCurrent, &virtual_critsec);
+    pthread_rwlock_rdlock(&virtual_region_lock);
 
-    p = pVirtualMemory;
-    count = 0;
-    while ( p ) {
+    for ( count = 0; count < nVirtualMemoryCount; count++ ) {
+        p = pVirtualMemory[ count ];
 
         DBGOUT( "Entry %d : \n", count );
         DBGOUT( "\t startBoundary %#x \n", p->startBoundary );
@@ -764,22 +811,17 @@ static void VIRTUALDisplayList( void  )
         DBGOUT( "\n" );
         DBGOUT( "\t accessProtection %d \n", p->accessProtection );
         DBGOUT( "\t allocationType %d \n", p->allocationType );
-        DBGOUT( "\t pNext %p \n", p->pNext );
-        DBGOUT( "\t pLast %p \n", p->pLast );
-
-        count++;
-        p = p->pNext;
     }
     
-    InternalLeaveCriticalSection(pthrCurrent, &virtual_critsec);
+    pthread_rwlock_unlock(&virtual_region_lock);
 }
 #endif
 
 /****
  *  VIRTUALStoreAllocationInfo()
  *
- *      Stores the allocation information in the linked list.
- *      NOTE: The caller must own the critical section.
+ *      Stores the allocation information in the region map.
+ *      NOTE: The caller must own virtual_critsec.
  */
 static BOOL VIRTUALStoreAllocationInfo( 
             IN UINT_PTR startBoundary,      /* Start of the region. */
@@ -788,9 +830,9 @@ static BOOL VIRTUALStoreAllocationInfo(
             IN DWORD flProtection )     /* Protections flags on the memory. */
 {
     PCMI pNewEntry       = NULL;
-    PCMI pMemInfo        = NULL;
     BOOL bRetVal         = TRUE;
     SIZE_T nBufferSize   = 0;
+    SIZE_T index;
 
     if ( ( memSize & VIRTUAL_PAGE_MASK ) != 0 )
     {
@@ -860,46 +902,111 @@ static BOOL VIRTUALStoreAllocationInfo(
         goto done;
     }
     
-    pMemInfo = pVirtualMemory;
+    InternalInitializeCriticalSection( &pNewEntry->critsec );
 
-    if ( pMemInfo && pMemInfo->startBoundary < startBoundary )
-    {
-        /* Look for the correct insert point */
-        TRACE( "Looking for the correct insert location.\n");
-        while ( pMemInfo->pNext && ( pMemInfo->pNext->startBoundary < startBoundary ) ) 
-        {
-            pMemInfo = pMemInfo->pNext;
-        }
-        
-        pNewEntry->pNext = pMemInfo->pNext;
-        pNewEntry->pLast = pMemInfo;
-        
-        if ( pNewEntry->pNext ) 
-        {
-            pNewEntry->pNext->pLast = pNewEntry;
-        }
-        
-        pMemInfo->pNext = pNewEntry;
-    }
-    else
+    pthread_rwlock_wrlock(&virtual_region_lock);
+
+    if ( nVirtualMemoryCount == nVirtualMemoryCapacity )
     {
-        TRACE( "Inserting a new element into the linked list\n" );
-        /* This is the first entry in the list. */
-        pNewEntry->pNext = pMemInfo;
-        pNewEntry->pLast = NULL;
-        
-        if ( pNewEntry->pNext ) 
+        SIZE_T nNewCapacity = nVirtualMemoryCapacity ? nVirtualMemoryCapacity * 2 : 64;
+        PCMI *pNewMap = (PCMI*)InternalRealloc( pVirtualMemory,
+                                                nNewCapacity * sizeof( PCMI ) );
+
+        if ( !pNewMap )
         {
-            pNewEntry->pNext->pLast = pNewEntry;
+            pthread_rwlock_unlock(&virtual_region_lock);
+            ERROR( "Unable to grow the region map.\n");
+            bRetVal =  FALSE;
+
+            InternalDeleteCriticalSection( &pNewEntry->critsec );
+#if MMAP_DOESNOT_ALLOW_REMAP
+            InternalFree( pNewEntry->pDirtyPages );
+#endif // MMAP_DOESNOT_ALLOW_REMAP
+            InternalFree( pNewEntry->pProtectionState );
+            InternalFree( pNewEntry->pAllocState );
+            InternalFree( pNewEntry );
+            pNewEntry = NULL;
+
+            goto done;
         }
-        
-        pVirtualMemory = pNewEntry ;
+
+        pVirtualMemory = pNewMap;
+        nVirtualMemoryCapacity = nNewCapacity;
     }
+
+    /* Keep the map sorted by start address. */
+    index = VIRTUALFindRegionIndex( startBoundary );
+    memmove( pVirtualMemory + index + 1, pVirtualMemory + index,
+             ( nVirtualMemoryCount - index ) * sizeof( PCMI ) );
+    pVirtualMemory[ index ] = pNewEntry;
+    nVirtualMemoryCount++;
+
+    pthread_rwlock_unlock(&virtual_region_lock);
 done:
     TRACE( "Exiting StoreAllocationInformation. \n" );
     return bRetVal;
 }
 
+#if VIRTUAL_COMMIT_IN_PLACE
+/******
+ *
+ *  VIRTUALReserveHugePageMemory() - Reserves a region that starts on a huge
+ *  page boundary and advises the kernel to back it with transparent huge
+ *  pages once it is committed.
+ *
+ *      Over-reserves by one huge page and trims the ends, since mmap only
+ *      guarantees page alignment. Returns NULL on failure, in which case the
+ *      caller falls back to an ordinary reservation.
+ */
+static LPVOID VIRTUALReserveHugePageMemory(
+                IN CPalThread *pthrCurrent, /* Currently executing thread */
+                IN SIZE_T MemSize)          /* Page aligned size of Region */
+{
+    SIZE_T ReserveSize = MemSize + VIRTUAL_HUGE_PAGE_SIZE;
+    char * pReserved;
+    char * pAligned;
+    SIZE_T nHead;
+    SIZE_T nTail;
+
+    pReserved = (char *)ReserveVirtualMemory(pthrCurrent, NULL, ReserveSize);
+    if (pReserved == NULL)
+    {
+        return NULL;
+    }
+
+    pAligned = (char *)(((UINT_PTR)pReserved + VIRTUAL_HUGE_PAGE_MASK) & ~(UINT_PTR)VIRTUAL_HUGE_PAGE_MASK);
+    nHead = pAligned - pReserved;
+    nTail = ReserveSize - nHead - MemSize;
+    if (nHead != 0)
+    {
+        munmap(pReserved, nHead);
+    }
+    if (nTail != 0)
+    {
+        munmap(pAligned + MemSize, nTail);
+    }
+
+    // Map the whole region up front; committing page ranges one at a time
+    // with mprotect() would leave it split into VMAs too small for THP.
+    if (mprotect(pAligned, MemSize, PROT_READ | PROT_WRITE) != 0)
+    {
+        WARN("mprotect() failed! Error(%d)=%s\n", errno, strerror(errno));
+        munmap(pAligned, MemSize);
+        return NULL;
+    }
+
+#ifdef MADV_HUGEPAGE
+    // Not fatal: the kernel may be built without THP or have it disabled.
+    if (madvise(pAligned, MemSize, MADV_HUGEPAGE) != 0)
+    {
+        WARN("madvise(MADV_HUGEPAGE) failed! Error(%d)=%s\n", errno, strerror(errno));
+    }
+#endif  // MADV_HUGEPAGE
+
+    return pAligned;
+}
+#endif  // VIRTUAL_COMMIT_IN_PLACE
+
 /******
  *
  *  VIRTUALReserveMemory() - Helper function that actually reserves the memory.
@@ -938,6 +1045,18 @@ static LPVOID VIRTUALReserveMemory(
         pRetVal = g_executableMemoryAllocator.AllocateMemory(MemSize);
     }
 
+#if VIRTUAL_COMMIT_IN_PLACE
+    if (((flAllocationType & MEM_RESERVE_HUGEPAGES) != 0) && (lpAddress == NULL))
+    {
+        pRetVal = VIRTUALReserveHugePageMemory(pthrCurrent, MemSize);
+        if (pRetVal == NULL)
+        {
+            // The ordinary reservation below must not be treated as mapped.
+            flAllocationType &= ~MEM_RESERVE_HUGEPAGES;
+        }
+    }
+#endif  // VIRTUAL_COMMIT_IN_PLACE
+
     if (pRetVal == NULL)
     {
         // Try to reserve memory from the OS
@@ -1066,24 +1185,22 @@ done:
 
 /******
  *
- *  VIRTUALCommitMemory() - Helper function that actually commits the memory.
+ *  VIRTUALCommitPages() - Commits a page range of a region.
  *
- *      NOTE: I call SetLastError in here, because many different error states
- *              exists, and that would be very complicated to work around.
+ *      NOTE: The caller must hold virtual_critsec or virtual_region_lock, so
+ *            that the region cannot be released. This function takes the
+ *            region's own lock.
  *
+ *      Returns the start of the range, or NULL on failure.
  */
-static LPVOID VIRTUALCommitMemory(
+static LPVOID VIRTUALCommitPages(
                 IN CPalThread *pthrCurrent, /* Currently executing thread */
-                IN LPVOID lpAddress,        /* Region to reserve or commit */
-                IN SIZE_T dwSize,           /* Size of Region */
-                IN DWORD flAllocationType,  /* Type of allocation */
+                IN PCMI pInformation,       /* Region containing the pages */
+                IN UINT_PTR StartBoundary,  /* Page aligned start of the range */
+                IN SIZE_T MemSize,          /* Page aligned size of the range */
                 IN DWORD flProtect)         /* Type of access protection */
 {
-    UINT_PTR StartBoundary      = 0;
-    SIZE_T MemSize              = 0;
-    PCMI pInformation           = 0;
     LPVOID pRetVal              = NULL;
-    BOOL IsLocallyReserved      = FALSE;
     SIZE_T totalPages;
     INT allocationType, curAllocationType;
     INT protectionState, curProtectionState;
@@ -1094,61 +1211,8 @@ static LPVOID VIRTUALCommitMemory(
     INT nProtect;
     INT vProtect;
 
-    if ( lpAddress )
-    {
-        StartBoundary = (UINT_PTR)lpAddress & ~VIRTUAL_PAGE_MASK;
-        /* Add the sizes, and round down to the nearest page boundary. */
-        MemSize = ( ((UINT_PTR)lpAddress + dwSize + VIRTUAL_PAGE_MASK) & ~VIRTUAL_PAGE_MASK ) - 
-                  StartBoundary;
-    }
-    else
-    {
-        MemSize = ( dwSize + VIRTUAL_PAGE_MASK ) & ~VIRTUAL_PAGE_MASK;
-    }
-
-    /* See if we have already reserved this memory. */
-    pInformation = VIRTUALFindRegionInformation( StartBoundary );
-    
-    if ( !pInformation )
-    {
-        /* According to the new MSDN docs, if MEM_COMMIT is specified,
-        and the memory is not reserved, you reserve and then commit.
-        */
-        LPVOID pReservedMemory = 
-                VIRTUALReserveMemory( pthrCurrent, lpAddress, dwSize, 
-                                      flAllocationType, flProtect );
-        
-        TRACE( "Reserve and commit the memory!\n " );
-
-        if ( pReservedMemory )
-        {
-            /* Re-align the addresses and try again to find the memory. */
-            StartBoundary = (UINT_PTR)pReservedMemory & ~VIRTUAL_PAGE_MASK;
-            MemSize = ( ((UINT_PTR)pReservedMemory + dwSize + VIRTUAL_PAGE_MASK) 
-                        & ~VIRTUAL_PAGE_MASK ) - StartBoundary;
-            
-            pInformation = VIRTUALFindRegionInformation( StartBoundary );
+    InternalEnterCriticalSection(pthrCurrent, &pInformation->critsec);
 
-            if ( !pInformation )
-            {
-                ASSERT( "Unable to locate the region information.\n" );
-                pthrCurrent->SetLastError( ERROR_INTERNAL_ERROR );
-                pRetVal = NULL;
-                goto done;
-            }
-            IsLocallyReserved = TRUE;
-        }
-        else
-        {
-            ERROR( "Unable to reserve the memory.\n" );
-            /* Don't set last error here, it will already be set. */
-            pRetVal = NULL;
-            goto done;
-        }
-    }
-               
-    TRACE( "Committing the memory now..\n");
-    
     // Pages that aren't already committed need to be committed. Pages that
     // are committed don't need to be committed, but they might need to have
     // their permissions changed.
@@ -1174,7 +1238,7 @@ static LPVOID VIRTUALCommitMemory(
     if (totalPages > pInformation->memSize / VIRTUAL_PAGE_SIZE - runStart)
     {
         ERROR("Trying to commit beyond the end of the region!\n");
-        goto error;
+        goto done;
     }
 
     while(runStart < initialRunStart + totalPages)
@@ -1199,13 +1263,18 @@ static LPVOID VIRTUALCommitMemory(
         {
             // Commit the pages
             void * pRet = MAP_FAILED;
-#if MMAP_DOESNOT_ALLOW_REMAP
+#if VIRTUAL_COMMIT_IN_PLACE
+            if (VIRTUALIsHugePageRegion(pInformation))
+                pRet = (void *)StartBoundary;
+            else
+#endif // VIRTUAL_COMMIT_IN_PLACE
+#if MMAP_DOESNOT_ALLOW_REMAP || VIRTUAL_COMMIT_IN_PLACE
             if (mprotect((void *) StartBoundary, MemSize, PROT_WRITE | PROT_READ) == 0)
                 pRet = (void *)StartBoundary;
-#else // MMAP_DOESNOT_ALLOW_REMAP
+#else // MMAP_DOESNOT_ALLOW_REMAP || VIRTUAL_COMMIT_IN_PLACE
             pRet = mmap((void *) StartBoundary, MemSize, PROT_WRITE | PROT_READ,
                      MAP_ANON | MAP_FIXED | MAP_PRIVATE, -1, 0);
-#endif // MMAP_DOESNOT_ALLOW_REMAP
+#endif // MMAP_DOESNOT_ALLOW_REMAP || VIRTUAL_COMMIT_IN_PLACE
             if (pRet != MAP_FAILED)
             {
 #if MMAP_DOESNOT_ALLOW_REMAP
@@ -1228,7 +1297,7 @@ static LPVOID VIRTUALCommitMemory(
             else
             {
                 ERROR("mmap() failed! Error(%d)=%s\n", errno, strerror(errno));
-                goto error;
+                goto done;
             }
             VIRTUALSetAllocState(MEM_COMMIT, runStart, runLength, pInformation);
 #if MMAP_DOESNOT_ALLOW_REMAP
@@ -1256,7 +1325,7 @@ static LPVOID VIRTUALCommitMemory(
             {
                 ERROR("mprotect() failed! Error(%d)=%s\n",
                       errno, strerror(errno));
-                goto error;
+                goto done;
             }
         }
         
@@ -1267,16 +1336,107 @@ static LPVOID VIRTUALCommitMemory(
     }
     pRetVal = (void *) (pInformation->startBoundary +
                         initialRunStart * VIRTUAL_PAGE_SIZE);
-    goto done;
 
-error:
+done:
+    InternalLeaveCriticalSection(pthrCurrent, &pInformation->critsec);
+    return pRetVal;
+}
+
+/******
+ *
+ *  VIRTUALCommitMemory() - Helper function that actually commits the memory.
+ *
+ *      NOTE: I call SetLastError in here, because many different error states
+ *              exists, and that would be very complicated to work around.
+ *
+ *      NOTE: The caller must own virtual_critsec. Commits inside a region
+ *            that is already reserved go through VIRTUALCommitReservedMemory
+ *            instead.
+ *
+ */
+static LPVOID VIRTUALCommitMemory(
+                IN CPalThread *pthrCurrent, /* Currently executing thread */
+                IN LPVOID lpAddress,        /* Region to reserve or commit */
+                IN SIZE_T dwSize,           /* Size of Region */
+                IN DWORD flAllocationType,  /* Type of allocation */
+                IN DWORD flProtect)         /* Type of access protection */
+{
+    UINT_PTR StartBoundary      = 0;
+    SIZE_T MemSize              = 0;
+    PCMI pInformation           = 0;
+    LPVOID pRetVal              = NULL;
+    BOOL IsLocallyReserved      = FALSE;
+
+    if ( lpAddress )
+    {
+        StartBoundary = (UINT_PTR)lpAddress & ~VIRTUAL_PAGE_MASK;
+        /* Add the sizes, and round down to the nearest page boundary. */
+        MemSize = ( ((UINT_PTR)lpAddress + dwSize + VIRTUAL_PAGE_MASK) & ~VIRTUAL_PAGE_MASK ) - 
+                  StartBoundary;
+    }
+    else
+    {
+        MemSize = ( dwSize + VIRTUAL_PAGE_MASK ) & ~VIRTUAL_PAGE_MASK;
+    }
+
+    /* See if we have already reserved this memory. */
+    pInformation = VIRTUALFindRegionInformation( StartBoundary );
+    
+    if ( !pInformation )
+    {
+        /* According to the new MSDN docs, if MEM_COMMIT is specified,
+        and the memory is not reserved, you reserve and then commit.
+        */
+        LPVOID pReservedMemory = 
+                VIRTUALReserveMemory( pthrCurrent, lpAddress, dwSize, 
+                                      flAllocationType, flProtect );
+        
+        TRACE( "Reserve and commit the memory!\n " );
+
+        if ( pReservedMemory )
+        {
+            /* Re-align the addresses and try again to find the memory. */
+            StartBoundary = (UINT_PTR)pReservedMemory & ~VIRTUAL_PAGE_MASK;
+            MemSize = ( ((UINT_PTR)pReservedMemory + dwSize + VIRTUAL_PAGE_MASK) 
+                        & ~VIRTUAL_PAGE_MASK ) - StartBoundary;
+            
+            pInformation = VIRTUALFindRegionInformation( StartBoundary );
+
+            if ( !pInformation )
+            {
+                ASSERT( "Unable to locate the region information.\n" );
+                pthrCurrent->SetLastError( ERROR_INTERNAL_ERROR );
+                pRetVal = NULL;
+                goto done;
+            }
+            IsLocallyReserved = TRUE;
+        }
+        else
+        {
+            ERROR( "Unable to reserve the memory.\n" );
+            /* Don't set last error here, it will already be set. */
+            pRetVal = NULL;
+            goto done;
+        }
+    }
+               
+    TRACE( "Committing the memory now..\n");
+
+    pRetVal = VIRTUALCommitPages( pthrCurrent, pInformation, StartBoundary,
+                                  MemSize, flProtect );
+    if ( pRetVal != NULL )
+    {
+        goto done;
+    }
+
     if ( flAllocationType & MEM_RESERVE || IsLocallyReserved )
     {
 #if (MMAP_IGNORES_HINT && !MMAP_DOESNOT_ALLOW_REMAP)
-        mmap(pRetVal, MemSize, PROT_NONE, MAP_FIXED | MAP_PRIVATE,
-             gBackingFile, (char *) pRetVal - (char *) gBackingBaseAddress);
+        mmap((LPVOID) pInformation->startBoundary, pInformation->memSize,
+             PROT_NONE, MAP_FIXED | MAP_PRIVATE, gBackingFile,
+             (char *) pInformation->startBoundary - (char *) gBackingBaseAddress);
 #else   // MMAP_IGNORES_HINT && !MMAP_DOESNOT_ALLOW_REMAP
-        munmap( pRetVal, MemSize );
+        munmap( (LPVOID) pInformation->startBoundary, pInformation->memSize );
 #endif  // MMAP_IGNORES_HINT && !MMAP_DOESNOT_ALLOW_REMAP
         if ( VIRTUALReleaseMemory( pInformation ) == FALSE )
         {
@@ -1294,6 +1454,45 @@ done:
     return pRetVal;
 }
 
+/******
+ *
+ *  VIRTUALCommitReservedMemory() - Commits pages inside a region that is
+ *  already reserved. Only takes the read side of virtual_region_lock.
+ *
+ *      Returns the committed address. Returns NULL and sets *pbFound to FALSE
+ *      if no region contains lpAddress, in which case the caller has to fall
+ *      back to VIRTUALCommitMemory().
+ */
+static LPVOID VIRTUALCommitReservedMemory(
+                IN CPalThread *pthrCurrent, /* Currently executing thread */
+                IN LPVOID lpAddress,        /* Region to commit */
+                IN SIZE_T dwSize,           /* Size of Region */
+                IN DWORD flProtect,         /* Type of access protection */
+                OUT BOOL *pbFound)          /* Whether a region was found */
+{
+    UINT_PTR StartBoundary;
+    SIZE_T MemSize;
+    PCMI pInformation;
+    LPVOID pRetVal = NULL;
+
+    StartBoundary = (UINT_PTR)lpAddress & ~VIRTUAL_PAGE_MASK;
+    MemSize = ( ((UINT_PTR)lpAddress + dwSize + VIRTUAL_PAGE_MASK) & ~VIRTUAL_PAGE_MASK ) -
+              StartBoundary;
+
+    pthread_rwlock_rdlock(&virtual_region_lock);
+
+    pInformation = VIRTUALFindRegionInformation( StartBoundary );
+    *pbFound = pInformation != NULL;
+    if ( pInformation )
+    {
+        pRetVal = VIRTUALCommitPages( pthrCurrent, pInformation, StartBoundary,
+                                      MemSize, flProtect );
+    }
+
+    pthread_rwlock_unlock(&virtual_region_lock);
+    return pRetVal;
+}
+
 #if MMAP_IGNORES_HINT
 /*++
 Function:
@@ -1608,6 +1807,190 @@ done:
 }
 #endif // RESERVE_FROM_BACKING_FILE
 
+/*++
+Function:
+    VIRTUALDecommitMemory
+
+    Decommits the pages of a reserved region. Takes the read side of
+    virtual_region_lock and the region's own lock, so decommits of different
+    regions do not serialize on virtual_critsec.
+--*/
+static BOOL VIRTUALDecommitMemory(
+        IN CPalThread *pthrCurrent, /* Currently executing thread */
+        IN LPVOID lpAddress,        /* Address of region. */
+        IN SIZE_T dwSize)           /* Size of region. */
+{
+    BOOL bRetVal = TRUE;
+    PCMI pUnCommittedMem = NULL;
+    UINT_PTR StartBoundary  = 0;
+    SIZE_T MemSize        = 0;
+
+    /* 
+     * A two byte range straddling 2 pages caues both pages to be either
+     * released or decommitted. So round the dwSize up to the next page 
+     * boundary and round the lpAddress down to the next page boundary.
+     */
+    MemSize = (((UINT_PTR)(dwSize) + ((UINT_PTR)(lpAddress) & VIRTUAL_PAGE_MASK) 
+                + VIRTUAL_PAGE_MASK) & ~VIRTUAL_PAGE_MASK);
+
+    StartBoundary = (UINT_PTR)lpAddress & ~VIRTUAL_PAGE_MASK;
+
+    pthread_rwlock_rdlock(&virtual_region_lock);
+
+    pUnCommittedMem = VIRTUALFindRegionInformation( StartBoundary );
+    if (!pUnCommittedMem)
+    {
+        ASSERT( "Unable to locate the region information.\n" );
+        pthrCurrent->SetLastError( ERROR_INTERNAL_ERROR );
+        bRetVal = FALSE;
+        goto unlockRegions;
+    }
+
+    InternalEnterCriticalSection(pthrCurrent, &pUnCommittedMem->critsec);
+
+    TRACE( "Un-committing the following page(s) %d to %d.\n", 
+           StartBoundary, MemSize );
+
+#if MMAP_DOESNOT_ALLOW_REMAP
+    // if no double mapping is supported, 
+    // just mprotect the memory with no access
+    if (mprotect((LPVOID)StartBoundary, MemSize, PROT_NONE) == 0)
+#elif VIRTUAL_COMMIT_IN_PLACE
+    // Drop the pages and revoke access in place; replacing the mapping
+    // with a fresh one costs a VMA teardown and rebuild on every decommit.
+    if (madvise((LPVOID)StartBoundary, MemSize, MADV_DONTNEED) == 0 &&
+        mprotect((LPVOID)StartBoundary, MemSize,
+                 VIRTUALIsHugePageRegion(pUnCommittedMem) ? PROT_READ | PROT_WRITE : PROT_NONE) == 0)
+#else // MMAP_DOESNOT_ALLOW_REMAP
+    // Explicitly calling mmap instead of mprotect here makes it
+    // that much more clear to the operating system that we no
+    // longer need these pages.
+#if RESERVE_FROM_BACKING_FILE
+    if ( mmap( (LPVOID)StartBoundary, MemSize, PROT_NONE,
+               MAP_FIXED | MAP_PRIVATE, gBackingFile,
+               (char *) StartBoundary - (char *) gBackingBaseAddress ) !=
+         MAP_FAILED )
+#else   // RESERVE_FROM_BACKING_FILE
+    if ( mmap( (LPVOID)StartBoundary, MemSize, PROT_NONE,
+               MAP_FIXED | MAP_ANON | MAP_PRIVATE, -1, 0 ) != MAP_FAILED )
+#endif  // RESERVE_FROM_BACKING_FILE
+#endif // MMAP_DOESNOT_ALLOW_REMAP
+    {
+#if (MMAP_ANON_IGNORES_PROTECTION && !MMAP_DOESNOT_ALLOW_REMAP && !VIRTUAL_COMMIT_IN_PLACE)
+        if (mprotect((LPVOID) StartBoundary, MemSize, PROT_NONE) != 0)
+        {
+            ASSERT("mprotect failed to protect the region!\n");
+            pthrCurrent->SetLastError(ERROR_INTERNAL_ERROR);
+            munmap((LPVOID) StartBoundary, MemSize);
+            bRetVal = FALSE;
+            goto done;
+        }
+#endif  // MMAP_ANON_IGNORES_PROTECTION && !MMAP_DOESNOT_ALLOW_REMAP && !VIRTUAL_COMMIT_IN_PLACE
+
+        SIZE_T index = 0;
+        SIZE_T nNumOfPagesToChange = 0;
+
+        /* We can now commit this memory by calling VirtualAlloc().*/
+        index = (StartBoundary - pUnCommittedMem->startBoundary) / VIRTUAL_PAGE_SIZE;
+        
+        nNumOfPagesToChange = MemSize / VIRTUAL_PAGE_SIZE;
+        VIRTUALSetAllocState( MEM_RESERVE, index, 
+                              nNumOfPagesToChange, pUnCommittedMem ); 
+#if MMAP_DOESNOT_ALLOW_REMAP
+        VIRTUALSetDirtyPages( 1, index, 
+                              nNumOfPagesToChange, pUnCommittedMem ); 
+#endif // MMAP_DOESNOT_ALLOW_REMAP
+
+        goto done;    
+    }
+    else
+    {
+        ASSERT( "mmap() returned an abnormal value.\n" );
+        bRetVal = FALSE;
+        pthrCurrent->SetLastError( ERROR_INTERNAL_ERROR );
+        goto done;
+    }
+
+done:
+    InternalLeaveCriticalSection(pthrCurrent, &pUnCommittedMem->critsec);
+unlockRegions:
+    pthread_rwlock_unlock(&virtual_region_lock);
+    return bRetVal;
+}
+
+/*++
+Function:
+    VIRTUALReleaseRegion
+
+    Unmaps a whole region and drops its record.
+
+    NOTE: The caller must own virtual_critsec.
+--*/
+static BOOL VIRTUALReleaseRegion(
+        IN CPalThread *pthrCurrent, /* Currently executing thread */
+        IN LPVOID lpAddress,        /* Address of region. */
+        IN SIZE_T dwSize)           /* Size of region. */
+{
+    BOOL bRetVal = TRUE;
+    PCMI pMemoryToBeReleased = 
+        VIRTUALFindRegionInformation( (UINT_PTR)lpAddress );
+    
+    if ( !pMemoryToBeReleased )
+    {
+        ERROR( "lpAddress must be the base address returned by VirtualAlloc.\n" );
+        pthrCurrent->SetLastError( ERROR_INVALID_ADDRESS );
+        bRetVal = FALSE;
+        goto done;
+    }
+    if ( dwSize != 0 )
+    {
+        ERROR( "dwSize must be 0 if you are releasing the memory.\n" );
+        pthrCurrent->SetLastError( ERROR_INVALID_PARAMETER );
+        bRetVal = FALSE;
+        goto done;
+    }
+
+    TRACE( "Releasing the following memory %d to %d.\n", 
+           pMemoryToBeReleased->startBoundary, pMemoryToBeReleased->memSize );
+    
+#if (MMAP_IGNORES_HINT && !MMAP_DOESNOT_ALLOW_REMAP)
+    if (mmap((void *) pMemoryToBeReleased->startBoundary,
+             pMemoryToBeReleased->memSize, PROT_NONE,
+             MAP_FIXED | MAP_PRIVATE, gBackingFile,
+             (char *) pMemoryToBeReleased->startBoundary -
+             (char *) gBackingBaseAddress) != MAP_FAILED)
+#else   // MMAP_IGNORES_HINT && !MMAP_DOESNOT_ALLOW_REMAP
+    if ( munmap( (LPVOID)pMemoryToBeReleased->startBoundary, 
+                 pMemoryToBeReleased->memSize ) == 0 )
+#endif  // MMAP_IGNORES_HINT && !MMAP_DOESNOT_ALLOW_REMAP
+    {
+        if ( VIRTUALReleaseMemory( pMemoryToBeReleased ) == FALSE )
+        {
+            ASSERT( "Unable to remove the PCMI entry from the list.\n" );
+            pthrCurrent->SetLastError( ERROR_INTERNAL_ERROR );
+            bRetVal = FALSE;
+            goto done;
+        }
+        pMemoryToBeReleased = NULL;
+    }
+    else
+    {
+#if MMAP_IGNORES_HINT
+        ASSERT("Unable to remap the memory onto the backing file; "
+               "error is %d.\n", errno);
+#else   // MMAP_IGNORES_HINT
+        ASSERT( "Unable to unmap the memory, munmap() returned "
+               "an abnormal value.\n" );
+#endif  // MMAP_IGNORES_HINT
+        pthrCurrent->SetLastError( ERROR_INTERNAL_ERROR );
+        bRetVal = FALSE;
+        goto done;
+    }
+
+done:
+    return bRetVal;
+}
+
 /*++
 Function:
   VirtualAlloc
@@ -1644,10 +2027,10 @@ VirtualAlloc(
     }
 
     /* Test for un-supported flags. */
-    if ( ( flAllocationType & ~( MEM_COMMIT | MEM_RESERVE | MEM_TOP_DOWN | MEM_RESERVE_EXECUTABLE ) ) != 0 )
+    if ( ( flAllocationType & ~( MEM_COMMIT | MEM_RESERVE | MEM_TOP_DOWN | MEM_RESERVE_EXECUTABLE | MEM_RESERVE_HUGEPAGES ) ) != 0 )
     {
         ASSERT( "flAllocationType can be one, or any combination of MEM_COMMIT, \
-               MEM_RESERVE, MEM_TOP_DOWN, or MEM_RESERVE_EXECUTABLE.\n" );
+               MEM_RESERVE, MEM_TOP_DOWN, MEM_RESERVE_EXECUTABLE or MEM_RESERVE_HUGEPAGES.\n" );
         pthrCurrent->SetLastError( ERROR_INVALID_PARAMETER );
         goto done;
     }
@@ -1684,6 +2067,19 @@ VirtualAlloc(
 
     if ( flAllocationType & MEM_COMMIT )
     {
+        if ( pRetVal == NULL && lpAddress != NULL )
+        {
+            /* Committing into an existing reservation is the common case
+               and does not need virtual_critsec. */
+            BOOL bFound;
+            pRetVal = VIRTUALCommitReservedMemory( pthrCurrent, lpAddress, dwSize,
+                                                   flProtect, &bFound );
+            if ( bFound )
+            {
+                goto done;
+            }
+        }
+
         InternalEnterCriticalSection(pthrCurrent, &virtual_critsec);
         if ( pRetVal != NULL )
         {
@@ -1731,7 +2127,6 @@ VirtualFree(
           lpAddress, dwSize, dwFreeType);
 
     pthrCurrent = InternalGetCurrentThread();
-    InternalEnterCriticalSection(pthrCurrent, &virtual_critsec);
 
     /* Sanity Checks. */
     if ( !lpAddress )
@@ -1761,9 +2156,6 @@ VirtualFree(
 
     if ( dwFreeType & MEM_DECOMMIT )
     {
-        UINT_PTR StartBoundary  = 0;
-        SIZE_T MemSize        = 0;
-
         if ( dwSize == 0 )
         {
             ERROR( "dwSize cannot be 0. \n" );
@@ -1771,144 +2163,16 @@ VirtualFree(
             bRetVal = FALSE;
             goto VirtualFreeExit;
         }
-        /* 
-         * A two byte range straddling 2 pages caues both pages to be either
-         * released or decommitted. So round the dwSize up to the next page 
-         * boundary and round the lpAddress down to the next page boundary.
-         */
-        MemSize = (((UINT_PTR)(dwSize) + ((UINT_PTR)(lpAddress) & VIRTUAL_PAGE_MASK) 
-                    + VIRTUAL_PAGE_MASK) & ~VIRTUAL_PAGE_MASK);
-
-        StartBoundary = (UINT_PTR)lpAddress & ~VIRTUAL_PAGE_MASK;
-
-        PCMI pUnCommittedMem;
-        pUnCommittedMem = VIRTUALFindRegionInformation( StartBoundary );
-        if (!pUnCommittedMem)
-        {
-            ASSERT( "Unable to locate the region information.\n" );
-            pthrCurrent->SetLastError( ERROR_INTERNAL_ERROR );
-            bRetVal = FALSE;
-            goto VirtualFreeExit;
-        }
-
-        TRACE( "Un-committing the following page(s) %d to %d.\n", 
-               StartBoundary, MemSize );
-
-#if MMAP_DOESNOT_ALLOW_REMAP
-        // if no double mapping is supported, 
-        // just mprotect the memory with no access
-        if (mprotect((LPVOID)StartBoundary, MemSize, PROT_NONE) == 0)
-#else // MMAP_DOESNOT_ALLOW_REMAP
-        // Explicitly calling mmap instead of mprotect here makes it
-        // that much more clear to the operating system that we no
-        // longer need these pages.
-#if RESERVE_FROM_BACKING_FILE
-        if ( mmap( (LPVOID)StartBoundary, MemSize, PROT_NONE,
-                   MAP_FIXED | MAP_PRIVATE, gBackingFile,
-                   (char *) StartBoundary - (char *) gBackingBaseAddress ) !=
-             MAP_FAILED )
-#else   // RESERVE_FROM_BACKING_FILE
-        if ( mmap( (LPVOID)StartBoundary, MemSize, PROT_NONE,
-                   MAP_FIXED | MAP_ANON | MAP_PRIVATE, -1, 0 ) != MAP_FAILED )
-#endif  // RESERVE_FROM_BACKING_FILE
-#endif // MMAP_DOESNOT_ALLOW_REMAP
-        {
-#if (MMAP_ANON_IGNORES_PROTECTION && !MMAP_DOESNOT_ALLOW_REMAP)
-            if (mprotect((LPVOID) StartBoundary, MemSize, PROT_NONE) != 0)
-            {
-                ASSERT("mprotect failed to protect the region!\n");
-                pthrCurrent->SetLastError(ERROR_INTERNAL_ERROR);
-                munmap((LPVOID) StartBoundary, MemSize);
-                bRetVal = FALSE;
-                goto VirtualFreeExit;
-            }
-#endif  // MMAP_ANON_IGNORES_PROTECTION && !MMAP_DOESNOT_ALLOW_REMAP
-
-            SIZE_T index = 0;
-            SIZE_T nNumOfPagesToChange = 0;
-
-            /* We can now commit this memory by calling VirtualAlloc().*/
-            index = (StartBoundary - pUnCommittedMem->startBoundary) / VIRTUAL_PAGE_SIZE;
-            
-            nNumOfPagesToChange = MemSize / VIRTUAL_PAGE_SIZE;
-            VIRTUALSetAllocState( MEM_RESERVE, index, 
-                                  nNumOfPagesToChange, pUnCommittedMem ); 
-#if MMAP_DOESNOT_ALLOW_REMAP
-            VIRTUALSetDirtyPages( 1, index, 
-                                  nNumOfPagesToChange, pUnCommittedMem ); 
-#endif // MMAP_DOESNOT_ALLOW_REMAP
-
-            goto VirtualFreeExit;    
-        }
-        else
-        {
-            ASSERT( "mmap() returned an abnormal value.\n" );
-            bRetVal = FALSE;
-            pthrCurrent->SetLastError( ERROR_INTERNAL_ERROR );
-            goto VirtualFreeExit;
-        }
+        bRetVal = VIRTUALDecommitMemory( pthrCurrent, lpAddress, dwSize );
     }
-    
-    if ( dwFreeType & MEM_RELEASE )
+    else
     {
-        PCMI pMemoryToBeReleased = 
-            VIRTUALFindRegionInformation( (UINT_PTR)lpAddress );
-        
-        if ( !pMemoryToBeReleased )
-        {
-            ERROR( "lpAddress must be the base address returned by VirtualAlloc.\n" );
-            pthrCurrent->SetLastError( ERROR_INVALID_ADDRESS );
-            bRetVal = FALSE;
-            goto VirtualFreeExit;
-        }
-        if ( dwSize != 0 )
-        {
-            ERROR( "dwSize must be 0 if you are releasing the memory.\n" );
-            pthrCurrent->SetLastError( ERROR_INVALID_PARAMETER );
-            bRetVal = FALSE;
-            goto VirtualFreeExit;
-        }
-
-        TRACE( "Releasing the following memory %d to %d.\n", 
-               pMemoryToBeReleased->startBoundary, pMemoryToBeReleased->memSize );
-        
-#if (MMAP_IGNORES_HINT && !MMAP_DOESNOT_ALLOW_REMAP)
-        if (mmap((void *) pMemoryToBeReleased->startBoundary,
-                 pMemoryToBeReleased->memSize, PROT_NONE,
-                 MAP_FIXED | MAP_PRIVATE, gBackingFile,
-                 (char *) pMemoryToBeReleased->startBoundary -
-                 (char *) gBackingBaseAddress) != MAP_FAILED)
-#else   // MMAP_IGNORES_HINT && !MMAP_DOESNOT_ALLOW_REMAP
-        if ( munmap( (LPVOID)pMemoryToBeReleased->startBoundary, 
-                     pMemoryToBeReleased->memSize ) == 0 )
-#endif  // MMAP_IGNORES_HINT && !MMAP_DOESNOT_ALLOW_REMAP
-        {
-            if ( VIRTUALReleaseMemory( pMemoryToBeReleased ) == FALSE )
-            {
-                ASSERT( "Unable to remove the PCMI entry from the list.\n" );
-                pthrCurrent->SetLastError( ERROR_INTERNAL_ERROR );
-                bRetVal = FALSE;
-                goto VirtualFreeExit;
-            }
-            pMemoryToBeReleased = NULL;
-        }
-        else
-        {
-#if MMAP_IGNORES_HINT
-            ASSERT("Unable to remap the memory onto the backing file; "
-                   "error is %d.\n", errno);
-#else   // MMAP_IGNORES_HINT
-            ASSERT( "Unable to unmap the memory, munmap() returned "
-                   "an abnormal value.\n" );
-#endif  // MMAP_IGNORES_HINT
-            pthrCurrent->SetLastError( ERROR_INTERNAL_ERROR );
-            bRetVal = FALSE;
-            goto VirtualFreeExit;
-        }
+        InternalEnterCriticalSection(pthrCurrent, &virtual_critsec);
+        bRetVal = VIRTUALReleaseRegion( pthrCurrent, lpAddress, dwSize );
+        InternalLeaveCriticalSection(pthrCurrent, &virtual_critsec);
     }
 
 VirtualFreeExit:
-    InternalLeaveCriticalSection(pthrCurrent, &virtual_critsec);
     LOGEXIT( "VirtualFree returning %s.\n", bRetVal == TRUE ? "TRUE" : "FALSE" );
     PERF_EXIT(VirtualFree);
     return bRetVal;
@@ -1944,7 +2208,7 @@ VirtualProtect(
           lpAddress, dwSize, flNewProtect, lpflOldProtect);
 
     pthrCurrent = InternalGetCurrentThread();
-    InternalEnterCriticalSection(pthrCurrent, &virtual_critsec);
+    pthread_rwlock_rdlock(&virtual_region_lock);
     
     StartBoundary = (UINT_PTR)lpAddress & ~VIRTUAL_PAGE_MASK;
     MemSize = (((UINT_PTR)(dwSize) + ((UINT_PTR)(lpAddress) & VIRTUAL_PAGE_MASK)
@@ -1969,6 +2233,8 @@ VirtualProtect(
     pEntry = VIRTUALFindRegionInformation( StartBoundary );
     if ( NULL != pEntry )
     {
+        InternalEnterCriticalSection(pthrCurrent, &pEntry->critsec);
+
         /* See if the pages are committed. */
         Index = OffSet = StartBoundary - pEntry->startBoundary == 0 ?
              0 : ( StartBoundary - pEntry->startBoundary ) / VIRTUAL_PAGE_SIZE;
@@ -2028,7 +2294,11 @@ VirtualProtect(
         }
     }
 ExitVirtualProtect:
-    InternalLeaveCriticalSection(pthrCurrent, &virtual_critsec);
+    if ( pEntry )
+    {
+        InternalLeaveCriticalSection(pthrCurrent, &pEntry->critsec);
+    }
+    pthread_rwlock_unlock(&virtual_region_lock);
 
 #if defined _DEBUG
     VIRTUALDisplayList();
@@ -2201,7 +2471,14 @@ VirtualQuery(
           lpAddress, lpBuffer, dwLength);
 
     pthrCurrent = InternalGetCurrentThread();
-    InternalEnterCriticalSection(pthrCurrent, &virtual_critsec);
+
+#if MMAP_IGNORES_HINT
+    // Make sure we have memory to map before we try to query it. This takes
+    // virtual_critsec, so it has to happen before virtual_region_lock.
+    VIRTUALGetBackingFile(pthrCurrent);
+#endif  // MMAP_IGNORES_HINT
+
+    pthread_rwlock_rdlock(&virtual_region_lock);
 
     if ( !lpBuffer)
     {
@@ -2219,9 +2496,6 @@ VirtualQuery(
     StartBoundary = (UINT_PTR)lpAddress & ~VIRTUAL_PAGE_MASK;
 
 #if MMAP_IGNORES_HINT
-    // Make sure we have memory to map before we try to query it.
-    VIRTUALGetBackingFile(pthrCurrent);
-
     // If we're suballocating, claim that any memory that isn't in our
     // suballocated block is already allocated. This keeps callers from
     // using these results to try to allocate those blocks and failing.
@@ -2268,6 +2542,8 @@ VirtualQuery(
     }
     else
     {
+        InternalEnterCriticalSection(pthrCurrent, &pEntry->critsec);
+
         /* Starting page. */
         SIZE_T Index = ( StartBoundary - pEntry->startBoundary ) / VIRTUAL_PAGE_SIZE;
 
@@ -2300,11 +2576,13 @@ VirtualQuery(
         lpBuffer->State =
             ( AllocationType == MEM_COMMIT ? MEM_COMMIT : MEM_RESERVE );
         WARN( "Ignoring lpBuffer->Type. \n" );
+
+        InternalLeaveCriticalSection(pthrCurrent, &pEntry->critsec);
     }
 
 ExitVirtualQuery:
 
-    InternalLeaveCriticalSection(pthrCurrent, &virtual_critsec);
+    pthread_rwlock_unlock(&virtual_region_lock);
     
     LOGEXIT( "VirtualQuery returning %d.\n", sizeof( *lpBuffer ) );
     PERF_EXIT(VirtualQuery);
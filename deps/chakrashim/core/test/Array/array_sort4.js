@@ -0,0 +1,90 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Array.prototype.sort on native int arrays without a compare function, and stability of sort with one
+
+if (this.WScript && this.WScript.LoadScriptFile) { // Check for running in ch
+    this.WScript.LoadScriptFile("..\\UnitTestFramework\\UnitTestFramework.js");
+}
+
+function stringSorted(values) {
+    return values.map(String).sort().map(Number);
+}
+
+var tests = [
+    {
+        name: "Int arrays sort by the strings of their elements",
+        body: function () {
+            var a = [10, 9, 1, -1, -10, -9, 0, 100, 2147483647, -2147483648, 21, 2];
+            assert.areEqual(stringSorted(a), a.slice().sort(), "short array");
+
+            var seed = 7;
+            var b = [];
+            for (var i = 0; i < 5000; i++) {
+                seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+                b.push(i % 3 ? seed % 1000 - 500 : seed | 0);
+            }
+            assert.areEqual(stringSorted(b), b.slice().sort(), "long array");
+        }
+    },
+    {
+        name: "Holes move to the end of int arrays",
+        body: function () {
+            var a = [3, , 20, , 1];
+            a.length = 8;
+            a.sort();
+            assert.areEqual(8, a.length, "length is unchanged");
+            assert.areEqual([1, 20, 3], a.slice(0, 3), "elements come first");
+            for (var i = 3; i < a.length; i++) {
+                assert.isFalse(i in a, "index " + i + " is a hole");
+            }
+
+            var empty = [];
+            empty.length = 5;
+            empty[0] = 1;
+            delete empty[0];
+            empty.sort();
+            assert.areEqual(5, empty.length, "array of holes keeps its length");
+        }
+    },
+    {
+        name: "Sort with a compare function is stable",
+        body: function () {
+            [10, 100, 2000].forEach(function (length) {
+                var a = [];
+                for (var i = 0; i < length; i++) {
+                    a.push({ key: (i * 7) % 5, index: i });
+                }
+                a.sort(function (x, y) { return x.key - y.key; });
+                for (var i = 1; i < length; i++) {
+                    var x = a[i - 1], y = a[i];
+                    assert.isTrue(x.key < y.key || (x.key === y.key && x.index < y.index), "length " + length + ", element " + i);
+                }
+            });
+        }
+    },
+    {
+        name: "Exceptions from the compare function leave the elements intact",
+        body: function () {
+            var a = [];
+            for (var i = 0; i < 1000; i++) {
+                a.push("s" + ((i * 37) % 1000));
+            }
+            var before = a.slice();
+            var calls = 0;
+            assert.throws(function () {
+                a.sort(function (x, y) {
+                    if (++calls === 3000) {
+                        throw new Error("stop");
+                    }
+                    return x < y ? -1 : x > y ? 1 : 0;
+                });
+            }, Error, "exception from the compare function is propagated", "stop");
+            assert.areEqual(before, a, "elements are untouched after an exception");
+        }
+    },
+];
+
+testRunner.runTests(tests, { verbose: WScript.Arguments[0] != "summary" });
@@ -0,0 +1,140 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Local time follows TZ as it changes at run time, including around DST
+// transitions, whether TZ names a zone file or holds a POSIX rule.
+// A Date keeps the local time it has computed, so every check uses a new one.
+
+WScript.LoadScriptFile("..\\UnitTestFramework\\UnitTestFramework.js");
+
+// WScript.SetTimeZone returns false where TZ does not pick the time zone;
+// the tests have nothing to check there.
+function setTimeZone(tz) {
+    return WScript.SetTimeZone(tz) === true;
+}
+
+function offsetAt(utc) {
+    return new Date(utc).getTimezoneOffset();
+}
+
+function hoursAt(utc) {
+    return new Date(utc).getHours();
+}
+
+var tests = [
+    {
+        name: "Zone file: offsets on either side of DST",
+        body: function () {
+            if (!setTimeZone("America/Los_Angeles")) {
+                return;
+            }
+            assert.areEqual(420, offsetAt(Date.UTC(2016, 6, 1, 12)), "summer");
+            assert.areEqual(480, offsetAt(Date.UTC(2016, 0, 1, 12)), "winter");
+            assert.areEqual(5, hoursAt(Date.UTC(2016, 6, 1, 12)), "summer hours");
+            assert.areEqual(Date.UTC(2016, 6, 1, 12), new Date(2016, 6, 1, 5).getTime(), "summer local to UTC");
+        }
+    },
+    {
+        name: "Zone file: spring forward",
+        body: function () {
+            if (!setTimeZone("America/Los_Angeles")) {
+                return;
+            }
+            // 2016-03-13 02:00 PST becomes 03:00 PDT at 10:00Z
+            assert.areEqual(480, offsetAt(Date.UTC(2016, 2, 13, 9, 59, 59)), "last second of PST");
+            assert.areEqual(420, offsetAt(Date.UTC(2016, 2, 13, 10)), "first second of PDT");
+            assert.areEqual(1, hoursAt(Date.UTC(2016, 2, 13, 9, 59, 59)), "hours before");
+            assert.areEqual(3, hoursAt(Date.UTC(2016, 2, 13, 10)), "hours after");
+
+            // A skipped local time is read with the offset from before the transition
+            var skipped = new Date(2016, 2, 13, 2, 30);
+            assert.areEqual(Date.UTC(2016, 2, 13, 10, 30), skipped.getTime(), "skipped local time");
+            assert.areEqual(3, skipped.getHours(), "skipped local time hours");
+        }
+    },
+    {
+        name: "Zone file: fall back",
+        body: function () {
+            if (!setTimeZone("America/Los_Angeles")) {
+                return;
+            }
+            // 2016-11-06 02:00 PDT becomes 01:00 PST at 09:00Z
+            assert.areEqual(420, offsetAt(Date.UTC(2016, 10, 6, 8, 59, 59)), "last second of PDT");
+            assert.areEqual(480, offsetAt(Date.UTC(2016, 10, 6, 9)), "first second of PST");
+            assert.areEqual(1, hoursAt(Date.UTC(2016, 10, 6, 8, 30)), "hours before");
+            assert.areEqual(1, hoursAt(Date.UTC(2016, 10, 6, 9, 30)), "hours after");
+
+            // A repeated local time resolves to the earlier instant
+            assert.areEqual(Date.UTC(2016, 10, 6, 8, 30), new Date(2016, 10, 6, 1, 30).getTime(), "repeated local time");
+        }
+    },
+    {
+        name: "Zone file: transitions past the end of the table",
+        body: function () {
+            if (!setTimeZone("America/Los_Angeles")) {
+                return;
+            }
+            assert.areEqual(420, offsetAt(Date.UTC(2050, 6, 1, 12)), "summer 2050");
+            assert.areEqual(480, offsetAt(Date.UTC(2050, 0, 1, 12)), "winter 2050");
+            // 2050-03-13 is the second Sunday of March
+            assert.areEqual(480, offsetAt(Date.UTC(2050, 2, 13, 9, 59, 59)), "before spring forward 2050");
+            assert.areEqual(420, offsetAt(Date.UTC(2050, 2, 13, 10)), "after spring forward 2050");
+        }
+    },
+    {
+        name: "Changing TZ takes effect on the next conversion",
+        body: function () {
+            if (!setTimeZone("America/Los_Angeles")) {
+                return;
+            }
+            assert.areEqual(420, offsetAt(Date.UTC(2016, 6, 1, 12)), "Los Angeles");
+
+            setTimeZone("Australia/Sydney");
+            assert.areEqual(-600, offsetAt(Date.UTC(2016, 6, 1, 12)), "Sydney winter");
+            assert.areEqual(-660, offsetAt(Date.UTC(2016, 0, 1, 12)), "Sydney summer");
+            assert.areEqual(23, hoursAt(Date.UTC(2016, 0, 1, 12)), "Sydney hours");
+            assert.areEqual(Date.UTC(2016, 0, 1, 12), new Date(2016, 0, 1, 23).getTime(), "Sydney local to UTC");
+
+            // 2016-10-02 02:00 AEST becomes 03:00 AEDT at 16:00Z the day before
+            assert.areEqual(-600, offsetAt(Date.UTC(2016, 9, 1, 15, 59, 59)), "last second of AEST");
+            assert.areEqual(-660, offsetAt(Date.UTC(2016, 9, 1, 16)), "first second of AEDT");
+
+            setTimeZone("UTC");
+            assert.areEqual(0, offsetAt(Date.UTC(2016, 6, 1, 12)), "UTC");
+            assert.areEqual(12, hoursAt(Date.UTC(2016, 6, 1, 12)), "UTC hours");
+
+            setTimeZone("America/Los_Angeles");
+            assert.areEqual(420, offsetAt(Date.UTC(2016, 6, 1, 12)), "back to Los Angeles");
+        }
+    },
+    {
+        name: "POSIX rule in TZ",
+        body: function () {
+            if (!setTimeZone("EST5EDT,M3.2.0,M11.1.0")) {
+                return;
+            }
+            assert.areEqual(240, offsetAt(Date.UTC(2016, 6, 1, 12)), "summer");
+            assert.areEqual(300, offsetAt(Date.UTC(2016, 0, 1, 12)), "winter");
+            // 2016-03-13 02:00 EST becomes 03:00 EDT at 07:00Z
+            assert.areEqual(300, offsetAt(Date.UTC(2016, 2, 13, 6, 59, 59)), "last second of EST");
+            assert.areEqual(240, offsetAt(Date.UTC(2016, 2, 13, 7)), "first second of EDT");
+            // 2016-11-06 02:00 EDT becomes 01:00 EST at 06:00Z
+            assert.areEqual(240, offsetAt(Date.UTC(2016, 10, 6, 5, 59, 59)), "last second of EDT");
+            assert.areEqual(300, offsetAt(Date.UTC(2016, 10, 6, 6)), "first second of EST");
+        }
+    },
+    {
+        name: "Empty TZ means UTC",
+        body: function () {
+            if (!setTimeZone("")) {
+                return;
+            }
+            assert.areEqual(0, offsetAt(Date.UTC(2016, 6, 1, 12)), "summer");
+            assert.areEqual(0, offsetAt(Date.UTC(2016, 0, 1, 12)), "winter");
+        }
+    }
+];
+
+testRunner.runTests(tests, { verbose: WScript.Arguments[0] != "summary" });
@@ -0,0 +1,70 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Functions are redeferred at full collections and reparsed on their next
+// call. Calling them again must behave exactly as before.
+
+function check(actual, expected, message) {
+    if (actual !== expected) {
+        throw new Error(message + ": expected " + expected + ", got " + actual);
+    }
+}
+
+function collect() {
+    CollectGarbage();
+    CollectGarbage();
+}
+
+var counter = 0;
+function leaf(a, b) { return a + b + counter; }
+
+function withArguments() { return arguments.length + ":" + Array.prototype.join.call(arguments, ","); }
+
+function Point(x, y) { this.x = x; this.y = y; }
+Point.prototype.sum = function () { return this.x + this.y; };
+
+var makeAdder = function (n) {
+    return function (m) { return n + m; };
+};
+var add5 = makeAdder(5);
+
+function defaults(a, b = a * 2, { c } = { c: 3 }) { return a + b + c; }
+
+var obj = {
+    value: 7,
+    method() { return this.value; },
+    get twice() { return this.value * 2; }
+};
+
+function run(round) {
+    counter = round;
+    check(leaf(1, 2), 3 + round, "leaf");
+    check(withArguments(1, "x", true), "3:1,x,true", "arguments");
+    var p = new Point(round, 1);
+    check(p.sum(), round + 1, "constructor and prototype method");
+    check(p instanceof Point, true, "instanceof");
+    check(add5(round), 5 + round, "closure");
+    check(defaults(1), 6, "default parameters");
+    check(obj.method(), 7, "method");
+    check(obj.twice, 14, "getter");
+    check(leaf.call(null, 2, 3), 5 + round, "call");
+    check(leaf.apply(null, [3, 4]), 7 + round, "apply");
+    check(leaf.length, 2, "length");
+    check(leaf.name, "leaf", "name");
+    check(leaf.toString(), "function leaf(a, b) { return a + b + counter; }", "toString");
+}
+
+for (var round = 0; round < 5; round++) {
+    run(round);
+    collect();
+}
+
+// A function that is redeferred while it still has function objects and
+// types created before the collection.
+var before = [1, 2, 3].map(function (x) { return x * 10; });
+collect();
+check([1, 2, 3].map(function (x) { return x * 10; }).join(), before.join(), "callback");
+
+print("pass");
@@ -0,0 +1,44 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Churns the recycler so that page segments carved out of huge page regions
+// are freed, kept committed and handed out again. Memory that comes back must
+// read as fresh: new objects and arrays may not see what their pages held.
+
+function check(cond, message) {
+    if (!cond) {
+        throw new Error(message);
+    }
+}
+
+var survivors = [];
+for (var round = 0; round < 20; round++) {
+    var garbage = [];
+    for (var i = 0; i < 20000; i++) {
+        garbage.push({ round: round, index: i, text: "item" + i });
+    }
+    for (var i = 0; i < 200; i++) {
+        var a = new Array(64);
+        a[63] = round;
+        survivors.push(a);
+    }
+    garbage = null;
+    CollectGarbage();
+
+    for (var i = 0; i < 200; i++) {
+        var fresh = new Array(64);
+        check(fresh[0] === undefined && fresh[62] === undefined, "new array reads stale data");
+        var obj = {};
+        check(obj.round === undefined && Object.keys(obj).length === 0, "new object reads stale data");
+    }
+}
+
+check(survivors.length === 4000, "survivor count");
+for (var i = 0; i < survivors.length; i++) {
+    check(survivors[i][63] === Math.floor(i / 200), "survivor " + i);
+    check(survivors[i][0] === undefined, "survivor " + i + " hole");
+}
+
+print("pass");
@@ -0,0 +1,84 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Number to string conversion gives the shortest digits that round trip, for values on either side of the fast path
+
+if (this.WScript && this.WScript.LoadScriptFile) { // Check for running in ch
+    this.WScript.LoadScriptFile("..\\UnitTestFramework\\UnitTestFramework.js");
+}
+
+var bits = new Uint32Array(2);
+var float = new Float64Array(bits.buffer);
+
+function pseudoRandom(seed) {
+    return function () {
+        seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+        return seed;
+    };
+}
+
+var tests = [
+    {
+        name: "Known conversions",
+        body: function () {
+            var expected = [
+                [0.1, "0.1"],
+                [0.3, "0.3"],
+                [0.1 + 0.2, "0.30000000000000004"],
+                [1 / 3, "0.3333333333333333"],
+                [123e-20, "1.23e-18"],
+                [1e21, "1e+21"],
+                [123456789012345680000, "123456789012345680000"],
+                [0.000001, "0.000001"],
+                [1e-7, "1e-7"],
+                [9007199254740993, "9007199254740992"],
+                [4.35, "4.35"],
+                [5e-324, "5e-324"],
+                [2.2250738585072014e-308, "2.2250738585072014e-308"],
+                [2.225073858507201e-308, "2.225073858507201e-308"],
+                [1.7976931348623157e308, "1.7976931348623157e+308"],
+                [-1.5, "-1.5"],
+                [Math.pow(2, 60), "1152921504606847000"],
+                [Math.pow(2, -20), "9.5367431640625e-7"]
+            ];
+            expected.forEach(function (pair) {
+                assert.areEqual(pair[1], String(pair[0]), "String(" + pair[1] + ")");
+                assert.areEqual(pair[1], JSON.stringify(pair[0]), "JSON.stringify(" + pair[1] + ")");
+            });
+        }
+    },
+    {
+        name: "Random doubles round trip with at most 17 digits",
+        body: function () {
+            var next = pseudoRandom(5);
+            for (var i = 0; i < 20000; i++) {
+                bits[0] = next() ^ (next() << 16);
+                bits[1] = next() & 0x7fefffff;
+                var value = float[0];
+                var str = String(value);
+                assert.areEqual(value, Number(str), "round trip of " + str);
+                assert.isTrue(str.replace(/e.*$/, "").replace(/[-.]/g, "").replace(/^0+|0+$/g, "").length <= 17, "digits of " + str);
+            }
+        }
+    },
+    {
+        name: "Repeated conversions give the same strings",
+        body: function () {
+            var values = [];
+            var first = [];
+            for (var i = 0; i < 100; i++) {
+                values.push(i / 7);
+                first.push(String(i / 7));
+            }
+            for (var round = 0; round < 3; round++) {
+                for (var i = values.length - 1; i >= 0; i--) {
+                    assert.areEqual(first[i], String(values[i]), "value " + i + " in round " + round);
+                }
+            }
+        }
+    },
+];
+
+testRunner.runTests(tests, { verbose: WScript.Arguments[0] != "summary" });
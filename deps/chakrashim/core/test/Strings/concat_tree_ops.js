@@ -0,0 +1,144 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// Equality, search and character access on strings built by concatenation, before and after they are flattened
+
+if (this.WScript && this.WScript.LoadScriptFile) { // Check for running in ch
+    this.WScript.LoadScriptFile("..\\UnitTestFramework\\UnitTestFramework.js");
+}
+
+// Builds the same string as a flat literal and as several kinds of concat string trees
+function shapes(parts) {
+    var flat = parts.join("");
+    var pair = parts[0];
+    for (var i = 1; i < parts.length; i++) {
+        pair = pair + parts[i];
+    }
+    var builder = "";
+    for (var i = 0; i < parts.length; i++) {
+        builder += parts[i];
+    }
+    var nested = parts.length > 2 ? (parts[0] + parts[1]) + (parts.slice(2).join("-").split("-").join("")) : pair;
+    var wrapped = "[" + flat + "]";
+    return [flat, pair, builder, nested, wrapped.substring(1, wrapped.length - 1)];
+}
+
+var parts = ["ab", "cab", "", "ca", "b", "\uD83D", "\uDE00", "abcabcab", "x"];
+var expected = parts.join("");
+
+var tests = [
+    {
+        name: "Strings of different shapes compare equal",
+        body: function () {
+            var all = shapes(parts);
+            for (var i = 0; i < all.length; i++) {
+                for (var j = 0; j < all.length; j++) {
+                    assert.isTrue(all[i] === all[j], "shape " + i + " === shape " + j);
+                    assert.isTrue(all[i] == all[j], "shape " + i + " == shape " + j);
+                }
+            }
+
+            var other = shapes(["ab", "cab", "", "ca", "b", "\uD83D", "\uDE00", "abcabcab", "y"]);
+            var shifted = shapes(["abc", "ab", "ca", "b", "\uD83D", "\uDE00", "abcabca", "bx"]);
+            for (var i = 0; i < other.length; i++) {
+                assert.isFalse(other[i] === expected, "last character differs, shape " + i);
+                assert.isTrue(shifted[i] === expected, "same characters split differently, shape " + i);
+            }
+        }
+    },
+    {
+        name: "indexOf and includes find matches that span parts",
+        body: function () {
+            var searches = ["a", "x", "bca", "bcab", "abcab", "\uD83D\uDE00", "b\uD83D\uDE00a", "cabx", "abcabcabx", "zz", expected, expected + "x"];
+            shapes(parts).forEach(function (s, shape) {
+                searches.forEach(function (search) {
+                    for (var position = 0; position <= expected.length; position += 3) {
+                        assert.areEqual(expected.indexOf(search, position), s.indexOf(search, position),
+                            "shape " + shape + ": indexOf(" + JSON.stringify(search) + ", " + position + ")");
+                    }
+                    assert.areEqual(expected.indexOf(search) !== -1, s.includes(search), "shape " + shape + ": includes(" + JSON.stringify(search) + ")");
+                });
+            });
+        }
+    },
+    {
+        name: "startsWith and endsWith compare across parts",
+        body: function () {
+            shapes(parts).forEach(function (s, shape) {
+                for (var i = 0; i <= expected.length; i++) {
+                    var prefix = expected.substring(0, i);
+                    var suffix = expected.substring(i);
+                    assert.isTrue(s.startsWith(prefix), "shape " + shape + ": startsWith prefix of length " + i);
+                    assert.isTrue(s.endsWith(suffix), "shape " + shape + ": endsWith suffix from " + i);
+                    assert.isTrue(s.startsWith(suffix, i), "shape " + shape + ": startsWith at " + i);
+                    assert.isTrue(s.endsWith(prefix, i), "shape " + shape + ": endsWith at " + i);
+                }
+                assert.isFalse(s.startsWith("abcabcay"), "shape " + shape + ": startsWith mismatch in a later part");
+                assert.isFalse(s.endsWith("abcabcab"), "shape " + shape + ": endsWith mismatch");
+            });
+        }
+    },
+    {
+        name: "charAt and charCodeAt read every part",
+        body: function () {
+            shapes(parts).forEach(function (s, shape) {
+                for (var i = expected.length - 1; i >= 0; i--) {
+                    assert.areEqual(expected.charCodeAt(i), s.charCodeAt(i), "shape " + shape + ": charCodeAt(" + i + ")");
+                    assert.areEqual(expected.charAt(i), s.charAt(i), "shape " + shape + ": charAt(" + i + ")");
+                }
+                assert.isTrue(isNaN(s.charCodeAt(expected.length)), "shape " + shape + ": charCodeAt past the end");
+                assert.areEqual("", s.charAt(expected.length), "shape " + shape + ": charAt past the end");
+            });
+        }
+    },
+    {
+        name: "Long strings built in a loop",
+        body: function () {
+            var s = "";
+            var flat = [];
+            for (var i = 0; i < 2000; i++) {
+                s += "item" + i + ",";
+                flat.push("item" + i);
+            }
+            var expectedLong = flat.join(",") + ",";
+
+            assert.areEqual(expectedLong.indexOf("item1999,"), s.indexOf("item1999,"), "indexOf near the end");
+            assert.areEqual(expectedLong.indexOf("9,item1"), s.indexOf("9,item1"), "indexOf across items");
+            assert.isTrue(s.endsWith("item1998,item1999,"), "endsWith");
+            assert.areEqual(expectedLong.charCodeAt(12345), s.charCodeAt(12345), "charCodeAt in the middle");
+            assert.isTrue(s === expectedLong, "equal to the joined string");
+            assert.isFalse(s === expectedLong.substring(0, expectedLong.length - 1) + ";", "differs in the last character");
+        }
+    },
+    {
+        name: "Trees read again and again are flattened without changing their contents",
+        body: function () {
+            var a = "";
+            var b = "";
+            for (var i = 0; i < 500; i++) {
+                a += "part" + i;
+                b += "part" + i;
+            }
+            var c = b + "";
+            var flat = a.split("").join("");
+
+            // Enough reads of the same trees to use up the budget for reading them in place, interleaved so
+            // that each tree is sometimes flattened while the other one still isn't
+            for (var round = 0; round < 20; round++) {
+                assert.isTrue(a === b, "round " + round + ": a === b");
+                assert.isTrue(c === flat, "round " + round + ": c === flat");
+                assert.isFalse(a === b.substring(1) + "x", "round " + round + ": a differs from a shifted string");
+                var index = (round * 131) % flat.length;
+                assert.areEqual(flat.charCodeAt(index), a.charCodeAt(index), "round " + round + ": a.charCodeAt(" + index + ")");
+                assert.areEqual(flat.charAt(index), c.charAt(index), "round " + round + ": c.charAt(" + index + ")");
+                assert.areEqual(flat.indexOf("art4", index), b.indexOf("art4", index), "round " + round + ": b.indexOf");
+                assert.isTrue(c.startsWith(flat.substring(index, index + 10), index), "round " + round + ": c.startsWith");
+            }
+            assert.isTrue(a === flat && b === flat && c === flat, "equal after being flattened");
+        }
+    },
+];
+
+testRunner.runTests(tests, { verbose: WScript.Arguments[0] != "summary" });
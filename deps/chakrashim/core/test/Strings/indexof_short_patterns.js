@@ -0,0 +1,75 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// indexOf, includes, split and replace with search strings found at every offset around the blocks they are searched in
+
+if (this.WScript && this.WScript.LoadScriptFile) { // Check for running in ch
+    this.WScript.LoadScriptFile("..\\UnitTestFramework\\UnitTestFramework.js");
+}
+
+var filler = "abcdefghijklmnopqrstuvw";
+filler += filler;
+
+function naiveIndexOf(str, search, position) {
+    for (var i = position; i + search.length <= str.length; i++) {
+        if (str.substr(i, search.length) === search) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+var patterns = ["x", "xy", "x\u0178y", "xyzzy", "x\u00FFyz\u0178zyx", "xyzxyzxyzxyzxyzxyz"];
+
+var tests = [
+    {
+        name: "Search strings are found at every offset",
+        body: function () {
+            patterns.forEach(function (pattern) {
+                for (var at = 0; at < 40; at++) {
+                    var str = filler.substring(0, at) + pattern + filler.substring(at);
+                    assert.areEqual(at, str.indexOf(pattern), JSON.stringify(pattern) + " at " + at);
+                    assert.areEqual(at, str.indexOf(pattern, at), JSON.stringify(pattern) + " from " + at);
+                    assert.areEqual(-1, str.indexOf(pattern, at + 1), JSON.stringify(pattern) + " after " + at);
+                    assert.isTrue(str.includes(pattern), JSON.stringify(pattern) + " is included at " + at);
+                    assert.areEqual(filler.substring(0, at) + "!" + filler.substring(at), str.replace(pattern, "!"), JSON.stringify(pattern) + " replaced at " + at);
+                }
+            });
+        }
+    },
+    {
+        name: "Near misses are not matches",
+        body: function () {
+            var str = "x_zx_zxy_x_yz_xyz";
+            ["xyz", "x", "xy", "yz", "zz", "x_zx_zxy_x_yz_xyz", "x_zx_zxy_x_yz_xyzz"].forEach(function (search) {
+                for (var position = 0; position <= str.length; position++) {
+                    assert.areEqual(naiveIndexOf(str, search, position), str.indexOf(search, position), JSON.stringify(search) + " from " + position);
+                }
+            });
+
+            // Characters that have the same low byte as the search string's
+            var wide = "\u0178\u0278\u0378\u7878\u78FFx";
+            assert.areEqual(5, wide.indexOf("x"), "one character");
+            assert.areEqual(-1, wide.indexOf("xx"), "two characters");
+        }
+    },
+    {
+        name: "Split on short separators",
+        body: function () {
+            var fields = [];
+            for (var i = 0; i < 200; i++) {
+                fields.push("field" + i + (i % 3 ? "" : "\u00E9"));
+            }
+            [",", ", ", "\t|", " -> ", "\u2028"].forEach(function (separator) {
+                var line = fields.join(separator);
+                assert.areEqual(fields, line.split(separator), JSON.stringify(separator));
+                assert.areEqual(fields.slice(0, 7), line.split(separator, 7), JSON.stringify(separator) + " with a limit");
+                assert.areEqual(["", ""], separator.split(separator), JSON.stringify(separator) + " alone");
+            });
+        }
+    },
+];
+
+testRunner.runTests(tests, { verbose: WScript.Arguments[0] != "summary" });
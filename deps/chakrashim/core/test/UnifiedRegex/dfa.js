@@ -0,0 +1,123 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+WScript.LoadScriptFile("..\\UnitTestFramework\\UnitTestFramework.js");
+
+function repeat(s, n) {
+    var result = "";
+    for (var i = 0; i < n; i++) {
+        result += s;
+    }
+    return result;
+}
+
+var tests = [
+    {
+        name: "Nested loops should fail without backtracking through every way of splitting the input",
+        body: function () {
+            var input = repeat("a", 30) + "!";
+            assert.areEqual(false, /^(a+)+$/.test(input), "nested quantifiers");
+            assert.areEqual(false, /^(a|aa)+$/.test(input), "overlapping alternatives");
+            assert.areEqual(null, /([xz]+[xz]+)+[yw]/.exec(repeat("x", 30)), "unanchored");
+            assert.areEqual(-1, (repeat("ab", 15) + "!").search(/^(ab|a|b)*$/), "search");
+        }
+    },
+    {
+        name: "Groups should be captured from the leftmost match",
+        body: function () {
+            var result = /a+bc|b/.exec("xaaabc");
+            assert.areEqual(1, result.index, "match ending after the earliest match to end");
+            assert.areEqual("aaabc", result[0], "result[0]");
+
+            result = /(a|ab)(c|bcd)(d*)/.exec("xabcd");
+            assert.areEqual(1, result.index, "result.index");
+            assert.areEqual(["abcd", "a", "bcd", ""], Array.prototype.slice.call(result), "groups");
+
+            result = /(a+)+(b)/.exec("--aaab");
+            assert.areEqual(2, result.index, "nested loop result.index");
+            assert.areEqual(["aaab", "aaa", "b"], Array.prototype.slice.call(result), "nested loop groups");
+        }
+    },
+    {
+        name: "The leftmost match should be found when an earlier match to end begins further right",
+        body: function () {
+            var result = /[ab][^z]*z|[bc]/.exec("-a-b-z");
+            assert.areEqual(1, result.index, "leftmost match ends after a match that begins later");
+            assert.areEqual("a-b-z", result[0], "result[0]");
+
+            result = /([ab]|[ab][ab])+[cd]|[ef]/.exec("xef-abababd");
+            assert.areEqual(1, result.index, "match ending first");
+            assert.areEqual(4, /([ab]|[ab][ab])+[cd]|[ef]/.exec("x---abababd").index, "only the later match");
+
+            assert.areEqual(1, /[ab]+$|[cd]/.exec("xab").index, "$ in the reversed pattern");
+            assert.areEqual(2, /[ab]+$|[cd]/.exec("xacab-").index, "$ not at the end of input");
+            assert.areEqual(4, /^[ab]*[cd]|[ef]/.exec("xabde").index, "^ in the reversed pattern");
+            assert.areEqual(0, /^[ab]*[cd]|[ef]/.exec("abde").index, "^ at the beginning of input");
+            assert.areEqual(3, /([ab]*)*[cd]?$/.exec("xyzab").index, "empty matches");
+        }
+    },
+    {
+        name: "Many matches in a long input",
+        body: function () {
+            var input = repeat("ab ba\t", 2000);
+            assert.areEqual(repeat("-", 4000), input.replace(/([ab]|[ab][ab])+[ \t]/g, "-"), "global replace");
+            assert.areEqual(4000, input.match(/([ab]|[ab][ab])+[ \t]/g).length, "match count");
+            assert.areEqual(null, /([ab]|[ab][ab])+[cd]/.exec(input), "no match");
+        }
+    },
+    {
+        name: "Global and sticky matches should begin at lastIndex",
+        body: function () {
+            assert.areEqual("<ab> <aab> <aaab>", "ab aab aaab".replace(/(a|aa)+b/g, "<$&>"), "global replace");
+            assert.areEqual("-a-b-c-", "abc".replace(/(x|y)*/g, "-"), "empty matches");
+
+            var re = /(a|b)+c/g;
+            var input = "abc-bc-c";
+            assert.areEqual("abc", re.exec(input)[0], "first global match");
+            assert.areEqual("bc", re.exec(input)[0], "second global match");
+            assert.areEqual(null, re.exec(input), "no third global match");
+            assert.areEqual(0, re.lastIndex, "lastIndex reset");
+
+            re = /(a|b)*c/y;
+            re.lastIndex = 2;
+            assert.areEqual("abc", re.exec("xxabc")[0], "sticky match");
+            re.lastIndex = 1;
+            assert.areEqual(null, re.exec("xxabc"), "sticky match must begin at lastIndex");
+        }
+    },
+    {
+        name: "Anchors, case insensitivity, non-ASCII characters and bounded loops",
+        body: function () {
+            assert.areEqual(true, /^(a|b)*$/.test("abab"), "^ and $");
+            assert.areEqual(1, /(a|b)*$/.exec("xab").index, "$ only");
+            assert.areEqual(null, /x^(a|b)*/.exec("xab"), "^ after a character");
+            assert.areEqual(["", undefined], Array.prototype.slice.call(/^(a*)*$/.exec("")), "empty input");
+            assert.areEqual(2, /(ab|cd)+E/i.exec("xxABcDe").index, "ignore case");
+            assert.areEqual(2, /[\u0400-\u04ff]+(\u0394|x)*!/.exec("ab\u0416\u0417\u0394!").index, "non-ASCII");
+            assert.areEqual(null, /[^\u0394]+(a|b)*\u0394/.exec("\u0394\u0394"), "negated non-ASCII set");
+            assert.areEqual("babc", /(a|b){2,3}c/.exec("ababc")[0], "bounded loop");
+            assert.areEqual("xababy", /x(a|ab){2}y/.exec("-xababy")[0], "exact loop");
+            assert.areEqual("a\nbEND", /(.|\n)*?END/.exec("a\nbEND")[0], "non-greedy loop");
+            assert.areEqual(1, /(a|b)*c$/m.exec("xabc\n").index, "multiline $");
+            assert.areEqual(["aab", "a"], Array.prototype.slice.call(/(a+)+\1b/.exec("aab")), "backreference");
+        }
+    },
+    {
+        name: "Patterns synchronized to a literal should not backtrack through everything before it",
+        body: function () {
+            var prefix = repeat("a", 40);
+            assert.areEqual(null, /(a|aa)+ERROR$/.exec(prefix + "ERROR!"), "literal found but no match");
+            assert.areEqual(0, /(a|aa)+ERROR$/.exec(prefix + "ERROR").index, "match");
+            assert.areEqual(9, /(a|aa)+ERROR$/.exec("aaaERROR!aaERROR").index, "match after a failed window");
+            assert.areEqual(null, /(a|aa)+ERROR$/.exec(prefix), "no literal");
+
+            var result = /x(a|aa)+ERROR/.exec(prefix + "xaaaERROR");
+            assert.areEqual(40, result.index, "result.index");
+            assert.areEqual(["xaaaERROR", "a"], Array.prototype.slice.call(result), "groups");
+        }
+    },
+];
+
+testRunner.runTests(tests, { verbose: WScript.Arguments[0] != 'summary' });
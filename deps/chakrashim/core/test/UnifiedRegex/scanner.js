@@ -23,6 +23,59 @@ var tests = [
             assert.areEqual(7, result.index, "result.index");
         }
     },
+    {
+        name: "Unbounded backup to a required literal should not skip a start that can consume the characters before it",
+        body: function () {
+            var log = "INFO  start\nDEBUG   x\n  \t ERROR   disk_full\nWARN low\n";
+            var result = /\s+ERROR\s+(\w+)/.exec(log);
+            assert.areNotEqual(null, result, "result");
+            assert.areEqual(21, result.index, "result.index");
+            assert.areEqual("\n  \t ERROR   disk_full", result[0], "result[0]");
+            assert.areEqual("disk_full", result[1], "result[1]");
+
+            assert.areEqual(null, /\s+ERROR\s+(\w+)/.exec("ERROR x, xERROR y"), "no whitespace before any ERROR");
+            assert.areEqual(5, /\s+ERROR\s+(\w+)/.exec("ERROR  ERROR x").index, "second ERROR");
+            assert.areEqual(3, /[a-z]*=\d+/.exec("12 key=34").index, "backup over a loop that may be empty");
+            assert.areEqual(0, /[a-z]*=\d+/.exec("=5").index, "backup to the start of the input");
+        }
+    },
+    {
+        name: "Unbounded backup with groups, alternations and backreferences before the required literal",
+        body: function () {
+            var result = /(a+|b+)\1*END/.exec("xxabbbbEND aaaEND");
+            assert.areEqual(3, result.index, "result.index");
+            assert.areEqual("bbbbEND", result[0], "result[0]");
+            assert.areEqual("bbbb", result[1], "result[1]");
+
+            result = /(\w)\1+:(\d+)/.exec("a: bb:1 cc:22");
+            assert.areEqual(3, result.index, "backreference in the prefix");
+            assert.areEqual("1", result[2], "result[2]");
+
+            result = /(?:ab)+c*XYZ/.exec("abab abababccXYZ");
+            assert.areEqual(5, result.index, "loop over a group in the prefix");
+            assert.areEqual("abababccXYZ", result[0], "result[0]");
+
+            var re = /\s*(ERROR|WARN)\d*/g;
+            var found = [];
+            var m;
+            while ((m = re.exec("  WARN1 x \tERROR22 ERRO WARN")) !== null) {
+                found.push(m.index + ":" + m[0]);
+            }
+            assert.areEqual(["0:  WARN1", "9: \tERROR22", "23: WARN"], found, "global search through an alternation of literals");
+        }
+    },
+    {
+        name: "Case insensitive and single character synchronization",
+        body: function () {
+            assert.areEqual(3, /\s+error:/i.exec("ok; \t\tErRoR: x").index, "case insensitive literal");
+            assert.areEqual(null, /\s+error:/i.exec("ok;error: x"), "case insensitive literal without whitespace");
+            assert.areEqual(6, /[a-z]+\./.exec("123 4 abc.d").index, "single character");
+            assert.areEqual(40, /[0-9]*#/.exec("--------------------------------------- 12#").index, "single character past several blocks");
+            assert.areEqual(41, "----------------------------------------0x".search(/x/), "character at the end of the input");
+            assert.areEqual(-1, "----------------------------------------0".search(/[xy]/), "character absent from the input");
+            assert.areEqual(17, "_________________\u0394Y".search(/[\u0394\u03b4]Y/i), "non-ASCII character pair");
+        }
+    },
 ];
 
 testRunner.runTests(tests, { verbose: WScript.Arguments[0] != 'summary' });
@@ -819,6 +819,54 @@ var tests = [
             assert.areEqual("test", map.get(key), "1.0 should be equal to the key 1 and map to 'test'");
         }
     },
+
+    {
+        name: "Iterators keep their place while the map grows, shrinks and is cleared",
+        body: function () {
+            var map = new Map();
+            var i;
+            for (i = 0; i < 1000; i++) {
+                map.set(i, i * 2);
+            }
+
+            var entries = map.entries();
+            for (i = 0; i < 10; i++) {
+                assert.areEqual([i, i * 2], entries.next().value, "first entries in insertion order");
+            }
+
+            // Deleting most of the entries makes the map compact itself
+            for (i = 0; i < 1000; i++) {
+                if (i % 100 !== 50) {
+                    map.delete(i);
+                }
+            }
+            assert.areEqual(10, map.size, "ten entries left");
+            assert.isTrue(map.get(150) === 300 && !map.has(151), "remaining entries are still found");
+
+            // Adding many entries makes the map grow
+            for (i = 0; i < 500; i++) {
+                map.set("k" + i, i);
+            }
+
+            var keys = [];
+            var next;
+            while (!(next = entries.next()).done) {
+                keys.push(next.value[0]);
+            }
+            assert.areEqual(510, keys.length, "the iterator sees the remaining and the added entries");
+            assert.areEqual(50, keys[0], "entries after the iterator position come first");
+            assert.areEqual(950, keys[9], "in insertion order");
+            assert.areEqual("k0", keys[10], "followed by the added entries");
+            assert.areEqual("k499", keys[509], "up to the last one");
+
+            var values = map.values();
+            values.next();
+            map.clear();
+            map.set("a", 1);
+            assert.areEqual({ value: 1, done: false }, values.next(), "an iterator moves to the start of a cleared map");
+            assert.areEqual({ value: undefined, done: true }, values.next(), "and ends after the new entries");
+        }
+    },
 ];
 
 testRunner.runTests(tests, { verbose: WScript.Arguments[0] != "summary" });
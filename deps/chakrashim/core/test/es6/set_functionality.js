@@ -742,6 +742,54 @@ var tests = [
             assert.isTrue(set.has(value), "1.0 should be equal to the value 1 and set has it");
         }
     },
+
+    {
+        name: "Iterators keep their place while the set grows, shrinks and is cleared",
+        body: function () {
+            var set = new Set();
+            var i;
+            for (i = 0; i < 1000; i++) {
+                set.add(i);
+            }
+
+            var values = set.values();
+            for (i = 0; i < 10; i++) {
+                assert.areEqual(i, values.next().value, "first values in insertion order");
+            }
+
+            // Deleting most of the values makes the set compact itself
+            for (i = 0; i < 1000; i++) {
+                if (i % 100 !== 50) {
+                    set.delete(i);
+                }
+            }
+            assert.areEqual(10, set.size, "ten values left");
+            assert.isTrue(set.has(150) && !set.has(151), "remaining values are still found");
+
+            // Adding many values makes the set grow
+            for (i = 0; i < 500; i++) {
+                set.add("v" + i);
+            }
+
+            var seen = [];
+            var next;
+            while (!(next = values.next()).done) {
+                seen.push(next.value);
+            }
+            assert.areEqual(510, seen.length, "the iterator sees the remaining and the added values");
+            assert.areEqual(50, seen[0], "values after the iterator position come first");
+            assert.areEqual(950, seen[9], "in insertion order");
+            assert.areEqual("v0", seen[10], "followed by the added values");
+            assert.areEqual("v499", seen[509], "up to the last one");
+
+            values = set.values();
+            values.next();
+            set.clear();
+            set.add("a");
+            assert.areEqual({ value: "a", done: false }, values.next(), "an iterator moves to the start of a cleared set");
+            assert.areEqual({ value: undefined, done: true }, values.next(), "and ends after the new values");
+        }
+    },
 ];
 
 testRunner.runTests(tests, { verbose: WScript.Arguments[0] != "summary" });
@@ -0,0 +1,137 @@
+//-------------------------------------------------------------------------------------------------------
+// Copyright (C) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE.txt file in the project root for full license information.
+//-------------------------------------------------------------------------------------------------------
+
+// %TypedArray%.prototype.sort with and without a compare function, for short arrays and for arrays long enough to be radix sorted
+
+if (this.WScript && this.WScript.LoadScriptFile) { // Check for running in ch
+    this.WScript.LoadScriptFile("..\\UnitTestFramework\\UnitTestFramework.js");
+}
+
+function pseudoRandom(seed) {
+    return function () {
+        seed = (seed * 1103515245 + 12345) & 0x7fffffff;
+        return seed;
+    };
+}
+
+function checkSorted(ta, message) {
+    for (var i = 1; i < ta.length; i++) {
+        assert.isFalse(ta[i - 1] > ta[i], message + ": element " + i);
+    }
+}
+
+var tests = [
+    {
+        name: "Integer typed arrays sort numerically",
+        body: function () {
+            var ctors = [Int8Array, Uint8Array, Uint8ClampedArray, Int16Array, Uint16Array, Int32Array, Uint32Array];
+            [5, 1000].forEach(function (length) {
+                ctors.forEach(function (ctor) {
+                    var next = pseudoRandom(length);
+                    var ta = new ctor(length);
+                    var copy = [];
+                    for (var i = 0; i < length; i++) {
+                        ta[i] = next() * (next() & 1 ? -1 : 1);
+                        copy.push(ta[i]);
+                    }
+                    ta.sort();
+                    copy.sort(function (a, b) { return a - b; });
+                    assert.areEqual(copy, Array.prototype.slice.call(ta), ctor.name + " of length " + length);
+                });
+            });
+
+            var ta = new Int32Array([2147483647, -2147483648, 0, -1, 1, 10, 9]);
+            ta.sort();
+            assert.areEqual([-2147483648, -1, 0, 1, 9, 10, 2147483647], Array.prototype.slice.call(ta), "Int32Array extremes");
+        }
+    },
+    {
+        name: "Float typed arrays put -0 before +0 and NaN last",
+        body: function () {
+            [Float32Array, Float64Array].forEach(function (ctor) {
+                [0, 100].forEach(function (padding) {
+                    var values = [NaN, 0, Infinity, -0, -1.5, 1.5, -Infinity, NaN, -0, 0];
+                    for (var i = 1; i <= padding; i++) {
+                        values.push(i % 2 ? i / 4 : -i / 4);
+                    }
+                    var ta = new ctor(values);
+                    ta.sort();
+                    checkSorted(ta, ctor.name);
+
+                    var firstZero = Array.prototype.indexOf.call(ta, 0);
+                    assert.isTrue(Object.is(ta[firstZero], -0) && Object.is(ta[firstZero + 1], -0), ctor.name + ": -0 first");
+                    assert.isTrue(Object.is(ta[firstZero + 2], 0) && Object.is(ta[firstZero + 3], 0), ctor.name + ": then +0");
+                    assert.areEqual(-Infinity, ta[0], ctor.name + ": -Infinity first");
+                    assert.isTrue(isNaN(ta[ta.length - 1]) && isNaN(ta[ta.length - 2]), ctor.name + ": NaN last");
+                    assert.areEqual(Infinity, ta[ta.length - 3], ctor.name + ": Infinity before NaN");
+                });
+            });
+        }
+    },
+    {
+        name: "Compare function order is stable and exceptions leave the elements intact",
+        body: function () {
+            var ta = new Int32Array(600);
+            for (var i = 0; i < ta.length; i++) {
+                ta[i] = i;
+            }
+
+            // Sort by the last digit only; ties keep their original order
+            ta.sort(function (a, b) { return (a % 10) - (b % 10); });
+            for (var i = 1; i < ta.length; i++) {
+                var a = ta[i - 1], b = ta[i];
+                assert.isTrue(a % 10 < b % 10 || (a % 10 === b % 10 && a < b), "stable at " + i);
+            }
+
+            var before = Array.prototype.slice.call(ta);
+            var calls = 0;
+            assert.throws(function () {
+                ta.sort(function (a, b) {
+                    if (++calls === 1000) {
+                        throw new Error("stop");
+                    }
+                    return a - b;
+                });
+            }, Error, "exception from the compare function is propagated", "stop");
+            assert.areEqual(before, Array.prototype.slice.call(ta), "elements are untouched after an exception");
+        }
+    },
+    {
+        name: "Detaching the buffer in the compare function throws",
+        body: function () {
+            var ta = new Float64Array([3, 2, 1]);
+            assert.throws(function () {
+                ta.sort(function (a, b) {
+                    ArrayBuffer.transfer(ta.buffer, 0);
+                    return a - b;
+                });
+            }, TypeError, "sort throws once the buffer is detached");
+            assert.areEqual(0, ta.length, "the array is detached");
+        }
+    },
+    {
+        name: "Detaching the buffer while converting the compare function's result throws",
+        body: function () {
+            [Int8Array, Uint16Array, Int32Array, Float32Array, Float64Array].forEach(function (ctor) {
+                var ta = new ctor([5, 1, 4, 2, 3]);
+                var result = { valueOf: function () { ArrayBuffer.transfer(ta.buffer, 0); return -1; } };
+                assert.throws(function () {
+                    ta.sort(function (a, b) { return result; });
+                }, TypeError, ctor.name + ": sort throws once valueOf detached the buffer");
+                assert.areEqual(0, ta.length, ctor.name + ": the array is detached");
+            });
+
+            // Only the last comparison detaches
+            var ta = new Int32Array([2, 1]);
+            assert.throws(function () {
+                ta.sort(function (a, b) {
+                    return { valueOf: function () { ArrayBuffer.transfer(ta.buffer, 0); return a - b; } };
+                });
+            }, TypeError, "sort throws when the last comparison detached the buffer");
+        }
+    },
+];
+
+testRunner.runTests(tests, { verbose: WScript.Arguments[0] != "summary" });
@@ -820,6 +820,30 @@ class V8_EXPORT Script {
   Local<UnboundScript> GetUnboundScript();
 };
 
+namespace chakrashim {
+// Same as Script::Compile, but the engine parses |utf8Source|, a NUL-terminated
+// utf8 copy of |source| that lives as long as the isolate (e.g. a js2c
+// native), in place instead of re-encoding the UTF-16 string.
+V8_EXPORT MaybeLocal<Script> CompileStaticUtf8(Local<Context> context,
+                                               Local<String> source,
+                                               const char* utf8Source,
+                                               ScriptOrigin* origin = nullptr);
+
+// Same as Script::Compile of |head| + |content| + |tail|, but the engine
+// parses a view of the file at |path| in place and keeps the script's source
+// there instead of in the GC heap. Meant for large module files; sets
+// |mapped| to false and returns nothing when |content| is short or the file
+// doesn't hold it in utf8, e.g. it has a byte order mark or has changed since
+// it was read. A leading "#!" line in the file is read as a comment.
+V8_EXPORT MaybeLocal<Script> CompileMappedSource(Local<Context> context,
+                                                 Local<String> path,
+                                                 Local<String> content,
+                                                 const char* head,
+                                                 const char* tail,
+                                                 ScriptOrigin* origin,
+                                                 bool* mapped);
+}  // namespace chakrashim
+
 class V8_EXPORT ScriptCompiler {
  public:
   struct CachedData {
@@ -1492,6 +1516,8 @@ class V8_EXPORT Date : public Object {
                                                      double time);
 
   static Date *Cast(Value *obj);
+
+  static void DateTimeConfigurationChangeNotification(Isolate* isolate);
 };
 
 class V8_EXPORT RegExp : public Object {
@@ -1743,6 +1769,22 @@ class V8_EXPORT ArrayBuffer : public Object {
   ArrayBuffer();
 };
 
+namespace chakrashim {
+// JSON.stringify(|value|) encoded as utf8 into a new ArrayBuffer, without
+// creating the string in between. The result is undefined where
+// JSON.stringify returns undefined, and empty if it threw.
+V8_EXPORT MaybeLocal<Value> StringifyUtf8(Local<Context> context,
+                                          Local<Value> value);
+
+// JSON.parse(|data|, |reviver|) of |length| bytes of utf8 text, scanned
+// without decoding it to a string first. |reviver| may be empty. The result
+// is empty if parsing threw.
+V8_EXPORT MaybeLocal<Value> ParseJsonUtf8(Local<Context> context,
+                                          const char* data,
+                                          size_t length,
+                                          Local<Value> reviver);
+}  // namespace chakrashim
+
 class V8_EXPORT ArrayBufferView : public Object {
  public:
   Local<ArrayBuffer> Buffer();
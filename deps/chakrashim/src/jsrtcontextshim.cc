@@ -418,23 +418,12 @@ bool ContextShim::ExposeGc() {
 }
 
 bool ContextShim::ExecuteChakraShimJS() {
-  wchar_t buffer[_countof(chakra_shim_native) + 1];
-
-  if (StringConvert::CopyRaw<unsigned char, wchar_t>(chakra_shim_native,
-      _countof(chakra_shim_native),
-      buffer,
-      _countof(chakra_shim_native)) != JsNoError) {
-    return false;
-  }
-
-  // Ensure the buffer is null terminated
-  buffer[_countof(chakra_shim_native)] = L'\0';
-
+  // js2c output is NUL-terminated utf8, parse it in place
   JsValueRef getInitFunction;
-  if (JsParseScript(buffer,
-                    JS_SOURCE_CONTEXT_NONE,
-                    L"chakra_shim.js",
-                    &getInitFunction) != JsNoError) {
+  if (ParseStaticScriptUtf8(
+        reinterpret_cast<const char *>(chakra_shim_native),
+        "chakra_shim.js",
+        &getInitFunction) != JsNoError) {
     return false;
   }
   JsValueRef initFunction;
@@ -0,0 +1,279 @@
+// Copyright Microsoft. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#include "jsrtmappedsource.h"
+#include <string>
+#include <unordered_map>
+
+namespace jsrt {
+
+// Sources handed to the runtime, keyed by the source context they were parsed
+// with. Source contexts come from a per-thread counter and the runtime calls
+// back on the thread that parsed the script, so each thread keeps its own.
+typedef std::unordered_map<JsSourceContext, MappedSource *> MappedSourceMap;
+static __declspec(thread) MappedSourceMap *s_mappedSources;
+
+// Another thread can take the address range between releasing a probe
+// reservation and placing the view in it, so placement is retried this often
+static const int kMaxMapAttempts = 8;
+
+static size_t RoundUp(size_t value, size_t alignment) {
+  return (value + alignment - 1) & ~(alignment - 1);
+}
+
+// Whether |utf8| is exactly the utf8 encoding of |str|. The engine reads the
+// source up to the first NUL and utf8 can't carry a lone surrogate, so
+// strings with either never match; neither does a file with invalid utf8,
+// which was decoded to U+FFFD.
+static bool MatchesUtf8(const wchar_t *str, size_t length,
+                        const char *utf8, size_t utf8Length) {
+  const unsigned char *bytes = reinterpret_cast<const unsigned char *>(utf8);
+  const unsigned char *end = bytes + utf8Length;
+  for (size_t i = 0; i < length; i++) {
+    unsigned int ch = str[i];
+    unsigned char encoded[4];
+    size_t count;
+    if (ch == 0) {
+      return false;
+    } else if (ch < 0x80) {
+      encoded[0] = static_cast<unsigned char>(ch);
+      count = 1;
+    } else if (ch < 0x800) {
+      encoded[0] = static_cast<unsigned char>(0xC0 | (ch >> 6));
+      encoded[1] = static_cast<unsigned char>(0x80 | (ch & 0x3F));
+      count = 2;
+    } else if (ch >= 0xD800 && ch <= 0xDFFF) {
+      if (ch >= 0xDC00 || i + 1 == length ||
+          str[i + 1] < 0xDC00 || str[i + 1] > 0xDFFF) {
+        return false;
+      }
+      ch = 0x10000 + ((ch - 0xD800) << 10) + (str[++i] - 0xDC00);
+      encoded[0] = static_cast<unsigned char>(0xF0 | (ch >> 18));
+      encoded[1] = static_cast<unsigned char>(0x80 | ((ch >> 12) & 0x3F));
+      encoded[2] = static_cast<unsigned char>(0x80 | ((ch >> 6) & 0x3F));
+      encoded[3] = static_cast<unsigned char>(0x80 | (ch & 0x3F));
+      count = 4;
+    } else {
+      encoded[0] = static_cast<unsigned char>(0xE0 | (ch >> 12));
+      encoded[1] = static_cast<unsigned char>(0x80 | ((ch >> 6) & 0x3F));
+      encoded[2] = static_cast<unsigned char>(0x80 | (ch & 0x3F));
+      count = 3;
+    }
+
+    if (static_cast<size_t>(end - bytes) < count ||
+        memcmp(bytes, encoded, count) != 0) {
+      return false;
+    }
+    bytes += count;
+  }
+  return bytes == end;
+}
+
+MappedSource * MappedSource::New(JsValueRef path,
+                                 JsValueRef content,
+                                 const char *head,
+                                 const char *tail) {
+  const wchar_t *str;
+  size_t length;
+  const wchar_t *pathStr;
+  size_t pathLength;
+  if (JsStringToPointer(content, &str, &length) != JsNoError ||
+      length < kMinSourceLength ||
+      JsStringToPointer(path, &pathStr, &pathLength) != JsNoError) {
+    return nullptr;
+  }
+
+  SYSTEM_INFO systemInfo;
+  GetSystemInfo(&systemInfo);
+  const size_t pageSize = systemInfo.dwPageSize;
+  const size_t granularity = systemInfo.dwAllocationGranularity;
+  const size_t headLength = strlen(head);
+  const size_t tailLength = strlen(tail);
+  if (headLength > pageSize) {
+    return nullptr;
+  }
+
+  const std::wstring filename(pathStr, pathLength);
+  HANDLE file = CreateFileW(filename.c_str(), GENERIC_READ,
+                            FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return nullptr;
+  }
+  MappedSource *mappedSource = new MappedSource(file);
+
+  // Every character of |content| takes at least a byte of the file, and the
+  // tail and its NUL have to fit after the end of the file in its last page
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize) ||
+      fileSize.QuadPart < static_cast<LONGLONG>(length) ||
+      fileSize.QuadPart > MAXDWORD ||
+      RoundUp(static_cast<size_t>(fileSize.QuadPart), pageSize) -
+        static_cast<size_t>(fileSize.QuadPart) < tailLength + 1 ||
+      !mappedSource->Map(static_cast<size_t>(fileSize.QuadPart), pageSize,
+                         granularity)) {
+    delete mappedSource;
+    return nullptr;
+  }
+
+  const size_t size = static_cast<size_t>(fileSize.QuadPart);
+  char *view = mappedSource->view;
+  if (size >= 3 && view[0] == '\xEF' && view[1] == '\xBB' &&
+      view[2] == '\xBF') {
+    delete mappedSource;
+    return nullptr;
+  }
+
+  // The loader strips "#!" up to the first line break. Anything but ASCII
+  // there could end the comment early (e.g. U+2028), so such files fall back.
+  size_t offset = 0;
+  if (size >= 2 && view[0] == '#' && view[1] == '!') {
+    offset = 2;
+    while (offset < size && view[offset] != '\n' && view[offset] != '\r') {
+      if (static_cast<unsigned char>(view[offset]) >= 0x80) {
+        delete mappedSource;
+        return nullptr;
+      }
+      offset++;
+    }
+  }
+
+  if (!MatchesUtf8(str, length, view + offset, size - offset)) {
+    delete mappedSource;
+    return nullptr;
+  }
+
+  // Writes go to private copies of the pages they touch: the head's page,
+  // the first page for a "#!" line and the last page for the tail
+  char *source = view - headLength;
+  memcpy(source, head, headLength);
+  if (offset != 0) {
+    view[0] = '/';
+    view[1] = '/';
+  }
+  memcpy(view + size, tail, tailLength);
+  view[size + tailLength] = '\0';
+
+  DWORD oldProtect;
+  VirtualProtect(view - pageSize, pageSize, PAGE_READONLY, &oldProtect);
+  VirtualProtect(view, size + tailLength + 1, PAGE_READONLY, &oldProtect);
+
+  mappedSource->source = source;
+  return mappedSource;
+}
+
+// Places a copy-on-write view of the file at the start of an allocation
+// granule and reserves the granule before it, committing its last page for
+// the head
+bool MappedSource::Map(size_t fileSize, size_t pageSize, size_t granularity) {
+  HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0,
+                                      nullptr);
+  if (mapping == nullptr) {
+    return false;
+  }
+
+  for (int attempt = 0; attempt < kMaxMapAttempts && view == nullptr;
+       attempt++) {
+    char *base = static_cast<char *>(
+      VirtualAlloc(nullptr, granularity + RoundUp(fileSize, granularity),
+                   MEM_RESERVE, PAGE_NOACCESS));
+    if (base == nullptr) {
+      break;
+    }
+    VirtualFree(base, 0, MEM_RELEASE);
+
+    headBlock = static_cast<char *>(
+      VirtualAlloc(base, granularity, MEM_RESERVE, PAGE_NOACCESS));
+    if (headBlock == nullptr) {
+      continue;
+    }
+    view = static_cast<char *>(
+      MapViewOfFileEx(mapping, FILE_MAP_COPY, 0, 0, 0, base + granularity));
+    if (view == nullptr ||
+        VirtualAlloc(view - pageSize, pageSize, MEM_COMMIT,
+                     PAGE_READWRITE) == nullptr) {
+      if (view != nullptr) {
+        UnmapViewOfFile(view);
+        view = nullptr;
+      }
+      VirtualFree(headBlock, 0, MEM_RELEASE);
+      headBlock = nullptr;
+    }
+  }
+
+  // The view keeps the mapping alive
+  CloseHandle(mapping);
+  return view != nullptr;
+}
+
+MappedSource::~MappedSource() {
+  if (view != nullptr) {
+    UnmapViewOfFile(view);
+  }
+  if (headBlock != nullptr) {
+    VirtualFree(headBlock, 0, MEM_RELEASE);
+  }
+  CloseHandle(file);
+}
+
+static bool CALLBACK MappedSourceLoadCallback(JsSourceContext sourceContext,
+                                              const char** scriptBuffer) {
+  auto it = s_mappedSources->find(sourceContext);
+  if (it == s_mappedSources->end()) {
+    return false;
+  }
+
+  *scriptBuffer = it->second->Load();
+  return true;
+}
+
+static void CALLBACK MappedSourceUnloadCallback(
+    JsSourceContext sourceContext) {
+  auto it = s_mappedSources->find(sourceContext);
+  if (it != s_mappedSources->end()) {
+    delete it->second;
+    s_mappedSources->erase(it);
+  }
+}
+
+JsErrorCode MappedSource::Parse(JsSourceContext sourceContext,
+                                const char *sourceUrl,
+                                JsValueRef *result) {
+  if (s_mappedSources == nullptr) {
+    s_mappedSources = new MappedSourceMap();
+  }
+  CHAKRA_ASSERT(s_mappedSources->find(sourceContext) ==
+                s_mappedSources->end());
+  (*s_mappedSources)[sourceContext] = this;
+
+  // Once the runtime has loaded the source the unload callback releases it,
+  // even if the parse itself fails. The runtime loads it as soon as it has a
+  // holder for it, so if it failed before that nothing else will.
+  JsErrorCode error = JsParseScriptWithCallbackUtf8(
+    MappedSourceLoadCallback, MappedSourceUnloadCallback, sourceContext,
+    sourceUrl, JsParseScriptAttributeNone, result);
+  if (error != JsNoError && !isLoaded) {
+    s_mappedSources->erase(sourceContext);
+    delete this;
+  }
+  return error;
+}
+
+}  // namespace jsrt
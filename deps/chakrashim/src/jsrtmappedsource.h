@@ -0,0 +1,81 @@
+// Copyright Microsoft. All rights reserved.
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files(the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and / or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions :
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+
+#pragma once
+
+#include "jsrtutils.h"
+
+namespace jsrt {
+
+// A view of a script file laid out as the script the engine is asked to
+// parse: a head in the page just before the file's first page and a tail in
+// the slack after the end of the file, so the engine parses the file in
+// place. The file's pages stay clean, so the system can drop them under
+// memory pressure and shares them with everything else that maps the file;
+// only the head's page and the file's last page are private. The file is kept
+// open without write sharing for as long as the view exists, so it can be
+// renamed or deleted but not rewritten under the engine.
+class MappedSource {
+ public:
+  // Sources smaller than this are not worth a mapping of their own
+  static const size_t kMinSourceLength = 64 * 1024;
+
+  // Maps |path| and wraps it in |head| and |tail|. A leading "#!" line, which
+  // the module loader strips from |content|, is turned into a comment of the
+  // same length. Returns nullptr when the rest of the file isn't the utf8
+  // encoding of |content| (a byte order mark, a file changed since it was
+  // read, or a source that utf8 can't carry), when |content| is short, or
+  // when the file can't be mapped; callers then compile the string instead.
+  static MappedSource * New(JsValueRef path,
+                            JsValueRef content,
+                            const char *head,
+                            const char *tail);
+  ~MappedSource();
+
+  // Called when the runtime loads the source; from then on the runtime
+  // releases it through the unload callback
+  const char * Load() {
+    isLoaded = true;
+    return source;
+  }
+
+  // Parses the mapped source. The runtime takes ownership of this object and
+  // deletes it once no function created from the script is alive. If the
+  // parse fails before the runtime has loaded the source, this object is
+  // deleted before returning.
+  JsErrorCode Parse(JsSourceContext sourceContext,
+                    const char *sourceUrl,
+                    JsValueRef *result);
+
+ private:
+  explicit MappedSource(HANDLE file)
+    : file(file), headBlock(nullptr), view(nullptr), source(nullptr),
+      isLoaded(false) {}
+
+  bool Map(size_t fileSize, size_t pageSize, size_t granularity);
+
+  HANDLE file;
+  char *headBlock;  // reservation just before the view
+  char *view;
+  const char *source;  // start of the head
+  bool isLoaded;
+};
+
+}  // namespace jsrt
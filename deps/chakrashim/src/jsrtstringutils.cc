@@ -20,9 +20,124 @@
 
 #include "jsrtutils.h"
 #include <memory>
+#if defined(_M_IX86) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
 namespace jsrt {
 
 using std::unique_ptr;
+
+// The ascii helpers below handle the ascii characters at the start of a
+// string, 8 or 16 at a time where SSE2 is available, and return how many
+// there are.
+static size_t AsciiPrefixLength(const wchar_t *str, size_t length) {
+  size_t i = 0;
+#if defined(_M_IX86) || defined(_M_X64)
+  const __m128i nonAsciiBits = _mm_set1_epi16(static_cast<short>(0xFF80));
+  const __m128i zero = _mm_setzero_si128();
+  for (; length - i >= 8; i += 8) {
+    __m128i chars =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i));
+    __m128i nonAscii = _mm_and_si128(chars, nonAsciiBits);
+    if (_mm_movemask_epi8(_mm_cmpeq_epi16(nonAscii, zero)) != 0xFFFF) {
+      break;
+    }
+  }
+#endif
+  while (i < length && str[i] < 0x80) {
+    i++;
+  }
+  return i;
+}
+
+static size_t NarrowAsciiPrefix(const wchar_t *str, size_t length,
+                                char* buffer) {
+  size_t i = 0;
+#if defined(_M_IX86) || defined(_M_X64)
+  const __m128i nonAsciiBits = _mm_set1_epi16(static_cast<short>(0xFF80));
+  const __m128i zero = _mm_setzero_si128();
+  for (; length - i >= 16; i += 16) {
+    __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i));
+    __m128i high =
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i + 8));
+    __m128i nonAscii = _mm_and_si128(_mm_or_si128(low, high), nonAsciiBits);
+    if (_mm_movemask_epi8(_mm_cmpeq_epi16(nonAscii, zero)) != 0xFFFF) {
+      break;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(buffer + i),
+                     _mm_packus_epi16(low, high));
+  }
+#endif
+  for (; i < length && str[i] < 0x80; i++) {
+    buffer[i] = static_cast<char>(str[i]);
+  }
+  return i;
+}
+
+static size_t WidenAsciiPrefix(const char *str, size_t length,
+                               wchar_t* buffer) {
+  size_t i = 0;
+#if defined(_M_IX86) || defined(_M_X64)
+  const __m128i zero = _mm_setzero_si128();
+  for (; length - i >= 16; i += 16) {
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(str + i));
+    if (_mm_movemask_epi8(bytes) != 0) {
+      break;
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(buffer + i),
+                     _mm_unpacklo_epi8(bytes, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(buffer + i + 8),
+                     _mm_unpackhi_epi8(bytes, zero));
+  }
+#endif
+  for (; i < length && static_cast<uint8_t>(str[i]) < 0x80; i++) {
+    buffer[i] = static_cast<wchar_t>(str[i]);
+  }
+  return i;
+}
+
+// Returns how many of the characters at the start of str fit in capacity
+// bytes of UTF-8 without splitting a surrogate pair, and the bytes they take.
+// Unpaired surrogates take 3 bytes, as WideCharToMultiByte writes them as
+// U+FFFD.
+static size_t UTF8PrefixLength(const wchar_t *str, size_t length,
+                               size_t capacity, __out size_t *utf8Length) {
+  size_t i = 0;
+  size_t bytes = 0;
+  while (i < length) {
+    size_t charLength = 1;
+    size_t charBytes;
+    if (str[i] < 0x80) {
+      size_t asciiLength =
+        AsciiPrefixLength(str + i, min(length - i, capacity - bytes));
+      if (asciiLength == 0) {
+        break;
+      }
+      i += asciiLength;
+      bytes += asciiLength;
+      continue;
+    } else if (str[i] < 0x800) {
+      charBytes = 2;
+    } else if (IS_HIGH_SURROGATE(str[i]) && i + 1 < length &&
+               IS_LOW_SURROGATE(str[i + 1])) {
+      charLength = 2;
+      charBytes = 4;
+    } else {
+      charBytes = 3;
+    }
+
+    if (capacity - bytes < charBytes) {
+      break;
+    }
+    i += charLength;
+    bytes += charBytes;
+  }
+
+  *utf8Length = bytes;
+  return i;
+}
+
 JsErrorCode StringConvert::GetCharLength(const wchar_t *str,
                                          const size_t length,
                                          const int code,
@@ -47,6 +162,13 @@ JsErrorCode StringConvert::GetCharLength(const wchar_t *str,
   return JsNoError;
 }
 
+JsErrorCode StringConvert::GetUTF8Length(const wchar_t *str,
+                                         const size_t length,
+                                         __out size_t *utf8Length) {
+  UTF8PrefixLength(str, length, static_cast<size_t>(-1), utf8Length);
+  return JsNoError;
+}
+
 JsErrorCode StringConvert::InternalToChar(const wchar_t *str,
                                           const size_t length,
                                           const int code,
@@ -138,6 +260,52 @@ JsErrorCode StringConvert::InternalToChar(const wchar_t *str,
   return JsNoError;
 }
 
+JsErrorCode StringConvert::InternalToUTF8Char(const wchar_t *str,
+                                              const size_t length,
+                                              char* buffer,
+                                              size_t bufferSize,
+                                              __out size_t *bytesWritten,
+                                              __out size_t *charsWritten) {
+  // The ascii prefix is copied directly. The length of the rest is worked out
+  // up front, so that it is converted in one call even when the buffer only
+  // has room for part of it.
+  size_t asciiLength =
+    NarrowAsciiPrefix(str, min(length, bufferSize), buffer);
+  size_t utf8Length = 0;
+  size_t strLengthToWrite = asciiLength + UTF8PrefixLength(
+    str + asciiLength, length - asciiLength, bufferSize - asciiLength,
+    &utf8Length);
+
+  size_t result = asciiLength;
+  if (strLengthToWrite > asciiLength) {
+    DWORD converted = WideCharToMultiByte(
+      CP_UTF8,
+      0,
+      str + asciiLength,
+      static_cast<int>(strLengthToWrite - asciiLength),
+      buffer + asciiLength,
+      static_cast<int>(utf8Length),
+      NULL,
+      NULL);
+
+    if (converted == 0) {
+      // This should never happen.
+      return JsErrorFatal;
+    }
+    result += converted;
+  }
+
+  if (bytesWritten != nullptr) {
+    *bytesWritten = result;
+  }
+
+  if (charsWritten != nullptr) {
+    *charsWritten = strLengthToWrite;
+  }
+
+  return JsNoError;
+}
+
 JsErrorCode StringConvert::InternalToWChar(const char *str,
                                            const size_t length,
                                            const int code,
@@ -152,42 +320,60 @@ JsErrorCode StringConvert::InternalToWChar(const char *str,
   }
 
   //
-  // Get length (in wchar_t's) of resulting UTF-16 string
+  // Widen the ascii prefix directly, which is often the whole string
   //
-  const int utf16Length = ::MultiByteToWideChar(
-    code,                      // convert the given code
-    0,                         // flags
-    str,                       // source string
-    static_cast<int>(length),  // length (in chars) of source string
-    NULL,                      // unused - no conversion done in this step
-    0);           // request size of destination buffer, in wchar_t's
-
-  if (utf16Length == 0) {
-    // Error
-    return JsErrorFatal;
+  size_t asciiLength = 0;
+  if (code == CP_UTF8) {
+    asciiLength = WidenAsciiPrefix(str, min(length, size), buffer);
+    if (asciiLength == length) {
+      *charsWritten = asciiLength;
+      return JsNoError;
+    }
+    if (asciiLength == size) {
+      // The buffer is full, and the rest doesn't fit
+      return JsErrorFatal;
+    }
   }
 
   if (size == -1) {
-    size = utf16Length;
+    //
+    // Get length (in wchar_t's) of resulting UTF-16 string
+    //
+    const int utf16Length = ::MultiByteToWideChar(
+      code,                      // convert the given code
+      0,                         // flags
+      str + asciiLength,         // source string
+      static_cast<int>(length - asciiLength),  // length (in chars) of source
+      NULL,                      // unused - no conversion done in this step
+      0);           // request size of destination buffer, in wchar_t's
+
+    if (utf16Length == 0) {
+      // Error
+      return JsErrorFatal;
+    }
+
+    size = asciiLength + utf16Length;
   }
 
   //
-  // Do the conversion from code to UTF-16
+  // Do the conversion from code to UTF-16. This fails if the buffer is too
+  // small, so there is no need to measure the result first.
   //
-  *charsWritten = ::MultiByteToWideChar(
+  const int converted = ::MultiByteToWideChar(
     code,                       // convert from code
-    0,                          // validation was done in previous call,
-                                // so speed up things with default flags
-    str,                        // source string
-    static_cast<int>(length),   // length (in chars) of source string
-    buffer,                     // destination buffer
-    static_cast<int>(size));    // size of destination buffer, in wchar_t's
-
-  if (*charsWritten == 0) {
+    0,                          // flags
+    str + asciiLength,          // source string
+    static_cast<int>(length - asciiLength),  // length (in chars) of source
+    buffer + asciiLength,       // destination buffer
+    static_cast<int>(size - asciiLength));   // size of destination buffer
+
+  if (converted == 0) {
     // Error
     return JsErrorFatal;
   }
 
+  *charsWritten = asciiLength + converted;
+
   //
   // Return resulting UTF-16 string
   //
@@ -35,8 +35,8 @@ class StringConvert {
                                 const size_t size,
                                 __out size_t *bytesWritten = nullptr,
                                 __out size_t *charsWrittern = nullptr) {
-    return InternalToChar(
-      str, length, CP_UTF8, buffer, size, bytesWritten, charsWrittern);
+    return InternalToUTF8Char(
+      str, length, buffer, size, bytesWritten, charsWrittern);
   }
 
   static JsErrorCode ToWChar(const char *str,
@@ -49,7 +49,7 @@ class StringConvert {
 
   static JsErrorCode UTF8CharLength(
       const wchar_t *str, const size_t length, __out size_t *utf8Length) {
-    return GetCharLength(str, length, CP_UTF8, utf8Length);
+    return GetUTF8Length(str, length, utf8Length);
   }
 
   template <class SrcChar, class DstChar>
@@ -101,6 +101,9 @@ class StringConvert {
                                    const size_t length,
                                    const int code,
                                    __out size_t *utf8Length);
+  static JsErrorCode GetUTF8Length(const wchar_t *str,
+                                   const size_t length,
+                                   __out size_t *utf8Length);
   static JsErrorCode InternalToChar(const wchar_t *str,
                                     const size_t length,
                                     const int code,
@@ -108,6 +111,12 @@ class StringConvert {
                                     size_t bufferSize,
                                     __out size_t *bytesWritten = nullptr,
                                     __out size_t *charsWritten = nullptr);
+  static JsErrorCode InternalToUTF8Char(const wchar_t *str,
+                                        const size_t length,
+                                        char* buffer,
+                                        size_t bufferSize,
+                                        __out size_t *bytesWritten,
+                                        __out size_t *charsWritten);
   static JsErrorCode InternalToWChar(const char *str,
                                      const size_t length,
                                      const int code,
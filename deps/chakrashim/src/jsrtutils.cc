@@ -742,6 +742,26 @@ JsErrorCode ParseScript(const wchar_t *script,
   }
 }
 
+static bool CALLBACK StaticScriptLoadCallback(
+    JsSourceContext sourceContext, const char** scriptBuffer) {
+  *scriptBuffer = reinterpret_cast<const char*>(sourceContext);
+  return true;
+}
+
+static void CALLBACK StaticScriptUnloadCallback(
+    JsSourceContext sourceContext) {
+  // Nothing to release, the buffer outlives the runtime
+}
+
+JsErrorCode ParseStaticScriptUtf8(const char *script,
+                                  const char *sourceUrl,
+                                  JsValueRef *result) {
+  return JsParseScriptWithCallbackUtf8(
+    StaticScriptLoadCallback, StaticScriptUnloadCallback,
+    reinterpret_cast<JsSourceContext>(script), sourceUrl,
+    JsParseScriptAttributeNone, result);
+}
+
 #define RETURN_IF_JSERROR(err, returnValue) \
 if (err != JsNoError) { \
   return returnValue; \
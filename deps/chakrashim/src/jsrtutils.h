@@ -292,6 +292,13 @@ JsErrorCode ParseScript(const wchar_t *script,
                         bool isStrictMode,
                         JsValueRef *result);
 
+// Parses a NUL-terminated utf8 script that stays alive as long as the runtime
+// (e.g. static data) without copying it. The buffer address doubles as the
+// source context.
+JsErrorCode ParseStaticScriptUtf8(const char *script,
+                                  const char *sourceUrl,
+                                  JsValueRef *result);
+
 JsErrorCode GetHiddenValuesTable(JsValueRef object,
                                 JsPropertyIdRef* hiddenValueIdRef,
                                 JsValueRef* hiddenValuesTable,
@@ -110,4 +110,26 @@ ArrayBuffer* ArrayBuffer::Cast(Value* obj) {
   return static_cast<ArrayBuffer*>(obj);
 }
 
+namespace chakrashim {
+MaybeLocal<Value> StringifyUtf8(Local<Context> context, Local<Value> value) {
+  JsValueRef result;
+  if (JsStringifyUtf8(*value, &result) != JsNoError) {
+    return Local<Value>();
+  }
+  return Local<Value>::New(result);
+}
+
+MaybeLocal<Value> ParseJsonUtf8(Local<Context> context,
+                                const char* data,
+                                size_t length,
+                                Local<Value> reviver) {
+  JsValueRef result;
+  JsValueRef reviverRef = reviver.IsEmpty() ? JS_INVALID_REFERENCE : *reviver;
+  if (JsParseJsonUtf8(data, length, reviverRef, &result) != JsNoError) {
+    return Local<Value>();
+  }
+  return Local<Value>::New(result);
+}
+}  // namespace chakrashim
+
 }  // namespace v8
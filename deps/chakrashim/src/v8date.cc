@@ -52,4 +52,8 @@ Date *Date::Cast(v8::Value *obj) {
   return static_cast<Date*>(obj);
 }
 
+void Date::DateTimeConfigurationChangeNotification(Isolate* isolate) {
+  JsResetTimeZoneCache();
+}
+
 }  // namespace v8
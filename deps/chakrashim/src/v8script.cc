@@ -19,6 +19,7 @@
 // IN THE SOFTWARE.
 
 #include "v8chakra.h"
+#include "jsrtmappedsource.h"
 #include <memory>
 
 namespace v8 {
@@ -61,6 +62,11 @@ static JsErrorCode CreateScriptObject(JsValueRef sourceRef,
 
 // Compiled script object, bound to the context that was active when this
 // function was called. When run it will always use this context.
+// Sources here are always UTF-16 engine strings: one-byte and external
+// strings are copied into the engine when they are created (see
+// String::NewExternalOneByte), so there is no utf8 buffer to parse in place.
+// Sources that have one go through chakrashim::CompileStaticUtf8 (natives)
+// and chakrashim::CompileMappedSource (large module files) instead.
 MaybeLocal<Script> Script::Compile(Local<Context> context,
                                    Handle<String> source,
                                    ScriptOrigin* origin) {
@@ -95,6 +101,92 @@ MaybeLocal<Script> Script::Compile(Local<Context> context,
   return Local<Script>();
 }
 
+namespace chakrashim {
+// Shared tail of the utf8 compile paths; |parse| is called with the utf8
+// filename and produces the script function
+template <class Fn>
+static MaybeLocal<Script> CompileUtf8(Local<String> source,
+                                      ScriptOrigin* origin,
+                                      const Fn& parse) {
+  JsErrorCode error;
+  JsValueRef filenameRef;
+  if (origin != nullptr) {
+    error = JsConvertValueToString(*origin->ResourceName(), &filenameRef);
+  } else {
+    error = JsPointerToString(L"", 0, &filenameRef);
+  }
+
+  if (error == JsNoError) {
+    String::Utf8Value filename(Local<Value>::New(filenameRef));
+    JsValueRef scriptFunction;
+    error = parse(*filename, &scriptFunction);
+    if (error == JsNoError) {
+      JsValueRef scriptObject;
+      error = CreateScriptObject(*source, filenameRef, scriptFunction,
+                                 &scriptObject);
+      if (error == JsNoError) {
+        return Local<Script>::New(scriptObject);
+      }
+    }
+  }
+  return Local<Script>();
+}
+
+MaybeLocal<Script> CompileStaticUtf8(Local<Context> context,
+                                     Local<String> source,
+                                     const char* utf8Source,
+                                     ScriptOrigin* origin) {
+  // The strict mode workaround prepends to the script text, which can't be
+  // done in place
+  if (g_useStrict) {
+    return Script::Compile(context, source, origin);
+  }
+
+  return CompileUtf8(source, origin,
+    [=](const char* filename, JsValueRef* scriptFunction) {
+      return jsrt::ParseStaticScriptUtf8(utf8Source, filename, scriptFunction);
+    });
+}
+
+MaybeLocal<Script> CompileMappedSource(Local<Context> context,
+                                       Local<String> path,
+                                       Local<String> content,
+                                       const char* head,
+                                       const char* tail,
+                                       ScriptOrigin* origin,
+                                       bool* mapped) {
+  // The strict mode workaround prepends to the script text, which the view
+  // has no room for
+  jsrt::MappedSource* mappedSource = g_useStrict ? nullptr :
+    jsrt::MappedSource::New(*path, *content, head, tail);
+  *mapped = mappedSource != nullptr;
+  if (mappedSource == nullptr) {
+    return Local<Script>();
+  }
+
+  // The script object keeps the source it was compiled from, so that it can
+  // be bound to another context
+  Local<String> source = String::Concat(
+    String::Concat(String::NewFromUtf8(nullptr, head), content),
+    String::NewFromUtf8(nullptr, tail));
+  if (source.IsEmpty()) {
+    delete mappedSource;
+    return Local<Script>();
+  }
+
+  MaybeLocal<Script> script = CompileUtf8(source, origin,
+    [&](const char* filename, JsValueRef* scriptFunction) {
+      JsErrorCode error = mappedSource->Parse(currentContext++, filename,
+                                              scriptFunction);
+      // The runtime owns the source from here on, or Parse freed it
+      mappedSource = nullptr;
+      return error;
+    });
+  delete mappedSource;
+  return script;
+}
+}  // namespace chakrashim
+
 Local<Script> Script::Compile(Handle<String> source,
                               Handle<String> file_name) {
   ScriptOrigin origin(file_name);
@@ -69,18 +69,71 @@ int String::Length() const {
   return length;
 }
 
-int String::Utf8Length() const {
-  const wchar_t* str;
-  size_t stringLength;
-  if (JsStringToPointer((JsValueRef)this, &str, &stringLength) != JsNoError) {
-    // error
-    return 0;
+template <class Fn>
+struct Utf16RunState {
+  const Fn* fn;
+  wchar_t pending;
+  bool hasPending;
+  bool stopped;
+};
+
+template <class Fn>
+static bool CHAKRA_CALLBACK Utf16RunCallback(
+    const wchar_t* chunk, size_t length, void* callbackState) {
+  auto state = static_cast<Utf16RunState<Fn>*>(callbackState);
+
+  // Put back together a surrogate pair split by the previous chunk
+  if (state->hasPending) {
+    state->hasPending = false;
+    wchar_t pair[2] = { state->pending, chunk[0] };
+    size_t pairLength = IS_LOW_SURROGATE(chunk[0]) ? 2 : 1;
+    if (!(*state->fn)(pair, pairLength)) {
+      state->stopped = true;
+      return false;
+    }
+    chunk += pairLength - 1;
+    length -= pairLength - 1;
+  }
+
+  if (length > 0 && IS_HIGH_SURROGATE(chunk[length - 1])) {
+    state->pending = chunk[length - 1];
+    state->hasPending = true;
+    length--;
   }
 
-  size_t utf8Length;
-  auto result =
-    jsrt::StringConvert::UTF8CharLength(str, stringLength, &utf8Length);
-  if (result != JsNoError) {
+  if (length > 0 && !(*state->fn)(chunk, length)) {
+    state->stopped = true;
+    return false;
+  }
+  return true;
+}
+
+// Calls fn with the characters of a string in runs that don't split surrogate
+// pairs, reading strings built by concatenation in place instead of flattening
+// them. fn returns false to stop.
+template <class Fn>
+static JsErrorCode ForEachUtf16Run(JsValueRef ref, const Fn& fn) {
+  Utf16RunState<Fn> state = { &fn, L'\0', false, false };
+  JsErrorCode error =
+    JsStringForEachChunk(ref, 0, Utf16RunCallback<Fn>, &state);
+  if (error == JsNoError && state.hasPending && !state.stopped) {
+    fn(&state.pending, 1);
+  }
+  return error;
+}
+
+int String::Utf8Length() const {
+  size_t utf8Length = 0;
+  JsErrorCode convertResult = JsNoError;
+  JsErrorCode result = ForEachUtf16Run((JsValueRef)this,
+      [&](const wchar_t* str, size_t length) {
+    size_t runLength;
+    convertResult =
+      jsrt::StringConvert::UTF8CharLength(str, length, &runLength);
+    utf8Length += runLength;
+    return convertResult == JsNoError;
+  });
+  if (result != JsNoError || convertResult != JsNoError) {
     return 0;
   }
 
@@ -157,46 +210,45 @@ int String::WriteUtf8(
     return 0;
   }
 
-  const wchar_t* str;
-  size_t stringLength;
-  if (JsStringToPointer((JsValueRef)this, &str, &stringLength) != JsNoError) {
-    // error
-    return 0;
-  }
-
-  if (stringLength == 0) {
-    // bail out if string is empty
-
-    if (!(options & String::NO_NULL_TERMINATION)) {
-      buffer[0] = '\0';
+  // in case length was not provided the buffer is big enough for the whole
+  // string
+  const size_t capacity = length < 0 ? -1 : static_cast<size_t>(length);
+  size_t size = 0;
+  size_t charsCount = 0;
+  JsErrorCode convertResult = JsNoError;
+  JsErrorCode result = ForEachUtf16Run((JsValueRef)this,
+      [&](const wchar_t* str, size_t count) {
+    size_t bufferSize = -1;
+    if (capacity != -1) {
+      // every character takes at least a byte
+      bufferSize = capacity - size;
+      count = min(count, bufferSize);
+      if (count == 0) {
+        return false;
+      }
     }
 
-    return 0;
-  }
-
-  int originalLength = length;
-  if (length < 0) {
-    // in case length was not provided we want to copy the whole string
-    length = static_cast<int>(stringLength);
-  }
-  unsigned int count = length < static_cast<int>(stringLength) ?
-    length : static_cast<unsigned int>(stringLength);
+    size_t bytesWritten = 0;
+    size_t charsWritten = 0;
+    convertResult = jsrt::StringConvert::ToUTF8Char(
+      str, count, buffer + size, bufferSize, &bytesWritten, &charsWritten);
+    size += bytesWritten;
+    charsCount += charsWritten;
 
-  size_t charsCount = 0;
-  size_t size = 0;
-  // we pass -1 as the buffer size to imply that the buffer is big enough
-  JsErrorCode convertResult = jsrt::StringConvert::ToUTF8Char(
-    str, count, buffer, originalLength, &size, &charsCount);
+    // stop once the buffer is full
+    return convertResult == JsNoError && charsWritten == count &&
+      size != capacity;
+  });
 
-  if (convertResult != JsNoError) {
+  if (result != JsNoError || convertResult != JsNoError) {
     return 0;
   }
 
-  if (!(options & String::NO_NULL_TERMINATION)) {
-    buffer[size++] = '\0';
-    count++;
-    // CHAKRA-TODO: @saary - should we increase this?
-    // charsCount++;
+  if (!(options & String::NO_NULL_TERMINATION) && size < capacity) {
+    buffer[size] = '\0';
+    if (charsCount > 0) {
+      size++;
+    }
   }
 
   if (nchars_ref != nullptr) {
@@ -460,6 +460,151 @@ do {                                                                 \
 #endif
 
 
+/* Fast paths for the long, uneventful runs inside header names, header
+ * values and request paths.
+ *
+ * The state machine below looks at one byte per iteration.  The helpers
+ * here skip ahead 16 bytes at a time and hand control back at the first
+ * byte that may need attention.  The character ranges are conservative:
+ * they stop on every byte that is not unconditionally valid in the current
+ * state, so the scalar code still makes every decision that matters
+ * (strict vs. lenient mode, error reporting, callbacks).  When no vector
+ * unit is available they simply return the input pointer.
+ *
+ * SSE4.2 is detected at runtime unless the compiler already targets it.
+ * Define HTTP_PARSER_NO_SIMD to disable all of this.
+ */
+#if !defined(HTTP_PARSER_NO_SIMD) && defined(__GNUC__) &&                    \
+    (defined(__x86_64__) || defined(__i386__))
+# if defined(__SSE4_2__)
+#  define HTTP_PARSER_SSE42 1
+#  define HTTP_PARSER_SSE42_TARGET
+#  define HTTP_PARSER_HAS_SSE42() 1
+# elif defined(__clang__) || __GNUC__ > 4 ||                                  \
+       (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)
+#  define HTTP_PARSER_SSE42 1
+#  define HTTP_PARSER_SSE42_TARGET __attribute__((target("sse4.2")))
+#  define HTTP_PARSER_HAS_SSE42() has_sse42()
+# endif
+# if defined(__SSE2__)
+#  define HTTP_PARSER_SSE2 1
+# endif
+#endif
+
+#if HTTP_PARSER_SSE42 || HTTP_PARSER_SSE2
+# include <nmmintrin.h>
+#endif
+
+#if HTTP_PARSER_SSE42
+/* _SIDD_CMP_RANGES tables: pairs of inclusive [lo, hi] bounds of bytes that
+ * end a fast-forward.  Bytes outside all ranges are always valid.
+ */
+
+/* Everything but tchar; '|' and '~' are valid but share a range with '{'. */
+static const char token_stop_ranges[16] =
+  "\x00 " "\"\"" "()" ",," "//" ":@" "[]" "{\xff";
+
+/* Controls, space, '#' and '?'; DEL and above for the strict URL table. */
+static const char url_stop_ranges[8] =
+  "\x00 " "##" "??" "\x7f\xff";
+
+#if !defined(__SSE4_2__)
+static int
+has_sse42(void)
+{
+  static int has = -1;
+
+  if (has == -1) {
+    __builtin_cpu_init();
+    has = __builtin_cpu_supports("sse4.2") ? 1 : 0;
+  }
+
+  return has;
+}
+#endif
+
+HTTP_PARSER_SSE42_TARGET
+static const char *
+skip_ranges_sse42(const char *p, const char *end,
+                  const char *ranges, int ranges_len)
+{
+  const __m128i r = _mm_loadu_si128((const __m128i *) ranges);
+
+  while (end - p >= 16) {
+    const __m128i b = _mm_loadu_si128((const __m128i *) p);
+    int i = _mm_cmpestri(r, ranges_len, b, 16,
+                         _SIDD_LEAST_SIGNIFICANT | _SIDD_CMP_RANGES |
+                         _SIDD_UBYTE_OPS);
+    if (i != 16)
+      return p + i;
+    p += 16;
+  }
+
+  return p;
+}
+#endif
+
+/* Returns a pointer q in [p, end] such that every byte in [p, q) is a
+ * valid header name character.
+ */
+static const char *
+skip_token_chars(const char *p, const char *end)
+{
+#if HTTP_PARSER_SSE42
+  if (HTTP_PARSER_HAS_SSE42())
+    return skip_ranges_sse42(p, end, token_stop_ranges,
+                             sizeof(token_stop_ranges));
+#endif
+  (void) end;
+  return p;
+}
+
+/* Same for bytes that leave s_req_path and s_req_query_string unchanged. */
+static const char *
+skip_url_chars(const char *p, const char *end)
+{
+#if HTTP_PARSER_SSE42
+  if (HTTP_PARSER_HAS_SSE42())
+    return skip_ranges_sse42(p, end, url_stop_ranges,
+                             sizeof(url_stop_ranges));
+#endif
+  (void) end;
+  return p;
+}
+
+/* Returns the first CR or LF in [p, end), or NULL. */
+static const char *
+find_crlf(const char *p, const char *end)
+{
+#if HTTP_PARSER_SSE2
+  const __m128i cr = _mm_set1_epi8(CR);
+  const __m128i lf = _mm_set1_epi8(LF);
+
+  for (; end - p >= 16; p += 16) {
+    const __m128i b = _mm_loadu_si128((const __m128i *) p);
+    int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(b, cr),
+                                              _mm_cmpeq_epi8(b, lf)));
+    if (mask != 0)
+      return p + __builtin_ctz(mask);
+  }
+
+  for (; p != end; p++) {
+    if (*p == CR || *p == LF)
+      return p;
+  }
+
+  return NULL;
+#else
+  const char* p_cr = (const char*) memchr(p, CR, end - p);
+  const char* p_lf = (const char*) memchr(p, LF, end - p);
+
+  if (p_cr != NULL && (p_lf == NULL || p_cr < p_lf))
+    return p_cr;
+  return p_lf;
+#endif
+}
+
+
 /* Map errno values to strings for human-readable output */
 #define HTTP_STRERROR_GEN(n, s) { "HPE_" #n, s },
 static struct {
@@ -1119,6 +1264,12 @@ reexecute:
               SET_ERRNO(HPE_INVALID_URL);
               goto error;
             }
+            if (CURRENT_STATE() == s_req_path ||
+                CURRENT_STATE() == s_req_query_string) {
+              const char* q = skip_url_chars(p + 1, data + len);
+              COUNT_HEADER_SIZE(q - (p + 1));
+              p = q - 1;
+            }
         }
         break;
       }
@@ -1307,6 +1458,7 @@ reexecute:
 
           switch (parser->header_state) {
             case h_general:
+              p = skip_token_chars(p + 1, data + len) - 1;
               break;
 
             case h_C:
@@ -1533,21 +1685,14 @@ reexecute:
           switch (h_state) {
             case h_general:
             {
-              const char* p_cr;
-              const char* p_lf;
+              const char* p_crlf;
               size_t limit = data + len - p;
 
               limit = MIN(limit, HTTP_MAX_HEADER_SIZE);
 
-              p_cr = (const char*) memchr(p, CR, limit);
-              p_lf = (const char*) memchr(p, LF, limit);
-              if (p_cr != NULL) {
-                if (p_lf != NULL && p_cr >= p_lf)
-                  p = p_lf;
-                else
-                  p = p_cr;
-              } else if (UNLIKELY(p_lf != NULL)) {
-                p = p_lf;
+              p_crlf = find_crlf(p, p + limit);
+              if (p_crlf != NULL) {
+                p = p_crlf;
               } else {
                 p = data + len;
               }
@@ -82,6 +82,7 @@ static unsigned long read_cpufreq(unsigned int cpunum);
 
 
 int uv__platform_loop_init(uv_loop_t* loop) {
+  int err;
   int fd;
 
   fd = uv__epoll_create1(UV__EPOLL_CLOEXEC);
@@ -103,11 +104,19 @@ int uv__platform_loop_init(uv_loop_t* loop) {
   if (fd == -1)
     return -errno;
 
+  err = uv__iou_loop_init(loop);
+  if (err) {
+    uv__close(fd);
+    loop->backend_fd = -1;
+    return err;
+  }
+
   return 0;
 }
 
 
 void uv__platform_loop_delete(uv_loop_t* loop) {
+  uv__iou_delete(loop);
   if (loop->inotify_fd == -1) return;
   uv__io_stop(loop, &loop->inotify_read_watcher, POLLIN);
   uv__close(loop->inotify_fd);
@@ -196,6 +205,9 @@ void uv__io_poll(uv_loop_t* loop, int timeout) {
   int op;
   int i;
 
+  /* Hand the fs requests queued since the last iteration to the kernel. */
+  uv__iou_flush(loop);
+
   if (loop->nfds == 0) {
     assert(QUEUE_EMPTY(&loop->watcher_queue));
     return;
@@ -0,0 +1,682 @@
+/* Copyright libuv project contributors. All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/* io_uring backend for the asynchronous file system operations.
+ *
+ * Requests are written straight into the kernel's submission ring from the
+ * loop thread. The ring signals completions through an eventfd that is
+ * watched by the regular epoll loop, so no threadpool thread is involved.
+ *
+ * Entries are only made visible to the kernel when uv__io_poll() calls
+ * uv__iou_flush(), so all requests started in one loop iteration go out with
+ * a single io_uring_enter() call.
+ *
+ * The ring is set up lazily, the first time an eligible request comes in.
+ * It is found through a table keyed by the loop, rather than a field in
+ * uv_loop_t, so that the size of uv_loop_t stays what addons compiled against
+ * libuv 1.x expect.
+ * When io_uring is unavailable (old kernel, seccomp filter, UV_USE_IO_URING=0
+ * in the environment) or the ring is full, the caller falls back to the
+ * threadpool. Entries that the kernel refuses to take are handed to the
+ * threadpool as well.
+ */
+
+#include "uv.h"
+#include "internal.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/sysmacros.h>
+#include <unistd.h>
+
+/* Number of submission queue entries. The kernel sizes the completion queue
+ * at twice that, and because we never have more than this many requests in
+ * flight the completion queue cannot overflow.
+ */
+#define UV__IOU_ENTRIES 256
+
+/* How often uv__iou_flush() retries io_uring_enter() when the kernel is
+ * temporarily short of resources before giving up on the ring.
+ */
+#define UV__IOU_MAX_RETRIES 8
+
+struct uv__iou {
+  uv__io_t watcher;  /* Watches the eventfd. */
+  int ringfd;
+  int eventfd;
+  uint32_t* sqhead;
+  uint32_t* sqtail;
+  uint32_t* sqarray;
+  uint32_t sqmask;
+  uint32_t sqentries;
+  uint32_t* cqhead;
+  uint32_t* cqtail;
+  uint32_t cqmask;
+  struct uv__io_uring_cqe* cqes;
+  struct uv__io_uring_sqe* sqes;
+  void* ring;
+  size_t ringlen;
+  size_t sqeslen;
+  uint32_t in_flight;
+  uint32_t unsubmitted;  /* Queued entries the kernel has not seen yet. */
+};
+
+/* Placeholder for loops on which io_uring could not be set up. */
+static struct uv__iou uv__iou_unavailable;
+
+/* Entries are added by uv__platform_loop_init() and removed when the loop
+ * is deleted. Only the loop's own thread touches the iou field.
+ */
+struct uv__iou_entry {
+  uv_loop_t* loop;
+  struct uv__iou* iou;  /* NULL until first used. */
+  struct uv__iou_entry* next;
+};
+
+static struct uv__iou_entry* uv__iou_entries;
+static uv_mutex_t uv__iou_mutex;
+static uv_once_t uv__iou_once = UV_ONCE_INIT;
+
+static void uv__iou_io(uv_loop_t* loop, uv__io_t* w, unsigned int events);
+
+
+static int uv__iou_disabled(void) {
+  static int disabled = -1;
+  const char* val;
+
+  if (disabled == -1) {
+    val = getenv("UV_USE_IO_URING");
+    disabled = (val != NULL && atoi(val) == 0);
+  }
+
+  return disabled;
+}
+
+
+static void uv__iou_init_once(void) {
+  if (uv_mutex_init(&uv__iou_mutex))
+    abort();
+}
+
+
+int uv__iou_loop_init(uv_loop_t* loop) {
+  struct uv__iou_entry* entry;
+
+  entry = uv__malloc(sizeof(*entry));
+  if (entry == NULL)
+    return -ENOMEM;
+
+  entry->loop = loop;
+  entry->iou = NULL;
+
+  uv_once(&uv__iou_once, uv__iou_init_once);
+  uv_mutex_lock(&uv__iou_mutex);
+  entry->next = uv__iou_entries;
+  uv__iou_entries = entry;
+  uv_mutex_unlock(&uv__iou_mutex);
+
+  return 0;
+}
+
+
+static struct uv__iou_entry* uv__iou_entry(uv_loop_t* loop) {
+  struct uv__iou_entry* entry;
+
+  uv_mutex_lock(&uv__iou_mutex);
+  for (entry = uv__iou_entries; entry != NULL; entry = entry->next)
+    if (entry->loop == loop)
+      break;
+  uv_mutex_unlock(&uv__iou_mutex);
+
+  assert(entry != NULL);
+  return entry;
+}
+
+
+static struct uv__iou* uv__iou_init(uv_loop_t* loop) {
+  struct uv__io_uring_params params;
+  struct uv__iou* iou;
+  size_t sqlen;
+  size_t cqlen;
+  char* ring;
+  void* sqes;
+  int ringfd;
+  int efd;
+
+  if (uv__iou_disabled())
+    return NULL;
+
+  memset(&params, 0, sizeof(params));
+  ringfd = uv__io_uring_setup(UV__IOU_ENTRIES, &params);
+  if (ringfd == -1)
+    return NULL;
+
+  /* Reading and writing at the current file position (offset -1) requires
+   * IORING_FEAT_RW_CUR_POS, which also implies that OPENAT, CLOSE and STATX
+   * are implemented and that the rings share a single mapping.
+   */
+  if (!(params.features & UV__IORING_FEAT_RW_CUR_POS) ||
+      !(params.features & UV__IORING_FEAT_SINGLE_MMAP) ||
+      !(params.features & UV__IORING_FEAT_NODROP)) {
+    uv__close(ringfd);
+    return NULL;
+  }
+
+  sqlen = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  cqlen = params.cq_off.cqes +
+          params.cq_entries * sizeof(struct uv__io_uring_cqe);
+  if (cqlen > sqlen)
+    sqlen = cqlen;
+
+  ring = mmap(NULL,
+              sqlen,
+              PROT_READ | PROT_WRITE,
+              MAP_SHARED | MAP_POPULATE,
+              ringfd,
+              UV__IORING_OFF_SQ_RING);
+  if (ring == MAP_FAILED)
+    goto fail_ring;
+
+  sqes = mmap(NULL,
+              params.sq_entries * sizeof(struct uv__io_uring_sqe),
+              PROT_READ | PROT_WRITE,
+              MAP_SHARED | MAP_POPULATE,
+              ringfd,
+              UV__IORING_OFF_SQES);
+  if (sqes == MAP_FAILED)
+    goto fail_sqes;
+
+  efd = uv__eventfd2(0, UV__EFD_CLOEXEC | UV__EFD_NONBLOCK);
+  if (efd == -1)
+    goto fail_eventfd;
+
+  if (uv__io_uring_register(ringfd, UV__IORING_REGISTER_EVENTFD, &efd, 1))
+    goto fail_register;
+
+  iou = uv__malloc(sizeof(*iou));
+  if (iou == NULL)
+    goto fail_register;
+
+  iou->ringfd = ringfd;
+  iou->eventfd = efd;
+  iou->sqhead = (uint32_t*) (ring + params.sq_off.head);
+  iou->sqtail = (uint32_t*) (ring + params.sq_off.tail);
+  iou->sqarray = (uint32_t*) (ring + params.sq_off.array);
+  iou->sqmask = *(uint32_t*) (ring + params.sq_off.ring_mask);
+  iou->sqentries = params.sq_entries;
+  iou->cqhead = (uint32_t*) (ring + params.cq_off.head);
+  iou->cqtail = (uint32_t*) (ring + params.cq_off.tail);
+  iou->cqmask = *(uint32_t*) (ring + params.cq_off.ring_mask);
+  iou->cqes = (struct uv__io_uring_cqe*) (ring + params.cq_off.cqes);
+  iou->sqes = sqes;
+  iou->ring = ring;
+  iou->ringlen = sqlen;
+  iou->sqeslen = params.sq_entries * sizeof(struct uv__io_uring_sqe);
+  iou->in_flight = 0;
+  iou->unsubmitted = 0;
+
+  uv__io_init(&iou->watcher, uv__iou_io, efd);
+
+  return iou;
+
+fail_register:
+  uv__close(efd);
+fail_eventfd:
+  munmap(sqes, params.sq_entries * sizeof(struct uv__io_uring_sqe));
+fail_sqes:
+  munmap(ring, sqlen);
+fail_ring:
+  uv__close(ringfd);
+  return NULL;
+}
+
+
+static struct uv__iou* uv__iou_get(uv_loop_t* loop) {
+  struct uv__iou_entry* entry;
+  struct uv__iou* iou;
+
+  entry = uv__iou_entry(loop);
+  iou = entry->iou;
+  if (iou == NULL) {
+    iou = uv__iou_init(loop);
+    if (iou == NULL)
+      iou = &uv__iou_unavailable;
+    entry->iou = iou;
+  }
+
+  if (iou == &uv__iou_unavailable)
+    return NULL;
+
+  return iou;
+}
+
+
+void uv__iou_delete(uv_loop_t* loop) {
+  struct uv__iou_entry** link;
+  struct uv__iou_entry* entry;
+  struct uv__iou* iou;
+
+  uv_mutex_lock(&uv__iou_mutex);
+  for (link = &uv__iou_entries; *link != NULL; link = &(*link)->next)
+    if ((*link)->loop == loop)
+      break;
+  entry = *link;
+  if (entry != NULL)
+    *link = entry->next;
+  uv_mutex_unlock(&uv__iou_mutex);
+
+  if (entry == NULL)
+    return;
+
+  iou = entry->iou;
+  uv__free(entry);
+
+  if (iou == NULL || iou == &uv__iou_unavailable)
+    return;
+
+  /* uv_loop_close() refuses to close a loop with pending requests. */
+  assert(iou->in_flight == 0);
+
+  uv__io_stop(loop, &iou->watcher, POLLIN);
+  uv__close(iou->eventfd);
+  munmap(iou->sqes, iou->sqeslen);
+  munmap(iou->ring, iou->ringlen);
+  uv__close(iou->ringfd);
+  uv__free(iou);
+}
+
+
+static struct uv__io_uring_sqe* uv__iou_get_sqe(struct uv__iou* iou,
+                                                uv_loop_t* loop,
+                                                uv_fs_t* req) {
+  struct uv__io_uring_sqe* sqe;
+  uint32_t head;
+  uint32_t tail;
+  uint32_t slot;
+
+  /* Keeping in_flight below the ring size guarantees that there is room in
+   * the submission queue and that the completion queue never overflows.
+   */
+  if (iou->in_flight >= iou->sqentries)
+    return NULL;
+
+  head = __atomic_load_n(iou->sqhead, __ATOMIC_ACQUIRE);
+  tail = *iou->sqtail;
+  if (tail - head >= iou->sqentries)
+    return NULL;
+
+  slot = tail & iou->sqmask;
+  iou->sqarray[slot] = slot;
+
+  sqe = &iou->sqes[slot];
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->user_data = (uintptr_t) req;
+
+  /* Make uv_cancel() see a request that is no longer cancelable. */
+  req->work_req.loop = loop;
+  req->work_req.work = NULL;
+  req->work_req.done = NULL;
+  QUEUE_INIT(&req->work_req.wq);
+
+  return sqe;
+}
+
+
+static void uv__iou_submit(struct uv__iou* iou, uv_loop_t* loop) {
+  /* The kernel only reads the tail in io_uring_enter(); see uv__iou_flush(). */
+  __atomic_store_n(iou->sqtail, *iou->sqtail + 1, __ATOMIC_RELEASE);
+  iou->unsubmitted++;
+
+  iou->in_flight++;
+  if (!uv__io_active(&iou->watcher, POLLIN))
+    uv__io_start(loop, &iou->watcher, POLLIN);
+}
+
+
+/* Takes back the entries that io_uring_enter() did not consume and runs
+ * them on the threadpool instead.
+ */
+static void uv__iou_fallback(struct uv__iou* iou, uv_loop_t* loop) {
+  struct uv__io_uring_sqe* sqe;
+  uint32_t head;
+  uint32_t tail;
+  uv_fs_t* req;
+
+  head = __atomic_load_n(iou->sqhead, __ATOMIC_ACQUIRE);
+  tail = *iou->sqtail;
+  assert(tail - head == iou->unsubmitted);
+
+  __atomic_store_n(iou->sqtail, head, __ATOMIC_RELEASE);
+  iou->unsubmitted = 0;
+
+  for (; head != tail; head++) {
+    sqe = &iou->sqes[head & iou->sqmask];
+    req = (uv_fs_t*) (uintptr_t) sqe->user_data;
+    iou->in_flight--;
+
+    /* uv__fs_work() stats into req->statbuf directly. */
+    if (req->fs_type == UV_FS_STAT ||
+        req->fs_type == UV_FS_LSTAT ||
+        req->fs_type == UV_FS_FSTAT) {
+      uv__free(req->ptr);
+      req->ptr = NULL;
+    }
+
+    uv__fs_post(loop, req);
+  }
+
+  if (iou->in_flight == 0)
+    uv__io_stop(loop, &iou->watcher, POLLIN);
+}
+
+
+void uv__iou_flush(uv_loop_t* loop) {
+  struct uv__iou* iou;
+  int retries;
+  int rc;
+
+  iou = uv__iou_entry(loop)->iou;
+  if (iou == NULL || iou == &uv__iou_unavailable || iou->unsubmitted == 0)
+    return;
+
+  retries = 0;
+  while (iou->unsubmitted > 0) {
+    rc = uv__io_uring_enter(iou->ringfd, iou->unsubmitted, 0, 0);
+
+    if (rc > 0) {
+      /* The kernel stops early when it cannot allocate a request. */
+      iou->unsubmitted -= rc;
+      retries = 0;
+      continue;
+    }
+
+    if (rc == -1 && errno == EINTR)
+      continue;
+
+    if (rc == 0 || errno == EAGAIN || errno == EBUSY)
+      if (++retries < UV__IOU_MAX_RETRIES)
+        continue;
+
+    break;
+  }
+
+  if (iou->unsubmitted > 0)
+    uv__iou_fallback(iou, loop);
+}
+
+
+int uv__iou_fs_close(uv_loop_t* loop, uv_fs_t* req) {
+  struct uv__io_uring_sqe* sqe;
+  struct uv__iou* iou;
+
+  iou = uv__iou_get(loop);
+  if (iou == NULL)
+    return 0;
+
+  sqe = uv__iou_get_sqe(iou, loop, req);
+  if (sqe == NULL)
+    return 0;
+
+  sqe->fd = req->file;
+  sqe->opcode = UV__IORING_OP_CLOSE;
+
+  uv__iou_submit(iou, loop);
+
+  return 1;
+}
+
+
+int uv__iou_fs_fsync(uv_loop_t* loop, uv_fs_t* req, uint32_t fsync_flags) {
+  struct uv__io_uring_sqe* sqe;
+  struct uv__iou* iou;
+
+  iou = uv__iou_get(loop);
+  if (iou == NULL)
+    return 0;
+
+  sqe = uv__iou_get_sqe(iou, loop, req);
+  if (sqe == NULL)
+    return 0;
+
+  sqe->fd = req->file;
+  sqe->op_flags = fsync_flags;
+  sqe->opcode = UV__IORING_OP_FSYNC;
+
+  uv__iou_submit(iou, loop);
+
+  return 1;
+}
+
+
+int uv__iou_fs_open(uv_loop_t* loop, uv_fs_t* req) {
+  struct uv__io_uring_sqe* sqe;
+  struct uv__iou* iou;
+
+  iou = uv__iou_get(loop);
+  if (iou == NULL)
+    return 0;
+
+  sqe = uv__iou_get_sqe(iou, loop, req);
+  if (sqe == NULL)
+    return 0;
+
+  sqe->addr = (uintptr_t) req->path;
+  sqe->fd = UV__AT_FDCWD;
+  sqe->len = req->mode;
+  sqe->op_flags = req->flags | UV__O_CLOEXEC;
+  sqe->opcode = UV__IORING_OP_OPENAT;
+
+  uv__iou_submit(iou, loop);
+
+  return 1;
+}
+
+
+int uv__iou_fs_read_or_write(uv_loop_t* loop, uv_fs_t* req, int is_read) {
+  struct uv__io_uring_sqe* sqe;
+  struct uv__iou* iou;
+
+  /* The threadpool splits up larger vectors, see uv__fs_buf_iter(). */
+  if (req->nbufs > (unsigned int) uv__getiovmax())
+    return 0;
+
+  iou = uv__iou_get(loop);
+  if (iou == NULL)
+    return 0;
+
+  sqe = uv__iou_get_sqe(iou, loop, req);
+  if (sqe == NULL)
+    return 0;
+
+  sqe->addr = (uintptr_t) req->bufs;
+  sqe->fd = req->file;
+  sqe->len = req->nbufs;
+  sqe->off = req->off < 0 ? (uint64_t) -1 : (uint64_t) req->off;
+  sqe->opcode = is_read ? UV__IORING_OP_READV : UV__IORING_OP_WRITEV;
+
+  uv__iou_submit(iou, loop);
+
+  return 1;
+}
+
+
+int uv__iou_fs_statx(uv_loop_t* loop,
+                     uv_fs_t* req,
+                     int is_fstat,
+                     int is_lstat) {
+  struct uv__io_uring_sqe* sqe;
+  struct uv__statx* statxbuf;
+  struct uv__iou* iou;
+
+  iou = uv__iou_get(loop);
+  if (iou == NULL)
+    return 0;
+
+  statxbuf = uv__malloc(sizeof(*statxbuf));
+  if (statxbuf == NULL)
+    return 0;
+
+  sqe = uv__iou_get_sqe(iou, loop, req);
+  if (sqe == NULL) {
+    uv__free(statxbuf);
+    return 0;
+  }
+
+  /* Owned by the request until uv__iou_fs_statx_done(). */
+  req->ptr = statxbuf;
+
+  sqe->addr = (uintptr_t) req->path;
+  sqe->off = (uintptr_t) statxbuf;  /* addr2 */
+  sqe->fd = UV__AT_FDCWD;
+  sqe->len = UV__STATX_BASIC_STATS;
+  sqe->opcode = UV__IORING_OP_STATX;
+
+  if (is_fstat) {
+    sqe->addr = (uintptr_t) "";
+    sqe->fd = req->file;
+    sqe->op_flags |= UV__AT_EMPTY_PATH;
+  }
+
+  if (is_lstat)
+    sqe->op_flags |= UV__AT_SYMLINK_NOFOLLOW;
+
+  uv__iou_submit(iou, loop);
+
+  return 1;
+}
+
+
+/* Matches what uv__to_stat() reports on Linux, including the use of the
+ * change time as the birth time.
+ */
+static void uv__statx_to_stat(const struct uv__statx* src, uv_stat_t* dst) {
+  dst->st_dev = makedev(src->stx_dev_major, src->stx_dev_minor);
+  dst->st_mode = src->stx_mode;
+  dst->st_nlink = src->stx_nlink;
+  dst->st_uid = src->stx_uid;
+  dst->st_gid = src->stx_gid;
+  dst->st_rdev = makedev(src->stx_rdev_major, src->stx_rdev_minor);
+  dst->st_ino = src->stx_ino;
+  dst->st_size = src->stx_size;
+  dst->st_blksize = src->stx_blksize;
+  dst->st_blocks = src->stx_blocks;
+  dst->st_atim.tv_sec = src->stx_atime.tv_sec;
+  dst->st_atim.tv_nsec = src->stx_atime.tv_nsec;
+  dst->st_mtim.tv_sec = src->stx_mtime.tv_sec;
+  dst->st_mtim.tv_nsec = src->stx_mtime.tv_nsec;
+  dst->st_ctim.tv_sec = src->stx_ctime.tv_sec;
+  dst->st_ctim.tv_nsec = src->stx_ctime.tv_nsec;
+  dst->st_birthtim.tv_sec = src->stx_ctime.tv_sec;
+  dst->st_birthtim.tv_nsec = src->stx_ctime.tv_nsec;
+  dst->st_flags = 0;
+  dst->st_gen = 0;
+}
+
+
+static void uv__iou_fs_done(uv_loop_t* loop, uv_fs_t* req, int32_t res) {
+  struct uv__statx* statxbuf;
+
+  uv__req_unregister(loop, req);
+
+  switch (req->fs_type) {
+    case UV_FS_READ:
+    case UV_FS_WRITE:
+      if (req->bufs != req->bufsml)
+        uv__free(req->bufs);
+      req->bufs = NULL;
+      req->nbufs = 0;
+      break;
+
+    case UV_FS_STAT:
+    case UV_FS_LSTAT:
+    case UV_FS_FSTAT:
+      statxbuf = req->ptr;
+      req->ptr = NULL;
+      if (res == 0) {
+        uv__statx_to_stat(statxbuf, &req->statbuf);
+        req->ptr = &req->statbuf;
+      }
+      uv__free(statxbuf);
+      break;
+
+    case UV_FS_CLOSE:
+      /* Like uv__close(): the descriptor is gone either way. */
+      if (res == -EINTR || res == -EINPROGRESS)
+        res = 0;
+      break;
+
+    default:
+      break;
+  }
+
+  req->result = res;
+  req->cb(req);
+}
+
+
+static void uv__iou_io(uv_loop_t* loop, uv__io_t* w, unsigned int events) {
+  struct uv__io_uring_cqe* cqe;
+  struct uv__iou* iou;
+  uint64_t val;
+  uint32_t head;
+  uint32_t tail;
+  int32_t res;
+  uv_fs_t* req;
+  ssize_t r;
+
+  iou = container_of(w, struct uv__iou, watcher);
+
+  /* Reset the eventfd before draining so that completions posted while the
+   * callbacks below run wake up the loop again.
+   */
+  do
+    r = read(iou->eventfd, &val, sizeof(val));
+  while (r == -1 && errno == EINTR);
+
+  head = *iou->cqhead;
+  tail = __atomic_load_n(iou->cqtail, __ATOMIC_ACQUIRE);
+
+  while (head != tail) {
+    cqe = &iou->cqes[head & iou->cqmask];
+    req = (uv_fs_t*) (uintptr_t) cqe->user_data;
+    res = cqe->res;
+
+    /* Release the slot before running the callback; it may start new
+     * requests of its own.
+     */
+    head++;
+    __atomic_store_n(iou->cqhead, head, __ATOMIC_RELEASE);
+    iou->in_flight--;
+
+    uv__iou_fs_done(loop, req, res);
+
+    if (head == tail)
+      tail = __atomic_load_n(iou->cqtail, __ATOMIC_ACQUIRE);
+  }
+
+  if (iou->in_flight == 0)
+    uv__io_stop(loop, &iou->watcher, POLLIN);
+}
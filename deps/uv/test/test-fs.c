@@ -2666,3 +2666,104 @@ TEST_IMPL(fs_read_write_null_arguments) {
 
   return 0;
 }
+
+
+/* More requests than the io_uring backend has ring entries, all started in
+ * the same loop iteration, so that they are submitted as one batch and the
+ * overflow goes to the threadpool.
+ */
+#define BATCH_REQS 300
+
+static uv_fs_t batch_read_reqs[BATCH_REQS];
+static uv_fs_t batch_fstat_reqs[BATCH_REQS];
+static uv_buf_t batch_bufs[BATCH_REQS];
+static char batch_data[BATCH_REQS];
+static int batch_read_cb_count;
+static int batch_fstat_cb_count;
+
+
+static void batch_read_cb(uv_fs_t* req) {
+  int i;
+
+  i = req - batch_read_reqs;
+  ASSERT(req->fs_type == UV_FS_READ);
+  ASSERT(req->result == 1);
+  ASSERT(batch_data[i] == (char) ('a' + i % 26));
+  batch_read_cb_count++;
+  uv_fs_req_cleanup(req);
+}
+
+
+static void batch_fstat_cb(uv_fs_t* req) {
+  ASSERT(req->fs_type == UV_FS_FSTAT);
+  ASSERT(req->result == 0);
+  ASSERT(req->ptr == &req->statbuf);
+  ASSERT(req->statbuf.st_size == BATCH_REQS);
+  batch_fstat_cb_count++;
+  uv_fs_req_cleanup(req);
+}
+
+
+static int fs_read_batch(void) {
+  char contents[BATCH_REQS];
+  uv_file file;
+  int r;
+  int i;
+
+  unlink("test_file");
+  loop = uv_default_loop();
+
+  for (i = 0; i < BATCH_REQS; i++)
+    contents[i] = 'a' + i % 26;
+
+  r = uv_fs_open(NULL, &open_req1, "test_file", O_RDWR | O_CREAT,
+      S_IWUSR | S_IRUSR, NULL);
+  ASSERT(r >= 0);
+  file = open_req1.result;
+  uv_fs_req_cleanup(&open_req1);
+
+  iov = uv_buf_init(contents, sizeof(contents));
+  r = uv_fs_write(NULL, &write_req, file, &iov, 1, 0, NULL);
+  ASSERT(r == BATCH_REQS);
+  uv_fs_req_cleanup(&write_req);
+
+  for (i = 0; i < BATCH_REQS; i++) {
+    batch_bufs[i] = uv_buf_init(batch_data + i, 1);
+    r = uv_fs_read(loop, batch_read_reqs + i, file, batch_bufs + i, 1, i,
+                   batch_read_cb);
+    ASSERT(r == 0);
+    r = uv_fs_fstat(loop, batch_fstat_reqs + i, file, batch_fstat_cb);
+    ASSERT(r == 0);
+  }
+
+  r = uv_run(loop, UV_RUN_DEFAULT);
+  ASSERT(r == 0);
+  ASSERT(batch_read_cb_count == BATCH_REQS);
+  ASSERT(batch_fstat_cb_count == BATCH_REQS);
+
+  /* Closing through the loop reports success. */
+  close_cb_count = 0;
+  r = uv_fs_close(loop, &close_req, file, close_cb);
+  ASSERT(r == 0);
+  uv_run(loop, UV_RUN_DEFAULT);
+  ASSERT(close_cb_count == 1);
+
+  unlink("test_file");
+
+  MAKE_VALGRIND_HAPPY();
+  return 0;
+}
+
+
+TEST_IMPL(fs_read_batch) {
+  return fs_read_batch();
+}
+
+
+TEST_IMPL(fs_read_batch_threadpool) {
+#ifndef _WIN32
+  /* Tests run in a process of their own, so this only affects this one. */
+  setenv("UV_USE_IO_URING", "0", 1);
+#endif
+  return fs_read_batch();
+}
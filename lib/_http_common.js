@@ -24,11 +24,7 @@ const kOnBody = HTTPParser.kOnBody | 0;
 const kOnMessageComplete = HTTPParser.kOnMessageComplete | 0;
 const kOnExecute = HTTPParser.kOnExecute | 0;
 
-// Only called in the slow case where slow means
-// that the request headers were either fragmented
-// across multiple TCP packets or too large to be
-// processed in a single run. This method is also
-// called to process trailing HTTP headers.
+// Only called to process trailing HTTP headers.
 function parserOnHeaders(headers, url) {
   // Once we exceeded headers limit - stop collecting them
   if (this.maxHeaderPairs <= 0 ||
@@ -38,20 +34,15 @@ function parserOnHeaders(headers, url) {
   this._url += url;
 }
 
-// `headers` and `url` are set only if .onHeaders() has not been called for
-// this request.
 // `url` is not set for response parsers but that's not applicable here since
 // all our parsers are request parsers.
+// `headerValues` is set when the parser runs with lazy header values, see
+// IncomingMessage.prototype._addLazyHeaderLines().
 function parserOnHeadersComplete(versionMajor, versionMinor, headers, method,
                                  url, statusCode, statusMessage, upgrade,
-                                 shouldKeepAlive) {
+                                 shouldKeepAlive, headerValues) {
   var parser = this;
 
-  if (!headers) {
-    headers = parser._headers;
-    parser._headers = [];
-  }
-
   if (!url) {
     url = parser._url;
     parser._url = '';
@@ -69,7 +60,10 @@ function parserOnHeadersComplete(versionMajor, versionMinor, headers, method,
   if (parser.maxHeaderPairs > 0)
     n = Math.min(n, parser.maxHeaderPairs);
 
-  parser.incoming._addHeaderLines(headers, n);
+  if (headerValues !== undefined)
+    parser.incoming._addLazyHeaderLines(headers, n, headerValues);
+  else
+    parser.incoming._addHeaderLines(headers, n);
 
   if (typeof method === 'number') {
     // server only
@@ -151,6 +145,7 @@ function parserOnMessageComplete() {
 
 var parsers = new FreeList('parsers', 1000, function() {
   var parser = new HTTPParser(HTTPParser.REQUEST);
+  parser.setLazyHeaderValues(true);
 
   parser._headers = [];
   parser._url = '';
@@ -160,11 +155,7 @@ var parsers = new FreeList('parsers', 1000, function() {
   parser.incoming = null;
   parser.outgoing = null;
 
-  // Only called in the slow case where slow means
-  // that the request headers were either fragmented
-  // across multiple TCP packets or too large to be
-  // processed in a single run. This method is also
-  // called to process trailing HTTP headers.
+  // Only called to process trailing HTTP headers.
   parser[kOnHeaders] = parserOnHeaders;
   parser[kOnHeadersComplete] = parserOnHeadersComplete;
   parser[kOnBody] = parserOnBody;
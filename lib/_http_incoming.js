@@ -36,6 +36,11 @@ function IncomingMessage(socket) {
   this.complete = false;
   this.headers = {};
   this.rawHeaders = [];
+  this._lazyHeaders = null;
+  this._lazyHeaderValues = null;
+  this._lazyHeaderCount = 0;
+  this._lazyDest = null;
+  this._lazyRawDest = null;
   this.trailers = {};
   this.rawTrailers = [];
 
@@ -122,6 +127,114 @@ IncomingMessage.prototype._addHeaderLines = function(headers, n) {
 };
 
 
+// Installed on a message by _addLazyHeaderLines() so that `headers` and
+// `rawHeaders` stay own properties. The first access to either one fills in
+// both and turns them back into plain data properties.
+const lazyHeadersDescriptor = {
+  configurable: true,
+  enumerable: true,
+  get: function() {
+    this._materializeHeaders();
+    return this.headers;
+  },
+  set: function(val) {
+    this._materializeHeaders();
+    this.headers = val;
+  }
+};
+
+const lazyRawHeadersDescriptor = {
+  configurable: true,
+  enumerable: true,
+  get: function() {
+    this._materializeHeaders();
+    return this.rawHeaders;
+  },
+  set: function(val) {
+    this._materializeHeaders();
+    this.rawHeaders = val;
+  }
+};
+
+
+// Like _addHeaderLines() but every value slot in `headers` holds the end
+// offset of that value in `values`, a Buffer with all values back to back.
+// The value strings are not created until the headers are first looked at.
+IncomingMessage.prototype._addLazyHeaderLines = function(headers, n, values) {
+  // Reading the properties materializes any earlier lazy headers.
+  this._lazyDest = this.headers;
+  this._lazyRawDest = this.rawHeaders;
+  this._lazyHeaders = headers;
+  this._lazyHeaderValues = values;
+  this._lazyHeaderCount = n;
+  Object.defineProperty(this, 'headers', lazyHeadersDescriptor);
+  Object.defineProperty(this, 'rawHeaders', lazyRawHeadersDescriptor);
+};
+
+
+IncomingMessage.prototype._materializeHeaders = function() {
+  var headers = this._lazyHeaders;
+  var values = this._lazyHeaderValues;
+  var n = this._lazyHeaderCount;
+  var raw = this._lazyRawDest;
+  var dest = this._lazyDest;
+  var start = 0;
+
+  this._lazyHeaders = null;
+  this._lazyHeaderValues = null;
+  this._lazyHeaderCount = 0;
+  this._lazyDest = null;
+  this._lazyRawDest = null;
+
+  Object.defineProperty(this, 'headers', {
+    configurable: true,
+    enumerable: true,
+    writable: true,
+    value: dest
+  });
+  Object.defineProperty(this, 'rawHeaders', {
+    configurable: true,
+    enumerable: true,
+    writable: true,
+    value: raw
+  });
+
+  for (var i = 0; i < n; i += 2) {
+    var k = headers[i];
+    var end = headers[i + 1];
+    var v = values.latin1Slice(start, end);
+    start = end;
+    raw.push(k);
+    raw.push(v);
+    this._addHeaderLine(k, v, dest);
+  }
+};
+
+
+// Returns what `this.headers[field]` would be without creating strings for
+// the other header values. `field` must be lowercase.
+IncomingMessage.prototype._peekHeader = function(field) {
+  if (this._lazyHeaders === null)
+    return this.headers[field];
+
+  var headers = this._lazyHeaders;
+  var values = this._lazyHeaderValues;
+  var n = this._lazyHeaderCount;
+  var dest = {};
+  var start = 0;
+
+  for (var i = 0; i < n; i += 2) {
+    var k = headers[i];
+    var end = headers[i + 1];
+    if (k.length === field.length && k.toLowerCase() === field)
+      this._addHeaderLine(k, values.latin1Slice(start, end), dest);
+    start = end;
+  }
+
+  return dest[field];
+};
+
+
 // Add the given (field, value) pair to the message
 //
 // Per RFC2616, section 4.2 it is acceptable to join multiple instances of the
@@ -520,9 +520,10 @@ function connectionListener(socket) {
       }
     }
 
-    if (req.headers.expect !== undefined &&
+    var expect = req._peekHeader('expect');
+    if (expect !== undefined &&
         (req.httpVersionMajor == 1 && req.httpVersionMinor == 1)) {
-      if (continueExpression.test(req.headers.expect)) {
+      if (continueExpression.test(expect)) {
         res._expect_continue = true;
 
         if (self.listenerCount('checkContinue') > 0) {
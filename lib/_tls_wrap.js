@@ -529,6 +529,10 @@ TLSSocket.prototype.setMaxSendFragment = function setMaxSendFragment(size) {
   return this._handle.setMaxSendFragment(size) == 1;
 };
 
+TLSSocket.prototype.setSendChunkSize = function setSendChunkSize(size) {
+  return this._handle.setEncOutChunkSize(size);
+};
+
 TLSSocket.prototype.getTLSTicket = function getTLSTicket() {
   return this._handle.getTLSTicket();
 };
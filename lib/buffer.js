@@ -5,6 +5,9 @@ const binding = process.binding('buffer');
 const { isArrayBuffer } = process.binding('util');
 const bindingObj = {};
 const internalUtil = require('internal/util');
+// Only chakracore can stringify straight into utf8 and parse straight from it.
+const stringifyUtf8 = binding.stringifyUtf8;
+const parseUtf8 = binding.parseUtf8;
 
 class FastBuffer extends Uint8Array {}
 
@@ -122,6 +125,37 @@ Buffer.from = function(value, encodingOrOffset, length) {
   return fromObject(value);
 };
 
+/**
+ * Creates a Buffer holding JSON.stringify(value) encoded as UTF-8, or returns
+ * undefined where JSON.stringify(value) does.
+ * Buffer.fromJSON(value)
+ **/
+Buffer.fromJSON = function(value) {
+  if (stringifyUtf8 === undefined) {
+    const json = JSON.stringify(value);
+    return json === undefined ? undefined : fromString(json, 'utf8');
+  }
+
+  const arrayBuffer = stringifyUtf8(value);
+  return arrayBuffer === undefined ? undefined : new FastBuffer(arrayBuffer);
+};
+
+/**
+ * Parses the UTF-8 JSON text held in buffer, like JSON.parse(text, reviver).
+ * Buffer.parseJSON(buffer[, reviver])
+ **/
+Buffer.parseJSON = function(buffer, reviver) {
+  if (!(buffer instanceof Uint8Array))
+    throw new TypeError('"buffer" argument must be a Buffer or Uint8Array');
+
+  if (parseUtf8 === undefined) {
+    const text = Buffer.prototype.utf8Slice.call(buffer, 0, buffer.length);
+    return JSON.parse(text, reviver);
+  }
+
+  return parseUtf8(buffer, reviver);
+};
+
 Object.setPrototypeOf(Buffer, Uint8Array);
 markNoSpeciesConstructor(Buffer);
 
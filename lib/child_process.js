@@ -64,12 +64,12 @@ exports.fork = function(modulePath /*, args, options*/) {
 };
 
 
-exports._forkChild = function(fd) {
+exports._forkChild = function(fd, serialization) {
   // set process.send()
   var p = new Pipe(true);
   p.open(fd);
   p.unref();
-  const control = setupChannel(process, p);
+  const control = setupChannel(process, p, serialization);
   process.on('newListener', function(name) {
     if (name === 'message' || name === 'disconnect') control.ref();
   });
@@ -390,6 +390,7 @@ var spawn = exports.spawn = function(/*file, args, options*/) {
     detached: !!options.detached,
     envPairs: opts.envPairs,
     stdio: options.stdio,
+    serialization: options.serialization,
     uid: options.uid,
     gid: options.gid
   });
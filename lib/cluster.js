@@ -9,6 +9,13 @@ const util = require('util');
 const internalUtil = require('internal/util');
 const SCHED_NONE = 1;
 const SCHED_RR = 2;
+const SCHED_LOAD = 3;
+const SCHED_REUSEPORT = 4;
+
+// How often workers report their load to the master, and how much event loop
+// lag (in milliseconds) weighs as much as one in-flight connection.
+const kLoadReportInterval = 100;
+const kLagPerConnection = 10;
 
 const uv = process.binding('uv');
 
@@ -191,18 +198,90 @@ RoundRobinHandle.prototype.handoff = function(worker) {
     this.free.push(worker);  // Add to ready queue again.
     return;
   }
+  this.deliver(worker, handle);
+};
+
+RoundRobinHandle.prototype.deliver = function(worker, handle) {
   var message = { act: 'newconn', key: this.key };
 
   sendHelper(worker.process, message, handle, (reply) => {
-    if (reply.accepted)
+    if (reply.accepted) {
       handle.close();
-    else
+      // Counted as in flight until a load report from the worker covers it.
+      worker._handoffs = (worker._handoffs || 0) + 1;
+    } else {
       this.distribute(0, handle);  // Worker is shutting down. Send to another.
+    }
     this.handoff(worker);
   });
 };
 
 
+// Like RoundRobinHandle, but every connection goes to the idle worker with
+// the fewest in-flight connections and the least event loop lag, as
+// reported by the workers themselves.
+function LeastLoadedHandle(key, address, port, addressType, backlog, fd) {
+  RoundRobinHandle.call(this, key, address, port, addressType, backlog, fd);
+}
+util.inherits(LeastLoadedHandle, RoundRobinHandle);
+
+LeastLoadedHandle.prototype.distribute = function(err, handle) {
+  this.handles.push(handle);
+  this.dispatch();
+};
+
+LeastLoadedHandle.prototype.handoff = function(worker) {
+  if (worker.id in this.all === false) {
+    return;  // Worker is closing (or has closed) the server.
+  }
+  this.free.push(worker);
+  this.dispatch();
+};
+
+LeastLoadedHandle.prototype.dispatch = function() {
+  while (this.handles.length !== 0 && this.free.length !== 0) {
+    var best = 0;
+    for (var i = 1; i < this.free.length; i++) {
+      if (workerLoad(this.free[i]) < workerLoad(this.free[best]))
+        best = i;
+    }
+    var worker = this.free.splice(best, 1)[0];
+    this.deliver(worker, this.handles.shift());
+  }
+};
+
+function workerLoad(worker) {
+  var load = worker._load;
+  var handoffs = worker._handoffs || 0;
+  if (load === undefined) return handoffs;
+  // Handoffs the worker had not accepted yet when it last reported.
+  var unreported = handoffs - load.accepted;
+  return load.connections + unreported + load.lag / kLagPerConnection;
+}
+
+
+// Every worker binds its own listen socket with SO_REUSEPORT and the kernel
+// balances incoming connections between them. The master only keeps track
+// of which workers are listening.
+function ReusePortHandle(key) {
+  this.key = key;
+  this.workers = [];
+}
+
+ReusePortHandle.prototype.add = function(worker, send) {
+  assert(this.workers.indexOf(worker) === -1);
+  this.workers.push(worker);
+  send(0, { reuseport: true }, null);
+};
+
+ReusePortHandle.prototype.remove = function(worker) {
+  var index = this.workers.indexOf(worker);
+  if (index === -1) return false; // The worker wasn't sharing this handle.
+  this.workers.splice(index, 1);
+  return this.workers.length === 0;
+};
+
+
 if (cluster.isMaster)
   masterInit();
 else
@@ -217,7 +296,9 @@ function masterInit() {
   // XXX(bnoordhuis) Fold cluster.schedulingPolicy into cluster.settings?
   var schedulingPolicy = {
     'none': SCHED_NONE,
-    'rr': SCHED_RR
+    'rr': SCHED_RR,
+    'load': SCHED_LOAD,
+    'reuseport': SCHED_REUSEPORT
   }[process.env.NODE_CLUSTER_SCHED_POLICY];
 
   if (schedulingPolicy === undefined) {
@@ -229,6 +310,8 @@ function masterInit() {
   cluster.schedulingPolicy = schedulingPolicy;
   cluster.SCHED_NONE = SCHED_NONE;  // Leave it to the operating system.
   cluster.SCHED_RR = SCHED_RR;      // Master distributes connections.
+  cluster.SCHED_LOAD = SCHED_LOAD;  // Master picks the least loaded worker.
+  cluster.SCHED_REUSEPORT = SCHED_REUSEPORT;  // Workers bind with SO_REUSEPORT.
 
   // Keyed on address:port:etc. When a worker dies, we walk over the handles
   // and remove() the worker from each one. remove() may do a linear scan
@@ -258,8 +341,14 @@ function masterInit() {
       return process.nextTick(setupSettingsNT, settings);
     initialized = true;
     schedulingPolicy = cluster.schedulingPolicy;  // Freeze policy.
-    assert(schedulingPolicy === SCHED_NONE || schedulingPolicy === SCHED_RR,
+    assert(schedulingPolicy === SCHED_NONE ||
+           schedulingPolicy === SCHED_RR ||
+           schedulingPolicy === SCHED_LOAD ||
+           schedulingPolicy === SCHED_REUSEPORT,
            'Bad cluster.schedulingPolicy: ' + schedulingPolicy);
+    // The kernel only load balances SO_REUSEPORT sockets on Linux.
+    if (schedulingPolicy === SCHED_REUSEPORT && process.platform !== 'linux')
+      schedulingPolicy = SCHED_RR;
 
     var hasDebugArg = process.execArgv.some(function(argv) {
       return /^(--debug|--debug-brk)(=\d+)?$/.test(argv);
@@ -323,6 +412,7 @@ function masterInit() {
       silent: cluster.settings.silent,
       execArgv: execArgv,
       stdio: cluster.settings.stdio,
+      serialization: cluster.settings.serialization,
       gid: cluster.settings.gid,
       uid: cluster.settings.uid
     });
@@ -455,6 +545,8 @@ function masterInit() {
       exitedAfterDisconnect(worker, message);
     else if (message.act === 'close')
       close(worker, message);
+    else if (message.act === 'load')
+      load(worker, message);
   }
 
   function online(worker) {
@@ -481,13 +573,20 @@ function masterInit() {
     var handle = handles[key];
     if (handle === undefined) {
       var constructor = RoundRobinHandle;
+      if (schedulingPolicy === SCHED_LOAD)
+        constructor = LeastLoadedHandle;
       // UDP is exempt from round-robin connection balancing for what should
       // be obvious reasons: it's connectionless. There is nothing to send to
       // the workers except raw datagrams and that's pointless.
-      if (schedulingPolicy !== SCHED_RR ||
+      if (schedulingPolicy === SCHED_NONE ||
           message.addressType === 'udp4' ||
           message.addressType === 'udp6') {
         constructor = SharedHandle;
+      } else if (schedulingPolicy === SCHED_REUSEPORT &&
+                 message.port > 0 && !(message.fd >= 0)) {
+        // Ephemeral ports, pipes and inherited fds can't be bound by every
+        // worker independently, so those are still distributed by the master.
+        constructor = ReusePortHandle;
       }
       handles[key] = handle = new constructor(key,
                                               message.address,
@@ -505,13 +604,22 @@ function masterInit() {
         errno: errno,
         key: key,
         ack: message.seq,
-        data: handles[key].data
+        data: handles[key].data,
+        load: schedulingPolicy === SCHED_LOAD
       }, reply);
       if (errno) delete handles[key];  // Gives other workers a chance to retry.
       send(worker, reply, handle);
     });
   }
 
+  function load(worker, message) {
+    worker._load = {
+      accepted: message.accepted,
+      connections: message.connections,
+      lag: message.lag
+    };
+  }
+
   function listening(worker, message) {
     var info = {
       addressType: message.addressType,
@@ -541,6 +649,10 @@ function masterInit() {
 function workerInit() {
   var handles = {};
   var indexes = {};
+  var connections = 0;
+  // Monotonic, lets the master match load reports to its handoffs.
+  var acceptedConnections = 0;
+  var loadReportTimer = null;
 
   // Called from src/node.js
   cluster._setupWorker = function() {
@@ -592,6 +704,8 @@ function workerInit() {
 
       if (handle)
         shared(reply, handle, indexesKey, cb);  // Shared listen socket.
+      else if (reply.reuseport)
+        reuseport(reply, options, indexesKey, cb);  // Own listen socket.
       else
         rr(reply, indexesKey, cb);              // Round-robin.
     });
@@ -621,11 +735,29 @@ function workerInit() {
     cb(message.errno, handle);
   }
 
+  // Listen socket bound by this worker with SO_REUSEPORT.
+  function reuseport(message, options, indexesKey, cb) {
+    var handle = net._createServerHandle(options.address,
+                                         options.port,
+                                         options.addressType,
+                                         undefined,
+                                         true);
+    if (typeof handle === 'number') {
+      send({ act: 'close', key: message.key });
+      delete indexes[indexesKey];
+      return cb(handle, null);
+    }
+    shared(message, handle, indexesKey, cb);
+  }
+
   // Round-robin. Master distributes handles across workers.
   function rr(message, indexesKey, cb) {
     if (message.errno)
       return cb(message.errno, null);
 
+    if (message.load)
+      startLoadReports();
+
     var key = message.key;
     function listen(backlog) {
       // TODO(bnoordhuis) Send a message to the master that tells it to
@@ -683,7 +815,52 @@ function workerInit() {
     var server = handles[key];
     var accepted = server !== undefined;
     send({ ack: message.seq, accepted: accepted });
-    if (accepted) server.onconnection(0, handle);
+    if (accepted) {
+      // Track in-flight connections for the load reports.
+      connections++;
+      acceptedConnections++;
+      var close = handle.close;
+      handle.close = function() {
+        connections--;
+        return close.apply(this, arguments);
+      };
+      server.onconnection(0, handle);
+    }
+  }
+
+  // Periodically tell the master how many connections were accepted and are
+  // in flight, and how far the event loop lags behind, whenever any of them
+  // changes. Lag is reported in whole kLagPerConnection steps, less than
+  // that is scheduling noise.
+  function startLoadReports() {
+    if (loadReportTimer !== null)
+      return;
+
+    var last = Date.now();
+    var reportedAccepted = 0;
+    var reportedConnections = 0;
+    var reportedLag = 0;
+    loadReportTimer = setInterval(function() {
+      var now = Date.now();
+      var lag = Math.max(0, now - last - kLoadReportInterval);
+      lag -= lag % kLagPerConnection;
+      last = now;
+      if (acceptedConnections === reportedAccepted &&
+          connections === reportedConnections &&
+          lag === reportedLag) {
+        return;
+      }
+      reportedAccepted = acceptedConnections;
+      reportedConnections = connections;
+      reportedLag = lag;
+      send({
+        act: 'load',
+        accepted: acceptedConnections,
+        connections: connections,
+        lag: lag
+      });
+    }, kLoadReportInterval);
+    loadReportTimer.unref();
   }
 
   Worker.prototype.disconnect = function() {
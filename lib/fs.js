@@ -1856,6 +1856,7 @@ function ReadStream(path, options) {
   this.autoClose = options.autoClose === undefined ? true : options.autoClose;
   this.pos = undefined;
   this.bytesRead = 0;
+  this._sendFileDest = null;
 
   if (this.start !== undefined) {
     if (typeof this.start !== 'number') {
@@ -1913,6 +1914,13 @@ ReadStream.prototype._read = function(n) {
   if (this.destroyed)
     return;
 
+  if (this._sendFileDest !== null) {
+    var dest = this._sendFileDest;
+    this._sendFileDest = null;
+    if (canSendFile(this, dest))
+      return this._sendFile(dest);
+  }
+
   if (!pool || pool.length - pool.used < kMinPoolSpace) {
     // discard the old pool.
     pool = null;
@@ -1962,6 +1970,67 @@ ReadStream.prototype._read = function(n) {
 };
 
 
+// When a fresh ReadStream is piped straight into a plain TCP socket or pipe,
+// let the kernel copy the file into the socket instead of reading it into
+// Buffers. Anything that needs to see the data (an encoding, 'data'
+// listeners, other destinations) keeps the regular read path.
+ReadStream.prototype.pipe = function(dest, options) {
+  const state = this._readableState;
+  if (typeof dest._sendFile === 'function' &&
+      state.pipesCount === 0 &&
+      state.flowing !== true &&
+      state.decoder === null &&
+      state.length === 0 &&
+      this.bytesRead === 0 &&
+      this.listenerCount('data') === 0) {
+    this._sendFileDest = dest;
+  }
+  return Readable.prototype.pipe.call(this, dest, options);
+};
+
+
+// Re-checked when the first read happens, which may be well after pipe()
+// if the file was still being opened.
+function canSendFile(stream, dest) {
+  const state = stream._readableState;
+  return state.pipesCount === 1 &&
+         state.pipes === dest &&
+         state.length === 0 &&
+         stream.listenerCount('data') === 1 &&
+         dest._canSendFile();
+}
+
+
+ReadStream.prototype._sendFile = function(dest) {
+  var offset = -1;
+  var length = -1;
+  if (this.pos !== undefined) {
+    offset = this.pos;
+    if (this.end !== Infinity)
+      length = this.end - this.pos + 1;
+  }
+
+  if (length === 0)
+    return this.push(null);
+
+  dest._sendFile(this.fd, offset, length, (er, bytesSent) => {
+    this.bytesRead += bytesSent;
+    if (this.pos !== undefined)
+      this.pos += bytesSent;
+
+    // The socket has already been destroyed with the error; just release
+    // the file. The pipe is torn down by the socket's 'close'.
+    if (er) {
+      if (this.autoClose)
+        this.destroy();
+      return;
+    }
+
+    this.push(null);
+  });
+};
+
+
 ReadStream.prototype.destroy = function() {
   if (this.destroyed)
     return;
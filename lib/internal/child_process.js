@@ -17,6 +17,7 @@ const TTY = process.binding('tty_wrap').TTY;
 const TCP = process.binding('tcp_wrap').TCP;
 const UDP = process.binding('udp_wrap').UDP;
 const SocketList = require('internal/socket_list');
+const ipcSerialization = require('internal/ipc_serialization');
 
 const errnoException = util._errnoException;
 const SocketListSend = SocketList.SocketListSend;
@@ -268,6 +269,10 @@ ChildProcess.prototype.spawn = function(options) {
   const self = this;
   var ipc;
   var ipcFd;
+  const serialization = options.serialization || 'json';
+  if (serialization !== 'json' && serialization !== 'binary')
+    throw new TypeError('"serialization" must be "json" or "binary"');
+
   // If no `stdio` option was given - use default
   var stdio = options.stdio || 'pipe';
 
@@ -281,6 +286,7 @@ ChildProcess.prototype.spawn = function(options) {
     // Let child process know about opened IPC channel
     options.envPairs = options.envPairs || [];
     options.envPairs.push('NODE_CHANNEL_FD=' + ipcFd);
+    options.envPairs.push('NODE_CHANNEL_SERIALIZATION_MODE=' + serialization);
   }
 
   this.spawnfile = options.file;
@@ -349,7 +355,7 @@ ChildProcess.prototype.spawn = function(options) {
   });
 
   // Add .send() method and start listening for IPC data
-  if (ipc !== undefined) setupChannel(this, ipc);
+  if (ipc !== undefined) setupChannel(this, ipc, serialization);
 
   return err;
 };
@@ -408,7 +414,7 @@ ChildProcess.prototype.unref = function() {
 };
 
 
-function setupChannel(target, channel) {
+function setupChannel(target, channel, serialization) {
   target._channel = channel;
   target._handleQueue = null;
   target._pendingHandle = null;
@@ -434,10 +440,31 @@ function setupChannel(target, channel) {
 
   var decoder = new StringDecoder('utf8');
   var jsonBuffer = '';
+  var parser = null;
+  var pendingHandle;
+  if (serialization === 'binary')
+    parser = new ipcSerialization.MessageParser();
+
+  function onBinaryMessage(message) {
+    // A handle arrives with the read that carries the start of its message
+    if (message && message.cmd === 'NODE_HANDLE') {
+      handleMessage(target, message, pendingHandle);
+      pendingHandle = undefined;
+    } else {
+      handleMessage(target, message, undefined);
+    }
+  }
+
   channel.buffering = false;
   channel.onread = function(nread, pool, recvHandle) {
     // TODO(bnoordhuis) Check that nread > 0.
-    if (pool) {
+    if (pool && parser !== null) {
+      if (recvHandle)
+        pendingHandle = recvHandle;
+      parser.push(pool, onBinaryMessage);
+      this.buffering = parser.hasPendingData();
+
+    } else if (pool) {
       jsonBuffer += decoder.write(pool);
 
       var i, start = 0;
@@ -623,8 +650,14 @@ function setupChannel(target, channel) {
     var req = new WriteWrap();
     req.async = false;
 
-    var string = JSON.stringify(message) + '\n';
-    var err = channel.writeUtf8String(req, string, handle);
+    var err;
+    if (parser !== null) {
+      err = channel.writeBuffer(req, ipcSerialization.serialize(message),
+                                handle);
+    } else {
+      var string = JSON.stringify(message) + '\n';
+      err = channel.writeUtf8String(req, string, handle);
+    }
 
     if (err === 0) {
       if (handle) {
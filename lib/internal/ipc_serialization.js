@@ -0,0 +1,395 @@
+'use strict';
+
+// Binary serialization of IPC messages, used instead of line-delimited JSON
+// when a child is forked with `serialization: 'binary'`.
+//
+// Every message is framed as a 32-bit little-endian payload length followed
+// by the payload. The payload is a tagged encoding of the structured clone
+// subset: primitives, plain objects, arrays, Dates, RegExps, Maps, Sets,
+// ArrayBuffers, Buffers and typed arrays. Binary data is copied as raw bytes
+// and repeated or cyclic references are preserved.
+
+const Buffer = require('buffer').Buffer;
+
+const kHeaderSize = 4;
+const kInitialSize = 256;
+
+const TAG_UNDEFINED = 0;
+const TAG_NULL = 1;
+const TAG_TRUE = 2;
+const TAG_FALSE = 3;
+const TAG_INT32 = 4;
+const TAG_DOUBLE = 5;
+const TAG_STRING = 6;
+const TAG_ARRAY = 7;
+const TAG_OBJECT = 8;
+const TAG_DATE = 9;
+const TAG_REGEXP = 10;
+const TAG_BUFFER = 11;
+const TAG_TYPED_ARRAY = 12;
+const TAG_ARRAY_BUFFER = 13;
+const TAG_MAP = 14;
+const TAG_SET = 15;
+const TAG_REFERENCE = 16;
+
+const typedArrays = [
+  Int8Array,
+  Uint8Array,
+  Uint8ClampedArray,
+  Int16Array,
+  Uint16Array,
+  Int32Array,
+  Uint32Array,
+  Float32Array,
+  Float64Array
+];
+
+
+function Serializer() {
+  this.buffer = Buffer.allocUnsafe(kInitialSize);
+  this.offset = kHeaderSize;
+  this.seen = new Map();
+}
+
+Serializer.prototype.reserve = function(size) {
+  const needed = this.offset + size;
+  if (needed <= this.buffer.length)
+    return;
+
+  var length = this.buffer.length * 2;
+  while (length < needed)
+    length *= 2;
+  const buffer = Buffer.allocUnsafe(length);
+  this.buffer.copy(buffer, 0, 0, this.offset);
+  this.buffer = buffer;
+};
+
+Serializer.prototype.writeTag = function(tag) {
+  this.reserve(1);
+  this.buffer[this.offset++] = tag;
+};
+
+Serializer.prototype.writeUInt32 = function(value) {
+  this.reserve(4);
+  this.offset = this.buffer.writeUInt32LE(value, this.offset, true);
+};
+
+Serializer.prototype.writeDouble = function(value) {
+  this.reserve(8);
+  this.offset = this.buffer.writeDoubleLE(value, this.offset, true);
+};
+
+Serializer.prototype.writeString = function(string) {
+  const length = Buffer.byteLength(string, 'utf8');
+  this.writeUInt32(length);
+  this.reserve(length);
+  this.offset += this.buffer.write(string, this.offset, length, 'utf8');
+};
+
+Serializer.prototype.writeBytes = function(bytes) {
+  this.writeUInt32(bytes.length);
+  this.reserve(bytes.length);
+  this.offset += Buffer.from(bytes.buffer, bytes.byteOffset, bytes.length)
+                       .copy(this.buffer, this.offset);
+};
+
+Serializer.prototype.writeValue = function(value) {
+  switch (typeof value) {
+    case 'undefined':
+      this.writeTag(TAG_UNDEFINED);
+      return;
+    case 'boolean':
+      this.writeTag(value ? TAG_TRUE : TAG_FALSE);
+      return;
+    case 'number':
+      if ((value | 0) === value && (value !== 0 || 1 / value > 0)) {
+        this.writeTag(TAG_INT32);
+        this.reserve(4);
+        this.offset = this.buffer.writeInt32LE(value, this.offset, true);
+      } else {
+        this.writeTag(TAG_DOUBLE);
+        this.writeDouble(value);
+      }
+      return;
+    case 'string':
+      this.writeTag(TAG_STRING);
+      this.writeString(value);
+      return;
+    case 'object':
+      if (value === null) {
+        this.writeTag(TAG_NULL);
+        return;
+      }
+      this.writeObject(value);
+      return;
+  }
+  throw new TypeError(`${typeof value} could not be cloned`);
+};
+
+Serializer.prototype.writeObject = function(object) {
+  const id = this.seen.get(object);
+  if (id !== undefined) {
+    this.writeTag(TAG_REFERENCE);
+    this.writeUInt32(id);
+    return;
+  }
+  this.seen.set(object, this.seen.size);
+
+  if (object instanceof Buffer) {
+    this.writeTag(TAG_BUFFER);
+    this.writeBytes(object);
+  } else if (ArrayBuffer.isView(object)) {
+    const kind = typedArrays.indexOf(object.constructor);
+    if (kind === -1)
+      throw new TypeError(`${object.constructor.name} could not be cloned`);
+    this.writeTag(TAG_TYPED_ARRAY);
+    this.writeTag(kind);
+    this.writeBytes(new Uint8Array(object.buffer,
+                                   object.byteOffset,
+                                   object.byteLength));
+  } else if (object instanceof ArrayBuffer) {
+    this.writeTag(TAG_ARRAY_BUFFER);
+    this.writeBytes(new Uint8Array(object));
+  } else if (Array.isArray(object)) {
+    this.writeTag(TAG_ARRAY);
+    this.writeUInt32(object.length);
+    for (var i = 0; i < object.length; i++)
+      this.writeValue(object[i]);
+  } else if (object instanceof Date) {
+    this.writeTag(TAG_DATE);
+    this.writeDouble(object.getTime());
+  } else if (object instanceof RegExp) {
+    this.writeTag(TAG_REGEXP);
+    this.writeString(object.source);
+    this.writeString(object.flags);
+  } else if (object instanceof Map) {
+    this.writeTag(TAG_MAP);
+    this.writeUInt32(object.size);
+    for (const entry of object) {
+      this.writeValue(entry[0]);
+      this.writeValue(entry[1]);
+    }
+  } else if (object instanceof Set) {
+    this.writeTag(TAG_SET);
+    this.writeUInt32(object.size);
+    for (const entry of object)
+      this.writeValue(entry);
+  } else {
+    const keys = Object.keys(object);
+    this.writeTag(TAG_OBJECT);
+    this.writeUInt32(keys.length);
+    for (var j = 0; j < keys.length; j++) {
+      this.writeString(keys[j]);
+      this.writeValue(object[keys[j]]);
+    }
+  }
+};
+
+
+function Deserializer(buffer, offset, end) {
+  this.buffer = buffer;
+  this.offset = offset;
+  this.end = end;
+  this.objects = [];
+}
+
+Deserializer.prototype.check = function(size) {
+  if (this.offset + size > this.end)
+    throw new Error('Malformed IPC message');
+};
+
+Deserializer.prototype.readTag = function() {
+  this.check(1);
+  return this.buffer[this.offset++];
+};
+
+Deserializer.prototype.readUInt32 = function() {
+  this.check(4);
+  const value = this.buffer.readUInt32LE(this.offset, true);
+  this.offset += 4;
+  return value;
+};
+
+Deserializer.prototype.readDouble = function() {
+  this.check(8);
+  const value = this.buffer.readDoubleLE(this.offset, true);
+  this.offset += 8;
+  return value;
+};
+
+Deserializer.prototype.readString = function() {
+  const length = this.readUInt32();
+  this.check(length);
+  const string = this.buffer.toString('utf8', this.offset,
+                                      this.offset + length);
+  this.offset += length;
+  return string;
+};
+
+// Returns a copy so the result never aliases the read buffer
+Deserializer.prototype.readBytes = function() {
+  const length = this.readUInt32();
+  this.check(length);
+  const bytes = Buffer.allocUnsafe(length);
+  this.buffer.copy(bytes, 0, this.offset, this.offset + length);
+  this.offset += length;
+  return bytes;
+};
+
+Deserializer.prototype.readValue = function() {
+  const tag = this.readTag();
+  var i, length, object, value;
+
+  switch (tag) {
+    case TAG_UNDEFINED:
+      return undefined;
+    case TAG_NULL:
+      return null;
+    case TAG_TRUE:
+      return true;
+    case TAG_FALSE:
+      return false;
+    case TAG_INT32:
+      this.check(4);
+      value = this.buffer.readInt32LE(this.offset, true);
+      this.offset += 4;
+      return value;
+    case TAG_DOUBLE:
+      return this.readDouble();
+    case TAG_STRING:
+      return this.readString();
+    case TAG_REFERENCE:
+      i = this.readUInt32();
+      if (i >= this.objects.length)
+        throw new Error('Malformed IPC message');
+      return this.objects[i];
+    case TAG_BUFFER:
+      object = this.readBytes();
+      this.objects.push(object);
+      return object;
+    case TAG_TYPED_ARRAY: {
+      const Ctor = typedArrays[this.readTag()];
+      if (Ctor === undefined)
+        throw new Error('Malformed IPC message');
+      const bytes = this.readBytes();
+      // Copied into a fresh ArrayBuffer, which is always suitably aligned
+      const buffer = new ArrayBuffer(bytes.length);
+      new Uint8Array(buffer).set(bytes);
+      object = new Ctor(buffer);
+      this.objects.push(object);
+      return object;
+    }
+    case TAG_ARRAY_BUFFER: {
+      const bytes = this.readBytes();
+      object = new ArrayBuffer(bytes.length);
+      new Uint8Array(object).set(bytes);
+      this.objects.push(object);
+      return object;
+    }
+    case TAG_ARRAY:
+      length = this.readUInt32();
+      object = new Array(length);
+      this.objects.push(object);
+      for (i = 0; i < length; i++)
+        object[i] = this.readValue();
+      return object;
+    case TAG_OBJECT:
+      length = this.readUInt32();
+      object = {};
+      this.objects.push(object);
+      for (i = 0; i < length; i++) {
+        const key = this.readString();
+        // Plain assignment would call the `__proto__` setter
+        Object.defineProperty(object, key, {
+          value: this.readValue(),
+          writable: true,
+          enumerable: true,
+          configurable: true
+        });
+      }
+      return object;
+    case TAG_DATE:
+      object = new Date(this.readDouble());
+      this.objects.push(object);
+      return object;
+    case TAG_REGEXP: {
+      const source = this.readString();
+      object = new RegExp(source, this.readString());
+      this.objects.push(object);
+      return object;
+    }
+    case TAG_MAP:
+      length = this.readUInt32();
+      object = new Map();
+      this.objects.push(object);
+      for (i = 0; i < length; i++) {
+        const key = this.readValue();
+        object.set(key, this.readValue());
+      }
+      return object;
+    case TAG_SET:
+      length = this.readUInt32();
+      object = new Set();
+      this.objects.push(object);
+      for (i = 0; i < length; i++)
+        object.add(this.readValue());
+      return object;
+  }
+  throw new Error('Malformed IPC message');
+};
+
+
+// Returns a framed Buffer holding the serialized message
+function serialize(message) {
+  const serializer = new Serializer();
+  serializer.writeValue(message);
+  serializer.buffer.writeUInt32LE(serializer.offset - kHeaderSize, 0, true);
+  return serializer.buffer.slice(0, serializer.offset);
+}
+
+
+// Reassembles frames from the chunks read off the channel
+function MessageParser() {
+  this.chunks = [];
+  this.length = 0;
+}
+
+// Calls `onmessage` for every message completed by `chunk`
+MessageParser.prototype.push = function(chunk, onmessage) {
+  this.chunks.push(chunk);
+  this.length += chunk.length;
+
+  while (this.length >= kHeaderSize) {
+    if (this.chunks[0].length < kHeaderSize)
+      this.chunks = [Buffer.concat(this.chunks, this.length)];
+
+    const size = kHeaderSize + this.chunks[0].readUInt32LE(0, true);
+    if (this.length < size)
+      return;
+
+    if (this.chunks[0].length < size)
+      this.chunks = [Buffer.concat(this.chunks, this.length)];
+
+    const buffer = this.chunks[0];
+    const deserializer = new Deserializer(buffer, kHeaderSize, size);
+    const message = deserializer.readValue();
+
+    if (buffer.length === size)
+      this.chunks.shift();
+    else
+      this.chunks[0] = buffer.slice(size);
+    this.length -= size;
+
+    onmessage(message);
+  }
+};
+
+MessageParser.prototype.hasPendingData = function() {
+  return this.length !== 0;
+};
+
+
+module.exports = {
+  serialize,
+  MessageParser
+};
@@ -226,8 +226,11 @@ function setupChannel() {
     var fd = parseInt(process.env.NODE_CHANNEL_FD, 10);
     assert(fd >= 0);
 
+    const serialization = process.env.NODE_CHANNEL_SERIALIZATION_MODE;
+
     // Make sure it's not accidentally inherited by child processes.
     delete process.env.NODE_CHANNEL_FD;
+    delete process.env.NODE_CHANNEL_SERIALIZATION_MODE;
 
     var cp = require('child_process');
 
@@ -236,7 +239,7 @@ function setupChannel() {
     // FIXME is this really necessary?
     process.binding('tcp_wrap');
 
-    cp._forkChild(fd);
+    cp._forkChild(fd, serialization);
     assert(process.send);
   }
 }
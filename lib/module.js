@@ -10,6 +10,9 @@ const fs = require('fs');
 const path = require('path');
 const internalModuleReadFile = process.binding('fs').internalModuleReadFile;
 const internalModuleStat = process.binding('fs').internalModuleStat;
+// Only chakracore can keep module sources outside of its heap.
+const runMappedSourceInThisContext =
+    process.binding('contextify').runMappedSourceInThisContext;
 const preserveSymlinks = !!process.binding('config').preserveSymlinks;
 
 // If obj.hasOwnProperty has been overridden, then calling
@@ -526,14 +529,28 @@ Module.prototype._compile = function(content, filename) {
     }
   }
 
-  // create wrapper function
-  var wrapper = Module.wrap(content);
+  // ChakraCore can parse a large module file in place, wrapped as it is, and
+  // keep its source out of the heap. That needs the stock wrapper and a file
+  // that still holds content.
+  var compiledWrapper;
+  if (runMappedSourceInThisContext !== undefined &&
+      Module.wrap === NativeModule.wrap &&
+      Module.wrapper === NativeModule.wrapper) {
+    compiledWrapper = runMappedSourceInThisContext(content, filename,
+                                                   Module.wrapper[0],
+                                                   Module.wrapper[1]);
+  }
 
-  var compiledWrapper = vm.runInThisContext(wrapper, {
-    filename: filename,
-    lineOffset: 0,
-    displayErrors: true
-  });
+  if (compiledWrapper === undefined) {
+    // create wrapper function
+    var wrapper = Module.wrap(content);
+
+    compiledWrapper = vm.runInThisContext(wrapper, {
+      filename: filename,
+      lineOffset: 0,
+      displayErrors: true
+    });
+  }
 
   if (process._debugWaitConnect) {
     if (!resolvedArgv) {
@@ -18,6 +18,7 @@ const TCPConnectWrap = process.binding('tcp_wrap').TCPConnectWrap;
 const PipeConnectWrap = process.binding('pipe_wrap').PipeConnectWrap;
 const ShutdownWrap = process.binding('stream_wrap').ShutdownWrap;
 const WriteWrap = process.binding('stream_wrap').WriteWrap;
+const SendFileWrap = process.binding('stream_wrap').SendFileWrap;
 
 
 var cluster;
@@ -807,6 +808,80 @@ function afterWrite(status, handle, req, err) {
 }
 
 
+// Whether file data can be handed to the kernel and copied straight into
+// this socket with sendfile(2). Only plain TCP sockets and pipes with nothing
+// queued for writing qualify; TLS sockets never do.
+Socket.prototype._canSendFile = function() {
+  const handle = this._handle;
+  const state = this._writableState;
+  return handle !== null &&
+         typeof handle.sendFile === 'function' &&
+         !this.connecting &&
+         !this.destroyed &&
+         this.writable &&
+         !state.ending &&
+         !state.writing &&
+         !state.corked &&
+         state.length === 0 &&
+         handle.writeQueueSize === 0;
+};
+
+
+// Copy `length` bytes of `fd` starting at `offset` into the socket. A length
+// of -1 sends until end of file, an offset of -1 uses the current file
+// position. Writes made in the meantime are held back until it completes.
+Socket.prototype._sendFile = function(fd, offset, length, cb) {
+  var req = new SendFileWrap();
+  req.oncomplete = afterSendFile;
+  req.onprogress = onSendFileProgress;
+  req.owner = this;
+  req.cb = cb;
+
+  this._unrefTimer();
+  this.cork();
+
+  var err = this._handle.sendFile(req, fd, offset, length);
+  if (err) {
+    this.uncork();
+    process.nextTick(cb, errnoException(err, 'sendfile'), 0);
+  }
+};
+
+
+// Called between chunks of a sendfile transfer so that a large file sent to
+// a slow peer does not trip the idle timeout while bytes are still flowing.
+function onSendFileProgress(bytes) {
+  debug('sendfile progress', bytes);
+  this.owner._unrefTimer();
+}
+
+
+function afterSendFile(status, handle, req) {
+  var self = handle.owner;
+  debug('afterSendFile', status, req.bytes);
+
+  self._bytesDispatched += req.bytes;
+
+  if (self.destroyed) {
+    req.cb(errnoException(status < 0 ? status : uv.UV_ECANCELED, 'sendfile'),
+           req.bytes);
+    return;
+  }
+
+  if (status < 0) {
+    var ex = errnoException(status, 'sendfile');
+    debug('sendfile failure', ex);
+    self._destroy(ex);
+    req.cb(ex, req.bytes);
+    return;
+  }
+
+  self._unrefTimer();
+  self.uncork();
+  req.cb(null, req.bytes);
+}
+
+
 function connect(self, address, port, addressType, localAddress, localPort) {
   // TODO return promise from Socket.prototype.connect which
   // wraps _connectReq.
@@ -1149,7 +1224,7 @@ function _listen(handle, backlog) {
   return handle.listen(backlog || 511);
 }
 
-function createServerHandle(address, port, addressType, fd) {
+function createServerHandle(address, port, addressType, fd, reusePort) {
   var err = 0;
   // assign handle in listen, and clean up if bind or listen fails
   var handle;
@@ -1184,16 +1259,17 @@ function createServerHandle(address, port, addressType, fd) {
     debug('bind to ' + (address || 'anycast'));
     if (!address) {
       // Try binding to ipv6 first
-      err = handle.bind6('::', port);
+      err = handle.bind6('::', port, reusePort);
       if (err) {
         handle.close();
         // Fallback to ipv4
-        return createServerHandle('0.0.0.0', port);
+        return createServerHandle('0.0.0.0', port, undefined, undefined,
+                                  reusePort);
       }
     } else if (addressType === 6) {
-      err = handle.bind6(address, port);
+      err = handle.bind6(address, port, reusePort);
     } else {
-      err = handle.bind(address, port);
+      err = handle.bind(address, port, reusePort);
     }
   }
 
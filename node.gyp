@@ -79,6 +79,7 @@
       'lib/internal/cluster.js',
       'lib/internal/freelist.js',
       'lib/internal/fs.js',
+      'lib/internal/ipc_serialization.js',
       'lib/internal/linkedlist.js',
       'lib/internal/net.js',
       'lib/internal/module.js',
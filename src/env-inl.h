@@ -331,6 +331,15 @@ inline void Environment::set_http_parser_buffer(char* buffer) {
   http_parser_buffer_ = buffer;
 }
 
+// Owned by its idle handle, which frees it during handle cleanup
+inline ZScheduler* Environment::zlib_scheduler() const {
+  return zlib_scheduler_;
+}
+
+inline void Environment::set_zlib_scheduler(ZScheduler* scheduler) {
+  zlib_scheduler_ = scheduler;
+}
+
 inline Environment* Environment::from_cares_timer_handle(uv_timer_t* handle) {
   return ContainerOf(&Environment::cares_timer_handle_, handle);
 }
@@ -1662,9 +1662,12 @@ static void ReportException(Environment* env, const TryCatch& try_catch) {
 
 
 // Executes a str within the current v8 context.
+// |static_source|, when given, is a NUL-terminated utf8 copy of |source| that
+// outlives the isolate; engines that can parse it in place will.
 static Local<Value> ExecuteString(Environment* env,
                                   Local<String> source,
-                                  Local<String> filename) {
+                                  Local<String> filename,
+                                  const char* static_source = nullptr) {
   EscapableHandleScope scope(env->isolate());
   TryCatch try_catch(env->isolate());
 
@@ -1673,8 +1676,15 @@ static Local<Value> ExecuteString(Environment* env,
   try_catch.SetVerbose(false);
 
   ScriptOrigin origin(filename);
+#if defined(NODE_ENGINE_CHAKRACORE)
+  MaybeLocal<v8::Script> script = static_source != nullptr ?
+      v8::chakrashim::CompileStaticUtf8(env->context(), source, static_source,
+                                        &origin) :
+      v8::Script::Compile(env->context(), source, &origin);
+#else
   MaybeLocal<v8::Script> script =
       v8::Script::Compile(env->context(), source, &origin);
+#endif
   if (script.IsEmpty()) {
     ReportException(env, try_catch);
     exit(3);
@@ -3384,7 +3394,8 @@ void LoadEnvironment(Environment* env) {
   // 'internal_bootstrap_node_native' is the string containing that source code.
   Local<String> script_name = FIXED_ONE_BYTE_STRING(env->isolate(),
                                                     "bootstrap_node.js");
-  Local<Value> f_value = ExecuteString(env, MainSource(env), script_name);
+  Local<Value> f_value = ExecuteString(env, MainSource(env), script_name,
+                                       MainSourceUtf8());
   if (try_catch.HasCaught())  {
     ReportException(env, try_catch);
     exit(10);
@@ -470,6 +470,34 @@ void CreateFromString(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+#if defined(NODE_ENGINE_CHAKRACORE)
+// args: value
+// The engine writes the JSON text straight into the returned ArrayBuffer
+// instead of building a string that is then encoded again.
+void StringifyUtf8(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  Local<Value> result;
+  if (v8::chakrashim::StringifyUtf8(env->context(), args[0]).ToLocal(&result))
+    args.GetReturnValue().Set(result);
+}
+
+
+// args: buffer, reviver
+// The engine scans the utf8 bytes directly instead of decoding them into a
+// string that is then parsed.
+void ParseUtf8(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+  SPREAD_ARG(args[0], ts_obj);
+  Local<Value> result;
+  if (v8::chakrashim::ParseJsonUtf8(env->context(),
+                                    ts_obj_data,
+                                    ts_obj_length,
+                                    args[1]).ToLocal(&result))
+    args.GetReturnValue().Set(result);
+}
+#endif
+
+
 template <encoding encoding>
 void StringSlice(const FunctionCallbackInfo<Value>& args) {
   Environment* env = Environment::GetCurrent(args);
@@ -1317,6 +1345,10 @@ void Initialize(Local<Object> target,
 
   env->SetMethod(target, "setupBufferJS", SetupBufferJS);
   env->SetMethod(target, "createFromString", CreateFromString);
+#if defined(NODE_ENGINE_CHAKRACORE)
+  env->SetMethod(target, "stringifyUtf8", StringifyUtf8);
+  env->SetMethod(target, "parseUtf8", ParseUtf8);
+#endif
 
   env->SetMethod(target, "byteLengthUtf8", ByteLengthUtf8);
   env->SetMethod(target, "compare", Compare);
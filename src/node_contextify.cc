@@ -468,6 +468,10 @@ class ContextifyScript : public BaseObject {
     env->SetProtoMethod(script_tmpl, "runInThisContext", RunInThisContext);
 
     target->Set(class_name, script_tmpl->GetFunction());
+#if defined(NODE_ENGINE_CHAKRACORE)
+    env->SetMethod(target, "runMappedSourceInThisContext",
+                   RunMappedSourceInThisContext);
+#endif
     env->set_script_context_constructor_template(script_tmpl);
   }
 
@@ -551,6 +555,45 @@ class ContextifyScript : public BaseObject {
   }
 
 
+#if defined(NODE_ENGINE_CHAKRACORE)
+  // args: content, filename, head, tail
+  // Same as runInThisContext of head + content + tail with displayErrors,
+  // but the engine parses a view of the file in place and keeps the source
+  // there instead of in its heap. Returns undefined without running anything
+  // when the file can't be used that way.
+  static void RunMappedSourceInThisContext(
+      const FunctionCallbackInfo<Value>& args) {
+    Environment* env = Environment::GetCurrent(args);
+
+    CHECK(args[0]->IsString());
+    CHECK(args[1]->IsString());
+    CHECK(args[2]->IsString());
+    CHECK(args[3]->IsString());
+
+    TryCatch try_catch(env->isolate());
+    Local<String> filename = args[1].As<String>();
+    node::Utf8Value head(env->isolate(), args[2]);
+    node::Utf8Value tail(env->isolate(), args[3]);
+    ScriptOrigin origin(filename);
+    bool mapped;
+    MaybeLocal<Script> script = v8::chakrashim::CompileMappedSource(
+        env->context(), filename, args[0].As<String>(), *head, *tail, &origin,
+        &mapped);
+    if (!mapped)
+      return;
+
+    Local<Value> result;
+    if (script.IsEmpty() ||
+        !script.ToLocalChecked()->Run(env->context()).ToLocal(&result)) {
+      DecorateErrorStack(env, try_catch);
+      try_catch.ReThrow();
+      return;
+    }
+    args.GetReturnValue().Set(result);
+  }
+#endif
+
+
   static bool InstanceOf(Environment* env, const Local<Value>& value) {
     return !value.IsEmpty() &&
            env->script_context_constructor_template()->HasInstance(value);
@@ -417,8 +417,7 @@ void NodeBIO::TryAllocateForWrite(size_t hint) {
   if (w == nullptr ||
       (w->write_pos_ == w->len_ &&
        (w->next_ == r || w->next_->write_pos_ != 0))) {
-    size_t len = w == nullptr ? initial_ :
-                             kThroughputBufferLength;
+    size_t len = w == nullptr ? initial_ : chunk_;
     if (len < hint)
       len = hint;
     Buffer* next = new Buffer(env_, len);
@@ -16,6 +16,7 @@ class NodeBIO {
  public:
   NodeBIO() : env_(nullptr),
               initial_(kInitialBufferLength),
+              chunk_(kThroughputBufferLength),
               length_(0),
               read_head_(nullptr),
               write_head_(nullptr) {
@@ -79,6 +80,12 @@ class NodeBIO {
     initial_ = initial;
   }
 
+  // Size of the buffers allocated after the initial one, larger chunks let
+  // pending data be coalesced into fewer contiguous regions
+  inline void set_chunk(size_t chunk) {
+    chunk_ = chunk;
+  }
+
   static inline NodeBIO* FromBIO(BIO* bio) {
     CHECK_NE(bio->ptr, nullptr);
     return static_cast<NodeBIO*>(bio->ptr);
@@ -130,6 +137,7 @@ class NodeBIO {
 
   Environment* env_;
   size_t initial_;
+  size_t chunk_;
   size_t length_;
   Buffer* read_head_;
   Buffer* write_head_;
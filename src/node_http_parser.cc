@@ -15,6 +15,8 @@
 #include <stdlib.h>  // free()
 #include <string.h>  // strdup()
 
+#include <vector>
+
 // This is a binding to http_parser (https://github.com/joyent/http-parser)
 // The goal is to decouple sockets from parsing for more javascript-level
 // agility. A Buffer is read from a socket and passed to parser.execute().
@@ -53,6 +55,107 @@ const uint32_t kOnMessageComplete = 3;
 const uint32_t kOnExecute = 4;
 
 
+// Header names that show up in nearly every request or response. A string
+// is created for each of them once per environment, in both its canonical
+// and its all-lowercase spelling, and reused every time the exact same bytes
+// are seen again.
+struct CommonHeaderName {
+  const char* name;
+  size_t length;
+};
+
+#define V(name) { name, sizeof(name) - 1 },
+static const CommonHeaderName common_header_names[] = {
+  V("Accept")
+  V("Accept-Charset")
+  V("Accept-Encoding")
+  V("Accept-Language")
+  V("Accept-Ranges")
+  V("Age")
+  V("Authorization")
+  V("Cache-Control")
+  V("Connection")
+  V("Content-Encoding")
+  V("Content-Language")
+  V("Content-Length")
+  V("Content-Type")
+  V("Cookie")
+  V("Date")
+  V("DNT")
+  V("ETag")
+  V("Expect")
+  V("Expires")
+  V("Host")
+  V("If-Modified-Since")
+  V("If-None-Match")
+  V("Keep-Alive")
+  V("Last-Modified")
+  V("Location")
+  V("Origin")
+  V("Pragma")
+  V("Referer")
+  V("Server")
+  V("Set-Cookie")
+  V("Transfer-Encoding")
+  V("Upgrade")
+  V("Upgrade-Insecure-Requests")
+  V("User-Agent")
+  V("Vary")
+  V("Via")
+  V("X-Forwarded-For")
+  V("X-Forwarded-Proto")
+  V("X-Requested-With")
+};
+#undef V
+
+
+// Returns the index of |str| in the array built by CreateCommonHeaderNames()
+// or -1 if it is not a common header name.
+static int CommonHeaderNameIndex(const char* str, size_t size) {
+  for (size_t i = 0; i < arraysize(common_header_names); i++) {
+    const CommonHeaderName& header = common_header_names[i];
+
+    if (header.length != size)
+      continue;
+
+    if (memcmp(header.name, str, size) == 0)
+      return 2 * i;
+
+    size_t k = 0;
+    while (k < size && str[k] == ToLower(header.name[k]))
+      k++;
+    if (k == size)
+      return 2 * i + 1;
+  }
+
+  return -1;
+}
+
+
+static Local<Array> CreateCommonHeaderNames(Environment* env) {
+  Local<Array> names =
+      Array::New(env->isolate(), 2 * arraysize(common_header_names));
+  char lower[32];
+
+  for (size_t i = 0; i < arraysize(common_header_names); i++) {
+    const CommonHeaderName& header = common_header_names[i];
+    CHECK_LE(header.length, sizeof(lower));
+
+    for (size_t k = 0; k < header.length; k++)
+      lower[k] = ToLower(header.name[k]);
+
+    names->Set(env->context(), 2 * i,
+               OneByteString(env->isolate(), header.name, header.length))
+        .FromJust();
+    names->Set(env->context(), 2 * i + 1,
+               OneByteString(env->isolate(), lower, header.length))
+        .FromJust();
+  }
+
+  return names;
+}
+
+
 #define HTTP_CB(name)                                                         \
   static int name(http_parser* p_) {                                          \
     Parser* self = ContainerOf(&Parser::parser_, p_);                         \
@@ -77,6 +180,14 @@ struct StringPtr {
   }
 
 
+  StringPtr(StringPtr&& other)
+      : str_(other.str_), on_heap_(other.on_heap_), size_(other.size_) {
+    other.str_ = nullptr;
+    other.on_heap_ = false;
+    other.size_ = 0;
+  }
+
+
   ~StringPtr() {
     Reset();
   }
@@ -138,6 +249,10 @@ struct StringPtr {
   const char* str_;
   bool on_heap_;
   size_t size_;
+
+ private:
+  StringPtr(const StringPtr&) = delete;
+  void operator=(const StringPtr&) = delete;
 };
 
 
@@ -147,6 +262,8 @@ class Parser : public AsyncWrap {
       : AsyncWrap(env, wrap, AsyncWrap::PROVIDER_HTTPPARSER),
         current_buffer_len_(0),
         current_buffer_data_(nullptr) {
+    fields_.reserve(kInitialHeaderCapacity);
+    values_.reserve(kInitialHeaderCapacity);
     Wrap(object(), this);
     Init(type);
   }
@@ -187,16 +304,12 @@ class Parser : public AsyncWrap {
     if (num_fields_ == num_values_) {
       // start of new field name
       num_fields_++;
-      if (num_fields_ == arraysize(fields_)) {
-        // ran out of space - flush to javascript land
-        Flush();
-        num_fields_ = 1;
-        num_values_ = 0;
-      }
+      if (num_fields_ > fields_.size())
+        fields_.emplace_back();
       fields_[num_fields_ - 1].Reset();
     }
 
-    CHECK_LT(num_fields_, arraysize(fields_));
+    CHECK_LE(num_fields_, fields_.size());
     CHECK_EQ(num_fields_, num_values_ + 1);
 
     fields_[num_fields_ - 1].Update(at, length);
@@ -209,10 +322,12 @@ class Parser : public AsyncWrap {
     if (num_values_ != num_fields_) {
       // start of new header value
       num_values_++;
+      if (num_values_ > values_.size())
+        values_.emplace_back();
       values_[num_values_ - 1].Reset();
     }
 
-    CHECK_LT(num_values_, arraysize(values_));
+    CHECK_LE(num_values_, values_.size());
     CHECK_EQ(num_values_, num_fields_);
 
     values_[num_values_ - 1].Update(at, length);
@@ -235,6 +350,7 @@ class Parser : public AsyncWrap {
       A_STATUS_MESSAGE,
       A_UPGRADE,
       A_SHOULD_KEEP_ALIVE,
+      A_HEADER_VALUES,
       A_MAX
     };
 
@@ -249,15 +365,14 @@ class Parser : public AsyncWrap {
     for (size_t i = 0; i < arraysize(argv); i++)
       argv[i] = undefined;
 
-    if (have_flushed_) {
-      // Slow case, flush remaining headers.
-      Flush();
-    } else {
-      // Fast case, pass headers and URL to JS land.
+    // The header store grows as needed so all headers and the URL are
+    // passed to JS land in one go, however many there are.
+    if (lazy_header_values_)
+      argv[A_HEADERS] = CreateLazyHeaders(&argv[A_HEADER_VALUES]);
+    else
       argv[A_HEADERS] = CreateHeaders();
-      if (parser_.type == HTTP_REQUEST)
-        argv[A_URL] = url_.ToString(env());
-    }
+    if (parser_.type == HTTP_REQUEST)
+      argv[A_URL] = url_.ToString(env());
 
     num_fields_ = 0;
     num_values_ = 0;
@@ -458,6 +573,14 @@ class Parser : public AsyncWrap {
   }
 
 
+  // parser.setLazyHeaderValues(enabled)
+  static void SetLazyHeaderValues(const FunctionCallbackInfo<Value>& args) {
+    Parser* parser;
+    ASSIGN_OR_RETURN_UNWRAP(&parser, args.Holder());
+    parser->lazy_header_values_ = args[0]->IsTrue();
+  }
+
+
   template <bool should_pause>
   static void Pause(const FunctionCallbackInfo<Value>& args) {
     Environment* env = Environment::GetCurrent(args);
@@ -647,7 +770,7 @@ class Parser : public AsyncWrap {
     do {
       size_t j = 0;
       while (i < num_values_ && j < arraysize(argv) / 2) {
-        argv[j * 2] = fields_[i].ToString(env());
+        argv[j * 2] = HeaderName(fields_[i]);
         argv[j * 2 + 1] = values_[i].ToString(env());
         i++;
         j++;
@@ -661,7 +784,61 @@ class Parser : public AsyncWrap {
   }
 
 
-  // spill headers and request path to JS land
+  // Like CreateHeaders() but the value slots hold the end offset of each
+  // value in |*values|, a Buffer with all values back to back. Strings for
+  // the values are only created if and when JS land asks for them.
+  Local<Array> CreateLazyHeaders(Local<Value>* values) {
+    size_t total = 0;
+    for (size_t i = 0; i < num_values_; i++)
+      total += values_[i].size_;
+
+    Local<Object> buffer =
+        Buffer::New(env()->isolate(), total).ToLocalChecked();
+    char* data = Buffer::Data(buffer);
+    size_t offset = 0;
+
+    Local<Array> headers = Array::New(env()->isolate());
+    Local<Function> fn = env()->push_values_to_array_function();
+    Local<Value> argv[NODE_PUSH_VAL_TO_ARRAY_MAX * 2];
+    size_t i = 0;
+
+    do {
+      size_t j = 0;
+      while (i < num_values_ && j < arraysize(argv) / 2) {
+        if (values_[i].size_ > 0)
+          memcpy(data + offset, values_[i].str_, values_[i].size_);
+        offset += values_[i].size_;
+        argv[j * 2] = HeaderName(fields_[i]);
+        argv[j * 2 + 1] = Integer::NewFromUnsigned(env()->isolate(), offset);
+        i++;
+        j++;
+      }
+      if (j > 0) {
+        fn->Call(env()->context(), headers, j * 2, argv).ToLocalChecked();
+      }
+    } while (i < num_values_);
+
+    *values = buffer;
+    return headers;
+  }
+
+
+  Local<Value> HeaderName(const StringPtr& field) {
+    int index = CommonHeaderNameIndex(field.str_, field.size_);
+    if (index < 0)
+      return field.ToString(env());
+
+    Local<Array> names = env()->http_parser_header_names_array();
+    if (names.IsEmpty()) {
+      names = CreateCommonHeaderNames(env());
+      env()->set_http_parser_header_names_array(names);
+    }
+
+    return names->Get(env()->context(), index).ToLocalChecked();
+  }
+
+
+  // spill trailing headers and request path to JS land
   void Flush() {
     HandleScope scope(env()->isolate());
 
@@ -682,7 +859,6 @@ class Parser : public AsyncWrap {
       got_exception_ = true;
 
     url_.Reset();
-    have_flushed_ = true;
   }
 
 
@@ -692,20 +868,22 @@ class Parser : public AsyncWrap {
     status_message_.Reset();
     num_fields_ = 0;
     num_values_ = 0;
-    have_flushed_ = false;
     got_exception_ = false;
   }
 
 
+  // Enough for nearly every message; the stores grow past it when needed.
+  static const size_t kInitialHeaderCapacity = 32;
+
   http_parser parser_;
-  StringPtr fields_[32];  // header fields
-  StringPtr values_[32];  // header values
+  std::vector<StringPtr> fields_;  // header fields
+  std::vector<StringPtr> values_;  // header values
   StringPtr url_;
   StringPtr status_message_;
   size_t num_fields_;
   size_t num_values_;
-  bool have_flushed_;
   bool got_exception_;
+  bool lazy_header_values_ = false;
   Local<Object> current_buffer_;
   size_t current_buffer_len_;
   char* current_buffer_data_;
@@ -767,6 +945,7 @@ void InitHttpParser(Local<Object> target,
   env->SetProtoMethod(t, "execute", Parser::Execute);
   env->SetProtoMethod(t, "finish", Parser::Finish);
   env->SetProtoMethod(t, "reinitialize", Parser::Reinitialize);
+  env->SetProtoMethod(t, "setLazyHeaderValues", Parser::SetLazyHeaderValues);
   env->SetProtoMethod(t, "pause", Parser::Pause<true>);
   env->SetProtoMethod(t, "resume", Parser::Pause<false>);
   env->SetProtoMethod(t, "consume", Parser::Consume);
@@ -17,7 +17,11 @@ Local<String> MainSource(Environment* env) {
       env->isolate(),
       reinterpret_cast<const char*>(internal_bootstrap_node_native),
       NewStringType::kNormal,
-      sizeof(internal_bootstrap_node_native)).ToLocalChecked();
+      sizeof(internal_bootstrap_node_native) - 1).ToLocalChecked();
+}
+
+const char* MainSourceUtf8() {
+  return reinterpret_cast<const char*>(internal_bootstrap_node_native);
 }
 
 void DefineJavaScript(Environment* env, Local<Object> target) {
@@ -10,6 +10,8 @@ namespace node {
 
 void DefineJavaScript(Environment* env, v8::Local<v8::Object> target);
 v8::Local<v8::String> MainSource(Environment* env);
+// NUL-terminated utf8 text of MainSource(), valid for the life of the process.
+const char* MainSourceUtf8();
 
 }  // namespace node
 
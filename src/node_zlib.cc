@@ -15,6 +15,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/types.h>
+#include <vector>
 
 namespace node {
 
@@ -45,6 +46,69 @@ enum node_zlib_mode {
 
 void InitZlib(v8::Local<v8::Object> target);
 
+class ZCtx;
+
+/**
+ * Per-environment state shared by the zlib streams: small async writes issued
+ * in the same loop iteration are processed by a single threadpool job, and the
+ * deflate state of closed streams is reset and kept for new streams created
+ * with the same parameters.
+ */
+class ZScheduler {
+ public:
+  static ZScheduler* Get(Environment* env);
+
+  // |size| is the number of input bytes the write has to process
+  void Queue(ZCtx* ctx, size_t size);
+
+  // Return a reset deflate stream matching ctx's parameters, or nullptr
+  z_stream* TakeDeflate(ZCtx* ctx);
+
+  // Keep ctx's deflate stream for reuse, false if it has to be freed instead
+  bool ReleaseDeflate(ZCtx* ctx);
+
+ private:
+  struct Batch {
+    Batch() : size_(0) {}
+
+    uv_work_t work_req_;
+    std::vector<ZCtx*> ctxs_;
+    size_t size_;
+  };
+
+  struct PooledStream {
+    z_stream* strm_;
+    node_zlib_mode mode_;
+    int level_;
+    int windowBits_;
+    int memLevel_;
+    int strategy_;
+  };
+
+  explicit ZScheduler(Environment* env);
+  ~ZScheduler();
+
+  void Submit(Batch* batch);
+  void SubmitPending();
+  static void OnIdle(uv_idle_t* handle);
+  static void Process(uv_work_t* work_req);
+  static void After(uv_work_t* work_req, int status);
+
+  // A batch runs its streams one after the other on a single thread, so only
+  // small writes are batched, and a batch is submitted once it holds enough
+  // work to keep a thread busy. Larger writes and bursts still spread over
+  // the threadpool.
+  static const size_t kMaxBatchedWriteSize = 4 * 1024;
+  static const size_t kMaxBatchBytes = 32 * 1024;
+  static const size_t kMaxBatchSize = 16;
+  static const size_t kMaxPooledStreams = 8;
+
+  Environment* env_;
+  uv_idle_t idle_handle_;
+  Batch* pending_;
+  std::vector<PooledStream> pool_;
+};
+
 
 /**
  * Deflate/Inflate
@@ -63,6 +127,7 @@ class ZCtx : public AsyncWrap {
         mode_(mode),
         strategy_(0),
         windowBits_(0),
+        strm_(nullptr),
         write_in_progress_(false),
         pending_close_(false),
         refs_(0),
@@ -87,12 +152,20 @@ class ZCtx : public AsyncWrap {
     CHECK_LE(mode_, UNZIP);
 
     if (mode_ == DEFLATE || mode_ == GZIP || mode_ == DEFLATERAW) {
-      (void)deflateEnd(&strm_);
+      ZScheduler* scheduler = env()->zlib_scheduler();
+      if (dictionary_ != nullptr || scheduler == nullptr ||
+          !scheduler->ReleaseDeflate(this)) {
+        (void)deflateEnd(strm_);
+        delete strm_;
+      }
+      strm_ = nullptr;
       int64_t change_in_bytes = -static_cast<int64_t>(kDeflateContextSize);
       env()->isolate()->AdjustAmountOfExternalAllocatedMemory(change_in_bytes);
     } else if (mode_ == INFLATE || mode_ == GUNZIP || mode_ == INFLATERAW ||
                mode_ == UNZIP) {
-      (void)inflateEnd(&strm_);
+      (void)inflateEnd(strm_);
+      delete strm_;
+      strm_ = nullptr;
       int64_t change_in_bytes = -static_cast<int64_t>(kInflateContextSize);
       env()->isolate()->AdjustAmountOfExternalAllocatedMemory(change_in_bytes);
     }
@@ -168,29 +241,23 @@ class ZCtx : public AsyncWrap {
     CHECK(Buffer::IsWithinBounds(out_off, out_len, Buffer::Length(out_buf)));
     out = reinterpret_cast<Bytef *>(Buffer::Data(out_buf) + out_off);
 
-    // build up the work request
-    uv_work_t* work_req = &(ctx->work_req_);
-
-    ctx->strm_.avail_in = in_len;
-    ctx->strm_.next_in = in;
-    ctx->strm_.avail_out = out_len;
-    ctx->strm_.next_out = out;
+    ctx->strm_->avail_in = in_len;
+    ctx->strm_->next_in = in;
+    ctx->strm_->avail_out = out_len;
+    ctx->strm_->next_out = out;
     ctx->flush_ = flush;
 
     if (!async) {
       // sync version
       ctx->env()->PrintSyncTrace();
-      Process(work_req);
+      Process(ctx);
       if (CheckError(ctx))
         AfterSync(ctx, args);
       return;
     }
 
     // async version
-    uv_queue_work(ctx->env()->event_loop(),
-                  work_req,
-                  ZCtx::Process,
-                  ZCtx::After);
+    ZScheduler::Get(env)->Queue(ctx, in_len);
 
     args.GetReturnValue().Set(ctx->object());
   }
@@ -199,9 +266,9 @@ class ZCtx : public AsyncWrap {
   static void AfterSync(ZCtx* ctx, const FunctionCallbackInfo<Value>& args) {
     Environment* env = ctx->env();
     Local<Integer> avail_out = Integer::New(env->isolate(),
-                                            ctx->strm_.avail_out);
+                                            ctx->strm_->avail_out);
     Local<Integer> avail_in = Integer::New(env->isolate(),
-                                           ctx->strm_.avail_in);
+                                           ctx->strm_->avail_in);
 
     ctx->write_in_progress_ = false;
 
@@ -218,9 +285,7 @@ class ZCtx : public AsyncWrap {
   // This function may be called multiple times on the uv_work pool
   // for a single write() call, until all of the input bytes have
   // been consumed.
-  static void Process(uv_work_t* work_req) {
-    ZCtx *ctx = ContainerOf(&ZCtx::work_req_, work_req);
-
+  static void Process(ZCtx* ctx) {
     const Bytef* next_expected_header_byte = nullptr;
 
     // If the avail_out is left at 0, then it means that it ran out
@@ -230,11 +295,11 @@ class ZCtx : public AsyncWrap {
       case DEFLATE:
       case GZIP:
       case DEFLATERAW:
-        ctx->err_ = deflate(&ctx->strm_, ctx->flush_);
+        ctx->err_ = deflate(ctx->strm_, ctx->flush_);
         break;
       case UNZIP:
-        if (ctx->strm_.avail_in > 0) {
-          next_expected_header_byte = ctx->strm_.next_in;
+        if (ctx->strm_->avail_in > 0) {
+          next_expected_header_byte = ctx->strm_->next_in;
         }
 
         switch (ctx->gzip_id_bytes_read_) {
@@ -247,7 +312,7 @@ class ZCtx : public AsyncWrap {
               ctx->gzip_id_bytes_read_ = 1;
               next_expected_header_byte++;
 
-              if (ctx->strm_.avail_in == 1) {
+              if (ctx->strm_->avail_in == 1) {
                 // The only available byte was already read.
                 break;
               }
@@ -280,17 +345,17 @@ class ZCtx : public AsyncWrap {
       case INFLATE:
       case GUNZIP:
       case INFLATERAW:
-        ctx->err_ = inflate(&ctx->strm_, ctx->flush_);
+        ctx->err_ = inflate(ctx->strm_, ctx->flush_);
 
         // If data was encoded with dictionary
         if (ctx->err_ == Z_NEED_DICT && ctx->dictionary_ != nullptr) {
           // Load it
-          ctx->err_ = inflateSetDictionary(&ctx->strm_,
+          ctx->err_ = inflateSetDictionary(ctx->strm_,
                                            ctx->dictionary_,
                                            ctx->dictionary_len_);
           if (ctx->err_ == Z_OK) {
             // And try to decode again
-            ctx->err_ = inflate(&ctx->strm_, ctx->flush_);
+            ctx->err_ = inflate(ctx->strm_, ctx->flush_);
           } else if (ctx->err_ == Z_DATA_ERROR) {
             // Both inflateSetDictionary() and inflate() return Z_DATA_ERROR.
             // Make it possible for After() to tell a bad dictionary from bad
@@ -299,17 +364,17 @@ class ZCtx : public AsyncWrap {
           }
         }
 
-        while (ctx->strm_.avail_in > 0 &&
+        while (ctx->strm_->avail_in > 0 &&
                ctx->mode_ == GUNZIP &&
                ctx->err_ == Z_STREAM_END &&
-               ctx->strm_.next_in[0] != 0x00) {
+               ctx->strm_->next_in[0] != 0x00) {
           // Bytes remain in input buffer. Perhaps this is another compressed
           // member in the same archive, or just trailing garbage.
           // Trailing zero bytes are okay, though, since they are frequently
           // used for padding.
 
           Reset(ctx);
-          ctx->err_ = inflate(&ctx->strm_, ctx->flush_);
+          ctx->err_ = inflate(ctx->strm_, ctx->flush_);
         }
         break;
       default:
@@ -329,7 +394,7 @@ class ZCtx : public AsyncWrap {
     switch (ctx->err_) {
     case Z_OK:
     case Z_BUF_ERROR:
-      if (ctx->strm_.avail_out != 0 && ctx->flush_ == Z_FINISH) {
+      if (ctx->strm_->avail_out != 0 && ctx->flush_ == Z_FINISH) {
         ZCtx::Error(ctx, "unexpected end of file");
         return false;
       }
@@ -353,10 +418,9 @@ class ZCtx : public AsyncWrap {
 
 
   // v8 land!
-  static void After(uv_work_t* work_req, int status) {
+  static void After(ZCtx* ctx, int status) {
     CHECK_EQ(status, 0);
 
-    ZCtx* ctx = ContainerOf(&ZCtx::work_req_, work_req);
     Environment* env = ctx->env();
 
     HandleScope handle_scope(env->isolate());
@@ -366,9 +430,9 @@ class ZCtx : public AsyncWrap {
       return;
 
     Local<Integer> avail_out = Integer::New(env->isolate(),
-                                            ctx->strm_.avail_out);
+                                            ctx->strm_->avail_out);
     Local<Integer> avail_in = Integer::New(env->isolate(),
-                                           ctx->strm_.avail_in);
+                                           ctx->strm_->avail_in);
 
     ctx->write_in_progress_ = false;
 
@@ -387,8 +451,8 @@ class ZCtx : public AsyncWrap {
     // If you hit this assertion, you forgot to enter the v8::Context first.
     CHECK_EQ(env->context(), env->isolate()->GetCurrentContext());
 
-    if (ctx->strm_.msg != nullptr) {
-      message = ctx->strm_.msg;
+    if (ctx->strm_->msg != nullptr) {
+      message = ctx->strm_->msg;
     }
 
     HandleScope scope(env->isolate());
@@ -482,10 +546,6 @@ class ZCtx : public AsyncWrap {
     ctx->memLevel_ = memLevel;
     ctx->strategy_ = strategy;
 
-    ctx->strm_.zalloc = Z_NULL;
-    ctx->strm_.zfree = Z_NULL;
-    ctx->strm_.opaque = Z_NULL;
-
     ctx->flush_ = Z_NO_FLUSH;
 
     ctx->err_ = Z_OK;
@@ -506,12 +566,17 @@ class ZCtx : public AsyncWrap {
       case DEFLATE:
       case GZIP:
       case DEFLATERAW:
-        ctx->err_ = deflateInit2(&ctx->strm_,
-                                 ctx->level_,
-                                 Z_DEFLATED,
-                                 ctx->windowBits_,
-                                 ctx->memLevel_,
-                                 ctx->strategy_);
+        if (dictionary == nullptr)
+          ctx->strm_ = ZScheduler::Get(ctx->env())->TakeDeflate(ctx);
+        if (ctx->strm_ == nullptr) {
+          ctx->strm_ = NewStream();
+          ctx->err_ = deflateInit2(ctx->strm_,
+                                   ctx->level_,
+                                   Z_DEFLATED,
+                                   ctx->windowBits_,
+                                   ctx->memLevel_,
+                                   ctx->strategy_);
+        }
         ctx->env()->isolate()
             ->AdjustAmountOfExternalAllocatedMemory(kDeflateContextSize);
         break;
@@ -519,7 +584,8 @@ class ZCtx : public AsyncWrap {
       case GUNZIP:
       case INFLATERAW:
       case UNZIP:
-        ctx->err_ = inflateInit2(&ctx->strm_, ctx->windowBits_);
+        ctx->strm_ = NewStream();
+        ctx->err_ = inflateInit2(ctx->strm_, ctx->windowBits_);
         ctx->env()->isolate()
             ->AdjustAmountOfExternalAllocatedMemory(kInflateContextSize);
         break;
@@ -539,6 +605,14 @@ class ZCtx : public AsyncWrap {
     ctx->init_done_ = true;
   }
 
+  static z_stream* NewStream() {
+    z_stream* strm = new z_stream();
+    strm->zalloc = Z_NULL;
+    strm->zfree = Z_NULL;
+    strm->opaque = Z_NULL;
+    return strm;
+  }
+
   static void SetDictionary(ZCtx* ctx) {
     if (ctx->dictionary_ == nullptr)
       return;
@@ -548,7 +622,7 @@ class ZCtx : public AsyncWrap {
     switch (ctx->mode_) {
       case DEFLATE:
       case DEFLATERAW:
-        ctx->err_ = deflateSetDictionary(&ctx->strm_,
+        ctx->err_ = deflateSetDictionary(ctx->strm_,
                                          ctx->dictionary_,
                                          ctx->dictionary_len_);
         break;
@@ -567,7 +641,11 @@ class ZCtx : public AsyncWrap {
     switch (ctx->mode_) {
       case DEFLATE:
       case DEFLATERAW:
-        ctx->err_ = deflateParams(&ctx->strm_, level, strategy);
+        ctx->err_ = deflateParams(ctx->strm_, level, strategy);
+        if (ctx->err_ == Z_OK || ctx->err_ == Z_BUF_ERROR) {
+          ctx->level_ = level;
+          ctx->strategy_ = strategy;
+        }
         break;
       default:
         break;
@@ -585,12 +663,12 @@ class ZCtx : public AsyncWrap {
       case DEFLATE:
       case DEFLATERAW:
       case GZIP:
-        ctx->err_ = deflateReset(&ctx->strm_);
+        ctx->err_ = deflateReset(ctx->strm_);
         break;
       case INFLATE:
       case INFLATERAW:
       case GUNZIP:
-        ctx->err_ = inflateReset(&ctx->strm_);
+        ctx->err_ = inflateReset(ctx->strm_);
         break;
       default:
         break;
@@ -604,6 +682,8 @@ class ZCtx : public AsyncWrap {
   size_t self_size() const override { return sizeof(*this); }
 
  private:
+  friend class ZScheduler;
+
   void Ref() {
     if (++refs_ == 1) {
       ClearWeak();
@@ -629,9 +709,8 @@ class ZCtx : public AsyncWrap {
   int memLevel_;
   node_zlib_mode mode_;
   int strategy_;
-  z_stream strm_;
   int windowBits_;
-  uv_work_t work_req_;
+  z_stream* strm_;
   bool write_in_progress_;
   bool pending_close_;
   unsigned int refs_;
@@ -639,6 +718,138 @@ class ZCtx : public AsyncWrap {
 };
 
 
+ZScheduler::ZScheduler(Environment* env) : env_(env), pending_(nullptr) {
+  uv_idle_init(env->event_loop(), &idle_handle_);
+
+  auto close_and_delete = [](Environment* env, uv_handle_t* handle, void*) {
+    env->set_zlib_scheduler(nullptr);
+    uv_close(handle, [](uv_handle_t* handle) {
+      ZScheduler* scheduler =
+          ContainerOf(&ZScheduler::idle_handle_,
+                      reinterpret_cast<uv_idle_t*>(handle));
+      scheduler->env_->FinishHandleCleanup(handle);
+      delete scheduler;
+    });
+  };
+  env->RegisterHandleCleanup(reinterpret_cast<uv_handle_t*>(&idle_handle_),
+                             close_and_delete,
+                             nullptr);
+}
+
+
+ZScheduler::~ZScheduler() {
+  delete pending_;
+  for (PooledStream& pooled : pool_) {
+    (void)deflateEnd(pooled.strm_);
+    delete pooled.strm_;
+  }
+}
+
+
+ZScheduler* ZScheduler::Get(Environment* env) {
+  ZScheduler* scheduler = env->zlib_scheduler();
+  if (scheduler == nullptr) {
+    scheduler = new ZScheduler(env);
+    env->set_zlib_scheduler(scheduler);
+  }
+  return scheduler;
+}
+
+
+void ZScheduler::Queue(ZCtx* ctx, size_t size) {
+  // Not worth delaying, and it would hold up the writes batched with it
+  if (size > kMaxBatchedWriteSize) {
+    Batch* batch = new Batch();
+    batch->ctxs_.push_back(ctx);
+    batch->size_ = size;
+    Submit(batch);
+    return;
+  }
+
+  if (pending_ == nullptr) {
+    pending_ = new Batch();
+    uv_idle_start(&idle_handle_, OnIdle);
+  }
+
+  pending_->ctxs_.push_back(ctx);
+  pending_->size_ += size;
+  if (pending_->ctxs_.size() == kMaxBatchSize ||
+      pending_->size_ >= kMaxBatchBytes) {
+    SubmitPending();
+  }
+}
+
+
+void ZScheduler::Submit(Batch* batch) {
+  uv_queue_work(env_->event_loop(),
+                &batch->work_req_,
+                ZScheduler::Process,
+                ZScheduler::After);
+}
+
+
+void ZScheduler::SubmitPending() {
+  uv_idle_stop(&idle_handle_);
+  Submit(pending_);
+  pending_ = nullptr;
+}
+
+
+void ZScheduler::OnIdle(uv_idle_t* handle) {
+  ZScheduler* scheduler = ContainerOf(&ZScheduler::idle_handle_, handle);
+  scheduler->SubmitPending();
+}
+
+
+// thread pool!
+void ZScheduler::Process(uv_work_t* work_req) {
+  Batch* batch = ContainerOf(&Batch::work_req_, work_req);
+  for (ZCtx* ctx : batch->ctxs_)
+    ZCtx::Process(ctx);
+}
+
+
+void ZScheduler::After(uv_work_t* work_req, int status) {
+  Batch* batch = ContainerOf(&Batch::work_req_, work_req);
+  for (ZCtx* ctx : batch->ctxs_)
+    ZCtx::After(ctx, status);
+  delete batch;
+}
+
+
+z_stream* ZScheduler::TakeDeflate(ZCtx* ctx) {
+  for (auto it = pool_.begin(); it != pool_.end(); ++it) {
+    if (it->mode_ == ctx->mode_ &&
+        it->level_ == ctx->level_ &&
+        it->windowBits_ == ctx->windowBits_ &&
+        it->memLevel_ == ctx->memLevel_ &&
+        it->strategy_ == ctx->strategy_) {
+      z_stream* strm = it->strm_;
+      pool_.erase(it);
+      return strm;
+    }
+  }
+  return nullptr;
+}
+
+
+bool ZScheduler::ReleaseDeflate(ZCtx* ctx) {
+  if (pool_.size() == kMaxPooledStreams || deflateReset(ctx->strm_) != Z_OK)
+    return false;
+
+  PooledStream pooled = {
+    ctx->strm_,
+    ctx->mode_,
+    ctx->level_,
+    ctx->windowBits_,
+    ctx->memLevel_,
+    ctx->strategy_
+  };
+  pool_.push_back(pooled);
+  return true;
+}
+
+
 void InitZlib(Local<Object> target,
               Local<Value> unused,
               Local<Context> context,
@@ -196,7 +196,8 @@ class StreamBase : public StreamResource {
   enum Flags {
     kFlagNone = 0x0,
     kFlagHasWritev = 0x1,
-    kFlagNoShutdown = 0x2
+    kFlagNoShutdown = 0x2,
+    kFlagHasSendFile = 0x4
   };
 
   template <class Base>
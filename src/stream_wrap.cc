@@ -19,6 +19,13 @@
 #include <string.h>  // memcpy()
 #include <limits.h>  // INT_MAX
 
+#if defined(__linux__)
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/sendfile.h>
+#include <unistd.h>
+#endif
+
 
 namespace node {
 
@@ -29,6 +36,7 @@ using v8::FunctionTemplate;
 using v8::HandleScope;
 using v8::Integer;
 using v8::Local;
+using v8::Number;
 using v8::Object;
 using v8::Value;
 
@@ -52,6 +60,13 @@ void StreamWrap::Initialize(Local<Object> target,
   target->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "WriteWrap"),
               ww->GetFunction());
   env->set_write_wrap_constructor_function(ww->GetFunction());
+
+  Local<FunctionTemplate> sfw =
+      FunctionTemplate::New(env->isolate(), SendFileWrap::NewSendFileWrap);
+  sfw->InstanceTemplate()->SetInternalFieldCount(1);
+  sfw->SetClassName(FIXED_ONE_BYTE_STRING(env->isolate(), "SendFileWrap"));
+  target->Set(FIXED_ONE_BYTE_STRING(env->isolate(), "SendFileWrap"),
+              sfw->GetFunction());
 }
 
 
@@ -77,6 +92,10 @@ void StreamWrap::AddMethods(Environment* env,
                             v8::Local<v8::FunctionTemplate> target,
                             int flags) {
   env->SetProtoMethod(target, "setBlocking", SetBlocking);
+#if defined(__linux__)
+  if ((flags & StreamBase::kFlagHasSendFile) != 0)
+    env->SetProtoMethod(target, "sendFile", SendFile);
+#endif
   StreamBase::AddMethods<StreamWrap>(env, target, flags);
 }
 
@@ -274,6 +293,311 @@ void StreamWrap::SetBlocking(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+SendFileWrap::SendFileWrap(Environment* env,
+                           Local<Object> req_wrap_obj,
+                           int in_fd,
+                           int out_fd,
+                           int64_t offset,
+                           int64_t length)
+    : ReqWrap(env, req_wrap_obj, AsyncWrap::PROVIDER_SENDFILEWRAP),
+      in_fd_(in_fd),
+      out_fd_(out_fd),
+      offset_(offset),
+      remaining_(length),
+      bytes_(0),
+      reported_bytes_(0),
+      eof_(false),
+      status_(0),
+      pending_close_(0) {
+  Wrap(req_wrap_obj, this);
+}
+
+
+SendFileWrap::~SendFileWrap() {
+  CHECK_EQ(pending_close_, 0);
+#if defined(__linux__)
+  if (in_fd_ != -1)
+    close(in_fd_);
+  if (out_fd_ != -1)
+    close(out_fd_);
+#endif
+}
+
+
+int SendFileWrap::Queue() {
+  return uv_queue_work(env()->event_loop(), &req_, DoSendFile, AfterSendFile);
+}
+
+
+// Runs on the threadpool.  Sends at most kMaxChunkSize bytes and never waits
+// for the socket: UV_EAGAIN in status_ tells AfterSendFile() to poll for
+// writability on the loop instead.
+void SendFileWrap::DoSendFile(uv_work_t* req) {
+#if defined(__linux__)
+  SendFileWrap* req_wrap = ContainerOf(&SendFileWrap::req_, req);
+  req_wrap->status_ = 0;
+
+  size_t sent = 0;
+  while (req_wrap->remaining_ != 0 && sent < kMaxChunkSize) {
+    size_t len = kMaxChunkSize - sent;
+    if (req_wrap->remaining_ > 0 &&
+        static_cast<uint64_t>(req_wrap->remaining_) < len) {
+      len = static_cast<size_t>(req_wrap->remaining_);
+    }
+
+    ssize_t r;
+    if (req_wrap->offset_ < 0) {
+      r = sendfile(req_wrap->out_fd_, req_wrap->in_fd_, nullptr, len);
+    } else {
+      off_t off = static_cast<off_t>(req_wrap->offset_);
+      r = sendfile(req_wrap->out_fd_, req_wrap->in_fd_, &off, len);
+    }
+
+    if (r > 0) {
+      sent += r;
+      req_wrap->bytes_ += r;
+      if (req_wrap->offset_ >= 0)
+        req_wrap->offset_ += r;
+      if (req_wrap->remaining_ > 0)
+        req_wrap->remaining_ -= r;
+      continue;
+    }
+
+    if (r == 0) {
+      req_wrap->eof_ = true;
+      return;
+    }
+
+    if (errno == EINTR)
+      continue;
+
+    if (errno == EAGAIN || errno == EWOULDBLOCK) {
+      req_wrap->status_ = UV_EAGAIN;
+      return;
+    }
+
+    // libuv error codes are negated errno values on unix.
+    req_wrap->status_ = -errno;
+    return;
+  }
+#else
+  UNREACHABLE();
+#endif
+}
+
+
+void SendFileWrap::AfterSendFile(uv_work_t* req, int status) {
+  SendFileWrap* req_wrap = ContainerOf(&SendFileWrap::req_, req);
+  Environment* env = req_wrap->env();
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+
+  // The wrap and request objects should still be there.
+  CHECK_EQ(req_wrap->persistent().IsEmpty(), false);
+
+  if (status == 0)
+    status = req_wrap->status_;
+
+  bool done = req_wrap->eof_ || req_wrap->remaining_ == 0;
+  if (status != UV_EAGAIN && (status != 0 || done))
+    return req_wrap->Finish(status);
+
+  Local<Object> req_wrap_obj = req_wrap->object();
+  StreamWrap* wrap =
+      Unwrap<StreamWrap>(req_wrap_obj->Get(env->handle_string()).As<Object>());
+  if (wrap == nullptr || !wrap->IsAlive() || wrap->IsClosing())
+    return req_wrap->Finish(UV_ECANCELED);
+
+  // Let the owner refresh its idle timeout for every chunk that got out.
+  if (req_wrap->bytes_ != req_wrap->reported_bytes_) {
+    req_wrap->reported_bytes_ = req_wrap->bytes_;
+    if (req_wrap_obj->Has(env->context(),
+                          env->onprogress_string()).FromJust()) {
+      Local<Value> argv[] = {
+        Number::New(env->isolate(), static_cast<double>(req_wrap->bytes_))
+      };
+      req_wrap->MakeCallback(env->onprogress_string(), arraysize(argv), argv);
+    }
+  }
+
+  if (status == 0) {
+    status = req_wrap->Queue();
+  } else {
+    // The peer is slow to drain.  Wait on the loop for the socket to become
+    // writable, checking every kPollTimeout that the handle is still open.
+    status = uv_poll_start(&req_wrap->poll_, UV_WRITABLE, OnWritable);
+    if (status == 0)
+      status = uv_timer_start(&req_wrap->timer_,
+                              OnPollTimeout,
+                              kPollTimeout,
+                              kPollTimeout);
+  }
+
+  if (status != 0)
+    req_wrap->Finish(status);
+}
+
+
+void SendFileWrap::OnWritable(uv_poll_t* handle, int status, int events) {
+  SendFileWrap* req_wrap = ContainerOf(&SendFileWrap::poll_, handle);
+  Environment* env = req_wrap->env();
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+
+  uv_poll_stop(&req_wrap->poll_);
+  uv_timer_stop(&req_wrap->timer_);
+
+  // Errors on the socket are reported by the next sendfile() call.
+  status = req_wrap->Queue();
+  if (status != 0)
+    req_wrap->Finish(status);
+}
+
+
+void SendFileWrap::OnPollTimeout(uv_timer_t* handle) {
+  SendFileWrap* req_wrap = ContainerOf(&SendFileWrap::timer_, handle);
+  Environment* env = req_wrap->env();
+  HandleScope handle_scope(env->isolate());
+  Context::Scope context_scope(env->context());
+
+  StreamWrap* wrap = Unwrap<StreamWrap>(
+      req_wrap->object()->Get(env->handle_string()).As<Object>());
+  if (wrap != nullptr && wrap->IsAlive() && !wrap->IsClosing())
+    return;
+
+  uv_poll_stop(&req_wrap->poll_);
+  uv_timer_stop(&req_wrap->timer_);
+  req_wrap->Finish(UV_ECANCELED);
+}
+
+
+void SendFileWrap::Finish(int status) {
+  Environment* env = this->env();
+  Local<Object> req_wrap_obj = object();
+  Local<Object> handle_obj =
+      req_wrap_obj->Get(env->handle_string()).As<Object>();
+  StreamWrap* wrap = Unwrap<StreamWrap>(handle_obj);
+
+  if (wrap != nullptr && bytes_ > 0) {
+    if (wrap->is_tcp()) {
+      NODE_COUNT_NET_BYTES_SENT(bytes_);
+    } else if (wrap->is_named_pipe()) {
+      NODE_COUNT_PIPE_BYTES_SENT(bytes_);
+    }
+  }
+
+  // uint64_t -> double. 53bits is enough for all real cases.
+  req_wrap_obj->Set(env->bytes_string(),
+                    Number::New(env->isolate(), static_cast<double>(bytes_)));
+
+  Local<Value> argv[] = {
+    Integer::New(env->isolate(), status),
+    handle_obj,
+    req_wrap_obj
+  };
+
+  if (req_wrap_obj->Has(env->context(),
+                        env->oncomplete_string()).FromJust()) {
+    MakeCallback(env->oncomplete_string(), arraysize(argv), argv);
+  }
+
+  Dispose();
+}
+
+
+// The poll handle watches out_fd_, so the fd is only closed by the destructor
+// once both handles are gone.
+void SendFileWrap::Dispose() {
+  pending_close_ = 2;
+  uv_close(reinterpret_cast<uv_handle_t*>(&poll_), OnClose);
+  uv_close(reinterpret_cast<uv_handle_t*>(&timer_), OnClose);
+}
+
+
+void SendFileWrap::OnClose(uv_handle_t* handle) {
+  SendFileWrap* req_wrap = static_cast<SendFileWrap*>(handle->data);
+  if (--req_wrap->pending_close_ != 0)
+    return;
+  HandleScope handle_scope(req_wrap->env()->isolate());
+  delete req_wrap;
+}
+
+
+// sendFile(req, fd, offset, length): a negative offset reads from the current
+// file position, a negative length sends until end of file.  The stream must
+// not have writes in flight; the caller is expected to hold off further
+// writes until req.oncomplete(status, handle, req) has run.  If present,
+// req.onprogress(bytes) is called as the transfer makes progress.
+void StreamWrap::SendFile(const FunctionCallbackInfo<Value>& args) {
+  Environment* env = Environment::GetCurrent(args);
+
+  StreamWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+
+  CHECK(args[0]->IsObject());
+  CHECK(args[1]->IsInt32());
+  CHECK(args[2]->IsNumber());
+  CHECK(args[3]->IsNumber());
+
+  if (!wrap->IsAlive() || wrap->IsClosing())
+    return args.GetReturnValue().Set(UV_EINVAL);
+
+  if (wrap->stream()->write_queue_size != 0 || wrap->IsIPCPipe())
+    return args.GetReturnValue().Set(UV_EBUSY);
+
+#if defined(__linux__)
+  int fd = wrap->GetFD();
+  if (fd < 0)
+    return args.GetReturnValue().Set(UV_EBADF);
+
+  int out_fd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+  if (out_fd == -1)
+    return args.GetReturnValue().Set(-errno);
+
+  // The threadpool reads from its own descriptor, so that closing the file
+  // while a chunk is in flight can't make it read from whatever file reuses
+  // the number.  The duplicate shares the file position with the original.
+  int in_fd = fcntl(args[1]->Int32Value(), F_DUPFD_CLOEXEC, 0);
+  if (in_fd == -1) {
+    int err = -errno;
+    close(out_fd);
+    return args.GetReturnValue().Set(err);
+  }
+
+  Local<Object> req_wrap_obj = args[0].As<Object>();
+  SendFileWrap* req_wrap =
+      new SendFileWrap(env,
+                       req_wrap_obj,
+                       in_fd,
+                       out_fd,
+                       static_cast<int64_t>(args[2]->NumberValue()),
+                       static_cast<int64_t>(args[3]->NumberValue()));
+  req_wrap->Dispatched();
+  // Keep the stream object reachable until the transfer has finished.
+  req_wrap_obj->Set(env->handle_string(), wrap->object());
+
+  int err = uv_poll_init(env->event_loop(), &req_wrap->poll_, out_fd);
+  if (err) {
+    delete req_wrap;
+    return args.GetReturnValue().Set(err);
+  }
+  CHECK_EQ(uv_timer_init(env->event_loop(), &req_wrap->timer_), 0);
+  req_wrap->poll_.data = req_wrap;
+  req_wrap->timer_.data = req_wrap;
+  // The poll handle keeps the loop alive while the socket drains.
+  uv_unref(reinterpret_cast<uv_handle_t*>(&req_wrap->timer_));
+
+  err = req_wrap->Queue();
+  if (err)
+    req_wrap->Dispose();
+
+  args.GetReturnValue().Set(err);
+#else
+  args.GetReturnValue().Set(UV_ENOSYS);
+#endif
+}
+
+
 int StreamWrap::DoShutdown(ShutdownWrap* req_wrap) {
   int err;
   err = uv_shutdown(&req_wrap->req_, stream(), AfterShutdown);
@@ -7,6 +7,7 @@
 
 #include "env.h"
 #include "handle_wrap.h"
+#include "req-wrap.h"
 #include "string_bytes.h"
 #include "v8.h"
 
@@ -15,6 +16,62 @@ namespace node {
 // Forward declaration
 class StreamWrap;
 
+// Copies a range of a file descriptor straight into the stream's socket or
+// pipe with sendfile(2), so the payload never passes through a JS Buffer.
+// The transfer runs on the threadpool against a dup() of the stream's fd so
+// that closing the handle mid-transfer cannot hand the fd number to someone
+// else while the worker is still using it.  Workers never wait for the
+// socket: when it is full the loop polls the fd and queues the next chunk
+// once it becomes writable.
+class SendFileWrap : public ReqWrap<uv_work_t> {
+ public:
+  SendFileWrap(Environment* env,
+               v8::Local<v8::Object> req_wrap_obj,
+               int in_fd,
+               int out_fd,
+               int64_t offset,
+               int64_t length);
+  ~SendFileWrap();
+
+  static void NewSendFileWrap(const v8::FunctionCallbackInfo<v8::Value>& args) {
+    CHECK(args.IsConstructCall());
+  }
+
+  size_t self_size() const override { return sizeof(*this); }
+
+  // Maximum number of bytes sent by one threadpool job.  The owner is told
+  // about progress between jobs so that it can refresh its idle timeout.
+  static const size_t kMaxChunkSize = 1 << 20;
+  // How often the loop checks that the handle is still open while it waits
+  // for the socket to drain.
+  static const int kPollTimeout = 1000;
+
+ private:
+  friend class StreamWrap;
+
+  int Queue();
+  void Finish(int status);
+  void Dispose();
+
+  static void DoSendFile(uv_work_t* req);
+  static void AfterSendFile(uv_work_t* req, int status);
+  static void OnWritable(uv_poll_t* handle, int status, int events);
+  static void OnPollTimeout(uv_timer_t* handle);
+  static void OnClose(uv_handle_t* handle);
+
+  const int in_fd_;
+  const int out_fd_;
+  int64_t offset_;  // -1 means "use and update the current file position".
+  int64_t remaining_;  // -1 means "until end of file".
+  uint64_t bytes_;
+  uint64_t reported_bytes_;
+  bool eof_;
+  int status_;
+  int pending_close_;
+  uv_poll_t poll_;
+  uv_timer_t timer_;
+};
+
 class StreamWrap : public HandleWrap, public StreamBase {
  public:
   static void Initialize(v8::Local<v8::Object> target,
@@ -75,6 +132,7 @@ class StreamWrap : public HandleWrap, public StreamBase {
 
  private:
   static void SetBlocking(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SendFile(const v8::FunctionCallbackInfo<v8::Value>& args);
 
   // Callbacks for libuv
   static void OnAlloc(uv_handle_t* handle,
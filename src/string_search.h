@@ -10,6 +10,15 @@
 #include "node.h"
 #include <string.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define NODE_STRING_SEARCH_SSE2 1
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
 namespace node {
 namespace stringsearch {
 
@@ -311,6 +320,71 @@ inline size_t FindFirstCharacter(Vector<const uint8_t> pattern,
   return subject.forward() ? raw_pos : (subj_len - raw_pos - 1);
 }
 
+#ifdef NODE_STRING_SEARCH_SSE2
+inline unsigned CountTrailingZeros(uint32_t value) {
+#ifdef _MSC_VER
+  unsigned long index;
+  _BitScanForward(&index, value);
+  return index;
+#else
+  return __builtin_ctz(value);
+#endif
+}
+#endif
+
+
+// Finds the first position in `subject` where both the first and the last
+// characters of `pattern` match, 16 bytes at a time. Does not verify that the
+// characters in between match. Backwards searches, and one byte searches for a
+// single character, for which memchr is best, use FindFirstCharacter instead.
+template <typename Char>
+inline size_t FindFirstAndLastCharacter(Vector<const Char> pattern,
+                                        Vector<const Char> subject,
+                                        size_t index) {
+#ifdef NODE_STRING_SEARCH_SSE2
+  const size_t last_offset = pattern.length() - 1;
+  if (subject.forward() && (sizeof(Char) == 2 || last_offset > 0)) {
+    const Char* start = subject.start();
+    const Char first_char = pattern[0];
+    const Char last_char = pattern[last_offset];
+    const size_t max_n = subject.length() - last_offset;
+    const size_t chars_per_vector = sizeof(__m128i) / sizeof(Char);
+
+    const __m128i first = sizeof(Char) == 1 ?
+        _mm_set1_epi8(static_cast<char>(first_char)) :
+        _mm_set1_epi16(static_cast<int16_t>(first_char));
+    const __m128i last = sizeof(Char) == 1 ?
+        _mm_set1_epi8(static_cast<char>(last_char)) :
+        _mm_set1_epi16(static_cast<int16_t>(last_char));
+
+    size_t pos = index;
+    for (; pos + chars_per_vector <= max_n; pos += chars_per_vector) {
+      const __m128i first_chunk = _mm_loadu_si128(
+          reinterpret_cast<const __m128i*>(start + pos));
+      const __m128i last_chunk = _mm_loadu_si128(
+          reinterpret_cast<const __m128i*>(start + pos + last_offset));
+      const __m128i matches = sizeof(Char) == 1 ?
+          _mm_and_si128(_mm_cmpeq_epi8(first_chunk, first),
+                        _mm_cmpeq_epi8(last_chunk, last)) :
+          _mm_and_si128(_mm_cmpeq_epi16(first_chunk, first),
+                        _mm_cmpeq_epi16(last_chunk, last));
+      const uint32_t mask = _mm_movemask_epi8(matches);
+      if (mask != 0) {
+        return pos + CountTrailingZeros(mask) / sizeof(Char);
+      }
+    }
+
+    for (; pos < max_n; pos++) {
+      if (start[pos] == first_char && start[pos + last_offset] == last_char) {
+        return pos;
+      }
+    }
+    return subject.length();
+  }
+#endif
+  return FindFirstCharacter(pattern, subject, index);
+}
+
 //---------------------------------------------------------------------
 // Single Character Pattern Search Strategy
 //---------------------------------------------------------------------
@@ -321,7 +395,7 @@ size_t StringSearch<Char>::SingleCharSearch(
     Vector<const Char> subject,
     size_t index) {
   CHECK_EQ(1, search->pattern_.length());
-  return FindFirstCharacter(search->pattern_, subject, index);
+  return FindFirstAndLastCharacter(search->pattern_, subject, index);
 }
 
 //---------------------------------------------------------------------
@@ -339,7 +413,7 @@ size_t StringSearch<Char>::LinearSearch(
   const size_t pattern_length = pattern.length();
   const size_t n = subject.length() - pattern_length;
   for (size_t i = index; i <= n; i++) {
-    i = FindFirstCharacter(pattern, subject, i);
+    i = FindFirstAndLastCharacter(pattern, subject, i);
     if (i == subject.length())
       return subject.length();
     ASSERT_LE(i, n);
@@ -588,7 +662,7 @@ size_t StringSearch<Char>::InitialSearch(
   for (size_t i = index, n = subject.length() - pattern_length; i <= n; i++) {
     badness++;
     if (badness <= 0) {
-      i = FindFirstCharacter(pattern, subject, i);
+      i = FindFirstAndLastCharacter(pattern, subject, i);
       if (i == subject.length())
         return subject.length();
       ASSERT_LE(i, n);
@@ -13,6 +13,12 @@
 
 #include <stdlib.h>
 
+#if defined(__linux__)
+#include <errno.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
 
 namespace node {
 
@@ -70,7 +76,10 @@ void TCPWrap::Initialize(Local<Object> target,
   env->SetProtoMethod(t, "unref", HandleWrap::Unref);
   env->SetProtoMethod(t, "hasRef", HandleWrap::HasRef);
 
-  StreamWrap::AddMethods(env, t, StreamBase::kFlagHasWritev);
+  StreamWrap::AddMethods(env,
+                         t,
+                         StreamBase::kFlagHasWritev |
+                         StreamBase::kFlagHasSendFile);
 
   env->SetProtoMethod(t, "open", Open);
   env->SetProtoMethod(t, "bind", Bind);
@@ -186,6 +195,32 @@ void TCPWrap::Open(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+// Bind through a socket created with SO_REUSEPORT so that several processes
+// can listen on the same address and have the kernel balance connections.
+static int BindReusePort(uv_tcp_t* handle, const sockaddr* addr) {
+#if defined(__linux__) && defined(SO_REUSEPORT)
+  int fd = socket(addr->sa_family, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd == -1)
+    return -errno;
+
+  int on = 1;
+  int err = 0;
+  if (setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on)) != 0)
+    err = -errno;
+  if (err == 0)
+    err = uv_tcp_open(handle, fd);
+  if (err != 0) {
+    close(fd);
+    return err;
+  }
+
+  return uv_tcp_bind(handle, addr, 0);
+#else
+  return UV_ENOTSUP;
+#endif
+}
+
+
 void TCPWrap::Bind(const FunctionCallbackInfo<Value>& args) {
   TCPWrap* wrap;
   ASSIGN_OR_RETURN_UNWRAP(&wrap,
@@ -195,7 +230,10 @@ void TCPWrap::Bind(const FunctionCallbackInfo<Value>& args) {
   int port = args[1]->Int32Value();
   sockaddr_in addr;
   int err = uv_ip4_addr(*ip_address, port, &addr);
-  if (err == 0) {
+  if (err == 0 && args[2]->IsTrue()) {
+    err = BindReusePort(&wrap->handle_,
+                        reinterpret_cast<const sockaddr*>(&addr));
+  } else if (err == 0) {
     err = uv_tcp_bind(&wrap->handle_,
                       reinterpret_cast<const sockaddr*>(&addr),
                       0);
@@ -213,7 +251,10 @@ void TCPWrap::Bind6(const FunctionCallbackInfo<Value>& args) {
   int port = args[1]->Int32Value();
   sockaddr_in6 addr;
   int err = uv_ip6_addr(*ip6_address, port, &addr);
-  if (err == 0) {
+  if (err == 0 && args[2]->IsTrue()) {
+    err = BindReusePort(&wrap->handle_,
+                        reinterpret_cast<const sockaddr*>(&addr));
+  } else if (err == 0) {
     err = uv_tcp_bind(&wrap->handle_,
                       reinterpret_cast<const sockaddr*>(&addr),
                       0);
@@ -23,6 +23,7 @@ using v8::Exception;
 using v8::Function;
 using v8::FunctionCallbackInfo;
 using v8::FunctionTemplate;
+using v8::Int32;
 using v8::Local;
 using v8::Object;
 using v8::String;
@@ -44,6 +45,8 @@ TLSWrap::TLSWrap(Environment* env,
       enc_out_(nullptr),
       clear_in_(nullptr),
       write_size_(0),
+      record_bytes_(0),
+      last_record_time_(0),
       started_(false),
       established_(false),
       shutdown_(false),
@@ -118,6 +121,7 @@ void TLSWrap::InitSSL() {
   // Initialize SSL
   enc_in_ = NodeBIO::New();
   enc_out_ = NodeBIO::New();
+  NodeBIO::FromBIO(enc_out_)->set_chunk(kEncOutChunkSize);
   NodeBIO::FromBIO(enc_in_)->AssignEnvironment(env());
   NodeBIO::FromBIO(enc_out_)->AssignEnvironment(env());
 
@@ -459,6 +463,18 @@ void TLSWrap::ClearOut() {
 }
 
 
+size_t TLSWrap::NextRecordSize() {
+  uint64_t now = uv_now(env()->event_loop());
+  if (now - last_record_time_ > kRecordSizeIdleTimeout)
+    record_bytes_ = 0;
+  last_record_time_ = now;
+
+  if (record_bytes_ < kRecordSizeBoostThreshold)
+    return kInitialRecordSize;
+  return kMaxRecordSize;
+}
+
+
 bool TLSWrap::ClearIn() {
   // Ignore cycling data if ClientHello wasn't yet parsed
   if (!hello_parser_.IsEnded())
@@ -473,11 +489,13 @@ bool TLSWrap::ClearIn() {
   while (clear_in_->Length() > 0) {
     size_t avail = 0;
     char* data = clear_in_->Peek(&avail);
+    avail = std::min(avail, NextRecordSize());
     written = SSL_write(ssl_, data, avail);
     CHECK(written == -1 || written == static_cast<int>(avail));
     if (written == -1)
       break;
     clear_in_->Read(nullptr, avail);
+    record_bytes_ += avail;
   }
 
   // All written
@@ -606,10 +624,18 @@ int TLSWrap::DoWrite(WriteWrap* w,
 
   crypto::MarkPopErrorOnReturn mark_pop_error_on_return;
 
+  // Split the data into records of NextRecordSize() bytes
   int written = 0;
+  size_t offset = 0;
   for (i = 0; i < count; i++) {
-    written = SSL_write(ssl_, bufs[i].base, bufs[i].len);
-    CHECK(written == -1 || written == static_cast<int>(bufs[i].len));
+    for (offset = 0; offset < bufs[i].len; offset += written) {
+      size_t len = std::min(bufs[i].len - offset, NextRecordSize());
+      written = SSL_write(ssl_, bufs[i].base + offset, len);
+      CHECK(written == -1 || written == static_cast<int>(len));
+      if (written == -1)
+        break;
+      record_bytes_ += written;
+    }
     if (written == -1)
       break;
   }
@@ -621,7 +647,8 @@ int TLSWrap::DoWrite(WriteWrap* w,
       return UV_EPROTO;
 
     // No errors, queue rest
-    for (; i < count; i++)
+    clear_in_->Write(bufs[i].base + offset, bufs[i].len - offset);
+    for (i++; i < count; i++)
       clear_in_->Write(bufs[i].base, bufs[i].len);
   }
 
@@ -800,6 +827,21 @@ void TLSWrap::DestroySSL(const FunctionCallbackInfo<Value>& args) {
 }
 
 
+void TLSWrap::SetEncOutChunkSize(const FunctionCallbackInfo<Value>& args) {
+  TLSWrap* wrap;
+  ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
+
+  int32_t size = args[0]->IsInt32() ? args[0].As<Int32>()->Value() : 0;
+  if (wrap->ssl_ == nullptr ||
+      size < kMinEncOutChunkSize || size > kMaxEncOutChunkSize) {
+    return args.GetReturnValue().Set(false);
+  }
+
+  NodeBIO::FromBIO(wrap->enc_out_)->set_chunk(size);
+  args.GetReturnValue().Set(true);
+}
+
+
 void TLSWrap::EnableCertCb(const FunctionCallbackInfo<Value>& args) {
   TLSWrap* wrap;
   ASSIGN_OR_RETURN_UNWRAP(&wrap, args.Holder());
@@ -911,6 +953,7 @@ void TLSWrap::Initialize(Local<Object> target,
   env->SetProtoMethod(t, "setVerifyMode", SetVerifyMode);
   env->SetProtoMethod(t, "enableSessionCallbacks", EnableSessionCallbacks);
   env->SetProtoMethod(t, "destroySSL", DestroySSL);
+  env->SetProtoMethod(t, "setEncOutChunkSize", SetEncOutChunkSize);
   env->SetProtoMethod(t, "enableCertCb", EnableCertCb);
 
   StreamBase::AddMethods<TLSWrap>(env, t, StreamBase::kFlagHasWritev);
@@ -66,6 +66,23 @@ class TLSWrap : public AsyncWrap,
   // Maximum number of buffers passed to uv_write()
   static const int kSimultaneousBufferCount = 10;
 
+  // Default size of the ciphertext chunks, several records are coalesced
+  // into each. setEncOutChunkSize() accepts sizes in [kMinEncOutChunkSize,
+  // kMaxEncOutChunkSize].
+  static const int kEncOutChunkSize = 65536;
+  static const int kMinEncOutChunkSize = 1024;
+  static const int kMaxEncOutChunkSize = 16 * 1024 * 1024;
+
+  // Records sized to fit a single TCP segment keep the first bytes of a
+  // response decryptable without waiting for the rest of a full record
+  static const int kInitialRecordSize = 1400;
+  static const int kMaxRecordSize = 16384;
+
+  // Bytes written in small records before switching to full-sized ones, and
+  // the idle time after which small records are used again
+  static const size_t kRecordSizeBoostThreshold = 1024 * 1024;
+  static const uint64_t kRecordSizeIdleTimeout = 1000;
+
   // Write callback queue's item
   class WriteItem {
    public:
@@ -88,6 +105,7 @@ class TLSWrap : public AsyncWrap,
   void InitSSL();
   void EncOut();
   static void EncOutCb(WriteWrap* req_wrap, int status);
+  size_t NextRecordSize();
   bool ClearIn();
   void ClearOut();
   void MakePending();
@@ -137,6 +155,8 @@ class TLSWrap : public AsyncWrap,
   static void EnableCertCb(
       const v8::FunctionCallbackInfo<v8::Value>& args);
   static void DestroySSL(const v8::FunctionCallbackInfo<v8::Value>& args);
+  static void SetEncOutChunkSize(
+      const v8::FunctionCallbackInfo<v8::Value>& args);
 
 #ifdef SSL_CTRL_SET_TLSEXT_SERVERNAME_CB
   static void GetServername(const v8::FunctionCallbackInfo<v8::Value>& args);
@@ -150,6 +170,8 @@ class TLSWrap : public AsyncWrap,
   BIO* enc_out_;
   NodeBIO* clear_in_;
   size_t write_size_;
+  size_t record_bytes_;
+  uint64_t last_record_time_;
   typedef ListHead<WriteItem, &WriteItem::member_> WriteItemList;
   WriteItemList write_item_queue_;
   WriteItemList pending_write_items_;
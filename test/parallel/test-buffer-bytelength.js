@@ -69,6 +69,23 @@ assert.strictEqual(Buffer.byteLength('hello world', ''), 11);
 assert.strictEqual(Buffer.byteLength('hello world', 'abc'), 11);
 assert.strictEqual(Buffer.byteLength('ßœ∑≈', 'unkn0wn enc0ding'), 10);
 
+// utf8 with long ascii runs, which are converted in blocks
+for (let i = 0; i < 40; i++) {
+  const prefix = 'a'.repeat(i);
+  for (const [ch, len] of [['é', 2], ['挵', 3], ['𠝹', 4], ['\uD800', 3]]) {
+    const str = prefix + ch + 'b'.repeat(40 - i);
+    assert.strictEqual(Buffer.byteLength(str), 40 + len);
+    if (ch !== '\uD800') {
+      assert.strictEqual(Buffer.from(str).toString(), str);
+    }
+
+    // a partial write stops before a character that doesn't fit
+    const buf = Buffer.alloc(i + len - 1, '-');
+    assert.strictEqual(buf.write(str), i);
+    assert.strictEqual(buf.toString('latin1', 0, i), prefix);
+  }
+}
+
 // base64
 assert.strictEqual(Buffer.byteLength('aGVsbG8gd29ybGQ=', 'base64'), 11);
 assert.strictEqual(Buffer.byteLength('bm9kZS5qcyByb2NrcyE=', 'base64'), 14);
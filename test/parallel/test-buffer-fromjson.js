@@ -0,0 +1,38 @@
+'use strict';
+require('../common');
+const assert = require('assert');
+
+function check(value) {
+  const json = JSON.stringify(value);
+  const buf = Buffer.fromJSON(value);
+  assert(buf instanceof Buffer);
+  assert.deepStrictEqual(buf, Buffer.from(json));
+  assert.strictEqual(buf.toString(), json);
+}
+
+check(null);
+check(42);
+check('quote " backslash \\ newline \n control \u0001');
+check({ a: [1, 'two', { three: 3 }], b: 'héllo wörld', c: '😀' });
+check([new Date(0), Buffer.from('buf'), { toJSON: () => 'custom' }]);
+
+// Long enough to span many pieces of the engine's string tree
+const big = [];
+for (let i = 0; i < 10000; i++)
+  big.push({ id: i, name: `item ${i} é中`, tags: ['x', 'y\t'] });
+check(big);
+
+// Lone surrogates encode the same way Buffer.from() encodes them
+check('\ud800');
+check(['\udc00', '\ud83d' + 'a', '\ud83d' + '\ude00']);
+
+assert.strictEqual(Buffer.fromJSON(undefined), undefined);
+assert.strictEqual(Buffer.fromJSON(function() {}), undefined);
+assert.strictEqual(Buffer.fromJSON(), undefined);
+
+const circular = {};
+circular.self = circular;
+assert.throws(() => Buffer.fromJSON(circular), TypeError);
+
+assert.throws(() => Buffer.fromJSON({ toJSON() { throw new Error('boom'); } }),
+              /^Error: boom$/);
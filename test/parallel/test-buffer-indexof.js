@@ -518,3 +518,30 @@ assert.equal(0, reallyLong.lastIndexOf(pattern));
   assert.strictEqual(buf.indexOf(0xff), -1);
   assert.strictEqual(buf.indexOf(0xffff), -1);
 }
+
+// Matches on either side of the 16 byte blocks that short patterns are
+// searched in, for one and two byte encodings.
+{
+  const filler = 'abcdefghijklmnopqrstuvw'.repeat(2);
+  for (const pattern of ['x', 'xy', 'xÿy', 'xyzzy']) {
+    for (let at = 0; at < 40; at++) {
+      const str = filler.slice(0, at) + pattern + filler.slice(at);
+      for (const encoding of ['latin1', 'ucs2']) {
+        const buf = Buffer.from(str, encoding);
+        const scale = encoding === 'ucs2' ? 2 : 1;
+        assert.strictEqual(buf.indexOf(pattern, 0, encoding), at * scale);
+        assert.strictEqual(buf.indexOf(pattern, (at + 1) * scale, encoding),
+                           -1);
+        assert.strictEqual(
+          buf.indexOf(Buffer.from(pattern, encoding)), at * scale);
+      }
+    }
+  }
+
+  // The first and last characters match without the middle one
+  const buf = Buffer.from('x_zx_zxyzx_z', 'ucs2');
+  assert.strictEqual(buf.indexOf('xyz', 0, 'ucs2'), 12);
+  // Characters that share their low byte with the pattern
+  const wide = Buffer.from('Ÿɸ͸x', 'ucs2');
+  assert.strictEqual(wide.indexOf('x', 0, 'ucs2'), 6);
+}
@@ -0,0 +1,78 @@
+'use strict';
+require('../common');
+const assert = require('assert');
+
+function check(text) {
+  const buf = Buffer.from(text);
+  assert.deepStrictEqual(Buffer.parseJSON(buf), JSON.parse(text));
+}
+
+check('null');
+check(' [true, false, null] ');
+check('-0.5e3');
+check('"quote \\" backslash \\\\ newline \\n unicode \\u00e9 \\ud83d\\ude00"');
+check('{"a": [1, "two", {"three": 3}], "b": "h\u00e9llo w\u00f6rld", ' +
+      '"c": "\ud83d\ude00\u4e2d"}');
+check(`"${'a long plain ascii run '.repeat(20)}\u00e9${'x'.repeat(31)}"`);
+check(JSON.stringify({ '': 1, '\u00e9': 2, '\ud83d\ude00': 3, 'tab\t': 4 }));
+
+// Many objects of the same shape
+const big = [];
+for (let i = 0; i < 10000; i++)
+  big.push({ id: i, name: `item ${i} \u00e9\u4e2d`, tags: ['x', 'y\t'] });
+check(JSON.stringify(big));
+
+// Only the bytes in view are parsed, even where the text could go on
+const digits = Buffer.from('12345');
+assert.strictEqual(Buffer.parseJSON(digits.slice(0, 3)), 123);
+assert.strictEqual(Buffer.parseJSON(new Uint8Array(digits.buffer,
+                                                   digits.byteOffset + 1,
+                                                   2)), 23);
+assert.throws(() => Buffer.parseJSON(Buffer.from('"abc"').slice(0, 4)),
+              SyntaxError);
+
+// Noncharacters are kept, and every maximal subpart of an ill-formed
+// sequence becomes a single U+FFFD, as in the WHATWG Encoding Standard
+function checkBytes(bytes, expected) {
+  const buf = Buffer.from([0x22].concat(bytes, [0x22]));
+  assert.strictEqual(Buffer.parseJSON(buf), expected);
+}
+
+checkBytes([0xef, 0xb7, 0x90], '\ufdd0');
+checkBytes([0xef, 0xbf, 0xbe, 0xef, 0xbf, 0xbf], '\ufffe\uffff');
+checkBytes([0xf0, 0x9f, 0xbf, 0xbe], '\ud83f\udffe');
+checkBytes([0xf4, 0x8f, 0xbf, 0xbf], '\udbff\udfff');
+checkBytes([0x61, 0xff, 0xc3], 'a\ufffd\ufffd');
+// Truncated sequences
+checkBytes([0xc3], '\ufffd');
+checkBytes([0xe2, 0x82], '\ufffd');
+checkBytes([0xf0, 0x9f, 0x98], '\ufffd');
+checkBytes([0xf0, 0x9f, 0x98, 0x61], '\ufffda');
+checkBytes([0xe2, 0x82, 0xf0, 0x9f, 0x98, 0x80], '\ufffd\ud83d\ude00');
+// Overlong forms, surrogates and code points above U+10FFFF
+checkBytes([0xc0, 0xaf], '\ufffd\ufffd');
+checkBytes([0xe0, 0x80, 0xaf], '\ufffd\ufffd\ufffd');
+checkBytes([0xed, 0xa0, 0x80], '\ufffd\ufffd\ufffd');
+checkBytes([0xf4, 0x90, 0x80, 0x80], '\ufffd\ufffd\ufffd\ufffd');
+checkBytes([0xf8, 0x88, 0x80, 0x80, 0x80],
+           '\ufffd\ufffd\ufffd\ufffd\ufffd');
+// A quote ends a truncated sequence and the string
+assert.strictEqual(Buffer.parseJSON(Buffer.from([0x5b, 0x22, 0xe2, 0x22,
+                                                 0x2c, 0x31, 0x5d])),
+                   ['\ufffd', 1]);
+
+const revived = Buffer.parseJSON(Buffer.from('{"a": 1, "b": [2, 3]}'),
+                                 (key, value) => {
+                                   return typeof value === 'number' ?
+                                       value * 10 : value;
+                                 });
+assert.deepStrictEqual(revived, { a: 10, b: [20, 30] });
+
+assert.throws(() => Buffer.parseJSON(Buffer.alloc(0)), SyntaxError);
+assert.throws(() => Buffer.parseJSON(Buffer.from('{"a": }')), SyntaxError);
+assert.throws(() => Buffer.parseJSON(Buffer.from('"\n"')), SyntaxError);
+assert.throws(() => Buffer.parseJSON(Buffer.from('[1, 2')), SyntaxError);
+
+assert.throws(() => Buffer.parseJSON('{}'),
+              /^TypeError: "buffer" argument must be a Buffer or Uint8Array$/);
+assert.throws(() => Buffer.parseJSON(new ArrayBuffer(2)), TypeError);
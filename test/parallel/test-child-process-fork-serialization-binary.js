@@ -0,0 +1,77 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const fork = require('child_process').fork;
+const net = require('net');
+
+if (process.argv[2] === 'child') {
+  process.on('message', function(message, handle) {
+    if (handle) {
+      // A handle travels with a message spanning several reads
+      assert.strictEqual(message.withHandle.length, 200000);
+      process.send({ handle: handle instanceof net.Server });
+      handle.close();
+      return;
+    }
+
+    // Echo back, adding values that JSON could not carry
+    message.echo = true;
+    message.typed = new Float64Array([0.5, -Infinity]);
+    message.self = message;
+    process.send(message);
+    process.disconnect();
+  });
+  return;
+}
+
+const child = fork(__filename, ['child'], { serialization: 'binary' });
+
+const payload = {
+  text: 'caf\u00e9',
+  number: -0,
+  missing: undefined,
+  buffer: Buffer.alloc(100000, 'x'),
+  date: new Date(1234),
+  map: new Map([['key', [1, 2, 3]]]),
+  set: new Set([null, true]),
+  // An own `__proto__` key is data, not the prototype
+  proto: JSON.parse('{"__proto__": {"polluted": true}}')
+};
+
+child.on('message', common.mustCall(function(message) {
+  if ('handle' in message) {
+    assert.strictEqual(message.handle, true);
+    server.close();
+    return;
+  }
+
+  assert.strictEqual(message.echo, true);
+  assert.strictEqual(message.text, payload.text);
+  assert(Object.is(message.number, -0));
+  assert('missing' in message);
+  assert(message.buffer.equals(payload.buffer));
+  assert.strictEqual(message.date.getTime(), 1234);
+  assert.deepStrictEqual(message.map.get('key'), [1, 2, 3]);
+  assert(message.set.has(null) && message.set.has(true));
+  assert(message.typed instanceof Float64Array);
+  assert.deepStrictEqual(Array.from(message.typed), [0.5, -Infinity]);
+  assert.strictEqual(message.self, message);
+  assert(message.proto.hasOwnProperty('__proto__'));
+  assert.strictEqual(Object.getPrototypeOf(message.proto), Object.prototype);
+  assert.strictEqual(message.proto.polluted, undefined);
+  assert.strictEqual({}.polluted, undefined);
+}, 2));
+
+child.on('exit', common.mustCall(function(code) {
+  assert.strictEqual(code, 0);
+}));
+
+const server = net.createServer();
+server.listen(0, common.mustCall(function() {
+  child.send({ withHandle: Buffer.alloc(200000) }, server);
+  child.send(payload);
+}));
+
+assert.throws(function() {
+  fork(__filename, ['child'], { serialization: 'xml' });
+}, /"serialization" must be "json" or "binary"/);
@@ -0,0 +1,52 @@
+// Flags: --expose_internals
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const cluster = require('cluster');
+const net = require('net');
+
+if (!common.isLinux) {
+  common.skip('SO_REUSEPORT load balancing is Linux only');
+  return;
+}
+
+// With SCHED_REUSEPORT every worker binds the port itself and accepts its
+// connections directly, without the master handing them off.
+cluster.schedulingPolicy = cluster.SCHED_REUSEPORT;
+
+if (cluster.isWorker) {
+  net.createServer(function(socket) {
+    socket.end(`${cluster.worker.id}\n`);
+  }).listen(common.PORT, common.localhostIPv4, function() {
+    process.send('listening');
+  });
+  return;
+}
+
+const handles = require('internal/cluster').handles;
+const workers = [cluster.fork(), cluster.fork()];
+let listening = 0;
+
+for (const worker of workers) {
+  worker.on('message', common.mustCall(function() {
+    if (++listening === workers.length)
+      connect(20);
+  }));
+}
+
+function connect(remaining) {
+  if (remaining === 0) {
+    // The master only tracks the workers, it never owns a listen socket
+    for (const key in handles)
+      assert.strictEqual(handles[key].handle, undefined);
+    workers.forEach((worker) => worker.disconnect());
+    return;
+  }
+
+  const socket = net.connect(common.PORT, common.localhostIPv4);
+  socket.setEncoding('utf8');
+  socket.once('data', common.mustCall(function(data) {
+    assert(/^\d+\n$/.test(data));
+    connect(remaining - 1);
+  }));
+}
@@ -0,0 +1,46 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+
+// Only the chakracore time zone code re-reads TZ on the fly, V8 caches the
+// zone it started with.
+if (!common.isChakraEngine) {
+  common.skip('TZ changes are only picked up at run time by chakracore');
+  return;
+}
+
+if (common.isWindows) {
+  common.skip('TZ is not used to pick the time zone on Windows');
+  return;
+}
+
+if (!fs.existsSync('/usr/share/zoneinfo/America/New_York') ||
+    !fs.existsSync('/usr/share/zoneinfo/Australia/Sydney')) {
+  common.skip('missing time zone database');
+  return;
+}
+
+// A Date keeps the local time it has computed, so each check uses a new one
+const summer = () => new Date('2016-07-01T12:00:00Z');
+const winter = () => new Date('2016-01-01T12:00:00Z');
+
+process.env.TZ = 'America/New_York';
+assert.strictEqual(summer().getTimezoneOffset(), 240);
+assert.strictEqual(winter().getTimezoneOffset(), 300);
+assert.strictEqual(summer().getHours(), 8);
+assert.strictEqual(new Date(2016, 6, 1, 8).getTime(), summer().getTime());
+// Transitions past 2037 come from the rule at the end of the zone file
+assert.strictEqual(new Date('2050-07-01T12:00:00Z').getTimezoneOffset(), 240);
+assert.strictEqual(new Date('2050-01-01T12:00:00Z').getTimezoneOffset(), 300);
+
+// Changing TZ takes effect on the next conversion
+process.env.TZ = 'Australia/Sydney';
+assert.strictEqual(summer().getTimezoneOffset(), -600);
+assert.strictEqual(winter().getTimezoneOffset(), -660);
+assert.strictEqual(winter().getHours(), 23);
+assert.strictEqual(new Date(2016, 0, 1, 23).getTime(), winter().getTime());
+
+process.env.TZ = 'UTC';
+assert.strictEqual(summer().getTimezoneOffset(), 0);
+assert.strictEqual(summer().getHours(), 12);
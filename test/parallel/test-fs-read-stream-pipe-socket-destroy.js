@@ -0,0 +1,55 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const net = require('net');
+const path = require('path');
+
+// Destroying a ReadStream while it is being sent to a socket by sendfile
+// closes its fd with a transfer still in flight. The transfer must not go on
+// to read from another file that is opened under the same fd number.
+
+common.refreshTmpDir();
+
+const file = path.join(common.tmpDir, 'read_stream_pipe_socket_destroy.txt');
+const content = Buffer.alloc(3 * 1024 * 1024);
+for (let i = 0; i < content.length; i++)
+  content[i] = i % 251;
+fs.writeFileSync(file, content);
+
+// None of these bytes appear in content.
+const otherFile = path.join(common.tmpDir, 'read_stream_pipe_socket_other.txt');
+fs.writeFileSync(otherFile, Buffer.alloc(content.length, 0xff));
+
+let otherFd;
+
+const server = net.createServer(common.mustCall(function(socket) {
+  const stream = fs.createReadStream(file);
+  stream.pipe(socket);
+  stream.on('close', common.mustCall(function() {
+    // Likely to reuse the fd number the stream had.
+    otherFd = fs.openSync(otherFile, 'r');
+    client.resume();
+  }));
+  // The socket is full by now, so the transfer is waiting for it to drain.
+  setTimeout(function() {
+    stream.destroy();
+  }, 100);
+}));
+
+let client;
+server.listen(0, common.mustCall(function() {
+  const chunks = [];
+  client = net.connect(this.address().port);
+  client.pause();
+  client.on('data', function(chunk) {
+    chunks.push(chunk);
+  });
+  client.on('close', common.mustCall(function() {
+    const received = Buffer.concat(chunks);
+    assert.ok(received.length <= content.length);
+    assert.deepStrictEqual(received, content.slice(0, received.length));
+    fs.closeSync(otherFd);
+    server.close();
+  }));
+}));
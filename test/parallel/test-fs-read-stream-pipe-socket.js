@@ -0,0 +1,72 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const net = require('net');
+const path = require('path');
+
+// A ReadStream piped straight into a net.Socket may be copied by the kernel
+// (sendfile) instead of through Buffers. The bytes on the wire, the range
+// honoured and the stream bookkeeping must be the same either way. On Linux
+// the sendfile path must actually be taken.
+
+common.refreshTmpDir();
+
+const file = path.join(common.tmpDir, 'read_stream_pipe_socket.txt');
+// Several sendfile chunks, and more than the socket buffers can take while the
+// client is paused.
+const content = Buffer.alloc(3 * 1024 * 1024 + 12345);
+for (let i = 0; i < content.length; i++)
+  content[i] = i % 251;
+fs.writeFileSync(file, content);
+
+const sendFile = net.Socket.prototype._sendFile;
+let sendFileCalls = 0;
+net.Socket.prototype._sendFile = function() {
+  sendFileCalls++;
+  return sendFile.apply(this, arguments);
+};
+
+process.on('exit', function() {
+  if (common.isLinux)
+    assert.strictEqual(sendFileCalls, 4);
+});
+
+function check(options, expected, next) {
+  const server = net.createServer(common.mustCall(function(socket) {
+    const stream = fs.createReadStream(file, options);
+    stream.on('end', common.mustCall(function() {
+      assert.strictEqual(stream.bytesRead, expected.length);
+    }));
+    stream.on('close', common.mustCall(function() {}));
+    stream.pipe(socket);
+  }));
+
+  server.listen(0, common.mustCall(function() {
+    const chunks = [];
+    const client = net.connect(this.address().port);
+    // Let the socket fill up so the transfer has to wait for it to drain.
+    client.pause();
+    setTimeout(function() {
+      client.resume();
+    }, 100);
+    client.on('data', function(chunk) {
+      chunks.push(chunk);
+    });
+    client.on('end', common.mustCall(function() {
+      assert.deepStrictEqual(Buffer.concat(chunks), expected);
+      server.close();
+      next();
+    }));
+  }));
+}
+
+check(undefined, content, function() {
+  check({ start: 1000, end: 99999 }, content.slice(1000, 100000), function() {
+    check({ start: 200000 }, content.slice(200000), function() {
+      check({ start: 2500000, end: 2600000 },
+            content.slice(2500000, 2600001),
+            common.mustCall());
+    });
+  });
+});
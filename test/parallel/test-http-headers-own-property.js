@@ -0,0 +1,57 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const http = require('http');
+
+// The parser hands header values over lazily. `headers` and `rawHeaders`
+// must still behave like plain own properties of the message.
+
+function checkOwnProperties(msg) {
+  assert.ok(msg.hasOwnProperty('headers'));
+  assert.ok(msg.hasOwnProperty('rawHeaders'));
+  assert.notStrictEqual(Object.keys(msg).indexOf('headers'), -1);
+  assert.notStrictEqual(Object.keys(msg).indexOf('rawHeaders'), -1);
+
+  // Object.assign() and spreading copy own enumerable properties only.
+  const copy = Object.assign({}, msg);
+  assert.strictEqual(copy.headers['x-foo'], 'bar');
+  const i = copy.rawHeaders.indexOf('X-Foo');
+  assert.strictEqual(copy.rawHeaders[i + 1], 'bar');
+
+  // After the first read they are data properties.
+  const descriptor = Object.getOwnPropertyDescriptor(msg, 'headers');
+  assert.strictEqual(descriptor.value, msg.headers);
+  assert.strictEqual(descriptor.writable, true);
+  assert.strictEqual(
+      Object.getOwnPropertyDescriptor(msg, 'rawHeaders').value,
+      msg.rawHeaders);
+}
+
+const server = http.createServer(common.mustCall(function(req, res) {
+  checkOwnProperties(req);
+  res.setHeader('X-Foo', 'bar');
+  res.end();
+}));
+
+server.listen(0, common.mustCall(function() {
+  http.get({
+    port: this.address().port,
+    headers: { 'X-Foo': 'bar' }
+  }, common.mustCall(function(res) {
+    checkOwnProperties(res);
+    res.resume();
+    res.on('end', common.mustCall(function() {
+      server.close();
+    }));
+  }));
+}));
+
+// Assigning before the lazy values were read replaces them.
+const IncomingMessage = http.IncomingMessage;
+const msg = new IncomingMessage(null);
+msg._addLazyHeaderLines(['Host', 11], 2, Buffer.from('example.com'));
+msg.headers = { replaced: true };
+assert.deepStrictEqual(msg.headers, { replaced: true });
+assert.deepStrictEqual(msg.rawHeaders, ['Host', 'example.com']);
+assert.strictEqual(Object.getOwnPropertyDescriptor(msg, 'headers').writable,
+                   true);
@@ -240,6 +240,35 @@ function expectBody(expected) {
 }
 
 
+//
+// Test lazy header values.
+//
+{
+  const request = Buffer.from(
+      'GET / HTTP/1.1' + CRLF +
+      'Host: example.com' + CRLF +
+      'content-type: text/plain' + CRLF +
+      'X-Empty:' + CRLF +
+      'Content-Type: text/html' + CRLF +
+      CRLF);
+
+  const onHeadersComplete = function(versionMajor, versionMinor, headers,
+                                     method, url, statusCode, statusMessage,
+                                     upgrade, shouldKeepAlive, values) {
+    assert.deepStrictEqual(
+        headers,
+        ['Host', 11, 'content-type', 21, 'X-Empty', 21, 'Content-Type', 30]);
+    assert.strictEqual(values.toString('latin1'),
+                       'example.comtext/plaintext/html');
+  };
+
+  const parser = newParser(REQUEST);
+  parser.setLazyHeaderValues(true);
+  parser[kOnHeadersComplete] = mustCall(onHeadersComplete);
+  parser.execute(request, 0, request.length);
+}
+
+
 //
 // Test large number of headers
 //
@@ -257,12 +286,11 @@ function expectBody(expected) {
                                      method, url, statusCode, statusMessage,
                                      upgrade, shouldKeepAlive) {
     assert.strictEqual(method, methods.indexOf('GET'));
-    assert.strictEqual(url || parser.url, '/foo/bar/baz?quux=42#1337');
+    assert.strictEqual(url, '/foo/bar/baz?quux=42#1337');
     assert.strictEqual(versionMajor, 1);
     assert.strictEqual(versionMinor, 0);
 
-    headers = headers || parser.headers;
-
+    // All headers arrive here, none are flushed through kOnHeaders first.
     assert.strictEqual(headers.length, 2 * 256); // 256 key/value pairs
     for (let i = 0; i < headers.length; i += 2) {
       assert.strictEqual(headers[i], 'X-Filler');
@@ -271,6 +299,9 @@ function expectBody(expected) {
   };
 
   const parser = newParser(REQUEST);
+  parser[kOnHeaders] = function() {
+    assert.ok(false, 'Function should not be called.');
+  };
   parser[kOnHeadersComplete] = mustCall(onHeadersComplete);
   parser.execute(request, 0, request.length);
 }
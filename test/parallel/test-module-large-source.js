@@ -0,0 +1,83 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const fs = require('fs');
+const path = require('path');
+
+// Large modules may be parsed from a view of the file itself, outside of the
+// engine's heap. Functions parsed from them must keep seeing the source they
+// were compiled from, whatever happens to the file afterwards.
+
+common.refreshTmpDir();
+
+// Non-ASCII text in strings, comments and identifiers, and a character
+// outside of the BMP, so that source offsets and utf8 lengths differ.
+const body = 'function big\u00e9() {\n' +
+             '  // \u00fcber \u2603 \ud83d\ude00\n' +
+             '  return "\u00e9\u2603\ud83d\ude00";\n' +
+             '}\n' +
+             'exports.big\u00e9 = big\u00e9;\n' +
+             'exports.lazy = function() { return "\u2603".length; };\n' +
+             '/*' + 'x'.repeat(128 * 1024) + '*/\n' +
+             'exports.last = function last() { return 42; };\n';
+
+function check(mod) {
+  assert.strictEqual(mod['big\u00e9'](), '\u00e9\u2603\ud83d\ude00');
+  assert.strictEqual(mod.lazy(), 1);
+  assert.strictEqual(mod.last(), 42);
+  assert.strictEqual(mod.last.toString(),
+                     'function last() { return 42; }');
+  const source = mod['big\u00e9'].toString();
+  assert.ok(source.includes('\u00fcber \u2603 \ud83d\ude00'));
+}
+
+const file = path.join(common.tmpDir, 'large.js');
+fs.writeFileSync(file, body);
+const mod = require(file);
+check(mod);
+
+// Rewriting the file does not change what deferred functions are parsed from.
+// A file that is mapped can't be rewritten at all.
+try {
+  fs.writeFileSync(file, body.replace(/return 42/, 'return 43'));
+} catch (e) {
+  assert.strictEqual(e.code, 'EBUSY');
+}
+assert.strictEqual(mod.last(), 42);
+assert.strictEqual(mod.last.toString(), 'function last() { return 42; }');
+fs.unlinkSync(file);
+check(mod);
+
+// A BOM and a shebang are stripped before the module is compiled.
+const bomFile = path.join(common.tmpDir, 'large-bom.js');
+fs.writeFileSync(bomFile, '\ufeff#!/usr/bin/env node\n' + body);
+check(require(bomFile));
+
+// A shebang alone is read as a comment, which keeps line numbers as they are.
+const shebangFile = path.join(common.tmpDir, 'large-shebang.js');
+fs.writeFileSync(shebangFile, '#!/usr/bin/env node\n' + body +
+                 'exports.where = function() { return new Error().stack; };\n');
+const shebang = require(shebangFile);
+check(shebang);
+const line = body.split('\n').length + 1;
+assert.ok(shebang.where().includes('large-shebang.js:' + line + ':'));
+
+// The engine reads a utf8 source up to its first NUL, so a module with a raw
+// NUL in it is compiled from the string itself.
+const nulFile = path.join(common.tmpDir, 'large-nul.js');
+fs.writeFileSync(nulFile, body + 'exports.nul = "\u0000";\n');
+const nul = require(nulFile);
+check(nul);
+assert.strictEqual(nul.nul, '\u0000');
+
+// Syntax errors are still thrown as such.
+const badFile = path.join(common.tmpDir, 'large-bad.js');
+fs.writeFileSync(badFile, body + 'exports.bad = ;\n');
+assert.throws(() => require(badFile), SyntaxError);
+
+// Small modules are unaffected.
+const smallFile = path.join(common.tmpDir, 'small.js');
+fs.writeFileSync(smallFile, 'exports.f = function f() { return 1; };\n');
+const small = require(smallFile);
+assert.strictEqual(small.f(), 1);
+assert.strictEqual(small.f.toString(), 'function f() { return 1; }');
@@ -0,0 +1,64 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+
+if (!common.hasCrypto) {
+  common.skip('missing crypto');
+  return;
+}
+const tls = require('tls');
+
+const fs = require('fs');
+
+// A connection starts out with records small enough for a single TCP segment
+// and switches to full-sized records once enough data has been sent. Every
+// record is decrypted into its own 'data' chunk on the receiving side.
+
+const initialRecordSize = 1400;
+const maxRecordSize = 16384;
+const buf = Buffer.alloc(2 * 1024 * 1024, 'x');
+const chunks = [];
+
+const server = tls.createServer({
+  key: fs.readFileSync(common.fixturesDir + '/keys/agent1-key.pem'),
+  cert: fs.readFileSync(common.fixturesDir + '/keys/agent1-cert.pem')
+}, function(c) {
+  // Lower and upper limits
+  assert(!c.setSendChunkSize(1023));
+  assert(!c.setSendChunkSize(16 * 1024 * 1024 + 1));
+  assert(!c.setSendChunkSize('4096'));
+
+  // Chunks smaller than a record still carry whole records
+  assert(c.setSendChunkSize(1024));
+
+  c.end(buf);
+}).listen(0, common.mustCall(function() {
+  const c = tls.connect(this.address().port, {
+    rejectUnauthorized: false
+  }, common.mustCall(function() {
+    c.on('data', function(chunk) {
+      chunks.push(chunk.length);
+    });
+
+    c.on('end', common.mustCall(function() {
+      c.destroy();
+      server.close();
+
+      const received = chunks.reduce((a, b) => a + b, 0);
+      assert.strictEqual(received, buf.length);
+
+      // The first megabyte goes out in small records...
+      let sent = 0;
+      let i = 0;
+      for (; sent < 1024 * 1024; i++) {
+        assert(chunks[i] <= initialRecordSize,
+               `record ${i} is ${chunks[i]} bytes`);
+        sent += chunks[i];
+      }
+
+      // ...and the rest in full-sized ones
+      assert(chunks.slice(i).some((len) => len > initialRecordSize));
+      chunks.forEach((len) => assert(len <= maxRecordSize));
+    }));
+  }));
+}));
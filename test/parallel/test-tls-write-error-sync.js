@@ -0,0 +1,45 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+
+if (!common.hasCrypto) {
+  common.skip('missing crypto');
+  return;
+}
+const tls = require('tls');
+
+const fs = require('fs');
+const WriteWrap = process.binding('stream_wrap').WriteWrap;
+const UV_EPROTO = process.binding('uv').UV_EPROTO;
+
+// SSL_write() errors are returned by the write itself rather than reported
+// later, whatever size the records are being split into.
+
+const server = tls.createServer({
+  key: fs.readFileSync(common.fixturesDir + '/keys/agent1-key.pem'),
+  cert: fs.readFileSync(common.fixturesDir + '/keys/agent1-cert.pem')
+}, function(c) {
+  c.on('error', function() {});
+}).listen(0, common.mustCall(function() {
+  const c = tls.connect(this.address().port, {
+    rejectUnauthorized: false
+  }, common.mustCall(function() {
+    // Once shut down, the SSL object refuses to write
+    c._handle.shutdownSSL();
+
+    const req = new WriteWrap();
+    req.handle = c._handle;
+    req.oncomplete = function() {};
+    const err = c._handle.writeBuffer(req, Buffer.alloc(64 * 1024, 'x'));
+    assert.strictEqual(err, UV_EPROTO);
+    assert(/shutdown/i.test(req.error), req.error);
+
+    // The socket reports it the same way
+    c.on('error', common.mustCall(function(err) {
+      assert.strictEqual(err.code, 'EPROTO');
+      c.destroy();
+      server.close();
+    }));
+    c.write('x');
+  }));
+}));
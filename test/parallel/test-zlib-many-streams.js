@@ -0,0 +1,34 @@
+'use strict';
+// Many small streams compressed concurrently share threadpool jobs, and the
+// deflate state of finished streams is reused by later ones. Each stream
+// must still produce its own, independent output.
+
+const common = require('../common');
+const assert = require('assert');
+const zlib = require('zlib');
+
+const streams = 100;
+
+function roundtrip(i, level, callback) {
+  const input = Buffer.from(`response ${i} `.repeat(i + 1));
+  zlib.gzip(input, { level: level }, common.mustCall(function(err, zipped) {
+    assert.ifError(err);
+    zlib.gunzip(zipped, common.mustCall(function(err, result) {
+      assert.ifError(err);
+      assert.deepStrictEqual(result, input);
+      callback();
+    }));
+  }));
+}
+
+let done = 0;
+function next() {
+  if (++done === streams) {
+    // A second wave runs on streams released by the first one
+    for (let i = 0; i < streams; i++)
+      roundtrip(i, i % 2 ? 9 : 1, function() {});
+  }
+}
+
+for (let i = 0; i < streams; i++)
+  roundtrip(i, i % 2 ? 1 : 9, next);
@@ -0,0 +1,59 @@
+'use strict';
+const common = require('../common');
+const assert = require('assert');
+const cluster = require('cluster');
+const net = require('net');
+
+// With SCHED_LOAD the master hands every connection to the least loaded idle
+// worker. A worker that keeps its connections open should stop receiving new
+// ones while another worker is idle. The master counts its own handoffs until
+// the worker reports them, so this does not depend on the report timing.
+cluster.schedulingPolicy = cluster.SCHED_LOAD;
+
+if (cluster.isWorker) {
+  const sockets = [];
+  net.createServer(function(socket) {
+    sockets.push(socket);
+    socket.write(`${cluster.worker.id}\n`);
+  }).listen(0, function() {
+    process.send({ port: this.address().port });
+  });
+  process.on('disconnect', () => sockets.forEach((s) => s.destroy()));
+  return;
+}
+
+const workers = [cluster.fork(), cluster.fork()];
+const connections = [];
+const counts = {};
+let listening = 0;
+let port;
+
+for (const worker of workers) {
+  worker.on('message', common.mustCall(function(message) {
+    port = message.port;
+    if (++listening === workers.length)
+      connect(10);
+  }));
+}
+
+function connect(remaining) {
+  if (remaining === 0)
+    return done();
+
+  const socket = net.connect(port, common.localhostIPv4);
+  socket.setEncoding('utf8');
+  socket.once('data', common.mustCall(function(data) {
+    const id = data.trim();
+    counts[id] = (counts[id] || 0) + 1;
+    connections.push(socket);
+    connect(remaining - 1);
+  }));
+}
+
+function done() {
+  assert.strictEqual(Object.keys(counts).length, workers.length);
+  for (const id in counts)
+    assert.strictEqual(counts[id], 5, JSON.stringify(counts));
+  connections.forEach((socket) => socket.destroy());
+  workers.forEach((worker) => worker.disconnect());
+}
@@ -38,7 +38,9 @@ import string
 
 
 def ToCArray(filename, lines):
-  return ','.join(str(ord(c)) for c in lines)
+  # NUL-terminated so the source can be parsed in place as a C string; the
+  # terminator is left out of the recorded length.
+  return ','.join([str(ord(c)) for c in lines] + ['0'])
 
 
 def ReadFile(filename):
@@ -194,7 +196,7 @@ static const struct _native natives[] = { %(native_lines)s };
 
 
 NATIVE_DECLARATION = """\
-  { "%(id)s", %(escaped_id)s_native, sizeof(%(escaped_id)s_native) },
+  { "%(id)s", %(escaped_id)s_native, sizeof(%(escaped_id)s_native) - 1 },
 """
 
 SOURCE_DECLARATION = """\